@@ -82,13 +82,21 @@ uint32_t DecApp::decode()
   int                 poc;
   PicList* pcListPic = NULL;
 
-  ifstream bitstreamFile(m_bitstreamFileName.c_str(), ifstream::in | ifstream::binary);
-  if (!bitstreamFile)
+  // map regular files into memory, fall back to stream reading for pipes and the like
+  MappedBitstreamFile mappedBitstreamFile;
+  ifstream bitstreamFile;
+#if !RExt__DECODER_DEBUG_BIT_STATISTICS
+  if (!m_mapBitstreamFile || !mappedBitstreamFile.open(m_bitstreamFileName))
+#endif
   {
-    EXIT( "Failed to open bitstream file " << m_bitstreamFileName.c_str() << " for reading" ) ;
+    bitstreamFile.open(m_bitstreamFileName.c_str(), ifstream::in | ifstream::binary);
+    if (!bitstreamFile)
+    {
+      EXIT( "Failed to open bitstream file " << m_bitstreamFileName.c_str() << " for reading" ) ;
+    }
   }
 
-  InputByteStream bytestream(bitstreamFile);
+  InputByteStream bytestream = mappedBitstreamFile.isOpen() ? InputByteStream(mappedBitstreamFile.data(), mappedBitstreamFile.size()) : InputByteStream(bitstreamFile);
 
   if (!m_outputDecodedSEIMessagesFilename.empty() && m_outputDecodedSEIMessagesFilename!="-")
   {
@@ -165,7 +173,7 @@ uint32_t DecApp::decode()
   bool gdrRecoveryPeriod[MAX_NUM_LAYER_IDS] = { false };
   bool prevPicSkipped = true;
 
-  while (!!bitstreamFile)
+  while (bytestream.isGood())
   {
     InputNALUnit nalu;
     nalu.m_nalUnitType = NAL_UNIT_INVALID;
@@ -178,8 +186,8 @@ uint32_t DecApp::decode()
       AnnexBStats stats = AnnexBStats();
 
       // find next NAL unit in stream
-      byteStreamNALUnit(bytestream, nalu.getBitstream().getFifo(), stats);
-      if (nalu.getBitstream().getFifo().empty())
+      byteStreamNALUnit(bytestream, nalu, stats);
+      if (nalu.isPayloadEmpty())
       {
         /* this can happen if the following occur:
          *  - empty input file
@@ -318,9 +326,9 @@ uint32_t DecApp::decode()
       }
     }
 
-    if ((bNewPicture || !bitstreamFile || nalu.m_nalUnitType == NAL_UNIT_EOS) && !m_cDecLib.getFirstSliceInSequence(nalu.m_nuhLayerId) && !bPicSkipped)
+    if ((bNewPicture || !bytestream.isGood() || nalu.m_nalUnitType == NAL_UNIT_EOS) && !m_cDecLib.getFirstSliceInSequence(nalu.m_nuhLayerId) && !bPicSkipped)
     {
-      if (!loopFiltered[nalu.m_nuhLayerId] || bitstreamFile)
+      if (!loopFiltered[nalu.m_nuhLayerId] || bytestream.isGood())
       {
         m_cDecLib.executeLoopFilters();
         m_cDecLib.finishPicture(poc, pcListPic, INFO, m_newCLVS[nalu.m_nuhLayerId]);
@@ -343,7 +351,7 @@ uint32_t DecApp::decode()
         }
       }
     }
-    else if ( (bNewPicture || !bitstreamFile || nalu.m_nalUnitType == NAL_UNIT_EOS ) &&
+    else if ( (bNewPicture || !bytestream.isGood() || nalu.m_nalUnitType == NAL_UNIT_EOS ) &&
       m_cDecLib.getFirstSliceInSequence(nalu.m_nuhLayerId))
     {
       m_cDecLib.setFirstSliceInPicture (true);
@@ -396,6 +404,7 @@ uint32_t DecApp::decode()
         }
         if( ( m_cDecLib.getVPS() != nullptr && ( m_cDecLib.getVPS()->getMaxLayers() == 1 || xIsNaluWithinTargetOutputLayerIdSet( &nalu ) ) ) || m_cDecLib.getVPS() == nullptr )
         {
+          m_cVideoIOYuvReconFile[nalu.m_nuhLayerId].setAsyncFrames( m_asyncYuvFrames );
           m_cVideoIOYuvReconFile[nalu.m_nuhLayerId].open( reconFileName, true, m_outputBitDepth, m_outputBitDepth, bitDepths.recon ); // write mode
         }
       }
@@ -480,12 +489,12 @@ uint32_t DecApp::decode()
       isEosPresentInLastPu = isEosPresentInPu;
       isEosPresentInPu = false;
     }
-    if (bNewPicture || !bitstreamFile || nalu.m_nalUnitType == NAL_UNIT_EOS)
+    if (bNewPicture || !bytestream.isGood() || nalu.m_nalUnitType == NAL_UNIT_EOS)
     {
       m_cDecLib.checkAPSInPictureUnit();
       m_cDecLib.resetPictureUnitNals();
     }
-    if (bNewAccessUnit || !bitstreamFile)
+    if (bNewAccessUnit || !bytestream.isGood())
     {
       m_cDecLib.CheckNoOutputPriorPicFlagsInAccessUnit();
       m_cDecLib.resetAccessUnitNoOutputPriorPicFlags();
@@ -577,6 +586,7 @@ void DecApp::xCreateDecLib()
 #endif
   );
   m_cDecLib.setDecodedPictureHashSEIEnabled(m_decodedPictureHashSEIEnabled);
+  m_cDecLib.setParallelLoopFilter(m_parallelLoopFilter);
 
 
   if (!m_outputDecodedSEIMessagesFilename.empty())
@@ -691,6 +701,8 @@ void DecApp::xWriteOutput( PicList* pcListPic, uint32_t tId )
           (pcPicTop->getPOC() == m_iPOCLastDisplay+1 || m_iPOCLastDisplay < 0))
       {
         // write to file
+        pcPicTop->waitReconComplete();
+        pcPicBottom->waitReconComplete();
         numPicsNotYetDisplayed = numPicsNotYetDisplayed-2;
         if ( !m_reconFileName.empty() )
         {
@@ -742,6 +754,10 @@ void DecApp::xWriteOutput( PicList* pcListPic, uint32_t tId )
       if(pcPic->neededForOutput && pcPic->getPOC() >= m_iPOCLastDisplay &&
         (numPicsNotYetDisplayed >  maxNumReorderPicsHighestTid || dpbFullness > maxDecPicBufferingHighestTid))
       {
+        if (!pcPic->isReconComplete())
+        {
+          break;  // still being filtered, the following pictures are output after it
+        }
         // write to file
         numPicsNotYetDisplayed--;
         if (!pcPic->referenced)
@@ -814,6 +830,7 @@ void DecApp::xWriteOutput( PicList* pcListPic, uint32_t tId )
  */
 void DecApp::xFlushOutput( PicList* pcListPic, const int layerId )
 {
+  m_cDecLib.finishLoopFilter();
   if(!pcListPic || pcListPic->empty())
   {
     return;
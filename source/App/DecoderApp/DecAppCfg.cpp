@@ -75,7 +75,9 @@ bool DecAppCfg::parseCfg( int argc, char* argv[] )
 
   ("help",                      do_help,                               false,      "this help text")
   ("BitstreamFile,b",           m_bitstreamFileName,                   string(""), "bitstream input file name")
+  ("MapBitstreamFile",          m_mapBitstreamFile,                    true,       "memory-map the bitstream file instead of stream reading (not possible for pipes, which always use stream reading)")
   ("ReconFile,o",               m_reconFileName,                       string(""), "reconstructed YUV output file name\n")
+  ("AsyncYuvFrames",            m_asyncYuvFrames,                      2,          "number of frames the reconstructed YUV file is written behind by a background thread (0: synchronous file I/O)")
 
   ("OplFile,-opl",              m_oplFilename ,                        string(""), "opl-file name without extension for conformance testing\n")
 
@@ -90,6 +92,7 @@ bool DecAppCfg::parseCfg( int argc, char* argv[] )
   ("OutputColourSpaceConvert",  outputColourSpaceConvert,              string(""), "Colour space conversion to apply to input 444 video. Permitted values are (empty string=UNCHANGED) " + getListOfColourSpaceConverts(false))
   ("MaxTemporalLayer,t",        m_iMaxTemporalLayer,                   500,    "Maximum Temporal Layer to be decoded. -1 to decode all layers")
   ("TargetOutputLayerSet,p",    m_targetOlsIdx,                        500,    "Target output layer set index")
+  ("ParallelLoopFilter",        m_parallelLoopFilter,                  true,       "apply the in-loop filters of each picture on a worker thread while the next picture is decoded")
   ("SEIDecodedPictureHash,-dph",m_decodedPictureHashSEIEnabled,        1,          "Control handling of decoded picture hash SEI messages\n"
                                                                                    "\t1: check hash in SEI messages if available in the bitstream\n"
                                                                                    "\t0: ignore SEI message")
@@ -246,7 +249,9 @@ bool DecAppCfg::parseCfg( int argc, char* argv[] )
 
 DecAppCfg::DecAppCfg()
 : m_bitstreamFileName()
+, m_mapBitstreamFile(true)
 , m_reconFileName()
+, m_asyncYuvFrames(2)
 , m_oplFilename()
 
 , m_iSkipFrame(0)
@@ -256,6 +261,7 @@ DecAppCfg::DecAppCfg()
 , m_iMaxTemporalLayer(-1)
 , m_mTidExternalSet(false)
 , m_tOlsIdxTidExternalSet(false)
+, m_parallelLoopFilter(true)
 , m_decodedPictureHashSEIEnabled(0)
 , m_decodedNoDisplaySEIEnabled(false)
 , m_colourRemapSEIFileName()
@@ -57,7 +57,9 @@ class DecAppCfg
 {
 protected:
   std::string   m_bitstreamFileName;                    ///< input bitstream file name
+  bool          m_mapBitstreamFile;                     ///< memory-map the input bitstream file if possible
   std::string   m_reconFileName;                        ///< output reconstruction file name
+  int           m_asyncYuvFrames;                       ///< number of frames written behind by the YUV file I/O thread
 
   std::string   m_oplFilename;                        ///< filename to output conformance log.
 
@@ -69,6 +71,7 @@ protected:
   int           m_iMaxTemporalLayer;                  ///< maximum temporal layer to be decoded
   bool          m_mTidExternalSet;                    ///< maximum temporal layer set externally
   bool          m_tOlsIdxTidExternalSet;              ///< target output layer set index externally set
+  bool          m_parallelLoopFilter;                 ///< filter each picture on a worker thread while the next picture is decoded
   int           m_decodedPictureHashSEIEnabled;       ///< Checksum(3)/CRC(2)/MD5(1)/disable(0) acting on decoded picture hash SEI message
   bool          m_decodedNoDisplaySEIEnabled;         ///< Enable(true)/disable(false) writing only pictures that get displayed based on the no display SEI message
   std::string   m_colourRemapSEIFileName;             ///< output Colour Remapping file name
@@ -732,6 +732,7 @@ void EncApp::xInitLibCfg()
   m_cEncLib.setUseHashME                                         ( m_HashME );
 
   m_cEncLib.setUseVA(m_VA);
+  m_cEncLib.setUseVAFastSearch(m_vaFastSearch);
   if (m_VA) {
     m_cEncLib.setUseVAMVP(false);
     m_cEncLib.setVaOffset4x4(1);
@@ -1218,6 +1219,7 @@ void EncApp::xInitLibCfg()
     }
   }
   m_cEncLib.setGopBasedTemporalFilterEnabled(m_gopBasedTemporalFilterEnabled);
+  m_cEncLib.setUseMemoryBudget                                    ( m_memoryBudget );
   m_cEncLib.setNumRefLayers                                       ( m_numRefLayers );
 
   m_cEncLib.setVPSParameters(m_cfgVPSParameters);
@@ -1226,6 +1228,7 @@ void EncApp::xInitLibCfg()
 void EncApp::xCreateLib( std::list<PelUnitBuf*>& recBufList, const int layerId )
 {
   // Video I/O
+  m_cVideoIOYuvInputFile.setAsyncFrames( m_asyncYuvFrames );
   m_cVideoIOYuvInputFile.open( m_inputFileName,     false, m_inputBitDepth, m_MSBExtendedBitDepth, m_internalBitDepth );  // read  mode
 #if EXTENSION_360_VIDEO
   m_cVideoIOYuvInputFile.skipFrames(m_FrameSkip, m_inputFileWidth, m_inputFileHeight, m_InputChromaFormatIDC);
@@ -1259,6 +1262,7 @@ void EncApp::xCreateLib( std::list<PelUnitBuf*>& recBufList, const int layerId )
         reconFileName.append( std::to_string( layerId ) );
       }
     }
+    m_cVideoIOYuvReconFile.setAsyncFrames( m_asyncYuvFrames );
     m_cVideoIOYuvReconFile.open( reconFileName, true, m_outputBitDepth, m_outputBitDepth, m_internalBitDepth );  // write mode
   }
 
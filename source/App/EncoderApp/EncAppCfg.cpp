@@ -816,6 +816,7 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   ("FrameRate,-fr",                                   m_iFrameRate,                                         0, "Frame rate")
   ("FrameSkip,-fs",                                   m_FrameSkip,                                         0u, "Number of frames to skip at start of input YUV")
   ("TemporalSubsampleRatio,-ts",                      m_temporalSubsampleRatio,                            1u, "Temporal sub-sample ratio when reading input YUV")
+  ("AsyncYuvFrames",                                  m_asyncYuvFrames,                                     2, "Number of frames the input YUV file is read ahead and the reconstructed YUV file is written behind by background threads (0: synchronous file I/O)")
   ("FramesToBeEncoded,f",                             m_framesToBeEncoded,                                  0, "Number of frames to be encoded (default=all)")
   ("ClipInputVideoToRec709Range",                     m_bClipInputVideoToRec709Range,                   false, "If true then clip input video to the Rec. 709 Range on loading when InternalBitDepth is less than MSBExtendedBitDepth")
   ("ClipOutputVideoToRec709Range",                    m_bClipOutputVideoToRec709Range,                  false, "If true then clip output video to the Rec. 709 Range on saving when OutputBitDepth is less than InternalBitDepth")
@@ -1006,6 +1007,7 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   ("HashME",                                          m_HashME,                                         false, "Enable hash motion estimation (0:off, 1:on)")
 
   ("MPA",                                              m_VA,                                              true, "Enable motion plane adaptive tool (0:off, 1:on)")
+  ("MPAFastSearch",                                    m_vaFastSearch,                                    true, "Hierarchical subsampled integer motion search for MPA viewports (0:off, 1:on)")
 
   ("AllowDisFracMMVD",                                m_allowDisFracMMVD,                               false, "Disable fractional MVD in MMVD mode adaptively")
   ("AffineAmvr",                                      m_AffineAmvr,                                     false, "Eanble AMVR for affine inter mode")
@@ -1606,6 +1608,8 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
     ("TemporalFilterFutureReference",                 m_gopBasedTemporalFilterFutureReference,   true,            "Enable referencing of future frames in the GOP based temporal filter. This is typically disabled for Low Delay configurations.")
     ("TemporalFilterStrengthFrame*",                  m_gopBasedTemporalFilterStrengths, std::map<int, double>(), "Strength for every * frame in GOP based temporal filter, where * is an integer."
                                                                                                                   " E.g. --TemporalFilterStrengthFrame8 0.95 will enable GOP based temporal filter at every 8th frame with strength 0.95");
+  opts.addOptions()
+    ("MemoryBudget",                                  m_memoryBudget,                           false,            "Release the original buffers of coded pictures and keep reconstructions that are only needed for output without margins (0:off, 1:on)");
   // clang-format on
 
 #if EXTENSION_360_VIDEO
@@ -4581,6 +4585,7 @@ void EncAppCfg::xPrintParameter()
   msg(VERBOSE, "EncDbOpt:%d ", m_encDbOpt);
 
   msg( VERBOSE, "MPA:%d ", m_VA);
+  msg( VERBOSE, "MPAFastSearch:%d ", m_vaFastSearch);
 
   msg( VERBOSE, "\nFAST TOOL CFG: " );
   msg( VERBOSE, "LCTUFast:%d ", m_useFastLCTU );
@@ -4608,6 +4613,7 @@ void EncAppCfg::xPrintParameter()
     msg( VERBOSE, "RPR:%d ", 0 );
   }
   msg(VERBOSE, "TemporalFilter:%d ", m_gopBasedTemporalFilterEnabled);
+  msg(VERBOSE, "MemoryBudget:%d ", m_memoryBudget);
   msg(VERBOSE, "SEI CTI:%d ", m_ctiSEIEnabled);
 #if EXTENSION_360_VIDEO
   m_ext360.outputConfigurationSummary();
@@ -95,6 +95,7 @@ protected:
   int       m_iFrameRate;                                     ///< source frame-rates (Hz)
   uint32_t      m_FrameSkip;                                      ///< number of skipped frames from the beginning
   uint32_t      m_temporalSubsampleRatio;                         ///< temporal subsample ratio, 2 means code every two frames
+  int       m_asyncYuvFrames;                                 ///< number of frames read ahead / written behind by the YUV file I/O threads
   int       m_sourceWidth;                                   ///< source width in pixel
   int       m_sourceHeight;                                  ///< source height in pixel (when interlaced = field height)
 #if EXTENSION_360_VIDEO
@@ -363,6 +364,7 @@ protected:
 
   // Viewport-adaptive
   bool      m_VA;  ///< Use motion plane adaptive tool
+  bool      m_vaFastSearch;  ///< Use hierarchical integer motion search for MPA viewports
 
   bool      m_allowDisFracMMVD;
   bool      m_AffineAmvr;
@@ -828,6 +830,8 @@ protected:
   bool                  m_gopBasedTemporalFilterFutureReference;       ///< Enable/disable future frame references in the GOP-based Temporal Filter
   std::map<int, double> m_gopBasedTemporalFilterStrengths;             ///< Filter strength per frame for the GOP-based Temporal Filter
 
+  bool                  m_memoryBudget;                                ///< release buffers of coded pictures that are no longer needed
+
   int         m_maxLayers;
   int         m_targetOlsIdx;
   bool        m_OPIEnabled;                                     ///< enable Operating Point Information (OPI)
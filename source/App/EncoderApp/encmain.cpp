@@ -39,6 +39,15 @@
 #include <iostream>
 #include <chrono>
 #include <ctime>
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
 
 #include "EncoderLib/EncLibCommon.h"
 #include "EncApp.h"
@@ -52,6 +61,30 @@ static const uint32_t settingHelpWidth = 84;
 static const uint32_t settingValueWidth = 3;
 // --------------------------------------------------------------------------------------------------------------------- //
 
+/// peak resident set size of the process in MB
+static double getPeakResidentMemory()
+{
+#ifdef _WIN32
+  PROCESS_MEMORY_COUNTERS counters;
+  if( GetProcessMemoryInfo( GetCurrentProcess(), &counters, sizeof( counters ) ) )
+  {
+    return counters.PeakWorkingSetSize / ( 1024.0 * 1024.0 );
+  }
+  return 0.0;
+#else
+  struct rusage usage;
+  if( getrusage( RUSAGE_SELF, &usage ) != 0 )
+  {
+    return 0.0;
+  }
+#if defined( __APPLE__ )
+  return usage.ru_maxrss / ( 1024.0 * 1024.0 );
+#else
+  return usage.ru_maxrss / 1024.0;
+#endif
+#endif
+}
+
 //macro value printing function
 
 #define PRINT_CONSTANT(NAME, NAME_WIDTH, VALUE_WIDTH) std::cout << std::setw(NAME_WIDTH) << #NAME << " = " << std::setw(VALUE_WIDTH) << NAME << std::endl;
@@ -326,6 +359,7 @@ int main(int argc, char* argv[])
          (endClock - startClock) * 1.0 / CLOCKS_PER_SEC,
          encTime / 1000.0);
 #endif
+  printf(" Peak Memory: %12.1f MB [resident]\n", getPeakResidentMemory());
 
   return 0;
 }
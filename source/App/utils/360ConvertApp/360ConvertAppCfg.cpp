@@ -569,6 +569,7 @@ Bool TApp360ConvertCfg::parseCfg( Int argc, TChar* argv[] )
     ("FrameRate,-fr",                                   m_iFrameRate,                                         0, "Frame rate")
     ("FrameSkip,-fs",                                   m_FrameSkip,                                         0u, "Number of frames to skip at start of input YUV")
     ("TemporalSubsampleRatio,-ts",                      m_temporalSubsampleRatio,                            1u, "Temporal sub-sample ratio when reading input YUV")
+    ("AsyncYuvFrames",                                  m_asyncYuvFrames,                                     2, "Number of frames the YUV files are read ahead / written behind by background threads (0: synchronous file I/O)")
     ("FramesToBeEncoded,f",                             m_framesToBeConverted,                                0, "Number of frames to be converted (default=all)")
     ("ClipInputVideoToRec709Range",                     m_bClipInputVideoToRec709Range,                   false, "If true then clip input video to the Rec. 709 Range on loading when InternalBitDepth is less than MSBExtendedBitDepth")
     ("ClipOutputVideoToRec709Range",                    m_bClipOutputVideoToRec709Range,                  false, "If true then clip output video to the Rec. 709 Range on saving when OutputBitDepth is less than InternalBitDepth")
@@ -2998,6 +2999,9 @@ Void  TApp360ConvertCfg::convert()
 #if SVIDEO_DYNAMIC_VIEWPORT_PSNR
   FILE *fDynViewPort = nullptr;
   DynViewPortSettings dynViewPortSettings;
+#endif
+#if ENABLE_SIMD_OPT_BUFFER
+  g_pelBufOP.initPelBufOpsX86();
 #endif
   Bool bGeoConvertSkip = isGeoConvertSkipped();
   Bool bDirectFPConvert = isDirectFPConvert();
@@ -3006,17 +3010,20 @@ Void  TApp360ConvertCfg::convert()
   VideoIOYuv cTVideoIOYuvInputFile, cTVideoIOYuvOutputFile, cTVideoIOYuvRefFile;
 
   Double  dPSNRSum[METRIC_NUM][MAX_NUM_COMPONENT];
+  cTVideoIOYuvInputFile.setAsyncFrames( m_asyncYuvFrames );
   cTVideoIOYuvInputFile.open( m_pchInputFile,     false, m_inputBitDepth, m_MSBExtendedBitDepth, m_internalBitDepth );  // read  mode
   cTVideoIOYuvInputFile.skipFrames(m_FrameSkip, m_iInputWidth, m_iInputHeight, m_InputChromaFormatIDC);
 
   if(m_pchRefFile)
   {
+    cTVideoIOYuvRefFile.setAsyncFrames( m_asyncYuvFrames );
     cTVideoIOYuvRefFile.open( m_pchRefFile,     false, m_referenceBitDepth, m_referenceBitDepth, m_referenceBitDepth );  // read  mode
     cTVideoIOYuvRefFile.skipFrames(m_FrameSkip, m_iSourceWidth, m_iSourceHeight, m_OutputChromaFormatIDC);               
   }
 
   if (m_pchOutputFile)
   {
+    cTVideoIOYuvOutputFile.setAsyncFrames( m_asyncYuvFrames );
     cTVideoIOYuvOutputFile.open(m_pchOutputFile, true, m_outputBitDepth, m_outputBitDepth, m_outputBitDepth);  // write mode
   }  
   printChromaFormat();
@@ -146,6 +146,9 @@ Void TExt360AppEncTop::xCreate(EncGOP &encGop, PelStorage &yuvOrig)
     if(extCfg.m_viewPortPSNRParam.bViewPortPSNREnabled)
     {
       m_ext360EncGop.initViewPortPSNR(encGop, (Int)extCfg.m_viewPortPSNRParam.viewPortSettingsList.size());
+#if SVIDEO_VIEWPORT_CACHE
+      m_ext360EncGop.getViewPortPSNRMetric()->setViewPortCache(m_ext360EncGop.getViewPortCache());
+#endif
 #if SVIDEO_E2E_METRICS
       m_ext360EncGop.getViewPortPSNRMetric()->init(extCfg.m_sourceSVideoInfo, extCfg.m_codingSVideoInfo, &extCfg.m_inputGeoParam, extCfg.m_viewPortPSNRParam);
 #else
@@ -163,6 +166,9 @@ Void TExt360AppEncTop::xCreate(EncGOP &encGop, PelStorage &yuvOrig)
     if(extCfg.m_dynamicViewPortPSNRParam.bViewPortPSNREnabled)
     {
       m_ext360EncGop.initDynamicViewPortPSNR(encGop, (Int)extCfg.m_dynamicViewPortPSNRParam.viewPortSettingsList.size());
+#if SVIDEO_VIEWPORT_CACHE
+      m_ext360EncGop.getDynamicViewPortPSNRMetric()->setViewPortCache(m_ext360EncGop.getViewPortCache());
+#endif
       m_ext360EncGop.getDynamicViewPortPSNRMetric()->initDynamicViewPort(extCfg.m_sourceSVideoInfo, extCfg.m_codingSVideoInfo, &extCfg.m_inputGeoParam, extCfg.m_dynamicViewPortPSNRParam, cfg.m_FrameSkip, cfg.m_temporalSubsampleRatio);
     }
 #endif
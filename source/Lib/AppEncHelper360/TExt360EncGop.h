@@ -105,6 +105,9 @@ private:
 #if SVIDEO_CPPPSNR
   TCPPPSNRMetric          m_cCPPPSNRMetric;
 #endif
+#if SVIDEO_VIEWPORT_CACHE
+  TViewPortCache          m_cViewPortCache;   //shared by the static and the dynamic viewport PSNR;
+#endif
 #if SVIDEO_VIEWPORT_PSNR
   TViewPortPSNR           m_cViewPortPSNR;
 #endif
@@ -152,6 +155,9 @@ public:
   TViewPortPSNR* getViewPortPSNRMetric() { return &m_cViewPortPSNR;}
   static Void initViewPortPSNR(EncGOP &encGop, Int iNumVPs);
 #endif
+#if SVIDEO_VIEWPORT_CACHE
+  TViewPortCache* getViewPortCache() { return &m_cViewPortCache; }
+#endif
 #if SVIDEO_CF_SPSNR_NN
   TSPSNRMetric* getCFSPSNRMetric()  {return &m_cCFSPSNRMetric;}
 #endif
@@ -61,6 +61,8 @@ AdaptiveLoopFilter::AdaptiveLoopFilter()
     m_ctuEnableFlag[compIdx] = nullptr;
     m_ctuAlternative[compIdx] = nullptr;
   }
+  m_alfCtuFilterIndex = nullptr;
+  m_lastSliceIdx = 0xFFFFFFFF;
 
   m_deriveClassificationBlk = deriveClassificationBlk;
   m_filterCcAlf = filterBlkCcAlf<CC_ALF>;
@@ -401,7 +403,17 @@ void AdaptiveLoopFilter::applyCcAlfFilter(CodingStructure &cs, ComponentID compI
 
 void AdaptiveLoopFilter::ALFProcess(CodingStructure& cs)
 {
+  ALFPrepare( cs );
+  ALFCopyLines( cs, 0, cs.pcv->lumaHeight );
 
+  for( int ctuRow = 0; ctuRow < cs.pcv->heightInCtus; ctuRow++ )
+  {
+    ALFProcessCtuRow( cs, ctuRow );
+  }
+}
+
+void AdaptiveLoopFilter::ALFPrepare(CodingStructure& cs)
+{
   // set clipping range
   m_clpRngs = cs.slice->getClpRngs();
 
@@ -411,211 +423,248 @@ void AdaptiveLoopFilter::ALFProcess(CodingStructure& cs)
     m_ctuEnableFlag[compIdx] = cs.picture->getAlfCtuEnableFlag( compIdx );
     m_ctuAlternative[compIdx] = cs.picture->getAlfCtuAlternativeData( compIdx );
   }
-  short* alfCtuFilterIndex = nullptr;
-  uint32_t lastSliceIdx = 0xFFFFFFFF;
+  m_alfCtuFilterIndex = nullptr;
+  m_lastSliceIdx = 0xFFFFFFFF;
+}
+
+void AdaptiveLoopFilter::ALFCopyLines(CodingStructure& cs, const int lumaStart, const int lumaEnd)
+{
+  if( lumaEnd <= lumaStart )
+  {
+    return;
+  }
+  const int margin = MAX_ALF_FILTER_LENGTH >> 1;
+  const UnitArea lines( cs.area.chromaFormat, Area( 0, lumaStart, cs.pcv->lumaWidth, lumaEnd - lumaStart ) );
+  PelUnitBuf tmpLines = m_tempBuf.subBuf( lines );
+  tmpLines.copyFrom( cs.getRecoBuf( lines ) );
 
+  // the top and bottom margins are replicated from the extended first and last line
+  PelUnitBuf tmpYuv = m_tempBuf.getBuf( cs.area );
+  for( uint32_t compIdx = 0; compIdx < getNumberValidComponents( cs.area.chromaFormat ); compIdx++ )
+  {
+    tmpLines.get( ComponentID( compIdx ) ).extendBorderPel( margin, 0 );
+
+    PelBuf    buf      = tmpYuv.get( ComponentID( compIdx ) );
+    const int lineSize = sizeof( Pel ) * ( buf.width + ( margin << 1 ) );
+    if( lumaStart == 0 )
+    {
+      Pel* top = buf.bufAt( 0, 0 ) - margin;
+      for( int y = 0; y < margin; y++ )
+      {
+        ::memcpy( top - ( y + 1 ) * buf.stride, top, lineSize );
+      }
+    }
+    if( lumaEnd == cs.pcv->lumaHeight )
+    {
+      Pel* bottom = buf.bufAt( 0, buf.height - 1 ) - margin;
+      for( int y = 0; y < margin; y++ )
+      {
+        ::memcpy( bottom + ( y + 1 ) * buf.stride, bottom, lineSize );
+      }
+    }
+  }
+}
+
+void AdaptiveLoopFilter::ALFProcessCtuRow(CodingStructure& cs, const int ctuRow)
+{
   PelUnitBuf recYuv = cs.getRecoBuf();
-  m_tempBuf.copyFrom( recYuv );
   PelUnitBuf tmpYuv = m_tempBuf.getBuf( cs.area );
-  tmpYuv.extendBorderPel( MAX_ALF_FILTER_LENGTH >> 1 );
 
   const PreCalcValues& pcv = *cs.pcv;
 
-  int ctuIdx = 0;
+  int ctuIdx = ctuRow * pcv.widthInCtus;
   bool clipTop = false, clipBottom = false, clipLeft = false, clipRight = false;
   int numHorVirBndry = 0, numVerVirBndry = 0;
   int horVirBndryPos[] = { 0, 0, 0 };
   int verVirBndryPos[] = { 0, 0, 0 };
 
-  for( int yPos = 0; yPos < pcv.lumaHeight; yPos += pcv.maxCUHeight )
+  const int yPos = ctuRow * pcv.maxCUHeight;
+  for( int xPos = 0; xPos < pcv.lumaWidth; xPos += pcv.maxCUWidth )
   {
-    for( int xPos = 0; xPos < pcv.lumaWidth; xPos += pcv.maxCUWidth )
-    {
-      // get first CU in CTU
-      const CodingUnit *cu = cs.getCU( Position(xPos, yPos), CHANNEL_TYPE_LUMA );
+    // get first CU in CTU
+    const CodingUnit *cu = cs.getCU( Position(xPos, yPos), CHANNEL_TYPE_LUMA );
 
-      // skip this CTU if ALF is disabled
-      if (!cu->slice->getAlfEnabledFlag(COMPONENT_Y) && !cu->slice->getAlfEnabledFlag(COMPONENT_Cb) && !cu->slice->getAlfEnabledFlag(COMPONENT_Cr))
-      {
-        ctuIdx++;
-        continue;
-      }
+    // skip this CTU if ALF is disabled
+    if (!cu->slice->getAlfEnabledFlag(COMPONENT_Y) && !cu->slice->getAlfEnabledFlag(COMPONENT_Cb) && !cu->slice->getAlfEnabledFlag(COMPONENT_Cr))
+    {
+      ctuIdx++;
+      continue;
+    }
 
-      // reload ALF APS each time the slice changes during raster scan filtering
-      if(ctuIdx == 0 || lastSliceIdx != cu->slice->getSliceID() || alfCtuFilterIndex==nullptr)
-      {
-        cs.slice = cu->slice;
-        reconstructCoeffAPSs(cs, true, cu->slice->getAlfEnabledFlag(COMPONENT_Cb) || cu->slice->getAlfEnabledFlag(COMPONENT_Cr), false);
-        alfCtuFilterIndex = cu->slice->getPic()->getAlfCtbFilterIndex();
-        m_ccAlfFilterParam = cu->slice->m_ccAlfFilterParam;
-      }
-      lastSliceIdx = cu->slice->getSliceID();
+    // reload ALF APS each time the slice changes during raster scan filtering
+    if(ctuIdx == 0 || m_lastSliceIdx != cu->slice->getSliceID() || m_alfCtuFilterIndex==nullptr)
+    {
+      cs.slice = cu->slice;
+      reconstructCoeffAPSs(cs, true, cu->slice->getAlfEnabledFlag(COMPONENT_Cb) || cu->slice->getAlfEnabledFlag(COMPONENT_Cr), false);
+      m_alfCtuFilterIndex = cu->slice->getPic()->getAlfCtbFilterIndex();
+      m_ccAlfFilterParam = cu->slice->m_ccAlfFilterParam;
+    }
+    m_lastSliceIdx = cu->slice->getSliceID();
 
-      const int width = ( xPos + pcv.maxCUWidth > pcv.lumaWidth ) ? ( pcv.lumaWidth - xPos ) : pcv.maxCUWidth;
-      const int height = ( yPos + pcv.maxCUHeight > pcv.lumaHeight ) ? ( pcv.lumaHeight - yPos ) : pcv.maxCUHeight;
-      bool ctuEnableFlag = m_ctuEnableFlag[COMPONENT_Y][ctuIdx];
-      for( int compIdx = 1; compIdx < MAX_NUM_COMPONENT; compIdx++ )
+    const int width = ( xPos + pcv.maxCUWidth > pcv.lumaWidth ) ? ( pcv.lumaWidth - xPos ) : pcv.maxCUWidth;
+    const int height = ( yPos + pcv.maxCUHeight > pcv.lumaHeight ) ? ( pcv.lumaHeight - yPos ) : pcv.maxCUHeight;
+    bool ctuEnableFlag = m_ctuEnableFlag[COMPONENT_Y][ctuIdx];
+    for( int compIdx = 1; compIdx < MAX_NUM_COMPONENT; compIdx++ )
+    {
+      ctuEnableFlag |= m_ctuEnableFlag[compIdx][ctuIdx] > 0;
+      if (cu->slice->m_ccAlfFilterParam.ccAlfFilterEnabled[compIdx - 1])
       {
-        ctuEnableFlag |= m_ctuEnableFlag[compIdx][ctuIdx] > 0;
-        if (cu->slice->m_ccAlfFilterParam.ccAlfFilterEnabled[compIdx - 1])
-        {
-          ctuEnableFlag |= m_ccAlfFilterControl[compIdx - 1][ctuIdx] > 0;
-        }
+        ctuEnableFlag |= m_ccAlfFilterControl[compIdx - 1][ctuIdx] > 0;
       }
-      int rasterSliceAlfPad = 0;
-      if( ctuEnableFlag && isCrossedByVirtualBoundaries( cs, xPos, yPos, width, height, clipTop, clipBottom, clipLeft, clipRight, numHorVirBndry, numVerVirBndry, horVirBndryPos, verVirBndryPos, rasterSliceAlfPad ) )
+    }
+    int rasterSliceAlfPad = 0;
+    if( ctuEnableFlag && isCrossedByVirtualBoundaries( cs, xPos, yPos, width, height, clipTop, clipBottom, clipLeft, clipRight, numHorVirBndry, numVerVirBndry, horVirBndryPos, verVirBndryPos, rasterSliceAlfPad ) )
+    {
+      int yStart = yPos;
+      for( int i = 0; i <= numHorVirBndry; i++ )
       {
-        int yStart = yPos;
-        for( int i = 0; i <= numHorVirBndry; i++ )
+        const int yEnd = i == numHorVirBndry ? yPos + height : horVirBndryPos[i];
+        const int h = yEnd - yStart;
+        const bool clipT = ( i == 0 && clipTop ) || ( i > 0 ) || ( yStart == 0 );
+        const bool clipB = ( i == numHorVirBndry && clipBottom ) || ( i < numHorVirBndry ) || ( yEnd == pcv.lumaHeight );
+        int xStart = xPos;
+        for( int j = 0; j <= numVerVirBndry; j++ )
         {
-          const int yEnd = i == numHorVirBndry ? yPos + height : horVirBndryPos[i];
-          const int h = yEnd - yStart;
-          const bool clipT = ( i == 0 && clipTop ) || ( i > 0 ) || ( yStart == 0 );
-          const bool clipB = ( i == numHorVirBndry && clipBottom ) || ( i < numHorVirBndry ) || ( yEnd == pcv.lumaHeight );
-          int xStart = xPos;
-          for( int j = 0; j <= numVerVirBndry; j++ )
+          const int xEnd = j == numVerVirBndry ? xPos + width : verVirBndryPos[j];
+          const int w = xEnd - xStart;
+          const bool clipL = ( j == 0 && clipLeft ) || ( j > 0 ) || ( xStart == 0 );
+          const bool clipR = ( j == numVerVirBndry && clipRight ) || ( j < numVerVirBndry ) || ( xEnd == pcv.lumaWidth );
+          const int wBuf = w + (clipL ? 0 : MAX_ALF_PADDING_SIZE) + (clipR ? 0 : MAX_ALF_PADDING_SIZE);
+          const int hBuf = h + (clipT ? 0 : MAX_ALF_PADDING_SIZE) + (clipB ? 0 : MAX_ALF_PADDING_SIZE);
+          PelUnitBuf buf = m_tempBuf2.subBuf( UnitArea( cs.area.chromaFormat, Area( 0, 0, wBuf, hBuf ) ) );
+          buf.copyFrom( tmpYuv.subBuf( UnitArea( cs.area.chromaFormat, Area( xStart - (clipL ? 0 : MAX_ALF_PADDING_SIZE), yStart - (clipT ? 0 : MAX_ALF_PADDING_SIZE), wBuf, hBuf ) ) ) );
+          // pad top-left unavailable samples for raster slice
+          if ( xStart == xPos && yStart == yPos && ( rasterSliceAlfPad & 1 ) )
           {
-            const int xEnd = j == numVerVirBndry ? xPos + width : verVirBndryPos[j];
-            const int w = xEnd - xStart;
-            const bool clipL = ( j == 0 && clipLeft ) || ( j > 0 ) || ( xStart == 0 );
-            const bool clipR = ( j == numVerVirBndry && clipRight ) || ( j < numVerVirBndry ) || ( xEnd == pcv.lumaWidth );
-            const int wBuf = w + (clipL ? 0 : MAX_ALF_PADDING_SIZE) + (clipR ? 0 : MAX_ALF_PADDING_SIZE);
-            const int hBuf = h + (clipT ? 0 : MAX_ALF_PADDING_SIZE) + (clipB ? 0 : MAX_ALF_PADDING_SIZE);
-            PelUnitBuf buf = m_tempBuf2.subBuf( UnitArea( cs.area.chromaFormat, Area( 0, 0, wBuf, hBuf ) ) );
-            buf.copyFrom( tmpYuv.subBuf( UnitArea( cs.area.chromaFormat, Area( xStart - (clipL ? 0 : MAX_ALF_PADDING_SIZE), yStart - (clipT ? 0 : MAX_ALF_PADDING_SIZE), wBuf, hBuf ) ) ) );
-            // pad top-left unavailable samples for raster slice
-            if ( xStart == xPos && yStart == yPos && ( rasterSliceAlfPad & 1 ) )
+            buf.padBorderPel( MAX_ALF_PADDING_SIZE, 1 );
+          }
+
+          // pad bottom-right unavailable samples for raster slice
+          if ( xEnd == xPos + width && yEnd == yPos + height && ( rasterSliceAlfPad & 2 ) )
+          {
+            buf.padBorderPel( MAX_ALF_PADDING_SIZE, 2 );
+          }
+          buf.extendBorderPel( MAX_ALF_PADDING_SIZE );
+          buf = buf.subBuf( UnitArea ( cs.area.chromaFormat, Area( clipL ? 0 : MAX_ALF_PADDING_SIZE, clipT ? 0 : MAX_ALF_PADDING_SIZE, w, h ) ) );
+
+          if( m_ctuEnableFlag[COMPONENT_Y][ctuIdx] )
+          {
+            const Area blkSrc( 0, 0, w, h );
+            const Area blkDst( xStart, yStart, w, h );
+            deriveClassification( m_classifier, buf.get(COMPONENT_Y), blkDst, blkSrc );
+            short filterSetIndex = m_alfCtuFilterIndex[ctuIdx];
+            short *coeff;
+            Pel *clip;
+            if (filterSetIndex >= NUM_FIXED_FILTER_SETS)
             {
-              buf.padBorderPel( MAX_ALF_PADDING_SIZE, 1 );
+              coeff = m_coeffApsLuma[filterSetIndex - NUM_FIXED_FILTER_SETS];
+              clip = m_clippApsLuma[filterSetIndex - NUM_FIXED_FILTER_SETS];
             }
-
-            // pad bottom-right unavailable samples for raster slice
-            if ( xEnd == xPos + width && yEnd == yPos + height && ( rasterSliceAlfPad & 2 ) )
+            else
             {
-              buf.padBorderPel( MAX_ALF_PADDING_SIZE, 2 );
+              coeff = m_fixedFilterSetCoeffDec[filterSetIndex];
+              clip = m_clipDefault;
             }
-            buf.extendBorderPel( MAX_ALF_PADDING_SIZE );
-            buf = buf.subBuf( UnitArea ( cs.area.chromaFormat, Area( clipL ? 0 : MAX_ALF_PADDING_SIZE, clipT ? 0 : MAX_ALF_PADDING_SIZE, w, h ) ) );
+            m_filter7x7Blk(m_classifier, recYuv, buf, blkDst, blkSrc, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs
+              , m_alfVBLumaCTUHeight
+              , m_alfVBLumaPos
+            );
+          }
 
-            if( m_ctuEnableFlag[COMPONENT_Y][ctuIdx] )
+          for( int compIdx = 1; compIdx < MAX_NUM_COMPONENT; compIdx++ )
+          {
+            ComponentID compID = ComponentID( compIdx );
+            const int chromaScaleX = getComponentScaleX( compID, tmpYuv.chromaFormat );
+            const int chromaScaleY = getComponentScaleY( compID, tmpYuv.chromaFormat );
+
+            if( m_ctuEnableFlag[compIdx][ctuIdx] )
             {
-              const Area blkSrc( 0, 0, w, h );
-              const Area blkDst( xStart, yStart, w, h );
-              deriveClassification( m_classifier, buf.get(COMPONENT_Y), blkDst, blkSrc );
-              short filterSetIndex = alfCtuFilterIndex[ctuIdx];
-              short *coeff;
-              Pel *clip;
-              if (filterSetIndex >= NUM_FIXED_FILTER_SETS)
-              {
-                coeff = m_coeffApsLuma[filterSetIndex - NUM_FIXED_FILTER_SETS];
-                clip = m_clippApsLuma[filterSetIndex - NUM_FIXED_FILTER_SETS];
-              }
-              else
-              {
-                coeff = m_fixedFilterSetCoeffDec[filterSetIndex];
-                clip = m_clipDefault;
-              }
-              m_filter7x7Blk(m_classifier, recYuv, buf, blkDst, blkSrc, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y], cs
-                , m_alfVBLumaCTUHeight
-                , m_alfVBLumaPos
-              );
+              const Area blkSrc( 0, 0, w >> chromaScaleX, h >> chromaScaleY );
+              const Area blkDst( xStart >> chromaScaleX, yStart >> chromaScaleY, w >> chromaScaleX, h >> chromaScaleY );
+              uint8_t alt_num = m_ctuAlternative[compIdx][ctuIdx];
+              m_filter5x5Blk(m_classifier, recYuv, buf, blkDst, blkSrc, compID, m_chromaCoeffFinal[alt_num], m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs
+                , m_alfVBChmaCTUHeight
+                 , m_alfVBChmaPos );
             }
-
-            for( int compIdx = 1; compIdx < MAX_NUM_COMPONENT; compIdx++ )
+            if (cu->slice->m_ccAlfFilterParam.ccAlfFilterEnabled[compIdx - 1])
             {
-              ComponentID compID = ComponentID( compIdx );
-              const int chromaScaleX = getComponentScaleX( compID, tmpYuv.chromaFormat );
-              const int chromaScaleY = getComponentScaleY( compID, tmpYuv.chromaFormat );
+              const int filterIdx = m_ccAlfFilterControl[compIdx - 1][ctuIdx];
 
-              if( m_ctuEnableFlag[compIdx][ctuIdx] )
-              {
-                const Area blkSrc( 0, 0, w >> chromaScaleX, h >> chromaScaleY );
-                const Area blkDst( xStart >> chromaScaleX, yStart >> chromaScaleY, w >> chromaScaleX, h >> chromaScaleY );
-                uint8_t alt_num = m_ctuAlternative[compIdx][ctuIdx];
-                m_filter5x5Blk(m_classifier, recYuv, buf, blkDst, blkSrc, compID, m_chromaCoeffFinal[alt_num], m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs
-                  , m_alfVBChmaCTUHeight
-                   , m_alfVBChmaPos );
-              }
-              if (cu->slice->m_ccAlfFilterParam.ccAlfFilterEnabled[compIdx - 1])
+              if (filterIdx != 0)
               {
-                const int filterIdx = m_ccAlfFilterControl[compIdx - 1][ctuIdx];
+                const Area blkSrc(0, 0, w, h);
+                Area blkDst(xStart >> chromaScaleX, yStart >> chromaScaleY, w >> chromaScaleX, h >> chromaScaleY);
 
-                if (filterIdx != 0)
-                {
-                  const Area blkSrc(0, 0, w, h);
-                  Area blkDst(xStart >> chromaScaleX, yStart >> chromaScaleY, w >> chromaScaleX, h >> chromaScaleY);
+                const int16_t *filterCoeff = m_ccAlfFilterParam.ccAlfCoeff[compIdx - 1][filterIdx - 1];
 
-                  const int16_t *filterCoeff = m_ccAlfFilterParam.ccAlfCoeff[compIdx - 1][filterIdx - 1];
-
-                  m_filterCcAlf(recYuv.get(compID), buf, blkDst, blkSrc, compID, filterCoeff, m_clpRngs, cs,
-                                m_alfVBLumaCTUHeight, m_alfVBLumaPos);
-                }
+                m_filterCcAlf(recYuv.get(compID), buf, blkDst, blkSrc, compID, filterCoeff, m_clpRngs, cs,
+                              m_alfVBLumaCTUHeight, m_alfVBLumaPos);
               }
             }
-
-            xStart = xEnd;
           }
 
-          yStart = yEnd;
+          xStart = xEnd;
         }
+
+        yStart = yEnd;
       }
-      else
+    }
+    else
+    {
+      const UnitArea area( cs.area.chromaFormat, Area( xPos, yPos, width, height ) );
+      if( m_ctuEnableFlag[COMPONENT_Y][ctuIdx] )
       {
-        const UnitArea area( cs.area.chromaFormat, Area( xPos, yPos, width, height ) );
-        if( m_ctuEnableFlag[COMPONENT_Y][ctuIdx] )
+        Area blk( xPos, yPos, width, height );
+        deriveClassification( m_classifier, tmpYuv.get( COMPONENT_Y ), blk, blk );
+        short filterSetIndex = m_alfCtuFilterIndex[ctuIdx];
+        short *coeff;
+        Pel *clip;
+        if (filterSetIndex >= NUM_FIXED_FILTER_SETS)
         {
-          Area blk( xPos, yPos, width, height );
-          deriveClassification( m_classifier, tmpYuv.get( COMPONENT_Y ), blk, blk );
-          short filterSetIndex = alfCtuFilterIndex[ctuIdx];
-          short *coeff;
-          Pel *clip;
-          if (filterSetIndex >= NUM_FIXED_FILTER_SETS)
-          {
-            coeff = m_coeffApsLuma[filterSetIndex - NUM_FIXED_FILTER_SETS];
-            clip = m_clippApsLuma[filterSetIndex - NUM_FIXED_FILTER_SETS];
-          }
-          else
-          {
-            coeff = m_fixedFilterSetCoeffDec[filterSetIndex];
-            clip = m_clipDefault;
-          }
-          m_filter7x7Blk(m_classifier, recYuv, tmpYuv, blk, blk, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y],
-                         cs, m_alfVBLumaCTUHeight, m_alfVBLumaPos);
+          coeff = m_coeffApsLuma[filterSetIndex - NUM_FIXED_FILTER_SETS];
+          clip = m_clippApsLuma[filterSetIndex - NUM_FIXED_FILTER_SETS];
         }
+        else
+        {
+          coeff = m_fixedFilterSetCoeffDec[filterSetIndex];
+          clip = m_clipDefault;
+        }
+        m_filter7x7Blk(m_classifier, recYuv, tmpYuv, blk, blk, COMPONENT_Y, coeff, clip, m_clpRngs.comp[COMPONENT_Y],
+                       cs, m_alfVBLumaCTUHeight, m_alfVBLumaPos);
+      }
+
+      for( int compIdx = 1; compIdx < MAX_NUM_COMPONENT; compIdx++ )
+      {
+        ComponentID compID = ComponentID( compIdx );
+        const int chromaScaleX = getComponentScaleX( compID, tmpYuv.chromaFormat );
+        const int chromaScaleY = getComponentScaleY( compID, tmpYuv.chromaFormat );
 
-        for( int compIdx = 1; compIdx < MAX_NUM_COMPONENT; compIdx++ )
+        if (m_ctuEnableFlag[compIdx][ctuIdx])
+        {
+          Area    blk(xPos >> chromaScaleX, yPos >> chromaScaleY, width >> chromaScaleX, height >> chromaScaleY);
+          uint8_t alt_num = m_ctuAlternative[compIdx][ctuIdx];
+          m_filter5x5Blk(m_classifier, recYuv, tmpYuv, blk, blk, compID, m_chromaCoeffFinal[alt_num],
+                         m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs, m_alfVBChmaCTUHeight,
+                         m_alfVBChmaPos);
+        }
+        if (cu->slice->m_ccAlfFilterParam.ccAlfFilterEnabled[compIdx - 1])
         {
-          ComponentID compID = ComponentID( compIdx );
-          const int chromaScaleX = getComponentScaleX( compID, tmpYuv.chromaFormat );
-          const int chromaScaleY = getComponentScaleY( compID, tmpYuv.chromaFormat );
+          const int filterIdx = m_ccAlfFilterControl[compIdx - 1][ctuIdx];
 
-          if (m_ctuEnableFlag[compIdx][ctuIdx])
+          if (filterIdx != 0)
           {
-            Area    blk(xPos >> chromaScaleX, yPos >> chromaScaleY, width >> chromaScaleX, height >> chromaScaleY);
-            uint8_t alt_num = m_ctuAlternative[compIdx][ctuIdx];
-            m_filter5x5Blk(m_classifier, recYuv, tmpYuv, blk, blk, compID, m_chromaCoeffFinal[alt_num],
-                           m_chromaClippFinal[alt_num], m_clpRngs.comp[compIdx], cs, m_alfVBChmaCTUHeight,
-                           m_alfVBChmaPos);
-          }
-          if (cu->slice->m_ccAlfFilterParam.ccAlfFilterEnabled[compIdx - 1])
-          {
-            const int filterIdx = m_ccAlfFilterControl[compIdx - 1][ctuIdx];
-
-            if (filterIdx != 0)
-            {
-              Area blkDst(xPos >> chromaScaleX, yPos >> chromaScaleY, width >> chromaScaleX, height >> chromaScaleY);
-              Area blkSrc(xPos, yPos, width, height);
+            Area blkDst(xPos >> chromaScaleX, yPos >> chromaScaleY, width >> chromaScaleX, height >> chromaScaleY);
+            Area blkSrc(xPos, yPos, width, height);
 
-              const int16_t *filterCoeff = m_ccAlfFilterParam.ccAlfCoeff[compIdx - 1][filterIdx - 1];
+            const int16_t *filterCoeff = m_ccAlfFilterParam.ccAlfCoeff[compIdx - 1][filterIdx - 1];
 
-              m_filterCcAlf(recYuv.get(compID), tmpYuv, blkDst, blkSrc, compID, filterCoeff, m_clpRngs, cs,
-                            m_alfVBLumaCTUHeight, m_alfVBLumaPos);
-            }
+            m_filterCcAlf(recYuv.get(compID), tmpYuv, blkDst, blkSrc, compID, filterCoeff, m_clpRngs, cs,
+                          m_alfVBLumaCTUHeight, m_alfVBLumaPos);
           }
         }
       }
-      ctuIdx++;
     }
+    ctuIdx++;
   }
 }
 
@@ -85,6 +85,11 @@ public:
   void reconstructCoeffAPSs(CodingStructure& cs, bool luma, bool chroma, bool isRdo);
   void reconstructCoeff(AlfParam& alfParam, ChannelType channel, const bool isRdo, const bool isRedo = false);
   void ALFProcess(CodingStructure& cs);
+  // CTU row interface of ALFProcess(): the lines of a CTU row are copied (and border extended) before the CTU row
+  // above them is filtered
+  void ALFPrepare(CodingStructure& cs);
+  void ALFCopyLines(CodingStructure& cs, const int lumaStart, const int lumaEnd);
+  void ALFProcessCtuRow(CodingStructure& cs, const int ctuRow);
   void create( const int picWidth, const int picHeight, const ChromaFormat format, const int maxCUWidth, const int maxCUHeight, const int maxCUDepth, const int inputBitDepth[MAX_NUM_CHANNEL_TYPE] );
   void destroy();
   static void deriveClassificationBlk(AlfClassifier **classifier, int **laplacian[NUM_DIRECTIONS],
@@ -114,6 +119,7 @@ public:
                         const int   selectedFilterIdx);
   CcAlfFilterParam &getCcAlfFilterParam() { return m_ccAlfFilterParam; }
   uint8_t* getCcAlfControlIdc(const ComponentID compID)   { return m_ccAlfFilterControl[compID-1]; }
+  void     setCcAlfControlIdc(const ComponentID compID, const uint8_t* filterControl) { std::copy(filterControl, filterControl + m_numCTUsInPic, m_ccAlfFilterControl[compID-1]); }
   void (*m_filter5x5Blk)(AlfClassifier **classifier, const PelUnitBuf &recDst, const CPelUnitBuf &recSrc,
                          const Area &blkDst, const Area &blk, const ComponentID compId, const short *filterSet,
                          const Pel *fClipSet, const ClpRng &clpRng, CodingStructure &cs, const int vbCTUHeight,
@@ -172,6 +178,8 @@ protected:
   int                          m_alfVBChmaCTUHeight;
   ChromaFormat                 m_chromaFormat;
   ClpRngs                      m_clpRngs;
+  short*                       m_alfCtuFilterIndex;
+  uint32_t                     m_lastSliceIdx;
 };
 
 #endif
@@ -349,6 +349,12 @@ PelBufferOps::PelBufferOps()
   profGradFilter = gradFilterCore <false>;
   applyPROF      = applyPROFCore;
   roundIntVector = nullptr;
+  wghtSse        = wghtSseCore;
+
+  unpackSamples    = unpackSamplesCore;
+  packSamples      = packSamplesCore;
+  scaleSamples     = scaleSamplesCore;
+  checkSampleRange = checkSampleRangeCore;
 }
 
 PelBufferOps g_pelBufOP = PelBufferOps();
@@ -362,6 +368,106 @@ void copyBufferCore(Pel *src, int srcStride, Pel *dst, int dstStride, int width,
   }
 }
 
+double wghtSseCore(const Pel* org, int orgStride, const Pel* rec, int recStride, const double* wght, int wghtStride, int width, int height, int orgShift, int recShift)
+{
+  double sse = 0;
+  for (int y = 0; y < height; y++)
+  {
+    for (int x = 0; x < width; x++)
+    {
+      const Intermediate_Int diff = (Intermediate_Int)((org[x] << orgShift) - (rec[x] << recShift));
+      sse += diff * diff * wght[x];
+    }
+    org  += orgStride;
+    rec  += recStride;
+    wght += wghtStride;
+  }
+  return sse;
+}
+
+// file sample rows: 8-bit or 16-bit little-endian words
+void unpackSamplesCore(const uint8_t* src, Pel* dst, int width, bool is16bit)
+{
+  if (is16bit)
+  {
+    for (int x = 0; x < width; x++)
+    {
+      dst[x] = Pel(src[2 * x]) | (Pel(src[2 * x + 1]) << 8);
+    }
+  }
+  else
+  {
+    for (int x = 0; x < width; x++)
+    {
+      dst[x] = src[x];
+    }
+  }
+}
+
+void packSamplesCore(const Pel* src, uint8_t* dst, int width, bool is16bit)
+{
+  if (is16bit)
+  {
+    for (int x = 0; x < width; x++)
+    {
+      dst[2 * x]     = (src[x] >> 0) & 0xff;
+      dst[2 * x + 1] = (src[x] >> 8) & 0xff;
+    }
+  }
+  else
+  {
+    for (int x = 0; x < width; x++)
+    {
+      dst[x] = (uint8_t) src[x];
+    }
+  }
+}
+
+// shift > 0: multiply by 2^shift, shift < 0: divide with rounding by 2^-shift and clip to [minVal, maxVal]
+void scaleSamplesCore(Pel* buf, int stride, int width, int height, int shift, Pel minVal, Pel maxVal)
+{
+  if (shift > 0)
+  {
+    for (int y = 0; y < height; y++, buf += stride)
+    {
+      for (int x = 0; x < width; x++)
+      {
+        buf[x] <<= shift;
+      }
+    }
+  }
+  else if (shift < 0)
+  {
+    const int shiftr   = -shift;
+    const Pel rounding = 1 << (shiftr - 1);
+
+    for (int y = 0; y < height; y++, buf += stride)
+    {
+      for (int x = 0; x < width; x++)
+      {
+        buf[x] = Clip3(minVal, maxVal, Pel((buf[x] + rounding) >> shiftr));
+      }
+    }
+  }
+}
+
+bool checkSampleRangeCore(const Pel* buf, int stride, int width, int height, int bitDepth)
+{
+  const Pel mask = ~((1 << bitDepth) - 1);
+
+  for (int y = 0; y < height; y++, buf += stride)
+  {
+    for (int x = 0; x < width; x++)
+    {
+      if ((buf[x] & mask) != 0)
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
 void paddingCore(Pel *ptr, int stride, int width, int height, int padSize)
 {
   /*left and right padding*/
@@ -83,12 +83,22 @@ struct PelBufferOps
   void (*profGradFilter) (Pel* pSrc, int srcStride, int width, int height, int gradStride, Pel* gradX, Pel* gradY, const int bitDepth);
   void (*applyPROF)      (Pel* dst, int dstStride, const Pel* src, int srcStride, int width, int height, const Pel* gradX, const Pel* gradY, int gradStride, const int* dMvX, const int* dMvY, int dMvStride, const bool& bi, int shiftNum, Pel offset, const ClpRng& clpRng);
   void (*roundIntVector) (int* v, int size, unsigned int nShift, const int dmvLimit);
+  double (*wghtSse)      (const Pel* org, int orgStride, const Pel* rec, int recStride, const double* wght, int wghtStride, int width, int height, int orgShift, int recShift);
+  void (*unpackSamples)  (const uint8_t* src, Pel* dst, int width, bool is16bit);
+  void (*packSamples)    (const Pel* src, uint8_t* dst, int width, bool is16bit);
+  void (*scaleSamples)   (Pel* buf, int stride, int width, int height, int shift, Pel minVal, Pel maxVal);
+  bool (*checkSampleRange)(const Pel* buf, int stride, int width, int height, int bitDepth);
 };
 
 extern PelBufferOps g_pelBufOP;
 
 void paddingCore(Pel *ptr, int stride, int width, int height, int padSize);
 void copyBufferCore(Pel *src, int srcStride, Pel *Dst, int dstStride, int width, int height);
+double wghtSseCore(const Pel* org, int orgStride, const Pel* rec, int recStride, const double* wght, int wghtStride, int width, int height, int orgShift, int recShift);
+void unpackSamplesCore(const uint8_t* src, Pel* dst, int width, bool is16bit);
+void packSamplesCore(const Pel* src, uint8_t* dst, int width, bool is16bit);
+void scaleSamplesCore(Pel* buf, int stride, int width, int height, int shift, Pel minVal, Pel maxVal);
+bool checkSampleRangeCore(const Pel* buf, int stride, int width, int height, int bitDepth);
 
 template<typename T>
 struct AreaBuf : public Size
@@ -64,9 +64,10 @@ CodingStructure::CodingStructure(CUCache& cuCache, PUCache& puCache, TUCache& tu
   , parent    ( nullptr )
   , bestCS    ( nullptr )
   , m_isTuEnc ( false )
-  , m_cuCache ( cuCache )
-  , m_puCache ( puCache )
-  , m_tuCache ( tuCache )
+  , m_isTopLayer( false )
+  , m_cuArena ( cuCache )
+  , m_puArena ( puCache )
+  , m_tuArena ( tuCache )
   , bestParent ( nullptr )
   , tmpColorSpaceCost(MAX_DOUBLE)
   , firstColorSpaceSelected(true)
@@ -136,9 +137,12 @@ void CodingStructure::destroy()
   m_motionBuf = nullptr;
 
 
-  m_tuCache.cache( tus );
-  m_puCache.cache( pus );
-  m_cuCache.cache( cus );
+  tus.clear();
+  pus.clear();
+  cus.clear();
+  m_tuArena.release();
+  m_puArena.release();
+  m_cuArena.release();
 }
 
 void CodingStructure::releaseIntermediateData()
@@ -915,22 +919,19 @@ void CodingStructure::clearCuPuTuIdxMap( const UnitArea &_area, uint32_t numCu,
     AreaBuf<uint32_t>( idxPtrTU, scaledSelf.width, scaledBlk.size() ).fill( 0 );
   }
 
-  //pop cu/pu/tus
+  //pop cu/pu/tus, they stay in the arenas
   for( int i = m_numTUs; i > numTu; i-- )
   {
-    m_tuCache.cache( tus.back() );
     tus.pop_back();
     m_numTUs--;
   }
   for( int i = m_numPUs; i > numPu; i-- )
   {
-    m_puCache.cache( pus.back() );
     pus.pop_back();
     m_numPUs--;
   }
   for( int i = m_numCUs; i > numCu; i-- )
   {
-    m_cuCache.cache( cus.back() );
     cus.pop_back();
     m_numCUs--;
   }
@@ -948,7 +949,7 @@ CodingUnit* CodingStructure::getLumaCU( const Position &pos )
 
   const unsigned idx = m_cuIdx[effChType][rsAddr( pos, _blk.pos(), _blk.width, unitScale[effChType] )];
 
-  if (idx != 0)
+  if( xIsCurrentCU( idx, m_numCUs, pos, effChType ) )
   {
     return cus[idx - 1];
   }
@@ -983,7 +984,7 @@ CodingUnit* CodingStructure::getCU( const Position &pos, const ChannelType effCh
   {
     const unsigned idx = m_cuIdx[effChType][rsAddr( pos, _blk.pos(), _blk.width, unitScale[effChType] )];
 
-    if (idx != 0)
+    if( xIsCurrentCU( idx, m_numCUs, pos, effChType ) )
     {
       return cus[idx - 1];
     }
@@ -1018,7 +1019,7 @@ const CodingUnit* CodingStructure::getCU( const Position &pos, const ChannelType
   {
     const unsigned idx = m_cuIdx[effChType][rsAddr( pos, _blk.pos(), _blk.width, unitScale[effChType] )];
 
-    if (idx != 0)
+    if( xIsCurrentCU( idx, m_numCUs, pos, effChType ) )
     {
       return cus[idx - 1];
     }
@@ -1048,7 +1049,7 @@ PredictionUnit* CodingStructure::getPU( const Position &pos, const ChannelType e
   {
     const unsigned idx = m_puIdx[effChType][rsAddr( pos, _blk.pos(), _blk.width, unitScale[effChType] )];
 
-    if (idx != 0)
+    if( xIsCurrentPU( idx, m_numPUs, pos, effChType ) )
     {
       return pus[idx - 1];
     }
@@ -1078,7 +1079,7 @@ const PredictionUnit * CodingStructure::getPU( const Position &pos, const Channe
   {
     const unsigned idx = m_puIdx[effChType][rsAddr( pos, _blk.pos(), _blk.width, unitScale[effChType] )];
 
-    if (idx != 0)
+    if( xIsCurrentPU( idx, m_numPUs, pos, effChType ) )
     {
       return pus[idx - 1];
     }
@@ -1108,7 +1109,7 @@ TransformUnit* CodingStructure::getTU( const Position &pos, const ChannelType ef
   {
     const unsigned idx = m_tuIdx[effChType][rsAddr( pos, _blk.pos(), _blk.width, unitScale[effChType] )];
 
-    if( idx != 0 )
+    if( xIsCurrentTU( idx, m_numTUs, pos, effChType ) )
     {
       unsigned extraIdx = 0;
       if( isLuma( effChType ) )
@@ -1164,7 +1165,7 @@ const TransformUnit * CodingStructure::getTU( const Position &pos, const Channel
   else
   {
     const unsigned idx = m_tuIdx[effChType][rsAddr( pos, _blk.pos(), _blk.width, unitScale[effChType] )];
-    if( idx != 0 )
+    if( xIsCurrentTU( idx, m_numTUs, pos, effChType ) )
     {
       unsigned extraIdx = 0;
       if( isLuma( effChType ) )
@@ -1203,7 +1204,7 @@ const TransformUnit * CodingStructure::getTU( const Position &pos, const Channel
 
 CodingUnit& CodingStructure::addCU( const UnitArea &unit, const ChannelType chType )
 {
-  CodingUnit *cu = m_cuCache.get();
+  CodingUnit *cu = m_cuArena.get( m_numCUs );
 
   cu->UnitArea::operator=( unit );
   cu->initData();
@@ -1246,7 +1247,7 @@ CodingUnit& CodingStructure::addCU( const UnitArea &unit, const ChannelType chTy
     const Area scaledSelf  = scale.scale( _selfBlk );
     const Area scaledBlk   = scale.scale(     _blk );
     unsigned *idxPtr       = m_cuIdx[i] + rsAddr( scaledBlk.pos(), scaledSelf.pos(), scaledSelf.width );
-    CHECK( *idxPtr, "Overwriting a pre-existing value, should be '0'!" );
+    CHECK( xIsCurrentCU( *idxPtr, idx - 1, _blk.pos(), ChannelType( i ) ), "Overwriting a pre-existing value, should be '0'!" );
     AreaBuf<uint32_t>( idxPtr, scaledSelf.width, scaledBlk.size() ).fill( idx );
   }
 
@@ -1255,7 +1256,7 @@ CodingUnit& CodingStructure::addCU( const UnitArea &unit, const ChannelType chTy
 
 PredictionUnit& CodingStructure::addPU( const UnitArea &unit, const ChannelType chType )
 {
-  PredictionUnit *pu = m_puCache.get();
+  PredictionUnit *pu = m_puArena.get( m_numPUs );
 
   pu->UnitArea::operator=( unit );
   pu->initData();
@@ -1297,7 +1298,7 @@ PredictionUnit& CodingStructure::addPU( const UnitArea &unit, const ChannelType
     const Area scaledSelf  = scale.scale( _selfBlk );
     const Area scaledBlk   = scale.scale(     _blk );
     unsigned *idxPtr       = m_puIdx[i] + rsAddr( scaledBlk.pos(), scaledSelf.pos(), scaledSelf.width );
-    CHECK( *idxPtr, "Overwriting a pre-existing value, should be '0'!" );
+    CHECK( xIsCurrentPU( *idxPtr, idx - 1, _blk.pos(), ChannelType( i ) ), "Overwriting a pre-existing value, should be '0'!" );
     AreaBuf<uint32_t>( idxPtr, scaledSelf.width, scaledBlk.size() ).fill( idx );
   }
 
@@ -1306,7 +1307,7 @@ PredictionUnit& CodingStructure::addPU( const UnitArea &unit, const ChannelType
 
 TransformUnit& CodingStructure::addTU( const UnitArea &unit, const ChannelType chType )
 {
-  TransformUnit *tu = m_tuCache.get();
+  TransformUnit *tu = m_tuArena.get( m_numTUs );
 
   tu->UnitArea::operator=( unit );
   tu->initData();
@@ -1370,7 +1371,7 @@ TransformUnit& CodingStructure::addTU( const UnitArea &unit, const ChannelType c
         const Area scaledSelf = scale.scale(_selfBlk);
         const Area scaledBlk = isIspTu ? scale.scale(tu->cu->blocks[i]) : scale.scale(_blk);
         unsigned *idxPtr = m_tuIdx[i] + rsAddr(scaledBlk.pos(), scaledSelf.pos(), scaledSelf.width);
-        CHECK(*idxPtr, "Overwriting a pre-existing value, should be '0'!");
+        CHECK(xIsCurrentTU(*idxPtr, idx - 1, isIspTu ? tu->cu->blocks[i].pos() : _blk.pos(), ChannelType(i)), "Overwriting a pre-existing value, should be '0'!");
         AreaBuf<uint32_t>(idxPtr, scaledSelf.width, scaledBlk.size()).fill(idx);
       }
     }
@@ -1568,6 +1569,7 @@ void CodingStructure::create(const UnitArea& _unit, const bool isTopLayer, const
 void CodingStructure::createInternals(const UnitArea& _unit, const bool isTopLayer, const bool isPLTused)
 {
   area = _unit;
+  m_isTopLayer = isTopLayer;
 
   memcpy( unitScale, UnitScaleArray[area.chromaFormat], sizeof( unitScale ) );
 
@@ -1580,9 +1582,9 @@ void CodingStructure::createInternals(const UnitArea& _unit, const bool isTopLay
   {
     unsigned _area = unitScale[i].scale( area.blocks[i].size() ).area();
 
-    m_cuIdx[i]    = _area > 0 ? new unsigned[_area] : nullptr;
-    m_puIdx[i]    = _area > 0 ? new unsigned[_area] : nullptr;
-    m_tuIdx[i]    = _area > 0 ? new unsigned[_area] : nullptr;
+    m_cuIdx[i]    = _area > 0 ? new unsigned[_area]() : nullptr;
+    m_puIdx[i]    = _area > 0 ? new unsigned[_area]() : nullptr;
+    m_tuIdx[i]    = _area > 0 ? new unsigned[_area]() : nullptr;
     m_isDecomp[i] = _area > 0 ? new bool    [_area] : nullptr;
   }
 
@@ -2137,7 +2139,6 @@ void CodingStructure::clearTUs()
     size_t _area = ( area.blocks[i].area() >> unitScale[i].area );
 
     memset( m_isDecomp[i], false, sizeof( *m_isDecomp[0] ) * _area );
-    memset( m_tuIdx   [i],     0, sizeof( *m_tuIdx   [0] ) * _area );
   }
 
   numCh = getNumberValidComponents( area.chromaFormat );
@@ -2151,19 +2152,21 @@ void CodingStructure::clearTUs()
     pcu->firstTU = pcu->lastTU = nullptr;
   }
 
-  m_tuCache.cache( tus );
+  tus.clear();
+  if( m_isTopLayer )
+  {
+    m_tuArena.release();
+  }
   m_numTUs = 0;
 }
 
 void CodingStructure::clearPUs()
 {
-  int numCh = ::getNumberValidChannels( area.chromaFormat );
-  for( int i = 0; i < numCh; i++ )
+  pus.clear();
+  if( m_isTopLayer )
   {
-    memset( m_puIdx[i], 0, sizeof( *m_puIdx[0] ) * unitScale[i].scaleArea( area.blocks[i].area() ) );
+    m_puArena.release();
   }
-
-  m_puCache.cache( pus );
   m_numPUs = 0;
 
   for( auto &pcu : cus )
@@ -2174,13 +2177,11 @@ void CodingStructure::clearPUs()
 
 void CodingStructure::clearCUs()
 {
-  int numCh = ::getNumberValidChannels( area.chromaFormat );
-  for( int i = 0; i < numCh; i++ )
+  cus.clear();
+  if( m_isTopLayer )
   {
-    memset( m_cuIdx[i], 0, sizeof( *m_cuIdx[0] ) * unitScale[i].scaleArea( area.blocks[i].area() ) );
+    m_cuArena.release();
   }
-
-  m_cuCache.cache( cus );
   m_numCUs = 0;
 }
 
@@ -220,6 +220,26 @@ public:
 private:
   void createInternals(const UnitArea& _unit, const bool isTopLayer, const bool isPLTused);
 
+  // the index maps are not cleared with the units, an entry is valid only if it refers to a current unit covering pos
+  bool xIsCurrentCU( const unsigned idx, const unsigned numCUs, const Position &pos, const ChannelType chType ) const
+  {
+    return idx != 0 && idx <= numCUs && cus[idx - 1]->blocks[chType].contains( pos );
+  }
+  bool xIsCurrentPU( const unsigned idx, const unsigned numPUs, const Position &pos, const ChannelType chType ) const
+  {
+    return idx != 0 && idx <= numPUs && pus[idx - 1]->blocks[chType].contains( pos );
+  }
+  bool xIsCurrentTU( const unsigned idx, const unsigned numTUs, const Position &pos, const ChannelType chType ) const
+  {
+    if( idx == 0 || idx > numTUs )
+    {
+      return false;
+    }
+    const TransformUnit &tu = *tus[idx - 1];
+    // the first sub-partition of an ISP coding unit covers the whole coding unit in the map
+    return tu.cu && tu.cu->ispMode && isLuma( chType ) ? tu.cu->blocks[chType].contains( pos ) : tu.blocks[chType].contains( pos );
+  }
+
 public:
 
   std::vector<    CodingUnit*> cus;
@@ -249,9 +269,12 @@ private:
   unsigned m_numPUs;
   unsigned m_numTUs;
 
-  CUCache& m_cuCache;
-  PUCache& m_puCache;
-  TUCache& m_tuCache;
+  // the units of a coding structure below the picture level are kept in per structure arenas when the structure is
+  // cleared, picture level structures return them to the shared caches
+  bool                          m_isTopLayer;
+  dynamic_arena<CodingUnit>     m_cuArena;
+  dynamic_arena<PredictionUnit> m_puArena;
+  dynamic_arena<TransformUnit>  m_tuArena;
 
   std::vector<SAOBlkParam> m_sao;
 
@@ -296,6 +296,7 @@ static const int MAX_NUM_PARTS_IN_CTU =                         ( ( MAX_CU_SIZE
 static const int MAX_NUM_TUS =                                     16; ///< Maximum number of TUs within one CU. When max TB size is 32x32, up to 16 TUs within one CU (128x128) is supported
 static const int MAX_LOG2_DIFF_CU_TR_SIZE =                         3;
 static const int MAX_CU_TILING_PARTITIONS = 1 << ( MAX_LOG2_DIFF_CU_TR_SIZE << 1 );
+static const int PIC_BORDER_ROW_BAND =                              32; ///< Number of rows per task in the parallel border extension of pictures
 
 static const int JVET_C0024_ZERO_OUT_TH =                          32;
 
@@ -399,6 +400,8 @@ static const int MAX_LADF_INTERVALS       =                         5; /// max n
 #endif
 
 static const int NTAPS_BILINEAR           =                         2; ///< Number of taps for bilinear filter
+static const int VA_WRAP_BUF_STRIDE       =                        16; ///< Stride of the wrapped reference support of a VA 4x4 sub-block (4 + NTAPS_LUMA - 1, rounded up for SIMD loads)
+static const int VA_WRAP_BUF_HEIGHT       =           4 + NTAPS_LUMA; ///< Rows of the wrapped reference support of a VA 4x4 sub-block (one spare row for SIMD loads)
 
 static const int ATMVP_SUB_BLOCK_SIZE =                             3; ///< sub-block size for ATMVP
 static const int GEO_MAX_NUM_UNI_CANDS =                            6;
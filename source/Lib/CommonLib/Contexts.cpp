@@ -38,6 +38,7 @@
 #include "Contexts.h"
 
 #include <algorithm>
+#include <bitset>
 #include <cstring>
 #include <limits>
 
@@ -890,24 +891,97 @@ const CtxSet ContextSetCfg::Sao = { ContextSetCfg::SaoMergeFlag, ContextSetCfg::
 
 const CtxSet ContextSetCfg::Alf = { ContextSetCfg::ctbAlfFlag, ContextSetCfg::ctbAlfAlternative, ContextSetCfg::AlfUseTemporalFilt };
 
+std::atomic<uint64_t> CtxCopyStats::sm_bytesCopied  ( 0 );
+std::atomic<uint64_t> CtxCopyStats::sm_bytesFullCopy( 0 );
+
+static std::atomic<uint64_t> g_ctxBaseId( 0 );
+
 template <class BinProbModel>
 CtxStore<BinProbModel>::CtxStore()
-  : m_CtxBuffer ()
-  , m_Ctx       ( nullptr )
+  : m_CtxBuffer   ()
+  , m_Ctx         ( nullptr )
+  , m_baseId      ( ++g_ctxBaseId )
+  , m_dirtyBlocks ( 0 )
 {}
 
 template <class BinProbModel>
 CtxStore<BinProbModel>::CtxStore( bool dummy )
-  : m_CtxBuffer ( ContextSetCfg::NumberOfContexts )
-  , m_Ctx       ( m_CtxBuffer.data() )
-{}
+  : m_CtxBuffer   ( ContextSetCfg::NumberOfContexts )
+  , m_Ctx         ( m_CtxBuffer.data() )
+  , m_baseId      ( ++g_ctxBaseId )
+  , m_dirtyBlocks ( 0 )
+{
+  CHECK( ContextSetCfg::NumberOfContexts > ( 64 << CTX_BLOCK_LOG2 ), "Too many contexts for the dirty block mask" );
+}
 
 template <class BinProbModel>
 CtxStore<BinProbModel>::CtxStore( const CtxStore<BinProbModel>& ctxStore )
-  : m_CtxBuffer ( ctxStore.m_CtxBuffer )
-  , m_Ctx       ( m_CtxBuffer.data() )
+  : m_CtxBuffer   ( ctxStore.m_CtxBuffer )
+  , m_Ctx         ( m_CtxBuffer.data() )
+  , m_baseId      ( ctxStore.m_baseId )
+  , m_dirtyBlocks ( ctxStore.m_dirtyBlocks )
 {}
 
+template <class BinProbModel>
+void CtxStore<BinProbModel>::xSetNewBase()
+{
+  m_baseId      = ++g_ctxBaseId;
+  m_dirtyBlocks = 0;
+}
+
+template <class BinProbModel>
+void CtxStore<BinProbModel>::copyFrom( const CtxStore<BinProbModel>& src )
+{
+  checkInit();
+  const unsigned numCtx    = ContextSetCfg::NumberOfContexts;
+  const unsigned numBlocks = ( numCtx + ( 1 << CTX_BLOCK_LOG2 ) - 1 ) >> CTX_BLOCK_LOG2;
+  const uint64_t allBlocks = numBlocks < 64 ? ( uint64_t( 1 ) << numBlocks ) - 1 : ~uint64_t( 0 );
+  const uint64_t diff      = m_baseId == src.m_baseId ? ( m_dirtyBlocks | src.m_dirtyBlocks ) & allBlocks : allBlocks;
+
+  if( 2 * std::bitset<64>( diff ).count() > numBlocks )
+  {
+    ::memcpy( m_Ctx, src.m_Ctx, sizeof( BinProbModel ) * numCtx );
+    CtxCopyStats::add( sizeof( BinProbModel ) * numCtx, sizeof( BinProbModel ) * numCtx );
+
+    // both stores become the new snapshot, which keeps the dirty masks of later copies between them small
+    if( src.m_dirtyBlocks )
+    {
+      src.m_baseId      = ++g_ctxBaseId;
+      src.m_dirtyBlocks = 0;
+    }
+    m_baseId      = src.m_baseId;
+    m_dirtyBlocks = 0;
+    return;
+  }
+
+  size_t copied = 0;
+  for( unsigned first = 0; first < numCtx; first += 1 << CTX_BLOCK_LOG2 )
+  {
+    if( ( diff >> ( first >> CTX_BLOCK_LOG2 ) ) & 1 )
+    {
+      const unsigned size = std::min<unsigned>( 1 << CTX_BLOCK_LOG2, numCtx - first );
+      ::memcpy( m_Ctx + first, src.m_Ctx + first, sizeof( BinProbModel ) * size );
+      copied += sizeof( BinProbModel ) * size;
+    }
+  }
+  CtxCopyStats::add( copied, sizeof( BinProbModel ) * numCtx );
+  m_dirtyBlocks = src.m_dirtyBlocks;
+}
+
+template <class BinProbModel>
+void CtxStore<BinProbModel>::copyFrom( const CtxStore<BinProbModel>& src, const CtxSet& ctxSet )
+{
+  checkInit();
+  ::memcpy( m_Ctx + ctxSet.Offset, src.m_Ctx + ctxSet.Offset, sizeof( BinProbModel ) * ctxSet.Size );
+  CtxCopyStats::add( sizeof( BinProbModel ) * ctxSet.Size, sizeof( BinProbModel ) * ctxSet.Size );
+  if( ctxSet.Size )
+  {
+    const unsigned firstBlock = ctxSet.Offset >> CTX_BLOCK_LOG2;
+    const unsigned lastBlock  = ( ctxSet.Offset + ctxSet.Size - 1 ) >> CTX_BLOCK_LOG2;
+    m_dirtyBlocks |= ( ~uint64_t( 0 ) >> ( 63 - lastBlock ) ) & ( ~uint64_t( 0 ) << firstBlock );
+  }
+}
+
 template <class BinProbModel>
 void CtxStore<BinProbModel>::init( int qp, int initId )
 {
@@ -924,6 +998,7 @@ void CtxStore<BinProbModel>::init( int qp, int initId )
     m_CtxBuffer[k].init( clippedQP, initTable[k] );
     m_CtxBuffer[k].setLog2WindowSize(rateInitTable[k]);
   }
+  xSetNewBase();
 }
 
 template <class BinProbModel>
@@ -935,6 +1010,7 @@ void CtxStore<BinProbModel>::setWinSizes( const std::vector<uint8_t>& log2Window
   {
     m_CtxBuffer[k].setLog2WindowSize( log2WindowSizes[k] );
   }
+  xSetNewBase();
 }
 
 template <class BinProbModel>
@@ -946,6 +1022,7 @@ void CtxStore<BinProbModel>::loadPStates( const std::vector<uint16_t>& probState
   {
     m_CtxBuffer[k].setState( probStates[k] );
   }
+  xSetNewBase();
 }
 
 template <class BinProbModel>
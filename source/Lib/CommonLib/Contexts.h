@@ -42,6 +42,7 @@
 #include "Slice.h"
 
 #include <vector>
+#include <atomic>
 
 static constexpr int     PROB_BITS   = 15;   // Nominal number of bits to represent probabilities
 static constexpr int     PROB_BITS_0 = 10;   // Number of bits to represent 1st estimate
@@ -293,6 +294,27 @@ public:
 
 
 
+// bytes of context states copied by context snapshots and restores, compared to copying all contexts every time
+class CtxCopyStats
+{
+public:
+  static void     reset         ()                                  { sm_bytesCopied = 0; sm_bytesFullCopy = 0; }
+  static void     add           ( size_t copied, size_t fullCopy )  { sm_bytesCopied += copied; sm_bytesFullCopy += fullCopy; }
+  static uint64_t getBytesCopied  ()                                { return sm_bytesCopied; }
+  static uint64_t getBytesFullCopy()                                { return sm_bytesFullCopy; }
+private:
+  static std::atomic<uint64_t> sm_bytesCopied;
+  static std::atomic<uint64_t> sm_bytesFullCopy;
+};
+
+
+
+/// context store with dirty block tracking
+///
+/// The contexts are grouped into blocks of 1 << CTX_BLOCK_LOG2 contexts. Each store remembers the snapshot it was last
+/// copied from or initialized to (m_baseId) and the blocks modified since (m_dirtyBlocks). Copying between two stores
+/// with the same base only copies the blocks modified in either of them, so that saving and restoring the contexts
+/// around a mode trial costs in proportion to the contexts the trial has touched.
 template <class BinProbModel>
 class CtxStore : public FracBitsAccess
 {
@@ -301,25 +323,30 @@ public:
   CtxStore( bool dummy );
   CtxStore( const CtxStore<BinProbModel>& ctxStore );
 public:
-  void copyFrom   ( const CtxStore<BinProbModel>& src )                        { checkInit(); ::memcpy( m_Ctx,               src.m_Ctx,               sizeof( BinProbModel ) * ContextSetCfg::NumberOfContexts ); }
-  void copyFrom   ( const CtxStore<BinProbModel>& src, const CtxSet& ctxSet )  { checkInit(); ::memcpy( m_Ctx+ctxSet.Offset, src.m_Ctx+ctxSet.Offset, sizeof( BinProbModel ) * ctxSet.Size ); }
+  void copyFrom   ( const CtxStore<BinProbModel>& src );
+  void copyFrom   ( const CtxStore<BinProbModel>& src, const CtxSet& ctxSet );
   void init       ( int qp, int initId );
   void setWinSizes( const std::vector<uint8_t>&   log2WindowSizes );
   void loadPStates( const std::vector<uint16_t>&  probStates );
   void savePStates( std::vector<uint16_t>&        probStates )  const;
 
   const BinProbModel& operator[]      ( unsigned  ctxId  )  const { return m_Ctx[ctxId]; }
-  BinProbModel&       operator[]      ( unsigned  ctxId  )        { return m_Ctx[ctxId]; }
+  BinProbModel&       operator[]      ( unsigned  ctxId  )        { m_dirtyBlocks |= uint64_t( 1 ) << ( ctxId >> CTX_BLOCK_LOG2 ); return m_Ctx[ctxId]; }
   uint32_t            estFracBits     ( unsigned  bin,
                                         unsigned  ctxId  )  const { return m_Ctx[ctxId].estFracBits(bin); }
 
   BinFracBits         getFracBitsArray( unsigned  ctxId  )  const { return m_Ctx[ctxId].getFracBitsArray(); }
 
 private:
+  static constexpr int CTX_BLOCK_LOG2 = 3;
+
   inline void checkInit() { if( m_Ctx ) return; m_CtxBuffer.resize( ContextSetCfg::NumberOfContexts ); m_Ctx = m_CtxBuffer.data(); }
+  void        xSetNewBase();
 private:
   std::vector<BinProbModel> m_CtxBuffer;
   BinProbModel*             m_Ctx;
+  mutable uint64_t          m_baseId;
+  mutable uint64_t          m_dirtyBlocks;
 };
 
 
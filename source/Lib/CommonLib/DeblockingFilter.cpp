@@ -88,12 +88,331 @@ static bool isAvailableAbove( const CodingUnit& cu, const CodingUnit& cu2, const
 }
 
 
+// ====================================================================================================================
+// Edge filter kernels
+// ====================================================================================================================
+
+static inline void bilinearFilter( Pel* srcP, Pel* srcQ, const ptrdiff_t offset, int refMiddle, int refP, int refQ, int numberPSide, int numberQSide, const int* dbCoeffsP, const int* dbCoeffsQ, int tc )
+{
+  const char tc7[7] = { 6, 5, 4, 3, 2, 1, 1 };
+  const char tc3[3] = { 6, 4, 2 };
+
+  const char *tcP = (numberPSide == 3) ? tc3 : tc7;
+  const char *tcQ = (numberQSide == 3) ? tc3 : tc7;
+
+  for (int pos = 0; pos < numberPSide; pos++)
+  {
+    int src    = srcP[-offset * pos];
+    int cvalue = (tc * tcP[pos]) >> 1;
+    srcP[-offset * pos] =
+      Clip3(src - cvalue, src + cvalue, ((refMiddle * dbCoeffsP[pos] + refP * (64 - dbCoeffsP[pos]) + 32) >> 6));
+  }
+  for (int pos = 0; pos < numberQSide; pos++)
+  {
+    int src    = srcQ[offset * pos];
+    int cvalue = (tc * tcQ[pos]) >> 1;
+    srcQ[offset * pos] =
+      Clip3(src - cvalue, src + cvalue, ((refMiddle * dbCoeffsQ[pos] + refQ * (64 - dbCoeffsQ[pos]) + 32) >> 6));
+  }
+}
+
+static inline void filteringPandQ( Pel* src, const ptrdiff_t offset, int numberPSide, int numberQSide, int tc )
+{
+  CHECK(numberPSide <= 3 && numberQSide <= 3, "Short filtering in long filtering function");
+  Pel* srcP = src-offset;
+  Pel* srcQ = src;
+
+  int refP = 0;
+  int refQ = 0;
+  int refMiddle = 0;
+
+  const int dbCoeffs7[7] = { 59, 50, 41,32,23,14,5 };
+  const int dbCoeffs3[3] = { 53, 32, 11 };
+  const int dbCoeffs5[5] = { 58, 45, 32,19,6};
+  const int* dbCoeffsP   = numberPSide == 7 ? dbCoeffs7 : (numberPSide==5) ? dbCoeffs5 : dbCoeffs3;
+  const int* dbCoeffsQ   = numberQSide == 7 ? dbCoeffs7 : (numberQSide==5) ? dbCoeffs5 : dbCoeffs3;
+
+  switch (numberPSide)
+  {
+    case 7: refP = (srcP[-6*offset]   + srcP[-7 * offset] + 1) >> 1; break;
+    case 3: refP = (srcP[-2 * offset] + srcP[-3 * offset] + 1) >> 1; break;
+    case 5: refP = (srcP[-4 * offset] + srcP[-5 * offset] + 1) >> 1; break;
+  }
+
+  switch (numberQSide)
+  {
+    case 7: refQ = (srcQ[6 * offset] + srcQ[7 * offset] + 1) >> 1; break;
+    case 3: refQ = (srcQ[2 * offset] + srcQ[3 * offset] + 1) >> 1; break;
+    case 5: refQ = (srcQ[4 * offset] + srcQ[5 * offset] + 1) >> 1; break;
+  }
+
+  if (numberPSide == numberQSide)
+  {
+    if (numberPSide == 5)
+    {
+      refMiddle = (2 * (srcP[0] + srcQ[0] + srcP[-offset] + srcQ[offset] + srcP[-2 * offset] + srcQ[2 * offset]) + srcP[-3 * offset] + srcQ[3 * offset] + srcP[-4 * offset] + srcQ[4 * offset] + 8) >> 4;
+    }
+    else
+    {
+      refMiddle = (2 * (srcP[0] + srcQ[0]) + srcP[-offset] + srcQ[offset] + srcP[-2 * offset] + srcQ[2 * offset] + srcP[-3 * offset] + srcQ[3 * offset] + srcP[-4 * offset] + srcQ[4 * offset] + srcP[-5 * offset] + srcQ[5 * offset] + +srcP[-6 * offset] + srcQ[6 * offset] + 8) >> 4;
+    }
+  }
+  else
+  {
+    Pel* srcPt = srcP;
+    Pel* srcQt = srcQ;
+    int offsetP = -offset;
+    int offsetQ = offset;
+
+    int newNumberQSide = numberQSide;
+    int newNumberPSide = numberPSide;
+    if (numberQSide > numberPSide)
+    {
+      std::swap(srcPt, srcQt);
+      std::swap(offsetP, offsetQ);
+      newNumberQSide = numberPSide;
+      newNumberPSide = numberQSide;
+    }
+
+    if (newNumberPSide == 7 && newNumberQSide == 5)
+    {
+      refMiddle = (2 * (srcP[0] + srcQ[0] + srcP[-offset] + srcQ[offset]) + srcP[-2 * offset] + srcQ[2 * offset] + srcP[-3 * offset] + srcQ[3 * offset] + srcP[-4 * offset] + srcQ[4 * offset] + srcP[-5 * offset] + srcQ[5 * offset] + 8) >> 4;
+    }
+    else if (newNumberPSide == 7 && newNumberQSide == 3)
+    {
+      refMiddle = (2 * (srcPt[0] + srcQt[0]) + srcQt[0] + 2 * (srcQt[offsetQ] + srcQt[2 * offsetQ]) + srcPt[offsetP] + srcQt[offsetQ] + srcPt[2 * offsetP] + srcPt[3 * offsetP] + srcPt[4 * offsetP] + srcPt[5 * offsetP] + srcPt[6 * offsetP] + 8) >> 4;
+    }
+    else //if (newNumberPSide == 5 && newNumberQSide == 3)
+    {
+      refMiddle = (srcP[0] + srcQ[0] + srcP[-offset] + srcQ[offset] + srcP[-2 * offset] + srcQ[2 * offset] + srcP[-3 * offset] + srcQ[3 * offset] + 4) >> 3;
+    }
+  }
+  bilinearFilter(srcP,srcQ,offset,refMiddle,refP,refQ,numberPSide,numberQSide,dbCoeffsP,dbCoeffsQ,tc);
+}
+
+/**
+ - Deblocking of the DEBLOCK_SMALLEST_BLOCK / 2 lines of a luma edge segment with the strong or weak filter
+ .
+ \param src             pointer to the first line of the segment at the edge
+ \param offset          offset value for picture data across the edge
+ \param step            offset value for picture data from one line to the next
+ \param tc              tc value
+ \param sw              decision strong/weak filter
+ \param partPNoFilter   indicator to disable filtering on partP
+ \param partQNoFilter   indicator to disable filtering on partQ
+ \param thrCut          threshold value for weak filter decision
+ \param filterSecondP   decision weak filter/no filter for partP
+ \param filterSecondQ   decision weak filter/no filter for partQ
+ \param clpRng          clipping range of the luma samples
+*/
+static void pelFilterLuma( Pel* src, const ptrdiff_t offset, const ptrdiff_t step, const int tc, const bool sw, const bool partPNoFilter, const bool partQNoFilter, const int thrCut, const bool filterSecondP, const bool filterSecondQ, const ClpRng& clpRng )
+{
+  for( int i = 0; i < DEBLOCK_SMALLEST_BLOCK / 2; i++, src += step )
+  {
+    const Pel m4  = src[ 0         ];
+    const Pel m3  = src[-offset    ];
+    const Pel m5  = src[ offset    ];
+    const Pel m2  = src[-offset * 2];
+    const Pel m6  = src[ offset * 2];
+    const Pel m1  = src[-offset * 3];
+    const Pel m7  = src[ offset * 3];
+    const Pel m0  = src[-offset * 4];
+    const char tc3[3] = { 3, 2, 1};
+
+    if (sw)
+    {
+      src[-offset]     = Clip3(m3 - tc3[0] * tc, m3 + tc3[0] * tc, ((m1 + 2 * m2 + 2 * m3 + 2 * m4 + m5 + 4) >> 3));
+      src[0]           = Clip3(m4 - tc3[0] * tc, m4 + tc3[0] * tc, ((m2 + 2 * m3 + 2 * m4 + 2 * m5 + m6 + 4) >> 3));
+      src[-offset * 2] = Clip3(m2 - tc3[1] * tc, m2 + tc3[1] * tc, ((m1 + m2 + m3 + m4 + 2) >> 2));
+      src[offset]      = Clip3(m5 - tc3[1] * tc, m5 + tc3[1] * tc, ((m3 + m4 + m5 + m6 + 2) >> 2));
+      src[-offset * 3] = Clip3(m1 - tc3[2] * tc, m1 + tc3[2] * tc, ((2 * m0 + 3 * m1 + m2 + m3 + m4 + 4) >> 3));
+      src[offset * 2]  = Clip3(m6 - tc3[2] * tc, m6 + tc3[2] * tc, ((m3 + m4 + m5 + 3 * m6 + 2 * m7 + 4) >> 3));
+    }
+    else
+    {
+      /* Weak filter */
+      int delta = ( 9 * ( m4 - m3 ) - 3 * ( m5 - m2 ) + 8 ) >> 4;
+
+      if ( abs(delta) < thrCut )
+      {
+        delta = Clip3( -tc, tc, delta );
+        src[-offset] = ClipPel( m3 + delta, clpRng);
+        src[0]       = ClipPel( m4 - delta, clpRng);
+
+        const int tc2 = tc >> 1;
+        if( filterSecondP )
+        {
+          const int delta1 = Clip3( -tc2, tc2, ( ( ( ( m1 + m3 + 1 ) >> 1 ) - m2 + delta ) >> 1 ) );
+          src[-offset * 2] = ClipPel( m2 + delta1, clpRng);
+        }
+        if( filterSecondQ )
+        {
+          const int delta2 = Clip3( -tc2, tc2, ( ( ( ( m6 + m4 + 1 ) >> 1 ) - m5 - delta ) >> 1 ) );
+          src[offset] = ClipPel( m5 + delta2, clpRng);
+        }
+      }
+    }
+
+    if(partPNoFilter)
+    {
+      src[-offset    ] = m3;
+      src[-offset * 2] = m2;
+      src[-offset * 3] = m1;
+    }
+
+    if(partQNoFilter)
+    {
+      src[ 0         ] = m4;
+      src[ offset    ] = m5;
+      src[ offset * 2] = m6;
+    }
+  }
+}
+
+/**
+ - Deblocking of the DEBLOCK_SMALLEST_BLOCK / 2 lines of a luma edge segment with the long filter
+ .
+ \param src             pointer to the first line of the segment at the edge
+ \param offset          offset value for picture data across the edge
+ \param step            offset value for picture data from one line to the next
+ \param numberPSide     number of filtered samples of partP (3, 5 or 7)
+ \param numberQSide     number of filtered samples of partQ (3, 5 or 7)
+ \param tc              tc value
+ \param partPNoFilter   indicator to disable filtering on partP
+ \param partQNoFilter   indicator to disable filtering on partQ
+*/
+static void pelFilterLumaLong( Pel* src, const ptrdiff_t offset, const ptrdiff_t step, const int numberPSide, const int numberQSide, const int tc, const bool partPNoFilter, const bool partQNoFilter )
+{
+  for( int i = 0; i < DEBLOCK_SMALLEST_BLOCK / 2; i++, src += step )
+  {
+    Pel orgP[7], orgQ[7];
+
+    for( int j = 0; j < numberPSide; j++ )
+    {
+      orgP[j] = src[-offset * ( j + 1 )];
+    }
+    for( int j = 0; j < numberQSide; j++ )
+    {
+      orgQ[j] = src[offset * j];
+    }
+
+    filteringPandQ( src, offset, numberPSide, numberQSide, tc );
+
+    if( partPNoFilter )
+    {
+      for( int j = 0; j < numberPSide; j++ )
+      {
+        src[-offset * ( j + 1 )] = orgP[j];
+      }
+    }
+    if( partQNoFilter )
+    {
+      for( int j = 0; j < numberQSide; j++ )
+      {
+        src[offset * j] = orgQ[j];
+      }
+    }
+  }
+}
+
+/**
+ - Deblocking of the lines of a chroma edge segment
+ .
+ \param src             pointer to the first line of the segment at the edge
+ \param offset          offset value for picture data across the edge
+ \param step            offset value for picture data from one line to the next
+ \param numLines        number of lines of the segment
+ \param tc              tc value
+ \param sw              decision strong/weak filter
+ \param partPNoFilter   indicator to disable filtering on partP
+ \param partQNoFilter   indicator to disable filtering on partQ
+ \param clpRng          clipping range of the chroma samples
+ \param isChromaHorCTBBoundary  horizontal edge at a CTU boundary, only p0 and p1 are used on the P side
+*/
+static void pelFilterChroma( Pel* src, const ptrdiff_t offset, const ptrdiff_t step, const int numLines, const int tc, const bool sw, const bool partPNoFilter, const bool partQNoFilter, const ClpRng& clpRng, const bool isChromaHorCTBBoundary )
+{
+  for( int i = 0; i < numLines; i++, src += step )
+  {
+    int delta;
+
+    const Pel m0 = src[-offset * 4];
+    const Pel m1 = src[-offset * 3];
+    const Pel m2 = src[-offset * 2];
+    const Pel m3 = src[-offset];
+    const Pel m4 = src[0];
+    const Pel m5 = src[offset];
+    const Pel m6 = src[offset * 2];
+    const Pel m7 = src[offset * 3];
+
+    if (sw)
+    {
+      if (isChromaHorCTBBoundary)
+      {
+        src[-offset * 1] = Clip3(m3 - tc, m3 + tc, ((3 * m2 + 2 * m3 + m4 + m5 + m6 + 4) >> 3)); // p0
+        src[0] = Clip3(m4 - tc, m4 + tc, ((2 * m2 + m3 + 2 * m4 + m5 + m6 + m7 + 4) >> 3)); // q0
+        src[offset * 1] = Clip3(m5 - tc, m5 + tc, ((m2 + m3 + m4 + 2 * m5 + m6 + 2 * m7 + 4) >> 3));  // q1
+        src[offset * 2] = Clip3(m6 - tc, m6 + tc, ((m3 + m4 + m5 + 2 * m6 + 3 * m7 + 4) >> 3));       // q2
+      }
+      else
+      {
+        src[-offset * 3] = Clip3(m1 - tc, m1 + tc, ((3 * m0 + 2 * m1 + m2 + m3 + m4 + 4) >> 3));       // p2
+        src[-offset * 2] = Clip3(m2 - tc, m2 + tc, ((2 * m0 + m1 + 2 * m2 + m3 + m4 + m5 + 4) >> 3));  // p1
+        src[-offset * 1] = Clip3(m3 - tc, m3 + tc, ((m0 + m1 + m2 + 2 * m3 + m4 + m5 + m6 + 4) >> 3)); // p0
+        src[0] = Clip3(m4 - tc, m4 + tc, ((m1 + m2 + m3 + 2 * m4 + m5 + m6 + m7 + 4) >> 3)); // q0
+        src[offset * 1] = Clip3(m5 - tc, m5 + tc, ((m2 + m3 + m4 + 2 * m5 + m6 + 2 * m7 + 4) >> 3));  // q1
+        src[offset * 2] = Clip3(m6 - tc, m6 + tc, ((m3 + m4 + m5 + 2 * m6 + 3 * m7 + 4) >> 3));       // q2
+      }
+    }
+    else
+    {
+      delta           = Clip3(-tc, tc, ((((m4 - m3) << 2) + m2 - m5 + 4) >> 3));
+      src[-offset] = ClipPel(m3 + delta, clpRng);
+      src[0]        = ClipPel(m4 - delta, clpRng);
+    }
+
+    // without a large boundary only p0 and q0 are filtered
+    if( partPNoFilter )
+    {
+      src[-offset * 3] = m1; // p2
+      src[-offset * 2] = m2; // p1
+      src[-offset] = m3;
+    }
+    if( partQNoFilter )
+    {
+      src[offset * 1] = m5; // q1
+      src[offset * 2] = m6; // q2
+      src[ 0      ] = m4;
+    }
+  }
+}
+
+// bit 0: one of the pairs ( P0, Q0 ), ( P1, Q1 ) differs by threshold or more, bit 1: one of the pairs ( P0, Q1 ), ( P1, Q0 )
+static int mvPairsDiffer( const Mv* mvP, const Mv* mvQ, const int threshold )
+{
+  const bool direct  = ( abs( mvQ[0].getHor() - mvP[0].getHor() ) >= threshold ) || ( abs( mvQ[0].getVer() - mvP[0].getVer() ) >= threshold ) ||
+                       ( abs( mvQ[1].getHor() - mvP[1].getHor() ) >= threshold ) || ( abs( mvQ[1].getVer() - mvP[1].getVer() ) >= threshold );
+  const bool crossed = ( abs( mvQ[1].getHor() - mvP[0].getHor() ) >= threshold ) || ( abs( mvQ[1].getVer() - mvP[0].getVer() ) >= threshold ) ||
+                       ( abs( mvQ[0].getHor() - mvP[1].getHor() ) >= threshold ) || ( abs( mvQ[0].getVer() - mvP[1].getVer() ) >= threshold );
+
+  return ( direct ? 1 : 0 ) | ( crossed ? 2 : 0 );
+}
+
 // ====================================================================================================================
 // Constructor / destructor / create / destroy
 // ====================================================================================================================
 
 DeblockingFilter::DeblockingFilter()
 {
+  m_pelFilterLuma     = pelFilterLuma;
+  m_pelFilterLumaLong = pelFilterLumaLong;
+  m_pelFilterChroma   = pelFilterChroma;
+  m_mvPairsDiffer     = mvPairsDiffer;
+
+#if ENABLE_SIMD_OPT_DEBLOCK
+#ifdef TARGET_SIMD_X86
+  initDeblockingFilterX86();
+#endif
+#endif
 }
 
 DeblockingFilter::~DeblockingFilter()
@@ -161,37 +480,7 @@ void DeblockingFilter::deblockingFilterPic( CodingStructure& cs
   {
     for( int x = 0; x < pcv.widthInCtus; x++ )
     {
-      memset( m_aapucBS       [EDGE_VER].data(), 0,     m_aapucBS       [EDGE_VER].byte_size() );
-      memset( m_aapbEdgeFilter[EDGE_VER].data(), false, m_aapbEdgeFilter[EDGE_VER].byte_size() );
-      memset( m_maxFilterLengthP, 0, sizeof(m_maxFilterLengthP) );
-      memset( m_maxFilterLengthQ, 0, sizeof(m_maxFilterLengthQ) );
-      memset( m_transformEdge, false, sizeof(m_transformEdge) );
-      m_ctuXLumaSamples = x << pcv.maxCUWidthLog2;
-      m_ctuYLumaSamples = y << pcv.maxCUHeightLog2;
-
-      const UnitArea ctuArea( pcv.chrFormat, Area( x << pcv.maxCUWidthLog2, y << pcv.maxCUHeightLog2, pcv.maxCUWidth, pcv.maxCUWidth ) );
-      CodingUnit* firstCU = cs.getCU( ctuArea.lumaPos(), CH_L);
-      cs.slice = firstCU->slice;
-
-      // CU-based deblocking
-      for( auto &currCU : cs.traverseCUs( CS::getArea( cs, ctuArea, CH_L ), CH_L ) )
-      {
-        xDeblockCU( currCU, EDGE_VER );
-      }
-
-      if( CS::isDualITree( cs ) )
-      {
-        memset( m_aapucBS       [EDGE_VER].data(), 0,     m_aapucBS       [EDGE_VER].byte_size() );
-        memset( m_aapbEdgeFilter[EDGE_VER].data(), false, m_aapbEdgeFilter[EDGE_VER].byte_size() );
-        memset( m_maxFilterLengthP, 0, sizeof(m_maxFilterLengthP) );
-        memset( m_maxFilterLengthQ, 0, sizeof(m_maxFilterLengthQ) );
-        memset( m_transformEdge, false, sizeof(m_transformEdge) );
-
-        for( auto &currCU : cs.traverseCUs( CS::getArea( cs, ctuArea, CH_C ), CH_C ) )
-        {
-          xDeblockCU( currCU, EDGE_VER );
-        }
-      }
+      xDeblockCtu( cs, x, y, EDGE_VER );
     }
   }
 
@@ -200,37 +489,7 @@ void DeblockingFilter::deblockingFilterPic( CodingStructure& cs
   {
     for( int x = 0; x < pcv.widthInCtus; x++ )
     {
-      memset( m_aapucBS       [EDGE_HOR].data(), 0,     m_aapucBS       [EDGE_HOR].byte_size() );
-      memset( m_aapbEdgeFilter[EDGE_HOR].data(), false, m_aapbEdgeFilter[EDGE_HOR].byte_size() );
-      memset( m_maxFilterLengthP, 0, sizeof(m_maxFilterLengthP) );
-      memset( m_maxFilterLengthQ, 0, sizeof(m_maxFilterLengthQ) );
-      memset( m_transformEdge, false, sizeof(m_transformEdge) );
-      m_ctuXLumaSamples = x << pcv.maxCUWidthLog2;
-      m_ctuYLumaSamples = y << pcv.maxCUHeightLog2;
-
-      const UnitArea ctuArea( pcv.chrFormat, Area( x << pcv.maxCUWidthLog2, y << pcv.maxCUHeightLog2, pcv.maxCUWidth, pcv.maxCUWidth ) );
-      CodingUnit* firstCU = cs.getCU( ctuArea.lumaPos(), CH_L);
-      cs.slice = firstCU->slice;
-
-      // CU-based deblocking
-      for( auto &currCU : cs.traverseCUs( CS::getArea( cs, ctuArea, CH_L ), CH_L ) )
-      {
-        xDeblockCU( currCU, EDGE_HOR );
-      }
-
-      if( CS::isDualITree( cs ) )
-      {
-        memset( m_aapucBS       [EDGE_HOR].data(), 0,     m_aapucBS       [EDGE_HOR].byte_size() );
-        memset( m_aapbEdgeFilter[EDGE_HOR].data(), false, m_aapbEdgeFilter[EDGE_HOR].byte_size() );
-        memset( m_maxFilterLengthP, 0, sizeof(m_maxFilterLengthP) );
-        memset( m_maxFilterLengthQ, 0, sizeof(m_maxFilterLengthQ) );
-        memset( m_transformEdge, false, sizeof(m_transformEdge) );
-
-        for( auto &currCU : cs.traverseCUs( CS::getArea( cs, ctuArea, CH_C ), CH_C ) )
-        {
-          xDeblockCU( currCU, EDGE_HOR );
-        }
-      }
+      xDeblockCtu( cs, x, y, EDGE_HOR );
     }
   }
 
@@ -242,6 +501,59 @@ void DeblockingFilter::deblockingFilterPic( CodingStructure& cs
   DTRACE_CRC( g_trace_ctx, D_CRC, cs, cs.getRecoBuf() );
 }
 
+void DeblockingFilter::deblockingFilterCtuRow( CodingStructure& cs, const int ctuRow )
+{
+  const PreCalcValues& pcv = *cs.pcv;
+  m_shiftHor = ::getComponentScaleX( COMPONENT_Cb, cs.pcv->chrFormat );
+  m_shiftVer = ::getComponentScaleY( COMPONENT_Cb, cs.pcv->chrFormat );
+
+  for( int x = 0; x < pcv.widthInCtus; x++ )
+  {
+    xDeblockCtu( cs, x, ctuRow, EDGE_VER );
+  }
+  for( int x = 0; x < pcv.widthInCtus; x++ )
+  {
+    xDeblockCtu( cs, x, ctuRow, EDGE_HOR );
+  }
+}
+
+void DeblockingFilter::xDeblockCtu( CodingStructure& cs, const int ctuX, const int ctuY, const DeblockEdgeDir edgeDir )
+{
+  const PreCalcValues& pcv = *cs.pcv;
+
+  memset( m_aapucBS       [edgeDir].data(), 0,     m_aapucBS       [edgeDir].byte_size() );
+  memset( m_aapbEdgeFilter[edgeDir].data(), false, m_aapbEdgeFilter[edgeDir].byte_size() );
+  memset( m_maxFilterLengthP, 0, sizeof(m_maxFilterLengthP) );
+  memset( m_maxFilterLengthQ, 0, sizeof(m_maxFilterLengthQ) );
+  memset( m_transformEdge, false, sizeof(m_transformEdge) );
+  m_ctuXLumaSamples = ctuX << pcv.maxCUWidthLog2;
+  m_ctuYLumaSamples = ctuY << pcv.maxCUHeightLog2;
+
+  const UnitArea ctuArea( pcv.chrFormat, Area( ctuX << pcv.maxCUWidthLog2, ctuY << pcv.maxCUHeightLog2, pcv.maxCUWidth, pcv.maxCUWidth ) );
+  CodingUnit* firstCU = cs.getCU( ctuArea.lumaPos(), CH_L);
+  cs.slice = firstCU->slice;
+
+  // CU-based deblocking
+  for( auto &currCU : cs.traverseCUs( CS::getArea( cs, ctuArea, CH_L ), CH_L ) )
+  {
+    xDeblockCU( currCU, edgeDir );
+  }
+
+  if( CS::isDualITree( cs ) )
+  {
+    memset( m_aapucBS       [edgeDir].data(), 0,     m_aapucBS       [edgeDir].byte_size() );
+    memset( m_aapbEdgeFilter[edgeDir].data(), false, m_aapbEdgeFilter[edgeDir].byte_size() );
+    memset( m_maxFilterLengthP, 0, sizeof(m_maxFilterLengthP) );
+    memset( m_maxFilterLengthQ, 0, sizeof(m_maxFilterLengthQ) );
+    memset( m_transformEdge, false, sizeof(m_transformEdge) );
+
+    for( auto &currCU : cs.traverseCUs( CS::getArea( cs, ctuArea, CH_C ), CH_C ) )
+    {
+      xDeblockCU( currCU, edgeDir );
+    }
+  }
+}
+
 void DeblockingFilter::resetFilterLengths()
 {
   memset(m_aapucBS[EDGE_VER].data(), 0, m_aapucBS[EDGE_VER].byte_size());
@@ -827,23 +1139,23 @@ unsigned DeblockingFilter::xGetBoundaryStrengthSingle ( const CodingUnit& cu, co
     const Picture *piRefP1 = (CU::isIBC(cuP) ? NULL            : ((0 > miP.refIdx[1]) ? NULL : sliceP.getRefPic(REF_PIC_LIST_1, miP.refIdx[1])));
     const Picture *piRefQ0 = (CU::isIBC(cuQ) ? sliceQ.getPic() : ((0 > miQ.refIdx[0]) ? NULL : sliceQ.getRefPic(REF_PIC_LIST_0, miQ.refIdx[0])));
     const Picture *piRefQ1 = (CU::isIBC(cuQ) ? NULL            : ((0 > miQ.refIdx[1]) ? NULL : sliceQ.getRefPic(REF_PIC_LIST_1, miQ.refIdx[1])));
-    Mv mvP0, mvP1, mvQ0, mvQ1;
+    Mv mvP[2], mvQ[2];
 
     if (0 <= miP.refIdx[0])
     {
-      mvP0 = miP.mv[0];
+      mvP[0] = miP.mv[0];
     }
     if (0 <= miP.refIdx[1])
     {
-      mvP1 = miP.mv[1];
+      mvP[1] = miP.mv[1];
     }
     if (0 <= miQ.refIdx[0])
     {
-      mvQ0 = miQ.mv[0];
+      mvQ[0] = miQ.mv[0];
     }
     if (0 <= miQ.refIdx[1])
     {
-      mvQ1 = miQ.mv[1];
+      mvQ[1] = miQ.mv[1];
     }
 
     int nThreshold = (1 << MV_FRACTIONAL_BITS_INTERNAL) >> 1;
@@ -852,29 +1164,16 @@ unsigned DeblockingFilter::xGetBoundaryStrengthSingle ( const CodingUnit& cu, co
     //th can be optimized
     if ( ((piRefP0==piRefQ0)&&(piRefP1==piRefQ1)) || ((piRefP0==piRefQ1)&&(piRefP1==piRefQ0)) )
     {
+      // bit 0: the motion vectors of the same list differ, bit 1: the ones of the opposite lists differ
+      const int mvDiffer = m_mvPairsDiffer( mvP, mvQ, nThreshold );
+
       if ( piRefP0 != piRefP1 )   // Different L0 & L1
       {
-        if ( piRefP0 == piRefQ0 )
-        {
-          uiBs  = ((abs(mvQ0.getHor() - mvP0.getHor()) >= nThreshold) || (abs(mvQ0.getVer() - mvP0.getVer()) >= nThreshold) ||
-                   (abs(mvQ1.getHor() - mvP1.getHor()) >= nThreshold) || (abs(mvQ1.getVer() - mvP1.getVer()) >= nThreshold))
-                  ? 1 : 0;
-        }
-        else
-        {
-          uiBs  = ((abs(mvQ1.getHor() - mvP0.getHor()) >= nThreshold) || (abs(mvQ1.getVer() - mvP0.getVer()) >= nThreshold) ||
-                   (abs(mvQ0.getHor() - mvP1.getHor()) >= nThreshold) || (abs(mvQ0.getVer() - mvP1.getVer()) >= nThreshold))
-                  ? 1 : 0;
-        }
+        uiBs = ( piRefP0 == piRefQ0 ) ? ( mvDiffer & 1 ) : ( mvDiffer >> 1 );
       }
       else    // Same L0 & L1
       {
-        uiBs  = ((abs(mvQ0.getHor() - mvP0.getHor()) >= nThreshold) || (abs(mvQ0.getVer() - mvP0.getVer()) >= nThreshold) ||
-                 (abs(mvQ1.getHor() - mvP1.getHor()) >= nThreshold) || (abs(mvQ1.getVer() - mvP1.getVer()) >= nThreshold))
-              &&
-                ((abs(mvQ1.getHor() - mvP0.getHor()) >= nThreshold) || (abs(mvQ1.getVer() - mvP0.getVer()) >= nThreshold) ||
-                 (abs(mvQ0.getHor() - mvP1.getHor()) >= nThreshold) || (abs(mvQ0.getVer() - mvP1.getVer()) >= nThreshold))
-              ? 1 : 0;
+        uiBs = mvDiffer == 3 ? 1 : 0;
       }
     }
     else // for all different Ref_Idx
@@ -895,11 +1194,11 @@ unsigned DeblockingFilter::xGetBoundaryStrengthSingle ( const CodingUnit& cu, co
     return tmpBs + 1;
   }
 
-  Mv mvP0 = miP.mv[0];
-  Mv mvQ0 = miQ.mv[0];
+  const Mv mvP[2] = { miP.mv[0], Mv() };
+  const Mv mvQ[2] = { miQ.mv[0], Mv() };
 
   int nThreshold = (1 << MV_FRACTIONAL_BITS_INTERNAL) >> 1;
-  return ( ( abs( mvQ0.getHor() - mvP0.getHor() ) >= nThreshold ) || ( abs( mvQ0.getVer() - mvP0.getVer() ) >= nThreshold ) ) ? (tmpBs + 1) : tmpBs;
+  return ( m_mvPairsDiffer( mvP, mvQ, nThreshold ) & 1 ) ? (tmpBs + 1) : tmpBs;
 }
 
 #if LUMA_ADAPTIVE_DEBLOCKING_FILTER_QP_OFFSET
@@ -1098,9 +1397,6 @@ void DeblockingFilter::xEdgeFilterLuma( const CodingUnit& cu, const DeblockEdgeD
           int d0L = dp0L + dq0L;
           int d3L = dp3L + dq3L;
 
-          int dpL = dp0L + dp3L;
-          int dqL = dq0L + dq3L;
-
           int dL = d0L + d3L;
 
           bPartPNoFilter = bPartQNoFilter = false;
@@ -1113,9 +1409,6 @@ void DeblockingFilter::xEdgeFilterLuma( const CodingUnit& cu, const DeblockEdgeD
 
           if (dL < iBeta)
           {
-            const bool filterP = (dpL < iSideThreshold);
-            const bool filterQ = (dqL < iSideThreshold);
-
             Pel* src0 = piTmpSrc + iSrcStep * (iIdx*pelsInPart + iBlkIdx * 4 + 0);
             Pel* src3 = piTmpSrc + iSrcStep * (iIdx*pelsInPart + iBlkIdx * 4 + 3);
 
@@ -1125,10 +1418,7 @@ void DeblockingFilter::xEdgeFilterLuma( const CodingUnit& cu, const DeblockEdgeD
             if (swL)
             {
               useLongtapFilter = true;
-              for (int i = 0; i < DEBLOCK_SMALLEST_BLOCK / 2; i++)
-              {
-                xPelFilterLuma(piTmpSrc + iSrcStep*(iIdx*pelsInPart + iBlkIdx * 4 + i), iOffset, iTc, swL, bPartPNoFilter, bPartQNoFilter, iThrCut, filterP, filterQ, clpRng, sidePisLarge, sideQisLarge, maxFilterLengthP, maxFilterLengthQ);
-              }
+              m_pelFilterLumaLong(src0, iOffset, iSrcStep, sidePisLarge ? maxFilterLengthP : 3, sideQisLarge ? maxFilterLengthQ : 3, iTc, bPartPNoFilter, bPartQNoFilter);
             }
 
           }
@@ -1167,11 +1457,8 @@ void DeblockingFilter::xEdgeFilterLuma( const CodingUnit& cu, const DeblockEdgeD
                    && xUseStrongFiltering(piTmpSrc + iSrcStep * (iIdx * pelsInPart + iBlkIdx * 4 + 3), iOffset, 2 * d3,
                                           iBeta, iTc);
             }
-            for (int i = 0; i < DEBLOCK_SMALLEST_BLOCK / 2; i++)
-            {
-              xPelFilterLuma(piTmpSrc + iSrcStep * (iIdx * pelsInPart + iBlkIdx * 4 + i), iOffset, iTc, sw,
-                             bPartPNoFilter, bPartQNoFilter, iThrCut, bFilterP, bFilterQ, clpRng);
-            }
+            m_pelFilterLuma(piTmpSrc + iSrcStep * (iIdx * pelsInPart + iBlkIdx * 4), iOffset, iSrcStep, iTc, sw,
+                            bPartPNoFilter, bPartQNoFilter, iThrCut, bFilterP, bFilterQ, clpRng);
           }
         }
       }
@@ -1369,20 +1656,14 @@ void DeblockingFilter::xEdgeFilterChroma(const CodingUnit& cu, const DeblockEdge
                                 piTmpSrcChroma + iSrcStep * (iIdx * uiLoopLength + ((subSamplingShift == 1) ? 1 : 3)),
                                 iOffset, 2 * d3, beta, iTc, false, false, 7, 7, isChromaHorCTBBoundary);
 
-              for (unsigned step = 0; step < uiLoopLength; step++)
-              {
-                xPelFilterChroma(piTmpSrcChroma + iSrcStep * (step + iIdx * uiLoopLength), iOffset, iTc, sw,
-                                 bPartPNoFilter, bPartQNoFilter, clpRng, largeBoundary, isChromaHorCTBBoundary);
-              }
+              m_pelFilterChroma(piTmpSrcChroma + iSrcStep * (iIdx * uiLoopLength), iOffset, iSrcStep, uiLoopLength, iTc, sw,
+                                bPartPNoFilter, bPartQNoFilter, clpRng, isChromaHorCTBBoundary);
             }
           }
           if (!useLongFilter)
           {
-            for (unsigned step = 0; step < uiLoopLength; step++)
-            {
-              xPelFilterChroma(piTmpSrcChroma + iSrcStep * (step + iIdx * uiLoopLength), iOffset, iTc, false,
-                               bPartPNoFilter, bPartQNoFilter, clpRng, largeBoundary, isChromaHorCTBBoundary);
-            }
+            m_pelFilterChroma(piTmpSrcChroma + iSrcStep * (iIdx * uiLoopLength), iOffset, iSrcStep, uiLoopLength, iTc, false,
+                              bPartPNoFilter, bPartQNoFilter, clpRng, isChromaHorCTBBoundary);
           }
         }
       }
@@ -1392,278 +1673,6 @@ void DeblockingFilter::xEdgeFilterChroma(const CodingUnit& cu, const DeblockEdge
 
 
 
-/**
- - Deblocking for the luminance component with strong or weak filter
- .
- \param piSrc           pointer to picture data
- \param iOffset         offset value for picture data
- \param tc              tc value
- \param sw              decision strong/weak filter
- \param bPartPNoFilter  indicator to disable filtering on partP
- \param bPartQNoFilter  indicator to disable filtering on partQ
- \param iThrCut         threshold value for weak filter decision
- \param bFilterSecondP  decision weak filter/no filter for partP
- \param bFilterSecondQ  decision weak filter/no filter for partQ
- \param bitDepthLuma    luma bit depth
-*/
-inline void DeblockingFilter::xBilinearFilter(Pel* srcP, Pel* srcQ, int offset, int refMiddle, int refP, int refQ, int numberPSide, int numberQSide, const int* dbCoeffsP, const int* dbCoeffsQ, int tc) const
-{
-  const char tc7[7] = { 6, 5, 4, 3, 2, 1, 1 };
-  const char tc3[3] = { 6, 4, 2 };
-
-  const char *tcP = (numberPSide == 3) ? tc3 : tc7;
-  const char *tcQ = (numberQSide == 3) ? tc3 : tc7;
-
-  for (int pos = 0; pos < numberPSide; pos++)
-  {
-    int src    = srcP[-offset * pos];
-    int cvalue = (tc * tcP[pos]) >> 1;
-    srcP[-offset * pos] =
-      Clip3(src - cvalue, src + cvalue, ((refMiddle * dbCoeffsP[pos] + refP * (64 - dbCoeffsP[pos]) + 32) >> 6));
-  }
-  for (int pos = 0; pos < numberQSide; pos++)
-  {
-    int src    = srcQ[offset * pos];
-    int cvalue = (tc * tcQ[pos]) >> 1;
-    srcQ[offset * pos] =
-      Clip3(src - cvalue, src + cvalue, ((refMiddle * dbCoeffsQ[pos] + refQ * (64 - dbCoeffsQ[pos]) + 32) >> 6));
-  }
-}
-
-inline void DeblockingFilter::xFilteringPandQ(Pel* src, int offset, int numberPSide, int numberQSide, int tc) const
-{
-  CHECK(numberPSide <= 3 && numberQSide <= 3, "Short filtering in long filtering function");
-  Pel* srcP = src-offset;
-  Pel* srcQ = src;
-
-  int refP = 0;
-  int refQ = 0;
-  int refMiddle = 0;
-
-  const int dbCoeffs7[7] = { 59, 50, 41,32,23,14,5 };
-  const int dbCoeffs3[3] = { 53, 32, 11 };
-  const int dbCoeffs5[5] = { 58, 45, 32,19,6};
-  const int* dbCoeffsP   = numberPSide == 7 ? dbCoeffs7 : (numberPSide==5) ? dbCoeffs5 : dbCoeffs3;
-  const int* dbCoeffsQ   = numberQSide == 7 ? dbCoeffs7 : (numberQSide==5) ? dbCoeffs5 : dbCoeffs3;
-
-  switch (numberPSide)
-  {
-    case 7: refP = (srcP[-6*offset]   + srcP[-7 * offset] + 1) >> 1; break;
-    case 3: refP = (srcP[-2 * offset] + srcP[-3 * offset] + 1) >> 1; break;
-    case 5: refP = (srcP[-4 * offset] + srcP[-5 * offset] + 1) >> 1; break;
-  }
-
-  switch (numberQSide)
-  {
-    case 7: refQ = (srcQ[6 * offset] + srcQ[7 * offset] + 1) >> 1; break;
-    case 3: refQ = (srcQ[2 * offset] + srcQ[3 * offset] + 1) >> 1; break;
-    case 5: refQ = (srcQ[4 * offset] + srcQ[5 * offset] + 1) >> 1; break;
-  }
-
-  if (numberPSide == numberQSide)
-  {
-    if (numberPSide == 5)
-    {
-      refMiddle = (2 * (srcP[0] + srcQ[0] + srcP[-offset] + srcQ[offset] + srcP[-2 * offset] + srcQ[2 * offset]) + srcP[-3 * offset] + srcQ[3 * offset] + srcP[-4 * offset] + srcQ[4 * offset] + 8) >> 4;
-    }
-    else
-    {
-      refMiddle = (2 * (srcP[0] + srcQ[0]) + srcP[-offset] + srcQ[offset] + srcP[-2 * offset] + srcQ[2 * offset] + srcP[-3 * offset] + srcQ[3 * offset] + srcP[-4 * offset] + srcQ[4 * offset] + srcP[-5 * offset] + srcQ[5 * offset] + +srcP[-6 * offset] + srcQ[6 * offset] + 8) >> 4;
-    }
-  }
-  else
-  {
-    Pel* srcPt = srcP;
-    Pel* srcQt = srcQ;
-    int offsetP = -offset;
-    int offsetQ = offset;
-
-    int newNumberQSide = numberQSide;
-    int newNumberPSide = numberPSide;
-    if (numberQSide > numberPSide)
-    {
-      std::swap(srcPt, srcQt);
-      std::swap(offsetP, offsetQ);
-      newNumberQSide = numberPSide;
-      newNumberPSide = numberQSide;
-    }
-
-    if (newNumberPSide == 7 && newNumberQSide == 5)
-    {
-      refMiddle = (2 * (srcP[0] + srcQ[0] + srcP[-offset] + srcQ[offset]) + srcP[-2 * offset] + srcQ[2 * offset] + srcP[-3 * offset] + srcQ[3 * offset] + srcP[-4 * offset] + srcQ[4 * offset] + srcP[-5 * offset] + srcQ[5 * offset] + 8) >> 4;
-    }
-    else if (newNumberPSide == 7 && newNumberQSide == 3)
-    {
-      refMiddle = (2 * (srcPt[0] + srcQt[0]) + srcQt[0] + 2 * (srcQt[offsetQ] + srcQt[2 * offsetQ]) + srcPt[offsetP] + srcQt[offsetQ] + srcPt[2 * offsetP] + srcPt[3 * offsetP] + srcPt[4 * offsetP] + srcPt[5 * offsetP] + srcPt[6 * offsetP] + 8) >> 4;
-    }
-    else //if (newNumberPSide == 5 && newNumberQSide == 3)
-    {
-      refMiddle = (srcP[0] + srcQ[0] + srcP[-offset] + srcQ[offset] + srcP[-2 * offset] + srcQ[2 * offset] + srcP[-3 * offset] + srcQ[3 * offset] + 4) >> 3;
-    }
-  }
-  xBilinearFilter(srcP,srcQ,offset,refMiddle,refP,refQ,numberPSide,numberQSide,dbCoeffsP,dbCoeffsQ,tc);
-}
-
-inline void DeblockingFilter::xPelFilterLuma(Pel* piSrc, const int iOffset, const int tc, const bool sw, const bool bPartPNoFilter, const bool bPartQNoFilter, const int iThrCut, const bool bFilterSecondP, const bool bFilterSecondQ, const ClpRng& clpRng, bool sidePisLarge, bool sideQisLarge, int maxFilterLengthP, int maxFilterLengthQ) const
-{
-  int delta;
-
-  const Pel m4  = piSrc[ 0          ];
-  const Pel m3  = piSrc[-iOffset    ];
-  const Pel m5  = piSrc[ iOffset    ];
-  const Pel m2  = piSrc[-iOffset * 2];
-  const Pel m6  = piSrc[ iOffset * 2];
-  const Pel m1  = piSrc[-iOffset * 3];
-  const Pel m7  = piSrc[ iOffset * 3];
-  const Pel m0  = piSrc[-iOffset * 4];
-
-  const Pel mP1 = piSrc[-iOffset * 5];
-  const Pel mP2 = piSrc[-iOffset * 6];
-  const Pel mP3 = piSrc[-iOffset * 7];
-  const Pel m8  = piSrc[ iOffset * 4];
-  const Pel m9  = piSrc[ iOffset * 5];
-  const Pel m10 = piSrc[ iOffset * 6];
-  const char tc3[3] = { 3, 2, 1};
-  if (sw)
-  {
-    if (sidePisLarge || sideQisLarge)
-    {
-      xFilteringPandQ(piSrc, iOffset, sidePisLarge ? maxFilterLengthP : 3, sideQisLarge ? maxFilterLengthQ : 3, tc);
-    }
-    else
-    {
-      piSrc[-iOffset]     = Clip3(m3 - tc3[0] * tc, m3 + tc3[0] * tc, ((m1 + 2 * m2 + 2 * m3 + 2 * m4 + m5 + 4) >> 3));
-      piSrc[0]            = Clip3(m4 - tc3[0] * tc, m4 + tc3[0] * tc, ((m2 + 2 * m3 + 2 * m4 + 2 * m5 + m6 + 4) >> 3));
-      piSrc[-iOffset * 2] = Clip3(m2 - tc3[1] * tc, m2 + tc3[1] * tc, ((m1 + m2 + m3 + m4 + 2) >> 2));
-      piSrc[iOffset]      = Clip3(m5 - tc3[1] * tc, m5 + tc3[1] * tc, ((m3 + m4 + m5 + m6 + 2) >> 2));
-      piSrc[-iOffset * 3] = Clip3(m1 - tc3[2] * tc, m1 + tc3[2] * tc, ((2 * m0 + 3 * m1 + m2 + m3 + m4 + 4) >> 3));
-      piSrc[iOffset * 2]  = Clip3(m6 - tc3[2] * tc, m6 + tc3[2] * tc, ((m3 + m4 + m5 + 3 * m6 + 2 * m7 + 4) >> 3));
-    }
-  }
-  else
-  {
-    /* Weak filter */
-    delta = ( 9 * ( m4 - m3 ) - 3 * ( m5 - m2 ) + 8 ) >> 4;
-
-    if ( abs(delta) < iThrCut )
-    {
-      delta = Clip3( -tc, tc, delta );
-      piSrc[-iOffset] = ClipPel( m3 + delta, clpRng);
-      piSrc[0]        = ClipPel( m4 - delta, clpRng);
-
-      const int tc2 = tc >> 1;
-      if( bFilterSecondP )
-      {
-        const int delta1 = Clip3( -tc2, tc2, ( ( ( ( m1 + m3 + 1 ) >> 1 ) - m2 + delta ) >> 1 ) );
-        piSrc[-iOffset * 2] = ClipPel( m2 + delta1, clpRng);
-      }
-      if( bFilterSecondQ )
-      {
-        const int delta2 = Clip3( -tc2, tc2, ( ( ( ( m6 + m4 + 1 ) >> 1 ) - m5 - delta ) >> 1 ) );
-        piSrc[iOffset] = ClipPel( m5 + delta2, clpRng);
-      }
-    }
-  }
-
-  if(bPartPNoFilter)
-  {
-    piSrc[-iOffset    ] = m3;
-    piSrc[-iOffset * 2] = m2;
-    piSrc[-iOffset * 3] = m1;
-    if (sidePisLarge)
-    {
-      piSrc[-iOffset * 4] = m0;
-      piSrc[-iOffset * 5] = mP1;
-      piSrc[-iOffset * 6] = mP2;
-      piSrc[-iOffset * 7] = mP3;
-    }
-  }
-
-  if(bPartQNoFilter)
-  {
-    piSrc[ 0          ] = m4;
-    piSrc[ iOffset    ] = m5;
-    piSrc[ iOffset * 2] = m6;
-    if (sideQisLarge)
-    {
-      piSrc[iOffset * 3] = m7;
-      piSrc[iOffset * 4] = m8;
-      piSrc[iOffset * 5] = m9;
-      piSrc[iOffset * 6] = m10;
-    }
-  }
-}
-
-/**
- - Deblocking of one line/column for the chrominance component
- .
- \param piSrc           pointer to picture data
- \param iOffset         offset value for picture data
- \param tc              tc value
- \param bPartPNoFilter  indicator to disable filtering on partP
- \param bPartQNoFilter  indicator to disable filtering on partQ
- \param bitDepthChroma  chroma bit depth
- */
-inline void DeblockingFilter::xPelFilterChroma(Pel* piSrc, const int iOffset, const int tc, const bool sw, const bool bPartPNoFilter, const bool bPartQNoFilter, const ClpRng& clpRng, const bool largeBoundary, const bool isChromaHorCTBBoundary) const
-{
-  int delta;
-
-  const Pel m0 = piSrc[-iOffset * 4];
-  const Pel m1 = piSrc[-iOffset * 3];
-  const Pel m2 = piSrc[-iOffset * 2];
-  const Pel m3 = piSrc[-iOffset];
-  const Pel m4 = piSrc[0];
-  const Pel m5 = piSrc[iOffset];
-  const Pel m6 = piSrc[iOffset * 2];
-  const Pel m7 = piSrc[iOffset * 3];
-
-  if (sw)
-  {
-    if (isChromaHorCTBBoundary)
-    {
-      piSrc[-iOffset * 1] = Clip3(m3 - tc, m3 + tc, ((3 * m2 + 2 * m3 + m4 + m5 + m6 + 4) >> 3)); // p0
-      piSrc[0] = Clip3(m4 - tc, m4 + tc, ((2 * m2 + m3 + 2 * m4 + m5 + m6 + m7 + 4) >> 3)); // q0
-      piSrc[iOffset * 1] = Clip3(m5 - tc, m5 + tc, ((m2 + m3 + m4 + 2 * m5 + m6 + 2 * m7 + 4) >> 3));  // q1
-      piSrc[iOffset * 2] = Clip3(m6 - tc, m6 + tc, ((m3 + m4 + m5 + 2 * m6 + 3 * m7 + 4) >> 3));       // q2
-    }
-    else
-    {
-      piSrc[-iOffset * 3] = Clip3(m1 - tc, m1 + tc, ((3 * m0 + 2 * m1 + m2 + m3 + m4 + 4) >> 3));       // p2
-      piSrc[-iOffset * 2] = Clip3(m2 - tc, m2 + tc, ((2 * m0 + m1 + 2 * m2 + m3 + m4 + m5 + 4) >> 3));  // p1
-      piSrc[-iOffset * 1] = Clip3(m3 - tc, m3 + tc, ((m0 + m1 + m2 + 2 * m3 + m4 + m5 + m6 + 4) >> 3)); // p0
-      piSrc[0] = Clip3(m4 - tc, m4 + tc, ((m1 + m2 + m3 + 2 * m4 + m5 + m6 + m7 + 4) >> 3)); // q0
-      piSrc[iOffset * 1] = Clip3(m5 - tc, m5 + tc, ((m2 + m3 + m4 + 2 * m5 + m6 + 2 * m7 + 4) >> 3));  // q1
-      piSrc[iOffset * 2] = Clip3(m6 - tc, m6 + tc, ((m3 + m4 + m5 + 2 * m6 + 3 * m7 + 4) >> 3));       // q2
-    }
-  }
-  else
-  {
-    delta           = Clip3(-tc, tc, ((((m4 - m3) << 2) + m2 - m5 + 4) >> 3));
-    piSrc[-iOffset] = ClipPel(m3 + delta, clpRng);
-    piSrc[0]        = ClipPel(m4 - delta, clpRng);
-  }
-
-
-  if( bPartPNoFilter )
-  {
-    if (largeBoundary)
-    {
-      piSrc[-iOffset * 3] = m1; // p2
-      piSrc[-iOffset * 2] = m2; // p1
-    }
-    piSrc[-iOffset] = m3;
-  }
-  if( bPartQNoFilter )
-  {
-    if (largeBoundary)
-    {
-      piSrc[iOffset * 1] = m5; // q1
-      piSrc[iOffset * 2] = m6; // q2
-    }
-    piSrc[ 0      ] = m4;
-  }
-}
-
 /**
  - Decision between strong and weak filter
  .
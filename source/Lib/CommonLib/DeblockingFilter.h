@@ -65,6 +65,12 @@ private:
   bool    m_transformEdge[MAX_NUM_COMPONENT][MAX_CU_SIZE][MAX_CU_SIZE];    // transform edge flag for [component][luma/chroma sample distance from left edge of CTU][luma/chroma sample distance from top edge of CTU]
   PelStorage                   m_encPicYuvBuffer;
   bool                         m_enc;
+
+  // edge filter kernels, processing all lines of one edge segment
+  void ( *m_pelFilterLuma     )( Pel* src, const ptrdiff_t offset, const ptrdiff_t step, const int tc, const bool sw, const bool partPNoFilter, const bool partQNoFilter, const int thrCut, const bool filterSecondP, const bool filterSecondQ, const ClpRng& clpRng );
+  void ( *m_pelFilterLumaLong )( Pel* src, const ptrdiff_t offset, const ptrdiff_t step, const int numberPSide, const int numberQSide, const int tc, const bool partPNoFilter, const bool partQNoFilter );
+  void ( *m_pelFilterChroma   )( Pel* src, const ptrdiff_t offset, const ptrdiff_t step, const int numLines, const int tc, const bool sw, const bool partPNoFilter, const bool partQNoFilter, const ClpRng& clpRng, const bool isChromaHorCTBBoundary );
+  int  ( *m_mvPairsDiffer     )( const Mv* mvP, const Mv* mvQ, const int threshold );
 private:
 
   // set / get functions
@@ -89,10 +95,6 @@ private:
                                                const TransformUnit &currTU, const int firstComponent);
   void xSetMaxFilterLengthPQForCodingSubBlocks( const DeblockEdgeDir edgeDir, const CodingUnit& cu, const PredictionUnit& currPU, const bool& mvSubBlocks, const int& subBlockSize, const Area& areaPu );
 
-  inline void xBilinearFilter     ( Pel* srcP, Pel* srcQ, int offset, int refMiddle, int refP, int refQ, int numberPSide, int numberQSide, const int* dbCoeffsP, const int* dbCoeffsQ, int tc ) const;
-  inline void xFilteringPandQ     ( Pel* src, int offset, int numberPSide, int numberQSide, int tc ) const;
-  inline void xPelFilterLuma      ( Pel* piSrc, const int iOffset, const int tc, const bool sw, const bool bPartPNoFilter, const bool bPartQNoFilter, const int iThrCut, const bool bFilterSecondP, const bool bFilterSecondQ, const ClpRng& clpRng, bool sidePisLarge = false, bool sideQisLarge = false, int maxFilterLengthP = 7, int maxFilterLengthQ = 7 ) const;
-  inline void xPelFilterChroma(Pel* piSrc, const int iOffset, const int tc, const bool sw, const bool bPartPNoFilter, const bool bPartQNoFilter, const ClpRng& clpRng, const bool largeBoundary, const bool isChromaHorCTBBoundary) const;
   inline bool xUseStrongFiltering(Pel* piSrc, const int iOffset, const int d, const int beta, const int tc, bool sidePisLarge = false, bool sideQisLarge = false, int maxFilterLengthP = 7, int maxFilterLengthQ = 7, bool isChromaHorCTBBoundary = false) const;//move the computation outside the function
   inline unsigned BsSet(unsigned val, const ComponentID compIdx) const;
   inline unsigned BsGet(unsigned val, const ComponentID compIdx) const;
@@ -100,6 +102,8 @@ private:
   inline bool isCrossedByVirtualBoundaries ( const int xPos, const int yPos, const int width, const int height, int& numHorVirBndry, int& numVerVirBndry, int horVirBndryPos[], int verVirBndryPos[], const PicHeader* picHeader );
   inline void xDeriveEdgefilterParam       ( const int xPos, const int yPos, const int numVerVirBndry, const int numHorVirBndry, const int verVirBndryPos[], const int horVirBndryPos[], bool &verEdgeFilter, bool &horEdgeFilter );
 
+  void xDeblockCtu                ( CodingStructure& cs, const int ctuX, const int ctuY, const DeblockEdgeDir edgeDir );
+
   inline int xCalcDP(Pel* piSrc, const int iOffset, const bool isChromaHorCTBBoundary = false) const;
   inline int xCalcDQ              ( Pel* piSrc, const int iOffset ) const;
   static const uint16_t sm_tcTable[MAX_QP + 3];
@@ -121,6 +125,9 @@ public:
 
   /// picture-level deblocking filter
   void deblockingFilterPic        ( CodingStructure& cs );
+  /// deblocking of the vertical and then the horizontal edges of one CTU row, the last 8 luma lines stay pending
+  /// until the next CTU row has been filtered
+  void deblockingFilterCtuRow     ( CodingStructure& cs, const int ctuRow );
 
   static int getBeta              ( const int qp )
   {
@@ -129,6 +136,14 @@ public:
   }
 
   void resetFilterLengths();
+
+#if ENABLE_SIMD_OPT_DEBLOCK
+#ifdef TARGET_SIMD_X86
+  void initDeblockingFilterX86();
+  template <X86_VEXT vext>
+  void _initDeblockingFilterX86();
+#endif
+#endif
 };
 
 //! \}
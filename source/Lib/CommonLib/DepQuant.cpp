@@ -67,9 +67,6 @@ namespace DQIntern
     int32_t   bits[6];
   };
 
-
-  enum ScanPosType { SCAN_ISCSBB = 0, SCAN_SOCSBB = 1, SCAN_EOCSBB = 2 };
-
   struct ScanInfo
   {
     ScanInfo() {}
@@ -600,30 +597,6 @@ namespace DQIntern
 
 
 
-  /*================================================================================*/
-  /*=====                                                                      =====*/
-  /*=====   D A T A   S T R U C T U R E S                                      =====*/
-  /*=====                                                                      =====*/
-  /*================================================================================*/
-
-
-  struct PQData
-  {
-    TCoeff  absLevel;
-    int64_t deltaDist;
-  };
-
-
-  struct Decision
-  {
-    int64_t rdCost;
-    TCoeff  absLevel;
-    int     prevId;
-  };
-
-
-
-
   /*================================================================================*/
   /*=====                                                                      =====*/
   /*=====   P R E - Q U A N T I Z E R                                          =====*/
@@ -812,8 +785,6 @@ namespace DQIntern
   /*=====                                                                      =====*/
   /*================================================================================*/
 
-  class State;
-
   struct SbbCtx
   {
     uint8_t*  sbbFlags;
@@ -841,7 +812,7 @@ namespace DQIntern
       }
     }
 
-    inline void update(const ScanInfo &scanInfo, const State *prevState, State &currState);
+    inline void update( const ScanInfo &scanInfo, const StateMem *prevStates, const int prevId, StateMem &currStates, const int stateId, const int regBinLimit );
 
   private:
     const NbInfoOut*            m_nbInfo;
@@ -852,14 +823,7 @@ namespace DQIntern
     uint8_t                     m_memory[ 8 * ( MAX_TB_SIZEY * MAX_TB_SIZEY + MLS_GRP_NUM ) ];
   };
 
-#if JVET_V0106_DEP_QUANT_ENC_OPT
-#define RICEMAX 64
-#define RICE_ORDER_MAX 16
   const int32_t g_goRiceBits[RICE_ORDER_MAX][RICEMAX] =
-#else
-#define RICEMAX 32
-  const int32_t g_goRiceBits[4][RICEMAX] =
-#endif
   {
 #if JVET_V0106_DEP_QUANT_ENC_OPT
     { 32768, 65536, 98304, 131072, 163840, 196608, 262144, 262144, 327680, 327680, 327680, 327680, 393216, 393216, 393216, 393216, 393216, 393216, 393216, 393216, 458752, 458752, 458752, 458752, 458752, 458752, 458752, 458752, 458752, 458752, 458752, 458752, 458752, 458752, 458752, 458752, 524288, 524288, 524288, 524288, 524288, 524288, 524288, 524288, 524288, 524288, 524288, 524288, 524288, 524288, 524288, 524288, 524288, 524288, 524288, 524288, 524288, 524288, 524288, 524288, 524288, 524288, 524288, 524288 },
@@ -886,169 +850,96 @@ namespace DQIntern
 #endif
   };
 
-  class State
+  static inline int32_t levelRate( const int32_t* coeffBits, const int stride, const int32_t* goRiceTab, const TCoeff absLevel )
   {
-    friend class CommonCtx;
-  public:
-    State( const RateEstimator& rateEst, CommonCtx& commonCtx, const int stateId );
-
-    template<uint8_t numIPos>
-    inline void updateState(const ScanInfo &scanInfo, const State *prevStates, const Decision &decision, const int baseLevel, const bool extRiceFlag);
-    inline void updateStateEOS(const ScanInfo &scanInfo, const State *prevStates, const State *skipStates,
-                               const Decision &decision);
-
-    inline void init()
+    if( absLevel < 4 )
     {
-      m_rdCost        = std::numeric_limits<int64_t>::max()>>1;
-      m_numSigSbb     = 0;
-      m_remRegBins    = 4;  // just large enough for last scan pos
-      m_refSbbCtxId   = -1;
-      m_sigFracBits   = m_sigFracBitsArray[ 0 ];
-      m_coeffFracBits = m_gtxFracBitsArray[ 0 ];
-      m_goRicePar     = 0;
-      m_goRiceZero    = 0;
+      return coeffBits[absLevel * stride];
     }
-    void checkRdCosts( const ScanPosType spt, const PQData& pqDataA, const PQData& pqDataB, Decision& decisionA, Decision& decisionB ) const
+    const TCoeff value = ( absLevel - 4 ) >> 1;
+    return coeffBits[( absLevel - ( value << 1 ) ) * stride] + goRiceTab[value < RICEMAX ? value : RICEMAX - 1];
+  }
+
+  static void decideRdCosts( const StateMem& prevStates, const StateMem& skipStates, const PQData* pqData, const ScanPosType spt,
+                             const int32_t* startBits, const int32_t lastOffset, Decision* decisions )
+  {
+    // states 0 and 1 test the quantization indices 0 and 2, states 2 and 3 the indices 3 and 1
+    int64_t rdCostA[4], rdCostB[4], rdCostZ[4];
+    for( int s = 0; s < 4; s++ )
     {
-      const int32_t*  goRiceTab = g_goRiceBits[m_goRicePar];
-      int64_t         rdCostA   = m_rdCost + pqDataA.deltaDist;
-      int64_t         rdCostB   = m_rdCost + pqDataB.deltaDist;
-      int64_t         rdCostZ   = m_rdCost;
-      if (m_remRegBins >= 4)
+      const PQData&  pqDataA   = pqData[s < 2 ? 0 : 3];
+      const PQData&  pqDataB   = pqData[s < 2 ? 2 : 1];
+      const int32_t* goRiceTab = g_goRiceBits[prevStates.goRicePar[s]];
+      rdCostA[s]               = prevStates.rdCost[s] + pqDataA.deltaDist;
+      rdCostB[s]               = prevStates.rdCost[s] + pqDataB.deltaDist;
+      rdCostZ[s]               = prevStates.rdCost[s];
+      if( prevStates.remRegBins[s] >= 4 )
       {
-        if (pqDataA.absLevel < 4)
+        const int32_t sbbBits = ( spt == SCAN_SOCSBB ? prevStates.sbbBits[1][s] : 0 );
+        rdCostA[s] += levelRate( &prevStates.coeffBits[0][s], 4, goRiceTab, pqDataA.absLevel );
+        rdCostB[s] += levelRate( &prevStates.coeffBits[0][s], 4, goRiceTab, pqDataB.absLevel );
+        if( spt != SCAN_EOCSBB || prevStates.numSigSbb[s] )
         {
-          rdCostA += m_coeffFracBits.bits[pqDataA.absLevel];
+          rdCostA[s] += sbbBits + prevStates.sigBits[1][s];
+          rdCostB[s] += sbbBits + prevStates.sigBits[1][s];
+          rdCostZ[s] += sbbBits + prevStates.sigBits[0][s];
         }
         else
         {
-          const TCoeff value = (pqDataA.absLevel - 4) >> 1;
-          rdCostA +=
-            m_coeffFracBits.bits[pqDataA.absLevel - (value << 1)] + goRiceTab[value < RICEMAX ? value : RICEMAX - 1];
-        }
-        if (pqDataB.absLevel < 4)
-        {
-          rdCostB += m_coeffFracBits.bits[pqDataB.absLevel];
-        }
-        else
-        {
-          const TCoeff value = (pqDataB.absLevel - 4) >> 1;
-          rdCostB +=
-            m_coeffFracBits.bits[pqDataB.absLevel - (value << 1)] + goRiceTab[value < RICEMAX ? value : RICEMAX - 1];
-        }
-        if (spt == SCAN_ISCSBB)
-        {
-          rdCostA += m_sigFracBits.intBits[1];
-          rdCostB += m_sigFracBits.intBits[1];
-          rdCostZ += m_sigFracBits.intBits[0];
-        }
-        else if (spt == SCAN_SOCSBB)
-        {
-          rdCostA += m_sbbFracBits.intBits[1] + m_sigFracBits.intBits[1];
-          rdCostB += m_sbbFracBits.intBits[1] + m_sigFracBits.intBits[1];
-          rdCostZ += m_sbbFracBits.intBits[1] + m_sigFracBits.intBits[0];
-        }
-        else if (m_numSigSbb)
-        {
-          rdCostA += m_sigFracBits.intBits[1];
-          rdCostB += m_sigFracBits.intBits[1];
-          rdCostZ += m_sigFracBits.intBits[0];
-        }
-        else
-        {
-          rdCostZ = decisionA.rdCost;
+          rdCostZ[s]  = std::numeric_limits<int64_t>::max();
         }
       }
       else
       {
-        rdCostA +=
-          (1 << SCALE_BITS)
-          + goRiceTab[pqDataA.absLevel <= m_goRiceZero ? pqDataA.absLevel - 1
-                                                       : (pqDataA.absLevel < RICEMAX ? pqDataA.absLevel : RICEMAX - 1)];
-        rdCostB +=
-          (1 << SCALE_BITS)
-          + goRiceTab[pqDataB.absLevel <= m_goRiceZero ? pqDataB.absLevel - 1
-                                                       : (pqDataB.absLevel < RICEMAX ? pqDataB.absLevel : RICEMAX - 1)];
-        rdCostZ += goRiceTab[m_goRiceZero];
-      }
-      if (rdCostA < decisionA.rdCost)
-      {
-        decisionA.rdCost   = rdCostA;
-        decisionA.absLevel = pqDataA.absLevel;
-        decisionA.prevId   = m_stateId;
-      }
-      if (rdCostZ < decisionA.rdCost)
-      {
-        decisionA.rdCost   = rdCostZ;
-        decisionA.absLevel = 0;
-        decisionA.prevId   = m_stateId;
-      }
-      if (rdCostB < decisionB.rdCost)
-      {
-        decisionB.rdCost   = rdCostB;
-        decisionB.absLevel = pqDataB.absLevel;
-        decisionB.prevId   = m_stateId;
+        const TCoeff goRiceZero = prevStates.goRiceZero[s];
+        rdCostA[s] += ( 1 << SCALE_BITS ) + goRiceTab[pqDataA.absLevel <= goRiceZero ? pqDataA.absLevel - 1 : ( pqDataA.absLevel < RICEMAX ? pqDataA.absLevel : RICEMAX - 1 )];
+        rdCostB[s] += ( 1 << SCALE_BITS ) + goRiceTab[pqDataB.absLevel <= goRiceZero ? pqDataB.absLevel - 1 : ( pqDataB.absLevel < RICEMAX ? pqDataB.absLevel : RICEMAX - 1 )];
+        rdCostZ[s] += goRiceTab[goRiceZero];
       }
     }
 
-    inline void checkRdCostStart(int32_t lastOffset, const PQData &pqData, Decision &decision) const
+    // the candidates of the decisions 0..3 in the order of the state transitions, strict comparison keeps the first minimum
+    const int64_t candCost [3][4] = { { rdCostA[0], rdCostA[2], rdCostB[0], rdCostB[2] },
+                                      { rdCostZ[0], rdCostZ[2], rdCostA[1], rdCostA[3] },
+                                      { rdCostB[1], rdCostB[3], rdCostZ[1], rdCostZ[3] } };
+    const TCoeff  candLevel[3][4] = { { pqData[0].absLevel, pqData[3].absLevel, pqData[2].absLevel, pqData[1].absLevel },
+                                      { 0, 0, pqData[0].absLevel, pqData[3].absLevel },
+                                      { pqData[2].absLevel, pqData[1].absLevel, 0, 0 } };
+    static const int candPrevId[3][4] = { { 0, 2, 0, 2 }, { 0, 2, 1, 3 }, { 1, 3, 1, 3 } };
+    for( int d = 0; d < 4; d++ )
     {
-      int64_t rdCost = pqData.deltaDist + lastOffset;
-      if (pqData.absLevel < 4)
-      {
-        rdCost += m_coeffFracBits.bits[pqData.absLevel];
-      }
-      else
+      Decision& decision = decisions[d];
+      for( int k = 0; k < 3; k++ )
       {
-        const TCoeff value = (pqData.absLevel - 4) >> 1;
-        rdCost += m_coeffFracBits.bits[pqData.absLevel - (value << 1)] + g_goRiceBits[m_goRicePar][value < RICEMAX ? value : RICEMAX-1];
+        if( candCost[k][d] < decision.rdCost )
+        {
+          decision.rdCost   = candCost  [k][d];
+          decision.absLevel = candLevel [k][d];
+          decision.prevId   = candPrevId[k][d];
+        }
       }
-      if( rdCost < decision.rdCost )
+      if( spt == SCAN_EOCSBB )
       {
-        decision.rdCost   = rdCost;
-        decision.absLevel = pqData.absLevel;
-        decision.prevId   = -1;
+        const int64_t rdCost = skipStates.rdCost[d] + skipStates.sbbBits[0][d];
+        if( rdCost < decision.rdCost )
+        {
+          decision.rdCost   = rdCost;
+          decision.absLevel = 0;
+          decision.prevId   = 4 + d;
+        }
       }
-    }
-
-    inline void checkRdCostSkipSbb(Decision &decision) const
-    {
-      int64_t rdCost = m_rdCost + m_sbbFracBits.intBits[0];
-      if( rdCost < decision.rdCost )
+      if( !( d & 1 ) )
       {
-        decision.rdCost   = rdCost;
-        decision.absLevel = 0;
-        decision.prevId   = 4+m_stateId;
+        const int64_t rdCost = pqData[d].deltaDist + lastOffset + levelRate( startBits, 1, g_goRiceBits[0], pqData[d].absLevel );
+        if( rdCost < decision.rdCost )
+        {
+          decision.rdCost   = rdCost;
+          decision.absLevel = pqData[d].absLevel;
+          decision.prevId   = -1;
+        }
       }
     }
-
-    inline void checkRdCostSkipSbbZeroOut(Decision &decision) const
-    {
-      int64_t rdCost = m_rdCost + m_sbbFracBits.intBits[0];
-      decision.rdCost = rdCost;
-      decision.absLevel = 0;
-      decision.prevId = 4 + m_stateId;
-    }
-
-  private:
-    int64_t                   m_rdCost;
-    uint16_t                  m_absLevelsAndCtxInit[24];  // 16x8bit for abs levels + 16x16bit for ctx init id
-    int8_t                    m_numSigSbb;
-    int                       m_remRegBins;
-    int8_t                    m_refSbbCtxId;
-    BinFracBits               m_sbbFracBits;
-    BinFracBits               m_sigFracBits;
-    CoeffFracBits             m_coeffFracBits;
-    int8_t                    m_goRicePar;
-    int8_t                    m_goRiceZero;
-    const int8_t              m_stateId;
-    const BinFracBits*const   m_sigFracBitsArray;
-    const CoeffFracBits*const m_gtxFracBitsArray;
-    CommonCtx&                m_commonCtx;
-  public:
-    unsigned                  effWidth;
-    unsigned                  effHeight;
-  };
+  }
 
   unsigned templateAbsCompare(TCoeff sum)
   {
@@ -1076,50 +967,188 @@ namespace DQIntern
     return g_riceShift[rangeIdx];
   }
 
-  State::State( const RateEstimator& rateEst, CommonCtx& commonCtx, const int stateId )
-    : m_sbbFracBits     { { 0, 0 } }
-    , m_stateId         ( stateId )
-    , m_sigFracBitsArray( rateEst.sigFlagBits(stateId) )
-    , m_gtxFracBitsArray( rateEst.gtxFracBits(stateId) )
-    , m_commonCtx       ( commonCtx )
+  inline void CommonCtx::update( const ScanInfo &scanInfo, const StateMem *prevStates, const int prevId, StateMem &currStates, const int stateId, const int regBinLimit )
   {
+    uint8_t*    sbbFlags  = m_currSbbCtx[ stateId ].sbbFlags;
+    uint8_t*    levels    = m_currSbbCtx[ stateId ].levels;
+    std::size_t setCpSize = m_nbInfo[ scanInfo.scanIdx - 1 ].maxDist * sizeof(uint8_t);
+    if( prevStates && prevStates->refSbbCtxId[prevId] >= 0 )
+    {
+      ::memcpy( sbbFlags,                  m_prevSbbCtx[prevStates->refSbbCtxId[prevId]].sbbFlags,                  scanInfo.numSbb*sizeof(uint8_t) );
+      ::memcpy( levels + scanInfo.scanIdx, m_prevSbbCtx[prevStates->refSbbCtxId[prevId]].levels + scanInfo.scanIdx, setCpSize );
+    }
+    else
+    {
+      ::memset( sbbFlags,                  0, scanInfo.numSbb*sizeof(uint8_t) );
+      ::memset( levels + scanInfo.scanIdx, 0, setCpSize );
+    }
+    sbbFlags[ scanInfo.sbbPos ] = !!currStates.numSigSbb[stateId];
+    ::memcpy( levels + scanInfo.scanIdx, currStates.absLevelsAndCtxInit[stateId], scanInfo.sbbSize*sizeof(uint8_t) );
+
+    const int       sigNSbb   = ( ( scanInfo.nextSbbRight ? sbbFlags[ scanInfo.nextSbbRight ] : false ) || ( scanInfo.nextSbbBelow ? sbbFlags[ scanInfo.nextSbbBelow ] : false ) ? 1 : 0 );
+    currStates.numSigSbb  [stateId] = 0;
+    currStates.remRegBins [stateId] = ( prevStates ? prevStates->remRegBins[prevId] : regBinLimit );
+    currStates.goRicePar  [stateId] = 0;
+    currStates.refSbbCtxId[stateId] = stateId;
+    currStates.sbbBits [0][stateId] = m_sbbFlagBits[ sigNSbb ].intBits[0];
+    currStates.sbbBits [1][stateId] = m_sbbFlagBits[ sigNSbb ].intBits[1];
+
+    uint16_t          templateCtxInit[16];
+    const int         scanBeg   = scanInfo.scanIdx - scanInfo.sbbSize;
+    const NbInfoOut*  nbOut     = m_nbInfo + scanBeg;
+    const uint8_t*    absLevels = levels   + scanBeg;
+    for( int id = 0; id < scanInfo.sbbSize; id++, nbOut++ )
+    {
+      if( nbOut->num )
+      {
+        TCoeff sumAbs = 0, sumAbs1 = 0, sumNum = 0;
+#define UPDATE(k) {TCoeff t=absLevels[nbOut->outPos[k]]; sumAbs+=t; sumAbs1+=std::min<TCoeff>(4+(t&1),t); sumNum+=!!t; }
+        UPDATE(0);
+        if( nbOut->num > 1 )
+        {
+          UPDATE(1);
+          if( nbOut->num > 2 )
+          {
+            UPDATE(2);
+            if( nbOut->num > 3 )
+            {
+              UPDATE(3);
+              if( nbOut->num > 4 )
+              {
+                UPDATE(4);
+              }
+            }
+          }
+        }
+#undef UPDATE
+        templateCtxInit[id] = uint16_t(sumNum) + ( uint16_t(sumAbs1) << 3 ) + ( (uint16_t)std::min<TCoeff>( 127, sumAbs ) << 8 );
+      }
+      else
+      {
+        templateCtxInit[id] = 0;
+      }
+    }
+    ::memset( currStates.absLevelsAndCtxInit[stateId],     0,               16*sizeof(uint8_t) );
+    ::memcpy( currStates.absLevelsAndCtxInit[stateId] + 8, templateCtxInit, 16*sizeof(uint16_t) );
+  }
+
+
+
+  /*================================================================================*/
+  /*=====                                                                      =====*/
+  /*=====   T C Q                                                              =====*/
+  /*=====                                                                      =====*/
+  /*================================================================================*/
+  class DepQuant : private RateEstimator
+  {
+  public:
+    DepQuant( DecideRdCostsFunc* decideRdCosts );
+
+    void    quant   ( TransformUnit& tu, const CCoeffBuf& srcCoeff, const ComponentID compID, const QpParam& cQP, const double lambda, const Ctx& ctx, TCoeff& absSum, bool enableScalingLists, int* quantCoeff );
+    void    dequant ( const TransformUnit& tu, CoeffBuf& recCoeff, const ComponentID compID, const QpParam& cQP, bool enableScalingLists, int* quantCoeff );
+
+    int m_baseLevel;
+    bool m_extRiceRRCFlag;
+
+  private:
+    void    xDecideAndUpdate  ( const TCoeff absCoeff, const ScanInfo &scanInfo, bool zeroOut, TCoeff quantCoeff );
+    void    xDecide           ( const ScanPosType spt, const TCoeff absCoeff, const int lastOffset, Decision* decisions, bool zeroOut, TCoeff quantCoeff );
+    void    xInitStates       ( StateMem& states );
+    inline void xSetRateBits  ( StateMem& states, const int stateId, const BinFracBits& sigBits, const CoeffFracBits& coeffBits );
+    template<uint8_t numIPos>
+    inline void xUpdateState   ( const ScanInfo &scanInfo, const int stateId, const Decision &decision );
+    inline void xUpdateStateEOS( const ScanInfo &scanInfo, const int stateId, const Decision &decision );
+
+  private:
+    CommonCtx           m_commonCtx;
+    StateMem            m_allStates[ 3 ];
+    StateMem*           m_currStates;
+    StateMem*           m_prevStates;
+    StateMem*           m_skipStates;
+    int                 m_regBinLimit;
+    DecideRdCostsFunc*  m_decideRdCosts;
+    Quantizer           m_quant;
+    int32_t             m_lastOffset[ MAX_TB_SIZEY * MAX_TB_SIZEY ];
+    Decision            m_trellis[ MAX_TB_SIZEY * MAX_TB_SIZEY ][ 8 ];
+  };
+
+
+  DepQuant::DepQuant( DecideRdCostsFunc* decideRdCosts )
+    : RateEstimator   ()
+    , m_commonCtx     ()
+    , m_currStates    (  m_allStates      )
+    , m_prevStates    (  m_currStates + 1 )
+    , m_skipStates    (  m_prevStates + 1 )
+    , m_decideRdCosts ( decideRdCosts )
+  {
+    ::memset( m_allStates, 0, sizeof( m_allStates ) );
+  }
+
+
+  inline void DepQuant::xSetRateBits( StateMem& states, const int stateId, const BinFracBits& sigBits, const CoeffFracBits& coeffBits )
+  {
+    states.sigBits[0][stateId] = sigBits.intBits[0];
+    states.sigBits[1][stateId] = sigBits.intBits[1];
+    for( int k = 0; k < 6; k++ )
+    {
+      states.coeffBits[k][stateId] = coeffBits.bits[k];
+    }
+  }
+
+  void DepQuant::xInitStates( StateMem& states )
+  {
+    for( int stateId = 0; stateId < 4; stateId++ )
+    {
+      states.rdCost     [stateId] = std::numeric_limits<int64_t>::max()>>1;
+      states.numSigSbb  [stateId] = 0;
+      states.remRegBins [stateId] = 4;  // just large enough for last scan pos
+      states.refSbbCtxId[stateId] = -1;
+      states.goRicePar  [stateId] = 0;
+      states.goRiceZero [stateId] = 0;
+      xSetRateBits( states, stateId, sigFlagBits(stateId)[0], gtxFracBits(stateId)[0] );
+    }
   }
 
   template<uint8_t numIPos>
-  inline void State::updateState(const ScanInfo &scanInfo, const State *prevStates, const Decision &decision, const int baseLevel, const bool extRiceFlag)
+  inline void DepQuant::xUpdateState( const ScanInfo &scanInfo, const int stateId, const Decision &decision )
   {
-    m_rdCost = decision.rdCost;
+    const StateMem& prevStates  = *m_prevStates;
+    StateMem&       currStates  = *m_currStates;
+    const int       baseLevel   = m_baseLevel;
+    const bool      extRiceFlag = m_extRiceRRCFlag;
+    currStates.rdCost[stateId]  = decision.rdCost;
     if( decision.prevId > -2 )
     {
       if( decision.prevId >= 0 )
       {
-        const State*  prvState  = prevStates            +   decision.prevId;
-        m_numSigSbb             = prvState->m_numSigSbb + !!decision.absLevel;
-        m_refSbbCtxId           = prvState->m_refSbbCtxId;
-        m_sbbFracBits           = prvState->m_sbbFracBits;
-        m_remRegBins            = prvState->m_remRegBins - 1;
-        m_goRicePar             = prvState->m_goRicePar;
-        if( m_remRegBins >= 4 )
+        const int prevId                = decision.prevId;
+        currStates.numSigSbb  [stateId] = prevStates.numSigSbb[prevId] + !!decision.absLevel;
+        currStates.refSbbCtxId[stateId] = prevStates.refSbbCtxId[prevId];
+        currStates.sbbBits [0][stateId] = prevStates.sbbBits[0][prevId];
+        currStates.sbbBits [1][stateId] = prevStates.sbbBits[1][prevId];
+        currStates.remRegBins [stateId] = prevStates.remRegBins[prevId] - 1;
+        currStates.goRicePar  [stateId] = prevStates.goRicePar[prevId];
+        if( currStates.remRegBins[stateId] >= 4 )
         {
-          m_remRegBins -= (decision.absLevel < 2 ? (unsigned)decision.absLevel : 3);
+          currStates.remRegBins[stateId] -= (decision.absLevel < 2 ? (unsigned)decision.absLevel : 3);
         }
-        ::memcpy( m_absLevelsAndCtxInit, prvState->m_absLevelsAndCtxInit, 48*sizeof(uint8_t) );
+        ::memcpy( currStates.absLevelsAndCtxInit[stateId], prevStates.absLevelsAndCtxInit[prevId], 48*sizeof(uint8_t) );
       }
       else
       {
-        m_numSigSbb     =  1;
-        m_refSbbCtxId   = -1;
-        int ctxBinSampleRatio = (scanInfo.chType == CHANNEL_TYPE_LUMA) ? MAX_TU_LEVEL_CTX_CODED_BIN_CONSTRAINT_LUMA : MAX_TU_LEVEL_CTX_CODED_BIN_CONSTRAINT_CHROMA;
-        m_remRegBins = (effWidth * effHeight *ctxBinSampleRatio) / 16 - (decision.absLevel < 2 ? (unsigned)decision.absLevel : 3);
-        ::memset( m_absLevelsAndCtxInit, 0, 48*sizeof(uint8_t) );
+        currStates.numSigSbb  [stateId] =  1;
+        currStates.refSbbCtxId[stateId] = -1;
+        currStates.remRegBins [stateId] = m_regBinLimit - (decision.absLevel < 2 ? (unsigned)decision.absLevel : 3);
+        ::memset( currStates.absLevelsAndCtxInit[stateId], 0, 48*sizeof(uint8_t) );
       }
 
-      uint8_t* levels               = reinterpret_cast<uint8_t*>(m_absLevelsAndCtxInit);
+      uint16_t* absLevelsAndCtxInit = currStates.absLevelsAndCtxInit[stateId];
+      uint8_t*  levels              = reinterpret_cast<uint8_t*>(absLevelsAndCtxInit);
       levels[ scanInfo.insidePos ]  = (uint8_t)std::min<TCoeff>( 255, decision.absLevel );
 
-      if (m_remRegBins >= 4)
+      if (currStates.remRegBins[stateId] >= 4)
       {
-        TCoeff  tinit = m_absLevelsAndCtxInit[8 + scanInfo.nextInsidePos];
+        TCoeff  tinit = absLevelsAndCtxInit[8 + scanInfo.nextInsidePos];
         TCoeff  sumAbs1 = (tinit >> 3) & 31;
         TCoeff  sumNum = tinit & 7;
 #define UPDATE(k) {TCoeff t=levels[scanInfo.nextNbInfoSbb.inPos[k]]; sumAbs1+=std::min<TCoeff>(4+(t&1),t); sumNum+=!!t; }
@@ -1155,10 +1184,10 @@ namespace DQIntern
         }
 #undef UPDATE
         TCoeff sumGt1 = sumAbs1 - sumNum;
-        m_sigFracBits = m_sigFracBitsArray[scanInfo.sigCtxOffsetNext + std::min<TCoeff>( (sumAbs1+1)>>1, 3 )];
-        m_coeffFracBits = m_gtxFracBitsArray[scanInfo.gtxCtxOffsetNext + (sumGt1 < 4 ? sumGt1 : 4)];
+        xSetRateBits( currStates, stateId, sigFlagBits(stateId)[scanInfo.sigCtxOffsetNext + std::min<TCoeff>( (sumAbs1+1)>>1, 3 )],
+                      gtxFracBits(stateId)[scanInfo.gtxCtxOffsetNext + (sumGt1 < 4 ? sumGt1 : 4)] );
 
-        TCoeff  sumAbs = m_absLevelsAndCtxInit[8 + scanInfo.nextInsidePos] >> 8;
+        TCoeff  sumAbs = absLevelsAndCtxInit[8 + scanInfo.nextInsidePos] >> 8;
 #define UPDATE(k) {TCoeff t=levels[scanInfo.nextNbInfoSbb.inPos[k]]; sumAbs+=t; }
         if (numIPos == 1)
         {
@@ -1196,18 +1225,18 @@ namespace DQIntern
           unsigned currentShift = templateAbsCompare(sumAbs);
           sumAbs = sumAbs >> currentShift;
           int sumAll = std::max(std::min(31, (int)sumAbs - (int)baseLevel), 0);
-          m_goRicePar = g_goRiceParsCoeff[sumAll];
-          m_goRicePar += currentShift;
+          currStates.goRicePar[stateId] = g_goRiceParsCoeff[sumAll];
+          currStates.goRicePar[stateId] += currentShift;
         }
         else
         {
           int sumAll = std::max(std::min(31, (int)sumAbs - 4 * 5), 0);
-          m_goRicePar = g_goRiceParsCoeff[sumAll];
+          currStates.goRicePar[stateId] = g_goRiceParsCoeff[sumAll];
         }
       }
       else
       {
-        TCoeff  sumAbs = m_absLevelsAndCtxInit[8 + scanInfo.nextInsidePos] >> 8;
+        TCoeff  sumAbs = absLevelsAndCtxInit[8 + scanInfo.nextInsidePos] >> 8;
 #define UPDATE(k) {TCoeff t=levels[scanInfo.nextNbInfoSbb.inPos[k]]; sumAbs+=t; }
         if (numIPos == 1)
         {
@@ -1245,176 +1274,60 @@ namespace DQIntern
           unsigned currentShift = templateAbsCompare(sumAbs);
           sumAbs = sumAbs >> currentShift;
           sumAbs = std::min<TCoeff>(31, sumAbs);
-          m_goRicePar = g_goRiceParsCoeff[sumAbs];
-          m_goRicePar += currentShift;
+          currStates.goRicePar[stateId] = g_goRiceParsCoeff[sumAbs];
+          currStates.goRicePar[stateId] += currentShift;
         }
         else
         {
           sumAbs = std::min<TCoeff>(31, sumAbs);
-          m_goRicePar = g_goRiceParsCoeff[sumAbs];
+          currStates.goRicePar[stateId] = g_goRiceParsCoeff[sumAbs];
         }
-        m_goRiceZero = g_goRicePosCoeff0(m_stateId, m_goRicePar);
+        currStates.goRiceZero[stateId] = int8_t( g_goRicePosCoeff0(stateId, currStates.goRicePar[stateId]) );
       }
     }
   }
 
-  inline void State::updateStateEOS(const ScanInfo &scanInfo, const State *prevStates, const State *skipStates,
-                                    const Decision &decision)
+  inline void DepQuant::xUpdateStateEOS( const ScanInfo &scanInfo, const int stateId, const Decision &decision )
   {
-    m_rdCost = decision.rdCost;
+    StateMem& currStates        = *m_currStates;
+    currStates.rdCost[stateId]  = decision.rdCost;
     if( decision.prevId > -2 )
     {
-      const State* prvState = 0;
-      if( decision.prevId  >= 4 )
+      const StateMem* prvStates = 0;
+      int             prevId    = decision.prevId;
+      if( prevId >= 4 )
       {
         CHECK( decision.absLevel != 0, "cannot happen" );
-        prvState    = skipStates + ( decision.prevId - 4 );
-        m_numSigSbb = 0;
-        ::memset( m_absLevelsAndCtxInit, 0, 16*sizeof(uint8_t) );
+        prvStates                     = m_skipStates;
+        prevId                       -= 4;
+        currStates.numSigSbb[stateId] = 0;
+        ::memset( currStates.absLevelsAndCtxInit[stateId], 0, 16*sizeof(uint8_t) );
       }
-      else if( decision.prevId  >= 0 )
+      else if( prevId >= 0 )
       {
-        prvState    = prevStates            +   decision.prevId;
-        m_numSigSbb = prvState->m_numSigSbb + !!decision.absLevel;
-        ::memcpy( m_absLevelsAndCtxInit, prvState->m_absLevelsAndCtxInit, 16*sizeof(uint8_t) );
+        prvStates                     = m_prevStates;
+        currStates.numSigSbb[stateId] = prvStates->numSigSbb[prevId] + !!decision.absLevel;
+        ::memcpy( currStates.absLevelsAndCtxInit[stateId], prvStates->absLevelsAndCtxInit[prevId], 16*sizeof(uint8_t) );
       }
       else
       {
-        m_numSigSbb = 1;
-        ::memset( m_absLevelsAndCtxInit, 0, 16*sizeof(uint8_t) );
+        currStates.numSigSbb[stateId] = 1;
+        ::memset( currStates.absLevelsAndCtxInit[stateId], 0, 16*sizeof(uint8_t) );
       }
-      reinterpret_cast<uint8_t*>(m_absLevelsAndCtxInit)[ scanInfo.insidePos ] = (uint8_t)std::min<TCoeff>( 255, decision.absLevel );
+      reinterpret_cast<uint8_t*>(currStates.absLevelsAndCtxInit[stateId])[ scanInfo.insidePos ] = (uint8_t)std::min<TCoeff>( 255, decision.absLevel );
 
-      m_commonCtx.update( scanInfo, prvState, *this );
+      m_commonCtx.update( scanInfo, prvStates, prevId, currStates, stateId, m_regBinLimit );
 
-      TCoeff  tinit   = m_absLevelsAndCtxInit[ 8 + scanInfo.nextInsidePos ];
+      TCoeff  tinit   = currStates.absLevelsAndCtxInit[stateId][ 8 + scanInfo.nextInsidePos ];
       TCoeff  sumNum  =   tinit        & 7;
       TCoeff  sumAbs1 = ( tinit >> 3 ) & 31;
       TCoeff  sumGt1  = sumAbs1        - sumNum;
-      m_sigFracBits   = m_sigFracBitsArray[ scanInfo.sigCtxOffsetNext + std::min<TCoeff>( (sumAbs1+1)>>1, 3 ) ];
-      m_coeffFracBits = m_gtxFracBitsArray[ scanInfo.gtxCtxOffsetNext + ( sumGt1  < 4 ? sumGt1  : 4 ) ];
-    }
-  }
-
-  inline void CommonCtx::update(const ScanInfo &scanInfo, const State *prevState, State &currState)
-  {
-    uint8_t*    sbbFlags  = m_currSbbCtx[ currState.m_stateId ].sbbFlags;
-    uint8_t*    levels    = m_currSbbCtx[ currState.m_stateId ].levels;
-    std::size_t setCpSize = m_nbInfo[ scanInfo.scanIdx - 1 ].maxDist * sizeof(uint8_t);
-    if( prevState && prevState->m_refSbbCtxId >= 0 )
-    {
-      ::memcpy( sbbFlags,                  m_prevSbbCtx[prevState->m_refSbbCtxId].sbbFlags,                  scanInfo.numSbb*sizeof(uint8_t) );
-      ::memcpy( levels + scanInfo.scanIdx, m_prevSbbCtx[prevState->m_refSbbCtxId].levels + scanInfo.scanIdx, setCpSize );
-    }
-    else
-    {
-      ::memset( sbbFlags,                  0, scanInfo.numSbb*sizeof(uint8_t) );
-      ::memset( levels + scanInfo.scanIdx, 0, setCpSize );
-    }
-    sbbFlags[ scanInfo.sbbPos ] = !!currState.m_numSigSbb;
-    ::memcpy( levels + scanInfo.scanIdx, currState.m_absLevelsAndCtxInit, scanInfo.sbbSize*sizeof(uint8_t) );
-
-    const int       sigNSbb   = ( ( scanInfo.nextSbbRight ? sbbFlags[ scanInfo.nextSbbRight ] : false ) || ( scanInfo.nextSbbBelow ? sbbFlags[ scanInfo.nextSbbBelow ] : false ) ? 1 : 0 );
-    currState.m_numSigSbb     = 0;
-    if (prevState)
-    {
-      currState.m_remRegBins = prevState->m_remRegBins;
-    }
-    else
-    {
-      int ctxBinSampleRatio = (scanInfo.chType == CHANNEL_TYPE_LUMA) ? MAX_TU_LEVEL_CTX_CODED_BIN_CONSTRAINT_LUMA : MAX_TU_LEVEL_CTX_CODED_BIN_CONSTRAINT_CHROMA;
-      currState.m_remRegBins = (currState.effWidth * currState.effHeight *ctxBinSampleRatio) / 16;
-    }
-    currState.m_goRicePar     = 0;
-    currState.m_refSbbCtxId   = currState.m_stateId;
-    currState.m_sbbFracBits   = m_sbbFlagBits[ sigNSbb ];
-
-    uint16_t          templateCtxInit[16];
-    const int         scanBeg   = scanInfo.scanIdx - scanInfo.sbbSize;
-    const NbInfoOut*  nbOut     = m_nbInfo + scanBeg;
-    const uint8_t*    absLevels = levels   + scanBeg;
-    for( int id = 0; id < scanInfo.sbbSize; id++, nbOut++ )
-    {
-      if( nbOut->num )
-      {
-        TCoeff sumAbs = 0, sumAbs1 = 0, sumNum = 0;
-#define UPDATE(k) {TCoeff t=absLevels[nbOut->outPos[k]]; sumAbs+=t; sumAbs1+=std::min<TCoeff>(4+(t&1),t); sumNum+=!!t; }
-        UPDATE(0);
-        if( nbOut->num > 1 )
-        {
-          UPDATE(1);
-          if( nbOut->num > 2 )
-          {
-            UPDATE(2);
-            if( nbOut->num > 3 )
-            {
-              UPDATE(3);
-              if( nbOut->num > 4 )
-              {
-                UPDATE(4);
-              }
-            }
-          }
-        }
-#undef UPDATE
-        templateCtxInit[id] = uint16_t(sumNum) + ( uint16_t(sumAbs1) << 3 ) + ( (uint16_t)std::min<TCoeff>( 127, sumAbs ) << 8 );
-      }
-      else
-      {
-        templateCtxInit[id] = 0;
-      }
+      xSetRateBits( currStates, stateId, sigFlagBits(stateId)[ scanInfo.sigCtxOffsetNext + std::min<TCoeff>( (sumAbs1+1)>>1, 3 ) ],
+                    gtxFracBits(stateId)[ scanInfo.gtxCtxOffsetNext + ( sumGt1  < 4 ? sumGt1  : 4 ) ] );
     }
-    ::memset( currState.m_absLevelsAndCtxInit,     0,               16*sizeof(uint8_t) );
-    ::memcpy( currState.m_absLevelsAndCtxInit + 8, templateCtxInit, 16*sizeof(uint16_t) );
   }
 
 
-
-  /*================================================================================*/
-  /*=====                                                                      =====*/
-  /*=====   T C Q                                                              =====*/
-  /*=====                                                                      =====*/
-  /*================================================================================*/
-  class DepQuant : private RateEstimator
-  {
-  public:
-    DepQuant();
-
-    void    quant   ( TransformUnit& tu, const CCoeffBuf& srcCoeff, const ComponentID compID, const QpParam& cQP, const double lambda, const Ctx& ctx, TCoeff& absSum, bool enableScalingLists, int* quantCoeff );
-    void    dequant ( const TransformUnit& tu, CoeffBuf& recCoeff, const ComponentID compID, const QpParam& cQP, bool enableScalingLists, int* quantCoeff );
-
-    int m_baseLevel;
-    bool m_extRiceRRCFlag;
-
-  private:
-    void    xDecideAndUpdate  ( const TCoeff absCoeff, const ScanInfo &scanInfo, bool zeroOut, TCoeff quantCoeff, int effWidth, int effHeight, bool reverseLast );
-    void    xDecide           ( const ScanPosType spt, const TCoeff absCoeff, const int lastOffset, Decision* decisions, bool zeroOut, TCoeff quantCoeff );
-
-  private:
-    CommonCtx   m_commonCtx;
-    State       m_allStates[ 12 ];
-    State*      m_currStates;
-    State*      m_prevStates;
-    State*      m_skipStates;
-    State       m_startState;
-    Quantizer   m_quant;
-    Decision    m_trellis[ MAX_TB_SIZEY * MAX_TB_SIZEY ][ 8 ];
-  };
-
-
-#define TINIT(x) {*this,m_commonCtx,x}
-  DepQuant::DepQuant()
-    : RateEstimator ()
-    , m_commonCtx   ()
-    , m_allStates   {TINIT(0),TINIT(1),TINIT(2),TINIT(3),TINIT(0),TINIT(1),TINIT(2),TINIT(3),TINIT(0),TINIT(1),TINIT(2),TINIT(3)}
-    , m_currStates  (  m_allStates      )
-    , m_prevStates  (  m_currStates + 4 )
-    , m_skipStates  (  m_prevStates + 4 )
-    , m_startState  TINIT(0)
-  {}
-#undef TINIT
-
-
   void DepQuant::dequant( const TransformUnit& tu,  CoeffBuf& recCoeff, const ComponentID compID, const QpParam& cQP, bool enableScalingLists, int* piDequantCoef )
   {
     m_quant.dequantBlock( tu, compID, cQP, recCoeff, enableScalingLists, piDequantCoef );
@@ -1434,49 +1347,38 @@ namespace DQIntern
     {
       if( spt==SCAN_EOCSBB )
       {
-        m_skipStates[0].checkRdCostSkipSbbZeroOut( decisions[0] );
-        m_skipStates[1].checkRdCostSkipSbbZeroOut( decisions[1] );
-        m_skipStates[2].checkRdCostSkipSbbZeroOut( decisions[2] );
-        m_skipStates[3].checkRdCostSkipSbbZeroOut( decisions[3] );
+        for( int stateId = 0; stateId < 4; stateId++ )
+        {
+          decisions[stateId].rdCost   = m_skipStates->rdCost[stateId] + m_skipStates->sbbBits[0][stateId];
+          decisions[stateId].absLevel = 0;
+          decisions[stateId].prevId   = 4 + stateId;
+        }
       }
       return;
     }
 
     PQData  pqData[4];
     m_quant.preQuantCoeff( absCoeff, pqData, quanCoeff );
-    m_prevStates[0].checkRdCosts( spt, pqData[0], pqData[2], decisions[0], decisions[2]);
-    m_prevStates[1].checkRdCosts( spt, pqData[0], pqData[2], decisions[2], decisions[0]);
-    m_prevStates[2].checkRdCosts( spt, pqData[3], pqData[1], decisions[1], decisions[3]);
-    m_prevStates[3].checkRdCosts( spt, pqData[3], pqData[1], decisions[3], decisions[1]);
-    if( spt==SCAN_EOCSBB )
-    {
-      m_skipStates[0].checkRdCostSkipSbb(decisions[0]);
-      m_skipStates[1].checkRdCostSkipSbb(decisions[1]);
-      m_skipStates[2].checkRdCostSkipSbb(decisions[2]);
-      m_skipStates[3].checkRdCostSkipSbb(decisions[3]);
-    }
-
-    m_startState.checkRdCostStart( lastOffset, pqData[0], decisions[0] );
-    m_startState.checkRdCostStart( lastOffset, pqData[2], decisions[2] );
+    m_decideRdCosts( *m_prevStates, *m_skipStates, pqData, spt, gtxFracBits(0)[0].bits, lastOffset, decisions );
   }
 
-  void DepQuant::xDecideAndUpdate( const TCoeff absCoeff, const ScanInfo &scanInfo, bool zeroOut, TCoeff quantCoeff, int effWidth, int effHeight, bool reverseLast )
+  void DepQuant::xDecideAndUpdate( const TCoeff absCoeff, const ScanInfo &scanInfo, bool zeroOut, TCoeff quantCoeff )
   {
     Decision* decisions = m_trellis[ scanInfo.scanIdx ];
 
     std::swap( m_prevStates, m_currStates );
 
-    xDecide( scanInfo.spt, absCoeff, lastOffset(scanInfo.scanIdx, effWidth, effHeight, reverseLast), decisions, zeroOut, quantCoeff );
+    xDecide( scanInfo.spt, absCoeff, m_lastOffset[scanInfo.scanIdx], decisions, zeroOut, quantCoeff );
 
     if( scanInfo.scanIdx )
     {
       if( scanInfo.eosbb )
       {
         m_commonCtx.swap();
-        m_currStates[0].updateStateEOS( scanInfo, m_prevStates, m_skipStates, decisions[0] );
-        m_currStates[1].updateStateEOS( scanInfo, m_prevStates, m_skipStates, decisions[1] );
-        m_currStates[2].updateStateEOS( scanInfo, m_prevStates, m_skipStates, decisions[2] );
-        m_currStates[3].updateStateEOS( scanInfo, m_prevStates, m_skipStates, decisions[3] );
+        xUpdateStateEOS( scanInfo, 0, decisions[0] );
+        xUpdateStateEOS( scanInfo, 1, decisions[1] );
+        xUpdateStateEOS( scanInfo, 2, decisions[2] );
+        xUpdateStateEOS( scanInfo, 3, decisions[3] );
         ::memcpy( decisions+4, decisions, 4*sizeof(Decision) );
       }
       else if( !zeroOut )
@@ -1484,40 +1386,40 @@ namespace DQIntern
         switch( scanInfo.nextNbInfoSbb.num )
         {
         case 0:
-          m_currStates[0].updateState<0>(scanInfo, m_prevStates, decisions[0], m_baseLevel, m_extRiceRRCFlag);
-          m_currStates[1].updateState<0>(scanInfo, m_prevStates, decisions[1], m_baseLevel, m_extRiceRRCFlag);
-          m_currStates[2].updateState<0>(scanInfo, m_prevStates, decisions[2], m_baseLevel, m_extRiceRRCFlag);
-          m_currStates[3].updateState<0>(scanInfo, m_prevStates, decisions[3], m_baseLevel, m_extRiceRRCFlag);
+          xUpdateState<0>( scanInfo, 0, decisions[0] );
+          xUpdateState<0>( scanInfo, 1, decisions[1] );
+          xUpdateState<0>( scanInfo, 2, decisions[2] );
+          xUpdateState<0>( scanInfo, 3, decisions[3] );
           break;
         case 1:
-          m_currStates[0].updateState<1>(scanInfo, m_prevStates, decisions[0], m_baseLevel, m_extRiceRRCFlag);
-          m_currStates[1].updateState<1>(scanInfo, m_prevStates, decisions[1], m_baseLevel, m_extRiceRRCFlag);
-          m_currStates[2].updateState<1>(scanInfo, m_prevStates, decisions[2], m_baseLevel, m_extRiceRRCFlag);
-          m_currStates[3].updateState<1>(scanInfo, m_prevStates, decisions[3], m_baseLevel, m_extRiceRRCFlag);
+          xUpdateState<1>( scanInfo, 0, decisions[0] );
+          xUpdateState<1>( scanInfo, 1, decisions[1] );
+          xUpdateState<1>( scanInfo, 2, decisions[2] );
+          xUpdateState<1>( scanInfo, 3, decisions[3] );
           break;
         case 2:
-          m_currStates[0].updateState<2>(scanInfo, m_prevStates, decisions[0], m_baseLevel, m_extRiceRRCFlag);
-          m_currStates[1].updateState<2>(scanInfo, m_prevStates, decisions[1], m_baseLevel, m_extRiceRRCFlag);
-          m_currStates[2].updateState<2>(scanInfo, m_prevStates, decisions[2], m_baseLevel, m_extRiceRRCFlag);
-          m_currStates[3].updateState<2>(scanInfo, m_prevStates, decisions[3], m_baseLevel, m_extRiceRRCFlag);
+          xUpdateState<2>( scanInfo, 0, decisions[0] );
+          xUpdateState<2>( scanInfo, 1, decisions[1] );
+          xUpdateState<2>( scanInfo, 2, decisions[2] );
+          xUpdateState<2>( scanInfo, 3, decisions[3] );
           break;
         case 3:
-          m_currStates[0].updateState<3>(scanInfo, m_prevStates, decisions[0], m_baseLevel, m_extRiceRRCFlag);
-          m_currStates[1].updateState<3>(scanInfo, m_prevStates, decisions[1], m_baseLevel, m_extRiceRRCFlag);
-          m_currStates[2].updateState<3>(scanInfo, m_prevStates, decisions[2], m_baseLevel, m_extRiceRRCFlag);
-          m_currStates[3].updateState<3>(scanInfo, m_prevStates, decisions[3], m_baseLevel, m_extRiceRRCFlag);
+          xUpdateState<3>( scanInfo, 0, decisions[0] );
+          xUpdateState<3>( scanInfo, 1, decisions[1] );
+          xUpdateState<3>( scanInfo, 2, decisions[2] );
+          xUpdateState<3>( scanInfo, 3, decisions[3] );
           break;
         case 4:
-          m_currStates[0].updateState<4>(scanInfo, m_prevStates, decisions[0], m_baseLevel, m_extRiceRRCFlag);
-          m_currStates[1].updateState<4>(scanInfo, m_prevStates, decisions[1], m_baseLevel, m_extRiceRRCFlag);
-          m_currStates[2].updateState<4>(scanInfo, m_prevStates, decisions[2], m_baseLevel, m_extRiceRRCFlag);
-          m_currStates[3].updateState<4>(scanInfo, m_prevStates, decisions[3], m_baseLevel, m_extRiceRRCFlag);
+          xUpdateState<4>( scanInfo, 0, decisions[0] );
+          xUpdateState<4>( scanInfo, 1, decisions[1] );
+          xUpdateState<4>( scanInfo, 2, decisions[2] );
+          xUpdateState<4>( scanInfo, 3, decisions[3] );
           break;
         default:
-          m_currStates[0].updateState<5>(scanInfo, m_prevStates, decisions[0], m_baseLevel, m_extRiceRRCFlag);
-          m_currStates[1].updateState<5>(scanInfo, m_prevStates, decisions[1], m_baseLevel, m_extRiceRRCFlag);
-          m_currStates[2].updateState<5>(scanInfo, m_prevStates, decisions[2], m_baseLevel, m_extRiceRRCFlag);
-          m_currStates[3].updateState<5>(scanInfo, m_prevStates, decisions[3], m_baseLevel, m_extRiceRRCFlag);
+          xUpdateState<5>( scanInfo, 0, decisions[0] );
+          xUpdateState<5>( scanInfo, 1, decisions[1] );
+          xUpdateState<5>( scanInfo, 2, decisions[2] );
+          xUpdateState<5>( scanInfo, 3, decisions[3] );
         }
       }
 
@@ -1595,22 +1497,23 @@ namespace DQIntern
     //===== real init =====
     RateEstimator::initCtx( tuPars, tu, compID, ctx.getFracBitsAcess() );
     m_commonCtx.reset( tuPars, *this );
-    for( int k = 0; k < 12; k++ )
+    for( int k = 0; k < 3; k++ )
     {
-      m_allStates[k].init();
+      xInitStates( m_allStates[k] );
     }
-    m_startState.init();
 
 
     int effectWidth = std::min(32, effWidth);
     int effectHeight = std::min(32, effHeight);
-    for (int k = 0; k < 12; k++)
+    int ctxBinSampleRatio = (tuPars.m_chType == CHANNEL_TYPE_LUMA) ? MAX_TU_LEVEL_CTX_CODED_BIN_CONSTRAINT_LUMA : MAX_TU_LEVEL_CTX_CODED_BIN_CONSTRAINT_CHROMA;
+    m_regBinLimit = (effectWidth * effectHeight * ctxBinSampleRatio) / 16;
+
+    //===== last position rates of the tested scan positions =====
+    const bool reverseLast = tu.cu->slice->getReverseLastSigCoeffFlag();
+    for( int scanIdx = firstTestPos; scanIdx >= 0; scanIdx-- )
     {
-      m_allStates[k].effWidth = effectWidth;
-      m_allStates[k].effHeight = effectHeight;
+      m_lastOffset[scanIdx] = lastOffset( scanIdx, effectWidth, effectHeight, reverseLast );
     }
-    m_startState.effWidth = effectWidth;
-    m_startState.effHeight = effectHeight;
 
     //===== populate trellis =====
     for( int scanIdx = firstTestPos; scanIdx >= 0; scanIdx-- )
@@ -1619,11 +1522,11 @@ namespace DQIntern
       if (enableScalingLists)
       {
         m_quant.initQuantBlock(tu, compID, cQP, lambda, quantCoeff[scanInfo.rasterPos]);
-        xDecideAndUpdate( abs( tCoeff[scanInfo.rasterPos]), scanInfo, (zeroOut && (scanInfo.posX >= effWidth || scanInfo.posY >= effHeight)), quantCoeff[scanInfo.rasterPos], effectWidth, effectHeight, tu.cu->slice->getReverseLastSigCoeffFlag() );
+        xDecideAndUpdate( abs( tCoeff[scanInfo.rasterPos]), scanInfo, (zeroOut && (scanInfo.posX >= effWidth || scanInfo.posY >= effHeight)), quantCoeff[scanInfo.rasterPos] );
       }
       else
       {
-        xDecideAndUpdate( abs( tCoeff[scanInfo.rasterPos]), scanInfo, (zeroOut && (scanInfo.posX >= effWidth || scanInfo.posY >= effHeight)), defaultQuantisationCoefficient, effectWidth, effectHeight, tu.cu->slice->getReverseLastSigCoeffFlag() );
+        xDecideAndUpdate( abs( tCoeff[scanInfo.rasterPos]), scanInfo, (zeroOut && (scanInfo.posX >= effWidth || scanInfo.posY >= effHeight)), defaultQuantisationCoefficient );
       }
     }
 
@@ -1661,7 +1564,11 @@ DepQuant::DepQuant( const Quant* other, bool enc ) : QuantRDOQ( other )
 {
   const DepQuant* dq = dynamic_cast<const DepQuant*>( other );
   CHECK( other && !dq, "The DepQuant cast must be successfull!" );
-  p = new DQIntern::DepQuant();
+  m_decideRdCosts = DQIntern::decideRdCosts;
+#if ENABLE_SIMD_OPT_DEPQUANT && defined( TARGET_SIMD_X86 )
+  initDepQuantX86();
+#endif
+  p = new DQIntern::DepQuant( m_decideRdCosts );
   if( enc )
   {
     DQIntern::g_Rom.init();
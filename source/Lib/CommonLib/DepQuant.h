@@ -44,8 +44,54 @@
 #include "QuantRDOQ.h"
 
 
+#if JVET_V0106_DEP_QUANT_ENC_OPT
+#define RICEMAX 64
+#define RICE_ORDER_MAX 16
+#else
+#define RICEMAX 32
+#define RICE_ORDER_MAX 4
+#endif
 
 
+namespace DQIntern
+{
+  extern const int32_t g_goRiceBits[RICE_ORDER_MAX][RICEMAX];
+
+  enum ScanPosType { SCAN_ISCSBB = 0, SCAN_SOCSBB = 1, SCAN_EOCSBB = 2 };
+
+  struct PQData
+  {
+    TCoeff  absLevel;
+    int64_t deltaDist;
+  };
+
+  struct Decision
+  {
+    int64_t rdCost;
+    TCoeff  absLevel;
+    int     prevId;
+  };
+
+  // the four TCQ states of one trellis stage, stored as structure of arrays (index = state id)
+  struct StateMem
+  {
+    int64_t   rdCost             [4];
+    int32_t   sigBits         [2][4];   // significance flag bits for bin 0 and 1
+    int32_t   sbbBits         [2][4];   // coded sub-block flag bits for bin 0 and 1
+    int32_t   coeffBits       [6][4];   // level bits, see RateEstimator::xSetGtxFlagBits
+    int32_t   remRegBins         [4];
+    int32_t   goRicePar          [4];
+    int32_t   goRiceZero         [4];
+    int8_t    numSigSbb          [4];
+    int8_t    refSbbCtxId        [4];
+    uint16_t  absLevelsAndCtxInit[4][24];  // 16x8bit for abs levels + 16x16bit for ctx init id
+  };
+
+  // rd costs of all candidates of one scan position, fills decisions[0..3]
+  typedef void DecideRdCostsFunc( const StateMem& prevStates, const StateMem& skipStates, const PQData* pqData, const ScanPosType spt,
+                                  const int32_t* startBits, const int32_t lastOffset, Decision* decisions );
+}
+
 
 class DepQuant : public QuantRDOQ
 {
@@ -56,8 +102,17 @@ public:
   virtual void quant  ( TransformUnit &tu, const ComponentID &compID, const CCoeffBuf &pSrc, TCoeff &uiAbsSum, const QpParam &cQP, const Ctx& ctx );
   virtual void dequant( const TransformUnit &tu, CoeffBuf &dstCoeff, const ComponentID &compID, const QpParam &cQP );
 
+#if ENABLE_SIMD_OPT_DEPQUANT
+#ifdef TARGET_SIMD_X86
+  void initDepQuantX86();
+  template <X86_VEXT vext>
+  void _initDepQuantX86();
+#endif
+#endif
+
 private:
   void* p;
+  DQIntern::DecideRdCostsFunc* m_decideRdCosts;
 };
 
 
@@ -63,26 +63,31 @@ typedef std::vector<BlockHash>::iterator MapIterator;
 // ====================================================================================================================
 
 
-struct TCRCCalculatorLight
+// CRC32C (Castagnoli) of the block hashes of hash ME and IBC, the table driven functions are the fallback of the SSE4.2 ones
+struct Crc32c
 {
 public:
-  TCRCCalculatorLight(uint32_t bits, uint32_t truncPoly);
-  ~TCRCCalculatorLight();
+  static void init();
 
-public:
-  void processData(unsigned char* curData, uint32_t dataLength);
-  void reset() { m_remainder = 0; }
-  uint32_t getCRC() { return m_remainder & m_finalResultMask; }
+  static uint32_t (*computeWords)        (uint32_t crc, const uint32_t* words, int num);
+  static uint32_t (*computeWordsReversed)(uint32_t crc, const uint32_t* words, int num);
+  static uint32_t (*computePels)         (uint32_t crc, const Pel* pels, int num);
+  static void     (*hashRow2x2)          (const Pel* src0, const Pel* src1, int num, int shift, uint32_t* hash1, uint32_t* hash2, bool* rowSame, bool* colSame);
 
-private:
-  void xInitTable();
+  static const uint32_t m_seed1 = 0x00000000;
+  static const uint32_t m_seed2 = 0xFFFFFFFF;
 
 private:
-  uint32_t m_remainder;
-  uint32_t m_truncPoly;
-  uint32_t m_bits;
-  uint32_t m_table[256];
-  uint32_t m_finalResultMask;
+  static uint32_t xComputeWords        (uint32_t crc, const uint32_t* words, int num);
+  static uint32_t xComputeWordsReversed(uint32_t crc, const uint32_t* words, int num);
+  static uint32_t xComputePels         (uint32_t crc, const Pel* pels, int num);
+  static void     xHashRow2x2          (const Pel* src0, const Pel* src1, int num, int shift, uint32_t* hash1, uint32_t* hash2, bool* rowSame, bool* colSame);
+
+#ifdef TARGET_SIMD_X86
+  static void initCrc32cX86();
+  template <X86_VEXT vext>
+  static void _initCrc32cX86();
+#endif
 };
 
 
@@ -128,9 +133,6 @@ private:
   static const int m_CRCBits = 16;
   static const int m_blockSizeBits = 3;
   static int m_blockSizeToIndex[65][65];
-
-  static TCRCCalculatorLight m_crcCalculator1;
-  static TCRCCalculatorLight m_crcCalculator2;
 };
 
 #endif // __HASH__
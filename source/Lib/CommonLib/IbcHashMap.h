@@ -40,6 +40,7 @@
 
 // Include files
 #include "CommonLib/CommonDef.h"
+#include "CommonLib/Hash.h"
 #include "CommonLib/IntraPrediction.h"
 #include "CommonLib/InterPrediction.h"
 #include "CommonLib/TrQuant.h"
@@ -68,11 +69,7 @@ private:
   template<ChromaFormat chromaFormat>
   void    xxBuildPicHashMap(const PelUnitBuf& pic);
 
-  static  uint32_t xxComputeCrc32c16bit(uint32_t crc, const Pel pel);
-
 public:
-  uint32_t (*m_computeCrc32c) (uint32_t crc, const Pel pel);
-
   IbcHashMap();
   virtual ~IbcHashMap();
 
@@ -84,12 +81,6 @@ public:
 
   int     calHashBlkMatchPerc(const Area& lumaArea);
 
-#ifdef TARGET_SIMD_X86
-  void    initIbcHashMapX86();
-  template <X86_VEXT vext>
-  void    _initIbcHashMapX86();
-#endif
-
 };
 
 //! \}
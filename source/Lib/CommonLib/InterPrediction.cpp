@@ -739,6 +739,18 @@ void InterPrediction::xPredInterBlkVA(const ComponentID compID, const Prediction
   else
   {
     refBuf = refPic->getRecoBuf(compID, wrapRef);
+
+    // the reprojected 4x4 sub-blocks read the lines [yPos - 3, yPos + 7], above the picture the lines are mirrored
+    // at the pole and below it the whole reference is needed
+    const int lastLine = std::max<int>(yPos.maxCoeff() + NTAPS_LUMA - 1, (NTAPS_LUMA >> 1) - 1 - yPos.minCoeff());
+    if (lastLine >= (int) refBuf.height)
+    {
+      refPic->waitReconComplete();
+    }
+    else
+    {
+      refPic->waitReconLine(lastLine);
+    }
   }
 
   // backup data
@@ -761,10 +773,11 @@ void InterPrediction::xPredInterBlkVA(const ComponentID compID, const Prediction
 #if INTERPRED_PROFILING
   auto start_interpolTime = std::chrono::high_resolution_clock::now();
 #endif
-  int maxCUWidth = 0; // int(pu.cs->sps->getMaxCUWidth());
   for (int col = 0; col < blockSize.width / 4; ++col) {
     for (int row = 0; row < blockSize.height / 4; ++row) {
-      if (xPos(row, col) < -maxCUWidth or yPos(row, col) < -maxCUWidth or xPos(row, col) >= refBuf.width + maxCUWidth - 4 or yPos(row, col) >= refBuf.height + maxCUWidth - 4)
+      const Pel* refBlk;
+      int refBlkStride;
+      if (!xGetVARefBlock4x4(refBuf, xPos(row, col), yPos(row, col), refBlk, refBlkStride))
       {
         dstBuf.subBuf(col * 4, row * 4, 4, 4).memset(0);
         continue;
@@ -772,8 +785,8 @@ void InterPrediction::xPredInterBlkVA(const ComponentID compID, const Prediction
       if (yFrac(row, col) == 0)
       {
         m_if.filterHor(compID,
-                       (Pel *) refBuf.buf + yPos(row, col) * refBuf.stride + xPos(row, col),
-                       refBuf.stride,
+                       (Pel *) refBlk,
+                       refBlkStride,
                        dstBuf.buf + row * 4 * dstBuf.stride + col * 4,
                        dstBuf.stride,
                        4, 4, xFrac(row, col), rndRes, clpRng, bilinearMC, bilinearMC, useAltHpelIf);
@@ -781,8 +794,8 @@ void InterPrediction::xPredInterBlkVA(const ComponentID compID, const Prediction
       else if (xFrac(row, col) == 0)
       {
         m_if.filterVer(compID,
-                       (Pel *) refBuf.buf + yPos(row, col) * refBuf.stride + xPos(row, col),
-                       refBuf.stride,
+                       (Pel *) refBlk,
+                       refBlkStride,
                        dstBuf.buf + row * 4 * dstBuf.stride + col * 4,
                        dstBuf.stride,
                        4, 4, yFrac(row, col), true, rndRes, clpRng, bilinearMC, bilinearMC, useAltHpelIf);
@@ -798,8 +811,8 @@ void InterPrediction::xPredInterBlkVA(const ComponentID compID, const Prediction
         {
           vFilterSize = NTAPS_BILINEAR;
         }
-        m_if.filterHor(compID, (Pel *) refBuf.buf + yPos(row, col) * refBuf.stride + xPos(row, col) - ((vFilterSize >> 1) - 1) * refBuf.stride,
-                       refBuf.stride,
+        m_if.filterHor(compID, (Pel *) refBlk - ((vFilterSize >> 1) - 1) * refBlkStride,
+                       refBlkStride,
                        tmpBuf.buf,
                        tmpBuf.stride,
                        4, 4 + vFilterSize - 1, xFrac(row, col), false, clpRng, bilinearMC, bilinearMC, useAltHpelIf);
@@ -842,6 +855,68 @@ void InterPrediction::xPredInterBlkVA(const ComponentID compID, const Prediction
 #endif
 }
 
+/// Reference samples of a VA 4x4 sub-block at integer position (xPos, yPos), including the interpolation filter support.
+/// Sub-blocks inside the reference are fetched in place. For an equirectangular reference, the support of the other
+/// sub-blocks is gathered with horizontal wrap-around and pole crossing (longitude + 180 degrees, mirrored rows).
+/// Returns false if the sub-block cannot be predicted from the reference.
+bool InterPrediction::xGetVARefBlock4x4(const CPelBuf &refBuf, const int xPos, const int yPos, const Pel *&src, int &srcStride)
+{
+  const int width  = (int) refBuf.width;
+  const int height = (int) refBuf.height;
+  if (xPos >= 0 && yPos >= 0 && xPos < width - 4 && yPos < height - 4)
+  {
+    src       = refBuf.buf + yPos * refBuf.stride + xPos;
+    srcStride = refBuf.stride;
+    return true;
+  }
+  if (!m_mvReprojection || !m_mvReprojection->isEquirectangular() || width == 0 || height == 0)
+  {
+    return false;
+  }
+
+  const int offset    = (NTAPS_LUMA >> 1) - 1;
+  const int size      = 4 + NTAPS_LUMA - 1;
+  const int halfWidth = width >> 1;
+
+  // column indices for rows without ([0]) and with ([1]) pole crossing
+  int colIdx[2][4 + NTAPS_LUMA - 1];
+  for (int i = 0; i < size; i++)
+  {
+    const int x  = xPos - offset + i;
+    colIdx[0][i] = ((x % width) + width) % width;
+    colIdx[1][i] = (((x + halfWidth) % width) + width) % width;
+  }
+
+  for (int j = 0; j < size; j++)
+  {
+    int y    = yPos - offset + j;
+    int pole = 0;
+    if (y < 0)
+    {
+      y    = -y;
+      pole = 1;
+    }
+    else if (y >= height)
+    {
+      y    = 2 * height - y;
+      pole = 1;
+    }
+    y = Clip3(0, height - 1, y);
+
+    const Pel *refRow = refBuf.buf + y * refBuf.stride;
+    const int *cols   = colIdx[pole];
+    Pel       *dst    = m_vaWrapBuf + j * VA_WRAP_BUF_STRIDE;
+    for (int i = 0; i < size; i++)
+    {
+      dst[i] = refRow[cols[i]];
+    }
+  }
+
+  src       = m_vaWrapBuf + offset * VA_WRAP_BUF_STRIDE + offset;
+  srcStride = VA_WRAP_BUF_STRIDE;
+  return true;
+}
+
 void InterPrediction::xNearestNeighborPaddingForBDOF(const ArrayXXFixed &xPos, const ArrayXXFixed &yPos,
                                                      const ArrayXXFixed &xFrac, const ArrayXXFixed &yFrac,
                                                      CPelBuf refBuf, PelBuf dstBuf,
@@ -970,14 +1045,13 @@ void InterPrediction::xPredInterBlk ( const ComponentID& compID, const Predictio
     CPelBuf refBuf;
     {
       Position offset = pu.blocks[compID].pos().offset(mv.getHor() >> shiftHor, mv.getVer() >> shiftVer);
-      if (dmvrWidth)
+      const CompArea refArea = dmvrWidth ? CompArea(compID, chFmt, offset, Size(dmvrWidth, dmvrHeight))
+                                         : CompArea(compID, chFmt, offset, pu.blocks[compID].size());
+      if (NULL == srcPadBuf)
       {
-        refBuf = refPic->getRecoBuf(CompArea(compID, chFmt, offset, Size(dmvrWidth, dmvrHeight)), wrapRef);
-      }
-      else
-      {
-        refBuf = refPic->getRecoBuf(CompArea(compID, chFmt, offset, pu.blocks[compID].size()), wrapRef);
+        refPic->waitReconArea(refArea);
       }
+      refBuf = refPic->getRecoBuf(refArea, wrapRef);
     }
 
     if (NULL != srcPadBuf)
@@ -1439,6 +1513,8 @@ void InterPrediction::xPredAffineBlk(const ComponentID &compID, const Prediction
           yFrac = (iMvScaleTmpVer << (1 - iScaleY)) & 31;
         }
 
+        const CompArea refArea(compID, chFmt, pu.blocks[compID].offset(xInt + w, yInt + h), Size(blockWidth, blockHeight));
+        refPic->waitReconArea(refArea);
         const CPelBuf refBuf = refPic->getRecoBuf(
           CompArea(compID, chFmt, pu.blocks[compID].offset(xInt + w, yInt + h), pu.blocks[compID]), wrapRef);
 
@@ -1988,6 +2064,7 @@ void InterPrediction::xPrefetch(PredictionUnit& pu, PelUnitBuf &pcPad, RefPicLis
     {
       CPelBuf refBuf;
       Position Rec_offset = pu.blocks[compID].pos().offset(cMv.getHor() >> mvshiftTempHor, cMv.getVer() >> mvshiftTempVer);
+      refPic->waitReconArea(CompArea((ComponentID)compID, pu.chromaFormat, Rec_offset, Size(width, height)));
       refBuf = refPic->getRecoBuf(CompArea((ComponentID)compID, pu.chromaFormat, Rec_offset, pu.blocks[compID].size()), wrapRef);
       PelBuf &dstBuf = pcPad.bufs[compID];
       g_pelBufOP.copyBuffer((Pel *)refBuf.buf, refBuf.stride, ((Pel *)dstBuf.buf) + offset, dstBuf.stride, width, height);
@@ -2822,6 +2899,8 @@ bool InterPrediction::xPredInterBlkRPR( const std::pair<int, int>& scalingRatio,
 
   if( scaled )
   {
+    refPic->waitReconComplete();
+
     int row, col;
     int refPicWidth = refPic->getPicWidthInLumaSamples();
     int refPicHeight = refPic->getPicHeightInLumaSamples();
@@ -118,6 +118,7 @@ protected:
 
   // Viewport-adaptive
   MVReprojection*       m_mvReprojection;
+  Pel                  m_vaWrapBuf[VA_WRAP_BUF_STRIDE * VA_WRAP_BUF_HEIGHT];
 
   int                  m_IBCBufferWidth;
   PelStorage           m_IBCBuffer;
@@ -154,6 +155,7 @@ protected:
                                   const Pel* srcPadBuf = NULL,
                                   const int32_t srcPadStride = 0
                                  );
+  bool xGetVARefBlock4x4        ( const CPelBuf& refBuf, const int xPos, const int yPos, const Pel*& src, int& srcStride );
 
   void xAddBIOAvg4              (const Pel* src0, int src0Stride, const Pel* src1, int src1Stride, Pel *dst, int dstStride, const Pel *gradX0, const Pel *gradX1, const Pel *gradY0, const Pel*gradY1, int gradStride, int width, int height, int tmpx, int tmpy, int shift, int offset, const ClpRng& clpRng);
   void xBioGradFilter           (Pel* pSrc, int srcStride, int width, int height, int gradStride, Pel* gradX, Pel* gradY, int bitDepth);
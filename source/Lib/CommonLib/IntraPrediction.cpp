@@ -68,6 +68,213 @@ const uint8_t IntraPrediction::m_aucIntraFilter[MAX_INTRA_FILTER_DEPTHS] =
 };
 
 
+// ====================================================================================================================
+// Prediction kernels
+// ====================================================================================================================
+
+/** Function for deriving planar intra prediction. This function derives the prediction samples for planar mode (intra coding).
+ */
+
+//NOTE: Bit-Limit - 24-bit source
+static void predIntraPlanar( const CPelBuf &pSrc, PelBuf &pDst )
+{
+  const uint32_t width  = pDst.width;
+  const uint32_t height = pDst.height;
+
+  const uint32_t log2W = floorLog2( width );
+  const uint32_t log2H = floorLog2( height );
+
+  int leftColumn[MAX_CU_SIZE + 1], topRow[MAX_CU_SIZE + 1], bottomRow[MAX_CU_SIZE], rightColumn[MAX_CU_SIZE];
+  const uint32_t offset = 1 << (log2W + log2H);
+
+  // Get left and above reference column and row
+  CHECK(width > MAX_CU_SIZE, "width greater than limit");
+  for( int k = 0; k < width + 1; k++ )
+  {
+    topRow[k] = pSrc.at( k + 1, 0 );
+  }
+
+  CHECK(height > MAX_CU_SIZE, "height greater than limit");
+  for( int k = 0; k < height + 1; k++ )
+  {
+    leftColumn[k] = pSrc.at(k + 1, 1);
+  }
+
+  // Prepare intermediate variables used in interpolation
+  int bottomLeft = leftColumn[height];
+  int topRight = topRow[width];
+
+  for( int k = 0; k < width; k++ )
+  {
+    bottomRow[k] = bottomLeft - topRow[k];
+    topRow[k]    = topRow[k] << log2H;
+  }
+
+  for( int k = 0; k < height; k++ )
+  {
+    rightColumn[k] = topRight - leftColumn[k];
+    leftColumn[k]  = leftColumn[k] << log2W;
+  }
+
+  const uint32_t finalShift = 1 + log2W + log2H;
+  const uint32_t stride     = pDst.stride;
+  Pel*       pred       = pDst.buf;
+  for( int y = 0; y < height; y++, pred += stride )
+  {
+    int horPred = leftColumn[y];
+
+    for( int x = 0; x < width; x++ )
+    {
+      horPred += rightColumn[y];
+      topRow[x] += bottomRow[x];
+
+      int vertPred = topRow[x];
+      pred[x]      = ( ( horPred << log2H ) + ( vertPred << log2W ) + offset ) >> finalShift;
+    }
+  }
+}
+
+// DC prediction from the mean value of the reference samples
+//NOTE: Bit-Limit - 25-bit source
+static void predIntraDc( const CPelBuf &pSrc, PelBuf &pDst, const int multiRefIdx )
+{
+  CHECK( pDst.width == 0 || pDst.height == 0, "Empty area provided" );
+
+  int idx, sum = 0;
+  Pel dcVal;
+  const int width  = pDst.width;
+  const int height = pDst.height;
+  const auto denom     = (width == height) ? (width << 1) : std::max(width,height);
+  const auto divShift  = floorLog2(denom);
+  const auto divOffset = (denom >> 1);
+
+  if ( width >= height )
+  {
+    for( idx = 0; idx < width; idx++ )
+    {
+      sum += pSrc.at(multiRefIdx + 1 + idx, 0);
+    }
+  }
+  if ( width <= height )
+  {
+    for( idx = 0; idx < height; idx++ )
+    {
+      sum += pSrc.at(multiRefIdx + 1 + idx, 1);
+    }
+  }
+
+  dcVal = (sum + divOffset) >> divShift;
+  pDst.fill( dcVal );
+}
+
+// fractional angular prediction of luma with the 4-tap filters, deltaPos is the position of the first row
+static void predIntraAngLuma( Pel* pDst, const ptrdiff_t dstStride, const Pel* refMain, const int width, const int height, const int deltaPos,
+                              const int intraPredAngle, const bool useCubicFilter, const ClpRng& clpRng )
+{
+  Pel* pDsty = pDst;
+
+  for( int y = 0, pos = deltaPos; y < height; y++, pos += intraPredAngle, pDsty += dstStride )
+  {
+    const int deltaInt   = pos >> 5;
+    const int deltaFract = pos & 31;
+
+    const TFilterCoeff        intraSmoothingFilter[4] = {TFilterCoeff(16 - (deltaFract >> 1)), TFilterCoeff(32 - (deltaFract >> 1)), TFilterCoeff(16 + (deltaFract >> 1)), TFilterCoeff(deltaFract >> 1)};
+    const TFilterCoeff* const f                       = (useCubicFilter) ? InterpolationFilter::getChromaFilterTable(deltaFract) : intraSmoothingFilter;
+
+    for (int x = 0; x < width; x++)
+    {
+      Pel p[4];
+
+      p[0] = refMain[deltaInt + x];
+      p[1] = refMain[deltaInt + x + 1];
+      p[2] = refMain[deltaInt + x + 2];
+      p[3] = refMain[deltaInt + x + 3];
+
+      Pel val = (f[0] * p[0] + f[1] * p[1] + f[2] * p[2] + f[3] * p[3] + 32) >> 6;
+
+      pDsty[x] = ClipPel(val, clpRng);   // always clip even though not always needed
+    }
+  }
+}
+
+// fractional angular prediction of chroma with the linear filter
+static void predIntraAngChroma( Pel* pDst, const ptrdiff_t dstStride, const Pel* refMain, const int width, const int height, const int deltaPos,
+                                const int intraPredAngle )
+{
+  Pel* pDsty = pDst;
+
+  for( int y = 0, pos = deltaPos; y < height; y++, pos += intraPredAngle, pDsty += dstStride )
+  {
+    const int deltaInt   = pos >> 5;
+    const int deltaFract = pos & 31;
+
+    for (int x = 0; x < width; x++)
+    {
+      Pel p[2];
+
+      p[0] = refMain[deltaInt + x + 1];
+      p[1] = refMain[deltaInt + x + 2];
+
+      pDsty[x] = p[0] + ((deltaFract * (p[1] - p[0]) + 16) >> 5);
+    }
+  }
+}
+
+// position dependent combination of the planar and DC prediction with the unfiltered reference samples
+static void pdpcPlanarDc( const CPelBuf &pSrc, PelBuf &pDst, const int scale )
+{
+  for (int y = 0; y < pDst.height; y++)
+  {
+    const int wT   = 32 >> std::min(31, ((y << 1) >> scale));
+    const Pel left = pSrc.at(y + 1, 1);
+    for (int x = 0; x < pDst.width; x++)
+    {
+      const int wL    = 32 >> std::min(31, ((x << 1) >> scale));
+      const Pel top   = pSrc.at(x + 1, 0);
+      const Pel val   = pDst.at(x, y);
+      pDst.at(x, y) = val + ((wL * (left - val) + wT * (top - val) + 32) >> 6);
+    }
+  }
+}
+
+// position dependent combination of the pure vertical (horizontal) prediction with the left (top) reference samples
+static void pdpcHorVer( Pel* pDst, const ptrdiff_t dstStride, const Pel* refSide, const Pel topLeft, const int width, const int height,
+                        const int scale, const ClpRng& clpRng )
+{
+  for( int y = 0; y < height; y++, pDst += dstStride )
+  {
+    const Pel left = refSide[1 + y];
+    for (int x = 0; x < std::min(3 << scale, width); x++)
+    {
+      const int wL  = 32 >> (2 * x >> scale);
+      const Pel val = pDst[x];
+      pDst[x]       = ClipPel(val + ((wL * (left - topLeft) + 32) >> 6), clpRng);
+    }
+  }
+}
+
+// dst( y, x ) = src( x, y ) for the width x height samples of src
+static void transposeBlk( const Pel* src, const ptrdiff_t srcStride, Pel* dst, const ptrdiff_t dstStride, const int width, const int height )
+{
+  for( int y = 0; y < height; y++ )
+  {
+    for( int x = 0; x < width; x++ )
+    {
+      dst[x * dstStride + y] = src[x];
+    }
+    src += srcStride;
+  }
+}
+
+// [1 2 1] smoothing of the reference samples 1 .. length - 1
+static void filterRefSamples( const Pel* src, Pel* dst, const int length )
+{
+  for (int i = 1; i < length; i++)
+  {
+    dst[i] = (src[i - 1] + 2 * src[i] + src[i + 1] + 2) >> 2;
+  }
+}
+
 // ====================================================================================================================
 // Constructor / destructor / initialize
 // ====================================================================================================================
@@ -86,6 +293,21 @@ IntraPrediction::IntraPrediction()
 
   m_piTemp = nullptr;
   m_pMdlmTemp = nullptr;
+
+  m_predIntraPlanar    = predIntraPlanar;
+  m_predIntraDc        = predIntraDc;
+  m_predIntraAngLuma   = predIntraAngLuma;
+  m_predIntraAngChroma = predIntraAngChroma;
+  m_pdpcPlanarDc       = pdpcPlanarDc;
+  m_pdpcHorVer         = pdpcHorVer;
+  m_transposeBlk       = transposeBlk;
+  m_filterRefSamples   = filterRefSamples;
+
+#if ENABLE_SIMD_OPT_INTRAPRED
+#ifdef TARGET_SIMD_X86
+  initIntraPredictionX86();
+#endif
+#endif
 }
 
 IntraPrediction::~IntraPrediction()
@@ -147,39 +369,6 @@ void IntraPrediction::init(ChromaFormat chromaFormatIDC, const unsigned bitDepth
 // Public member functions
 // ====================================================================================================================
 
-// Function for calculating DC value of the reference samples used in Intra prediction
-//NOTE: Bit-Limit - 25-bit source
-Pel IntraPrediction::xGetPredValDc( const CPelBuf &pSrc, const Size &dstSize )
-{
-  CHECK( dstSize.width == 0 || dstSize.height == 0, "Empty area provided" );
-
-  int idx, sum = 0;
-  Pel dcVal;
-  const int width  = dstSize.width;
-  const int height = dstSize.height;
-  const auto denom     = (width == height) ? (width << 1) : std::max(width,height);
-  const auto divShift  = floorLog2(denom);
-  const auto divOffset = (denom >> 1);
-
-  if ( width >= height )
-  {
-    for( idx = 0; idx < width; idx++ )
-    {
-      sum += pSrc.at(m_ipaParam.multiRefIndex + 1 + idx, 0);
-    }
-  }
-  if ( width <= height )
-  {
-    for( idx = 0; idx < height; idx++ )
-    {
-      sum += pSrc.at(m_ipaParam.multiRefIndex + 1 + idx, 1);
-    }
-  }
-
-  dcVal = (sum + divOffset) >> divShift;
-  return dcVal;
-}
-
 int IntraPrediction::getModifiedWideAngle( int width, int height, int predMode )
 {
   //The function returns a 'modified' wide angle index, given that it is not necessary
@@ -233,8 +422,8 @@ void IntraPrediction::predIntraAng( const ComponentID compId, PelBuf &piPred, co
 
   switch (uiDirMode)
   {
-    case(PLANAR_IDX): xPredIntraPlanar(srcBuf, piPred); break;
-    case(DC_IDX):     xPredIntraDc(srcBuf, piPred, channelType, false); break;
+    case(PLANAR_IDX): m_predIntraPlanar(srcBuf, piPred); break;
+    case(DC_IDX):     m_predIntraDc(srcBuf, piPred, m_ipaParam.multiRefIndex); break;
     case(BDPCM_IDX):  xPredIntraBDPCM(srcBuf, piPred, isLuma(compID) ? pu.cu->bdpcmMode : pu.cu->bdpcmModeChroma, clpRng); break;
     default:          xPredIntraAng(srcBuf, piPred, channelType, clpRng); break;
   }
@@ -247,18 +436,7 @@ void IntraPrediction::predIntraAng( const ComponentID compId, PelBuf &piPred, co
 
     if (uiDirMode == PLANAR_IDX || uiDirMode == DC_IDX)
     {
-      for (int y = 0; y < iHeight; y++)
-      {
-        const int wT   = 32 >> std::min(31, ((y << 1) >> scale));
-        const Pel left = srcBuf.at(y + 1, 1);
-        for (int x = 0; x < iWidth; x++)
-        {
-          const int wL    = 32 >> std::min(31, ((x << 1) >> scale));
-          const Pel top   = srcBuf.at(x + 1, 0);
-          const Pel val   = dstBuf.at(x, y);
-          dstBuf.at(x, y) = val + ((wL * (left - val) + wT * (top - val) + 32) >> 6);
-        }
-      }
+      m_pdpcPlanarDc(srcBuf, dstBuf, scale);
     }
   }
 }
@@ -285,74 +463,6 @@ void IntraPrediction::predIntraChromaLM(const ComponentID compID, PelBuf &piPred
   piPred.linearTransform(a, iShift, b, true, pu.cs->slice->clpRng(compID));
 }
 
-/** Function for deriving planar intra prediction. This function derives the prediction samples for planar mode (intra coding).
- */
-
-//NOTE: Bit-Limit - 24-bit source
-void IntraPrediction::xPredIntraPlanar( const CPelBuf &pSrc, PelBuf &pDst )
-{
-  const uint32_t width  = pDst.width;
-  const uint32_t height = pDst.height;
-
-  const uint32_t log2W = floorLog2( width );
-  const uint32_t log2H = floorLog2( height );
-
-  int leftColumn[MAX_CU_SIZE + 1], topRow[MAX_CU_SIZE + 1], bottomRow[MAX_CU_SIZE], rightColumn[MAX_CU_SIZE];
-  const uint32_t offset = 1 << (log2W + log2H);
-
-  // Get left and above reference column and row
-  CHECK(width > MAX_CU_SIZE, "width greater than limit");
-  for( int k = 0; k < width + 1; k++ )
-  {
-    topRow[k] = pSrc.at( k + 1, 0 );
-  }
-
-  CHECK(height > MAX_CU_SIZE, "height greater than limit");
-  for( int k = 0; k < height + 1; k++ )
-  {
-    leftColumn[k] = pSrc.at(k + 1, 1);
-  }
-
-  // Prepare intermediate variables used in interpolation
-  int bottomLeft = leftColumn[height];
-  int topRight = topRow[width];
-
-  for( int k = 0; k < width; k++ )
-  {
-    bottomRow[k] = bottomLeft - topRow[k];
-    topRow[k]    = topRow[k] << log2H;
-  }
-
-  for( int k = 0; k < height; k++ )
-  {
-    rightColumn[k] = topRight - leftColumn[k];
-    leftColumn[k]  = leftColumn[k] << log2W;
-  }
-
-  const uint32_t finalShift = 1 + log2W + log2H;
-  const uint32_t stride     = pDst.stride;
-  Pel*       pred       = pDst.buf;
-  for( int y = 0; y < height; y++, pred += stride )
-  {
-    int horPred = leftColumn[y];
-
-    for( int x = 0; x < width; x++ )
-    {
-      horPred += rightColumn[y];
-      topRow[x] += bottomRow[x];
-
-      int vertPred = topRow[x];
-      pred[x]      = ( ( horPred << log2H ) + ( vertPred << log2W ) + offset ) >> finalShift;
-    }
-  }
-}
-
-void IntraPrediction::xPredIntraDc( const CPelBuf &pSrc, PelBuf &pDst, const ChannelType channelType, const bool enableBoundaryFilter )
-{
-  const Pel dcval = xGetPredValDc( pSrc, pDst );
-  pDst.fill( dcval );
-}
-
 // Function for initialization of intra prediction parameters
 void IntraPrediction::initPredIntraParams(const PredictionUnit & pu, const CompArea area, const SPS& sps)
 {
@@ -544,78 +654,52 @@ void IntraPrediction::xPredIntraAng( const CPelBuf &pSrc, PelBuf &pDst, const Ch
         pDsty[x] = refMain[x + 1];
       }
 
-      if (m_ipaParam.applyPDPC)
-      {
-        const int scale   = (floorLog2(width) + floorLog2(height) - 2) >> 2;
-        const Pel topLeft = refMain[0];
-        const Pel left    = refSide[1 + y];
-        for (int x = 0; x < std::min(3 << scale, width); x++)
-        {
-          const int wL  = 32 >> (2 * x >> scale);
-          const Pel val = pDsty[x];
-          pDsty[x]      = ClipPel(val + ((wL * (left - topLeft) + 32) >> 6), clpRng);
-        }
-      }
-
       pDsty += dstStride;
     }
+
+    if (m_ipaParam.applyPDPC)
+    {
+      const int scale = (floorLog2(width) + floorLog2(height) - 2) >> 2;
+      m_pdpcHorVer(pDstBuf, dstStride, refSide, refMain[0], width, height, scale, clpRng);
+    }
   }
   else
   {
-    for (int y = 0, deltaPos = intraPredAngle * (1 + multiRefIdx); y<height; y++, deltaPos += intraPredAngle, pDsty += dstStride)
-    {
-      const int deltaInt   = deltaPos >> 5;
-      const int deltaFract = deltaPos & 31;
+    const int deltaPos = intraPredAngle * (1 + multiRefIdx);
 
-      if ( !isIntegerSlope( abs(intraPredAngle) ) )
+    if ( !isIntegerSlope( abs(intraPredAngle) ) )
+    {
+      if( isLuma(channelType) )
       {
-        if( isLuma(channelType) )
-        {
-          const bool useCubicFilter = !m_ipaParam.interpolationFlag;
-
-          const TFilterCoeff        intraSmoothingFilter[4] = {TFilterCoeff(16 - (deltaFract >> 1)), TFilterCoeff(32 - (deltaFract >> 1)), TFilterCoeff(16 + (deltaFract >> 1)), TFilterCoeff(deltaFract >> 1)};
-          const TFilterCoeff* const f                       = (useCubicFilter) ? InterpolationFilter::getChromaFilterTable(deltaFract) : intraSmoothingFilter;
-
-          for (int x = 0; x < width; x++)
-          {
-            Pel p[4];
-
-            p[0] = refMain[deltaInt + x];
-            p[1] = refMain[deltaInt + x + 1];
-            p[2] = refMain[deltaInt + x + 2];
-            p[3] = refMain[deltaInt + x + 3];
-
-            Pel val = (f[0] * p[0] + f[1] * p[1] + f[2] * p[2] + f[3] * p[3] + 32) >> 6;
-
-            pDsty[x] = ClipPel(val, clpRng);   // always clip even though not always needed
-          }
-        }
-        else
-        {
-          // Do linear filtering
-          for (int x = 0; x < width; x++)
-          {
-            Pel p[2];
-
-            p[0] = refMain[deltaInt + x + 1];
-            p[1] = refMain[deltaInt + x + 2];
-
-            pDsty[x] = p[0] + ((deltaFract * (p[1] - p[0]) + 16) >> 5);
-          }
-        }
+        m_predIntraAngLuma(pDstBuf, dstStride, refMain, width, height, deltaPos, intraPredAngle, !m_ipaParam.interpolationFlag, clpRng);
       }
       else
       {
+        m_predIntraAngChroma(pDstBuf, dstStride, refMain, width, height, deltaPos, intraPredAngle);
+      }
+    }
+    else
+    {
+      for (int y = 0, pos = deltaPos; y < height; y++, pos += intraPredAngle, pDsty += dstStride)
+      {
+        const int deltaInt = pos >> 5;
+
         // Just copy the integer samples
         for( int x = 0; x < width; x++ )
         {
           pDsty[x] = refMain[x + deltaInt + 1];
         }
       }
-      if (m_ipaParam.applyPDPC)
+    }
+
+    if (m_ipaParam.applyPDPC)
+    {
+      const int scale = m_ipaParam.angularScale;
+
+      pDsty = pDstBuf;
+      for (int y = 0; y < height; y++, pDsty += dstStride)
       {
-        const int scale       = m_ipaParam.angularScale;
-        int       invAngleSum = 256;
+        int invAngleSum = 256;
 
         for (int x = 0; x < std::min(3 << scale, width); x++)
         {
@@ -632,14 +716,7 @@ void IntraPrediction::xPredIntraAng( const CPelBuf &pSrc, PelBuf &pDst, const Ch
   // Flip the block if this is the horizontal mode
   if( !bIsModeVer )
   {
-    for( int y = 0; y < height; y++ )
-    {
-      for( int x = 0; x < width; x++ )
-      {
-        pDst.at( y, x ) = pDstBuf[x];
-      }
-      pDstBuf += dstStride;
-    }
+    m_transposeBlk(pDstBuf, dstStride, pDst.buf, pDst.stride, width, height);
   }
 }
 
@@ -1185,10 +1262,7 @@ void IntraPrediction::xFilterReferenceSamples(const Pel *refBufUnfiltered, Pel *
 
   refBufFiltered[0] = topLeft;
 
-  for (int i = 1; i < predSize; i++)
-  {
-    refBufFiltered[i] = (refBufUnfiltered[i - 1] + 2 * refBufUnfiltered[i] + refBufUnfiltered[i + 1] + 2) >> 2;
-  }
+  m_filterRefSamples(refBufUnfiltered, refBufFiltered, predSize);
   refBufFiltered[predSize] = refBufUnfiltered[predSize];
 
   refBufFiltered += predStride;
@@ -1196,10 +1270,7 @@ void IntraPrediction::xFilterReferenceSamples(const Pel *refBufUnfiltered, Pel *
 
   refBufFiltered[0] = topLeft;
 
-  for (int i = 1; i < predHSize; i++)
-  {
-    refBufFiltered[i] = (refBufUnfiltered[i - 1] + 2 * refBufUnfiltered[i] + refBufUnfiltered[i + 1] + 2) >> 2;
-  }
+  m_filterRefSamples(refBufUnfiltered, refBufFiltered, predHSize);
   refBufFiltered[predHSize] = refBufUnfiltered[predHSize];
 }
 
@@ -118,8 +118,6 @@ protected:
   ScanElement* m_scanOrder;
   bool         m_bestScanRotationMode;
   // prediction
-  void xPredIntraPlanar           ( const CPelBuf &pSrc, PelBuf &pDst );
-  void xPredIntraDc               ( const CPelBuf &pSrc, PelBuf &pDst, const ChannelType channelType, const bool enableBoundaryFilter = true );
   void xPredIntraAng              ( const CPelBuf &pSrc, PelBuf &pDst, const ChannelType channelType, const ClpRng& clpRng);
 
   void initPredIntraParams        ( const PredictionUnit & pu,  const CompArea compArea, const SPS& sps );
@@ -127,7 +125,6 @@ protected:
   static bool isIntegerSlope(const int absAng) { return (0 == (absAng & 0x1F)); }
 
   void xPredIntraBDPCM            ( const CPelBuf &pSrc, PelBuf &pDst, const uint32_t dirMode, const ClpRng& clpRng );
-  Pel  xGetPredValDc              ( const CPelBuf &pSrc, const Size &dstSize );
 
   void xFillReferenceSamples      ( const CPelBuf &recoBuf,      Pel* refBufUnfiltered, const CompArea &area, const CodingUnit &cu );
   void xFilterReferenceSamples(const Pel *refBufUnfiltered, Pel *refBufFiltered, const CompArea &area, const SPS &sps,
@@ -140,10 +137,32 @@ protected:
   void destroy                    ();
 
   void xGetLMParameters(const PredictionUnit &pu, const ComponentID compID, const CompArea& chromaArea, int& a, int& b, int& iShift);
+
+  // prediction kernels
+  void (*m_predIntraPlanar)   ( const CPelBuf &pSrc, PelBuf &pDst );
+  void (*m_predIntraDc)       ( const CPelBuf &pSrc, PelBuf &pDst, const int multiRefIdx );
+  void (*m_predIntraAngLuma)  ( Pel* pDst, const ptrdiff_t dstStride, const Pel* refMain, const int width, const int height, const int deltaPos,
+                                const int intraPredAngle, const bool useCubicFilter, const ClpRng& clpRng );
+  void (*m_predIntraAngChroma)( Pel* pDst, const ptrdiff_t dstStride, const Pel* refMain, const int width, const int height, const int deltaPos,
+                                const int intraPredAngle );
+  void (*m_pdpcPlanarDc)      ( const CPelBuf &pSrc, PelBuf &pDst, const int scale );
+  void (*m_pdpcHorVer)        ( Pel* pDst, const ptrdiff_t dstStride, const Pel* refSide, const Pel topLeft, const int width, const int height,
+                                const int scale, const ClpRng& clpRng );
+  void (*m_transposeBlk)      ( const Pel* src, const ptrdiff_t srcStride, Pel* dst, const ptrdiff_t dstStride, const int width, const int height );
+  void (*m_filterRefSamples)  ( const Pel* src, Pel* dst, const int length );
+
 public:
   IntraPrediction();
   virtual ~IntraPrediction();
 
+#if ENABLE_SIMD_OPT_INTRAPRED
+#ifdef TARGET_SIMD_X86
+  void initIntraPredictionX86();
+  template <X86_VEXT vext>
+  void _initIntraPredictionX86();
+#endif
+#endif
+
   void init                       (ChromaFormat chromaFormatIDC, const unsigned bitDepthY);
 
   // Angular Intra
@@ -6,10 +6,12 @@
 
 void MVReprojection::init(const Projection *projection, const Size &resolution, TCoord offset4x4) {
   m_projection = projection;
+  m_equirectangular = dynamic_cast<const EquirectangularProjection*>(projection) != nullptr;
   m_resolution = resolution;
   m_offset4x4 = offset4x4;
   m_perspective = PerspectiveProjection(projection->focalLength(), Array2TCoord(0, 0));
   m_lastViewport = INVALID;
+  m_cart2DProj8x8[0] = m_cart2DProj8x8[1] = nullptr;
   fillCache();
 }
 
@@ -26,6 +28,20 @@ void MVReprojection::fillCache()
   }
 }
 
+void MVReprojection::fillCoarseCache()
+{
+  const TCoord offset8x8 = 2 * m_offset4x4;
+  m_cart2DProj8x8[0] = std::make_shared<ArrayXXTCoord>(Eigen::Array<TCoord, 1, Eigen::Dynamic>::LinSpaced(m_resolution.width / 8, offset8x8, TCoord(m_resolution.width - 8) + offset8x8).replicate(m_resolution.height / 8, 1));
+  m_cart2DProj8x8[1] = std::make_shared<ArrayXXTCoord>(Eigen::Array<TCoord, Eigen::Dynamic, 1>::LinSpaced(m_resolution.height / 8, offset8x8, TCoord(m_resolution.height - 8) + offset8x8).replicate(1, m_resolution.width / 8));
+  for (int viewportIdx = 0; viewportIdx < NUM_VIEWPORT; ++viewportIdx) {
+    std::tuple<ArrayXXTCoordPtrPair, ArrayXXBoolPtr> cart2DPers_vip = toPerspective(ArrayXXTCoordPtrPair(m_cart2DProj8x8[0], m_cart2DProj8x8[1]), Viewport(viewportIdx));
+    ArrayXXTCoordPtrPair cart2DPers = std::get<0>(cart2DPers_vip);
+    m_cart2DPers8x8[viewportIdx][0] = std::get<0>(cart2DPers);
+    m_cart2DPers8x8[viewportIdx][1] = std::get<1>(cart2DPers);
+    m_vip8x8[viewportIdx] = std::get<1>(cart2DPers_vip);
+  }
+}
+
 std::tuple<ArrayXXTCoordPtrPair, ArrayXXBoolPtr>
 MVReprojection::toPerspective(ArrayXXTCoordPtrPair cart2DProj, Viewport viewport) const
 {
@@ -176,10 +192,35 @@ MVReprojection::reprojectMotionVector4x4(const Position &position, const Size &s
     m_lastVip = vip;
   }
 
+  return reprojectMotionVector(cart2DProjX, cart2DProjY, cart2DPersX, cart2DPersY, vip, m_offset4x4, motionVector, viewport, shiftHor, shiftVer);
+}
+
+ArrayXXFixedPtrPair
+MVReprojection::reprojectMotionVector8x8(const Position &position, const Size &size, const Mv &motionVector,
+                                         Viewport viewport, int shiftHor, int shiftVer)
+{
+  CHECK(position.x % 8 || position.y % 8 || size.width % 8 || size.height % 8, "Block is not aligned to the 8x8 subblock grid.");
+  if (!m_cart2DProj8x8[0]) {
+    fillCoarseCache();
+  }
+  const ArrayXXTCoordPtr cart2DProjX = std::make_shared<ArrayXXTCoord>(m_cart2DProj8x8[0]->block(position.y/8, position.x/8, size.height/8, size.width/8));
+  const ArrayXXTCoordPtr cart2DProjY = std::make_shared<ArrayXXTCoord>(m_cart2DProj8x8[1]->block(position.y/8, position.x/8, size.height/8, size.width/8));
+  const ArrayXXTCoordPtr cart2DPersX = std::make_shared<ArrayXXTCoord>(m_cart2DPers8x8[viewport][0]->block(position.y/8, position.x/8, size.height/8, size.width/8));
+  const ArrayXXTCoordPtr cart2DPersY = std::make_shared<ArrayXXTCoord>(m_cart2DPers8x8[viewport][1]->block(position.y/8, position.x/8, size.height/8, size.width/8));
+  const ArrayXXBoolPtr vip = std::make_shared<ArrayXXBool>(m_vip8x8[viewport]->block(position.y/8, position.x/8, size.height/8, size.width/8));
+  return reprojectMotionVector(cart2DProjX, cart2DProjY, cart2DPersX, cart2DPersY, vip, 2 * m_offset4x4, motionVector, viewport, shiftHor, shiftVer);
+}
+
+ArrayXXFixedPtrPair
+MVReprojection::reprojectMotionVector(const ArrayXXTCoordPtr &cart2DProjX, const ArrayXXTCoordPtr &cart2DProjY,
+                                      const ArrayXXTCoordPtr &cart2DPersX, const ArrayXXTCoordPtr &cart2DPersY,
+                                      const ArrayXXBoolPtr &vip, TCoord offset, const Mv &motionVector,
+                                      Viewport viewport, int shiftHor, int shiftVer) const
+{
   // Translatory motion
   TCoord mvX = TCoord(motionVector.hor >> shiftHor) + TCoord(motionVector.hor & ((1 << shiftHor) - 1))/TCoord(1 << shiftHor);
   TCoord mvY = TCoord(motionVector.ver >> shiftVer) + TCoord(motionVector.ver & ((1 << shiftVer) - 1))/TCoord(1 << shiftVer);
-  const ArrayXXTCoord mvSign = vip->select(TCoord(-1), ArrayXXTCoord::Ones(size.height/4, size.width/4));
+  const ArrayXXTCoord mvSign = vip->select(TCoord(-1), ArrayXXTCoord::Ones(vip->rows(), vip->cols()));
   const ArrayXXTCoordPtr cart2DPersMovedX = std::make_shared<ArrayXXTCoord>(*cart2DPersX + mvX * mvSign);
   const ArrayXXTCoordPtr cart2DPersMovedY = std::make_shared<ArrayXXTCoord>(*cart2DPersY + mvY * mvSign);
 
@@ -190,8 +231,8 @@ MVReprojection::reprojectMotionVector4x4(const Position &position, const Size &s
 
   // Perform no motion in case of NaN.
   ArrayXXBool isNaN = cart2DProjMovedX->isNaN() || cart2DProjMovedY->isNaN();
-  cart2DProjMovedX = std::make_shared<ArrayXXTCoord>(isNaN.select(*cart2DProjX, *cart2DProjMovedX) - m_offset4x4);
-  cart2DProjMovedY = std::make_shared<ArrayXXTCoord>(isNaN.select(*cart2DProjY, *cart2DProjMovedY) - m_offset4x4);
+  cart2DProjMovedX = std::make_shared<ArrayXXTCoord>(isNaN.select(*cart2DProjX, *cart2DProjMovedX) - offset);
+  cart2DProjMovedY = std::make_shared<ArrayXXTCoord>(isNaN.select(*cart2DProjY, *cart2DProjMovedY) - offset);
 
   // Return as fixed precision array
   ArrayXXFixedPtr cart2DProjMovedFixedX = std::make_shared<ArrayXXFixed>((*cart2DProjMovedX * (1 << shiftHor)).round().cast<int>());
@@ -16,12 +16,17 @@ class MVReprojection {
 
 public:
 
-  MVReprojection(): m_projection(nullptr), m_offset4x4(0), m_lastViewport(INVALID) {};
+  MVReprojection(): m_projection(nullptr), m_equirectangular(false), m_offset4x4(0), m_lastViewport(INVALID) {};
 
   void init(const Projection *projection, const Size &resolution, TCoord offset4x4);
 
 protected:
   void fillCache();
+  void fillCoarseCache();
+  ArrayXXFixedPtrPair reprojectMotionVector(const ArrayXXTCoordPtr &cart2DProjX, const ArrayXXTCoordPtr &cart2DProjY,
+                                            const ArrayXXTCoordPtr &cart2DPersX, const ArrayXXTCoordPtr &cart2DPersY,
+                                            const ArrayXXBoolPtr &vip, TCoord offset, const Mv &motionVector,
+                                            Viewport viewport, int shiftHor, int shiftVer) const;
 
 public:
   std::tuple<ArrayXXTCoordPtrPair, ArrayXXBoolPtr> toPerspective(ArrayXXTCoordPtrPair cart2DProj, Viewport viewport) const;
@@ -32,17 +37,27 @@ public:
 
   ArrayXXFixedPtrPair reprojectMotionVector4x4(const Position &position, const Size &size, const Mv &motionVector, Viewport viewport, int shiftHor, int shiftVer);
 
+  /// Reprojection on an 8x8 subblock grid (half resolution of the 4x4 grid) for hierarchical motion search. The coarse cache is filled on first use.
+  ArrayXXFixedPtrPair reprojectMotionVector8x8(const Position &position, const Size &size, const Mv &motionVector, Viewport viewport, int shiftHor, int shiftVer);
+
   /// Find the motion vector in the desired viewport that leads to the same motion vector at position as the original motion vector in the original viewport.
   Mv motionVectorInDesiredViewport(const Position &position, const Mv &motionVectorOrig, Viewport viewportOrig, Viewport viewportDesired, int shiftHor, int shiftVer) const;
 
+  /// Whether the projection covers the full sphere in equirectangular format (horizontal wrap-around, pole crossing).
+  bool isEquirectangular() const { return m_equirectangular; }
+
 protected:
   const Projection *m_projection;
+  bool m_equirectangular;
   Size m_resolution;
   TCoord m_offset4x4; ///< Coordinate offset for reprojection within 4x4 subblocks (0.0-3.0)
   PerspectiveProjection m_perspective;  ///< Cache for perspective projections for luma and chroma channels
   ArrayXXTCoordPtr m_cart2DProj[2];  ///< Cache for cartesian coordinates of pixels in original image
   ArrayXXTCoordPtr m_cart2DPers[NUM_VIEWPORT][2];  ///< Cache for cartesian coordinates in perspective viewports
   ArrayXXBoolPtr m_vip[NUM_VIEWPORT];  ///< Cache for virtual image plane flags in perspective viewports
+  ArrayXXTCoordPtr m_cart2DProj8x8[2];  ///< Cache for cartesian coordinates of 8x8 subblocks in original image
+  ArrayXXTCoordPtr m_cart2DPers8x8[NUM_VIEWPORT][2];  ///< Cache for cartesian coordinates of 8x8 subblocks in perspective viewports
+  ArrayXXBoolPtr m_vip8x8[NUM_VIEWPORT];  ///< Cache for virtual image plane flags of 8x8 subblocks in perspective viewports
 
   Position m_lastPosition;  ///< Last cached block position
   Size m_lastSize;  ///< Last cached block size
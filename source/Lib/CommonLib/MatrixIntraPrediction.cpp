@@ -42,6 +42,59 @@
 #include "MipData.h"
 
 
+static void computeReducedPred( int* const result, const int* const input, const uint8_t* matrix, const int sizeId, const int inputOffset,
+                                const bool transpose, const int bitDepth )
+{
+  const int inputSize       = sizeId == 0 ? 4 : 8;
+  const int reducedPredSize = sizeId < 2 ? 4 : 8;
+
+  // use local buffer for transposed result
+  static_vector<int, MIP_MAX_REDUCED_OUTPUT_SAMPLES> resBufTransposed( reducedPredSize * reducedPredSize );
+  int*const resPtr = (transpose) ? resBufTransposed.data() : result;
+
+  int sum = 0;
+  for( int i = 0; i < inputSize; i++ ) { sum += input[i]; }
+  const int offset = (1 << (MIP_SHIFT_MATRIX - 1)) - MIP_OFFSET_MATRIX * sum;
+  CHECK( inputSize != 4 * (inputSize >> 2), "Error, input size not divisible by four" );
+
+  const uint8_t *weight = matrix;
+
+  const bool redSize = (sizeId == 2);
+  int posRes = 0;
+  for( int y = 0; y < reducedPredSize; y++ )
+  {
+    for( int x = 0; x < reducedPredSize; x++ )
+    {
+      if( redSize ) weight -= 1;
+      int tmp0 = redSize ? 0 : (input[0] * weight[0]);
+      int tmp1 = input[1] * weight[1];
+      int tmp2 = input[2] * weight[2];
+      int tmp3 = input[3] * weight[3];
+      for (int i = 4; i < inputSize; i += 4)
+      {
+        tmp0 += input[i]     * weight[i];
+        tmp1 += input[i + 1] * weight[i + 1];
+        tmp2 += input[i + 2] * weight[i + 2];
+        tmp3 += input[i + 3] * weight[i + 3];
+      }
+      resPtr[posRes++] = ClipBD<int>(((tmp0 + tmp1 + tmp2 + tmp3 + offset) >> MIP_SHIFT_MATRIX) + inputOffset, bitDepth);
+
+      weight += inputSize;
+    }
+  }
+
+  if( transpose )
+  {
+    for( int y = 0; y < reducedPredSize; y++ )
+    {
+      for( int x = 0; x < reducedPredSize; x++ )
+      {
+        result[ y * reducedPredSize + x ] = resPtr[ x * reducedPredSize + y ];
+      }
+    }
+  }
+}
+
 MatrixIntraPrediction::MatrixIntraPrediction():
   m_component(MAX_NUM_COMPONENT),
   m_reducedBoundary          (MIP_MAX_INPUT_SIZE),
@@ -57,6 +110,7 @@ MatrixIntraPrediction::MatrixIntraPrediction():
   m_upsmpFactorHor( 0 ),
   m_upsmpFactorVer( 0 )
 {
+  m_computeReducedPred = computeReducedPred;
 }
 
 void MatrixIntraPrediction::prepareInputForPred(const CPelBuf &pSrc, const Area &block, const int bitDepth,
@@ -129,7 +183,7 @@ void MatrixIntraPrediction::predBlock(int *const result, const int modeIdx, cons
   static_vector<int, MIP_MAX_REDUCED_OUTPUT_SAMPLES> bufReducedPred( m_reducedPredSize * m_reducedPredSize );
   int* const       reducedPred     = needUpsampling ? bufReducedPred.data() : result;
   const int* const reducedBoundary = transpose ? m_reducedBoundaryTransposed.data() : m_reducedBoundary.data();
-  computeReducedPred(reducedPred, reducedBoundary, matrix, transpose, bitDepth);
+  m_computeReducedPred( reducedPred, reducedBoundary, matrix, m_sizeId, transpose ? m_inputOffsetTransp : m_inputOffset, transpose, bitDepth );
   if( needUpsampling )
   {
     predictionUpsampling( result, reducedPred );
@@ -158,8 +212,6 @@ void MatrixIntraPrediction::initPredBlockParams(const Size& block)
   CHECKD( (m_upsmpFactorVer < 1) || ((m_upsmpFactorVer & (m_upsmpFactorVer - 1)) != 0), "Need power of two vertical upsampling factor." );
 }
 
-
-
 void MatrixIntraPrediction::boundaryDownsampling1D(int* reducedDst, const int* const fullSrc, const SizeType srcLen, const SizeType dstLen)
 {
   if (dstLen < srcLen)
@@ -279,57 +331,3 @@ const uint8_t* MatrixIntraPrediction::getMatrixData(const int modeIdx) const
   default: THROW( "Invalid mipSizeId" );
   }
 }
-
-void MatrixIntraPrediction::computeReducedPred( int*const result, const int* const input,
-                                                const uint8_t* matrix,
-                                                const bool transpose, const int bitDepth )
-{
-  const int inputSize = 2 * m_reducedBdrySize;
-
-  // use local buffer for transposed result
-  static_vector<int, MIP_MAX_REDUCED_OUTPUT_SAMPLES> resBufTransposed( m_reducedPredSize * m_reducedPredSize );
-  int*const resPtr = (transpose) ? resBufTransposed.data() : result;
-
-  int sum = 0;
-  for( int i = 0; i < inputSize; i++ ) { sum += input[i]; }
-  const int offset = (1 << (MIP_SHIFT_MATRIX - 1)) - MIP_OFFSET_MATRIX * sum;
-  CHECK( inputSize != 4 * (inputSize >> 2), "Error, input size not divisible by four" );
-
-  const uint8_t *weight = matrix;
-  const int   inputOffset = transpose ? m_inputOffsetTransp : m_inputOffset;
-
-  const bool redSize = (m_sizeId == 2);
-  int posRes = 0;
-  for( int y = 0; y < m_reducedPredSize; y++ )
-  {
-    for( int x = 0; x < m_reducedPredSize; x++ )
-    {
-      if( redSize ) weight -= 1;
-      int tmp0 = redSize ? 0 : (input[0] * weight[0]);
-      int tmp1 = input[1] * weight[1];
-      int tmp2 = input[2] * weight[2];
-      int tmp3 = input[3] * weight[3];
-      for (int i = 4; i < inputSize; i += 4)
-      {
-        tmp0 += input[i]     * weight[i];
-        tmp1 += input[i + 1] * weight[i + 1];
-        tmp2 += input[i + 2] * weight[i + 2];
-        tmp3 += input[i + 3] * weight[i + 3];
-      }
-      resPtr[posRes++] = ClipBD<int>(((tmp0 + tmp1 + tmp2 + tmp3 + offset) >> MIP_SHIFT_MATRIX) + inputOffset, bitDepth);
-
-      weight += inputSize;
-    }
-  }
-
-  if( transpose )
-  {
-    for( int y = 0; y < m_reducedPredSize; y++ )
-    {
-      for( int x = 0; x < m_reducedPredSize; x++ )
-      {
-        result[ y * m_reducedPredSize + x ] = resPtr[ x * m_reducedPredSize + y ];
-      }
-    }
-  }
-}
@@ -54,6 +54,10 @@ public:
   void predBlock(int *const result, const int modeIdx, const bool transpose, const int bitDepth,
                  const ComponentID compId);
 
+  // matrix multiplication of the reduced boundary, result holds reducedPredSize x reducedPredSize samples
+  void (*m_computeReducedPred)( int* const result, const int* const input, const uint8_t* matrix, const int sizeId, const int inputOffset,
+                                const bool transpose, const int bitDepth );
+
   private:
     ComponentID m_component;
 
@@ -84,11 +88,6 @@ public:
                                         const unsigned int upsmpFactor );
 
     const uint8_t* getMatrixData(const int modeIdx) const;
-
-
-    void computeReducedPred( int*const result, const int* const input,
-                             const uint8_t* matrix,
-                             const bool transpose, const int bitDepth );
   };
 
 #endif //__MATRIXINTRAPPREDICTION__
@@ -151,26 +151,29 @@ struct MvField
   }
 };
 
-struct MotionInfo
+// Motion fields are stored per 4x4 unit for the whole picture and are re-read for merge, temporal and
+// deblocking derivation, so the layout is kept compact: the vectors come first, the small per-list
+// indices and viewports are stored as bytes and the flags share a single byte of bit-fields.
+struct alignas(16) MotionInfo
 {
-  bool     isInter;
-  bool     isIBCmot;
-  char     interDir;
-  bool     useAltHpelIf;
-  uint16_t   sliceIdx;
-  Mv      mv     [ NUM_REF_PIC_LIST_01 ];
-  int16_t   refIdx [ NUM_REF_PIC_LIST_01 ];
+  Mv       mv       [ NUM_REF_PIC_LIST_01 ];
+  Mv       bv;
+  uint16_t sliceIdx;
+  int8_t   refIdx   [ NUM_REF_PIC_LIST_01 ];
   Viewport viewport [ NUM_REF_PIC_LIST_01 ];
-  uint8_t         BcwIdx;
-  Mv      bv;
+  bool     isInter      : 1;
+  bool     isIBCmot     : 1;
+  bool     useAltHpelIf : 1;
+  uint8_t  interDir     : 2;
+  uint8_t  BcwIdx       : 3;
 #if GDR_ENABLED
   bool      sourceClean;  // source Position is clean/dirty
   Position  sourcePos;    // source Position of Mv
 #endif
 
-  MotionInfo() : isInter(false), isIBCmot(false), interDir(0), useAltHpelIf(false), sliceIdx(0), refIdx{ NOT_VALID, NOT_VALID }, viewport{ INVALID, INVALID }, BcwIdx(0) { }
+  MotionInfo() : sliceIdx(0), refIdx{ NOT_VALID, NOT_VALID }, viewport{ INVALID, INVALID }, isInter(false), isIBCmot(false), useAltHpelIf(false), interDir(0), BcwIdx(0) { }
   // ensure that MotionInfo(0) produces '\x000....' bit pattern - needed to work with AreaBuf - don't use this constructor for anything else
-  MotionInfo(int i) : isInter(i != 0), isIBCmot(false), interDir(0), useAltHpelIf(false), sliceIdx(0), refIdx{ 0,         0 }, viewport{ INVALID, INVALID }, BcwIdx(0) { CHECKD(i != 0, "The argument for this constructor has to be '0'"); }
+  MotionInfo(int i) : sliceIdx(0), refIdx{ 0,         0 }, viewport{ INVALID, INVALID }, isInter(i != 0), isIBCmot(false), useAltHpelIf(false), interDir(0), BcwIdx(0) { CHECKD(i != 0, "The argument for this constructor has to be '0'"); }
 
   bool operator==( const MotionInfo& mi ) const
   {
@@ -205,6 +208,10 @@ struct MotionInfo
   }
 };
 
+#if !GDR_ENABLED
+static_assert( sizeof( MotionInfo ) == 32, "MotionInfo is expected to fill exactly two 16-byte units" );
+#endif
+
 class BcwMotionParam
 {
   bool       m_readOnly[2][33];       // 2 RefLists, 33 RefFrams
@@ -53,6 +53,7 @@ Picture::Picture()
   m_bIsBorderExtended  = false;
   m_wrapAroundValid    = false;
   m_wrapAroundOffset   = 0;
+  m_isRecoCompact      = false;
   usedByCurr           = false;
   longTerm             = false;
   reconstructed        = false;
@@ -75,6 +76,8 @@ Picture::Picture()
   layerId = NOT_VALID;
   numSlices = 1;
   unscaledPic = nullptr;
+  m_reconProgress  = MAX_INT;
+  m_motionProgress = MAX_INT;
 }
 
 void Picture::create( const ChromaFormat &_chromaFormat, const Size &size, const unsigned _maxCUSize, const unsigned _margin, const bool _decoder, const int _layerId, const bool gopBasedTemporalFilterEnabled )
@@ -175,6 +178,69 @@ void Picture::destroyTempBuffers()
   }
 }
 
+void Picture::releaseOrigBuffers()
+{
+  M_BUFS( 0, PIC_ORIGINAL          ).destroy();
+  M_BUFS( 0, PIC_TRUE_ORIGINAL     ).destroy();
+  M_BUFS( 0, PIC_FILTERED_ORIGINAL ).destroy();
+}
+
+// replaces the reconstruction by a copy without margins, for pictures that are only kept for output
+void Picture::compactRecoBuffer()
+{
+  if( m_isRecoCompact )
+  {
+    return;
+  }
+
+  const Area a( Position{ 0, 0 }, lumaSize() );
+  PelStorage compact;
+  compact.create( chromaFormat, a );
+  compact.copyFrom( M_BUFS( 0, PIC_RECONSTRUCTION ) );
+
+  M_BUFS( 0, PIC_RECONSTRUCTION ).destroy();
+  M_BUFS( 0, PIC_RECON_WRAP ).destroy();
+  M_BUFS( 0, PIC_RECONSTRUCTION ).create( chromaFormat, a );
+  M_BUFS( 0, PIC_RECONSTRUCTION ).swap( compact );
+
+  m_isRecoCompact     = true;
+  m_bIsBorderExtended = false;
+  m_wrapAroundValid   = false;
+
+  if( cs )
+  {
+    cs->rebindPicBufs();
+  }
+}
+
+void Picture::restoreBuffers( const unsigned _maxCUSize, const bool gopBasedTemporalFilterEnabled )
+{
+  const Area a( Position{ 0, 0 }, lumaSize() );
+
+  if( m_isRecoCompact )
+  {
+    M_BUFS( 0, PIC_RECONSTRUCTION ).destroy();
+    M_BUFS( 0, PIC_RECONSTRUCTION ).create( chromaFormat, a, _maxCUSize, margin, MEMORY_ALIGN_DEF_SIZE );
+    M_BUFS( 0, PIC_RECON_WRAP ).create( chromaFormat, a, _maxCUSize, margin, MEMORY_ALIGN_DEF_SIZE );
+    m_isRecoCompact = false;
+
+    if( cs )
+    {
+      cs->rebindPicBufs();
+    }
+  }
+
+  if( M_BUFS( 0, PIC_ORIGINAL ).bufs.empty() )
+  {
+    M_BUFS( 0, PIC_ORIGINAL ).create( chromaFormat, a );
+    M_BUFS( 0, PIC_TRUE_ORIGINAL ).create( chromaFormat, a );
+    if( gopBasedTemporalFilterEnabled )
+    {
+      M_BUFS( 0, PIC_FILTERED_ORIGINAL ).create( chromaFormat, a );
+    }
+  }
+}
+
        PelBuf     Picture::getOrigBuf(const CompArea &blk)        { return getBuf(blk,  PIC_ORIGINAL); }
 const CPelBuf     Picture::getOrigBuf(const CompArea &blk)  const { return getBuf(blk,  PIC_ORIGINAL); }
        PelUnitBuf Picture::getOrigBuf(const UnitArea &unit)       { return getBuf(unit, PIC_ORIGINAL); }
@@ -959,12 +1025,61 @@ void Picture::restoreSubPicBorder(int POC, int subPicX0, int subPicY0, int subPi
   m_bufWrapSubPicBelow.destroy();
 }
 
+// extends the left and right margins of the rows [yStart, yEnd); a positive xoffset wraps the margins horizontally
+static void extendBorderRows( PelBuf &p, const int xmargin, const int xoffset, const int yStart, const int yEnd )
+{
+  for( int y = yStart; y < yEnd; y++ )
+  {
+    Pel* pi = p.bufAt( 0, y );
+    for( int x = 0; x < xmargin; x++ )
+    {
+      if( x < xoffset )
+      {
+        pi[ -x - 1 ] = pi[ -x - 1 + xoffset ];
+        pi[  p.width + x ] = pi[ p.width + x - xoffset ];
+      }
+      else
+      {
+        pi[ -x - 1 ] = pi[ 0 ];
+        pi[  p.width + x ] = pi[ p.width - 1 ];
+      }
+    }
+  }
+}
+
+// extends the left and right margins, then replicates the first and the last (extended) row into the top and bottom margins;
+// all rows of a stage are independent and are distributed over threads when built with OpenMP
+static void extendBorder( PelBuf &p, const int xmargin, const int ymargin, const int xoffset )
+{
+  const int height = p.height;
+#if _OPENMP
+#pragma omp parallel for schedule( static )
+#endif
+  for( int y = 0; y < height; y += PIC_BORDER_ROW_BAND )
+  {
+    extendBorderRows( p, xmargin, xoffset, y, std::min( y + PIC_BORDER_ROW_BAND, height ) );
+  }
+
+  const Pel* piTop    = p.bufAt( 0, 0 ) - xmargin;
+  const Pel* piBottom = p.bufAt( 0, height - 1 ) - xmargin;
+  const int  lineSize = sizeof( Pel ) * ( p.width + ( xmargin << 1 ) );
+#if _OPENMP
+#pragma omp parallel for schedule( static )
+#endif
+  for( int y = 0; y < ymargin; y++ )
+  {
+    ::memcpy( (Pel*) piBottom + ( y + 1 ) * p.stride, piBottom, lineSize );
+    ::memcpy( (Pel*) piTop    - ( y + 1 ) * p.stride, piTop,    lineSize );
+  }
+}
+
 void Picture::extendPicBorder( const PPS *pps )
 {
   if ( m_bIsBorderExtended )
   {
     if( isWrapAroundEnabled( pps ) && ( !m_wrapAroundValid || m_wrapAroundOffset != pps->getWrapAroundOffset() ) )
     {
+      waitReconComplete();
       extendWrapBorder( pps );
     }
     return;
@@ -974,37 +1089,10 @@ void Picture::extendPicBorder( const PPS *pps )
   {
     ComponentID compID = ComponentID( comp );
     PelBuf p = M_BUFS( 0, PIC_RECONSTRUCTION ).get( compID );
-    Pel *piTxt = p.bufAt(0,0);
     int xmargin = margin >> getComponentScaleX( compID, cs->area.chromaFormat );
     int ymargin = margin >> getComponentScaleY( compID, cs->area.chromaFormat );
 
-    Pel*  pi = piTxt;
-    // do left and right margins
-    for (int y = 0; y < p.height; y++)
-    {
-      for (int x = 0; x < xmargin; x++)
-      {
-        pi[-xmargin + x] = pi[0];
-        pi[p.width + x]  = pi[p.width - 1];
-      }
-      pi += p.stride;
-    }
-
-    // pi is now the (0,height) (bottom left of image within bigger picture
-    pi -= (p.stride + xmargin);
-    // pi is now the (-marginX, height-1)
-    for (int y = 0; y < ymargin; y++ )
-    {
-      ::memcpy( pi + (y+1)*p.stride, pi, sizeof(Pel)*(p.width + (xmargin << 1)));
-    }
-
-    // pi is still (-marginX, height-1)
-    pi -= ((p.height-1) * p.stride);
-    // pi is now (-marginX, 0)
-    for (int y = 0; y < ymargin; y++ )
-    {
-      ::memcpy( pi - (y+1)*p.stride, pi, sizeof(Pel)*(p.width + (xmargin<<1)) );
-    }
+    extendBorder( p, xmargin, ymargin, 0 );
 
     // reference picture with horizontal wrapped boundary
     if ( isWrapAroundEnabled( pps ) )
@@ -1021,6 +1109,83 @@ void Picture::extendPicBorder( const PPS *pps )
   m_bIsBorderExtended = true;
 }
 
+// extends the borders of the final luma lines [lumaStart, lumaEnd) and of the co-located chroma lines, the top and the
+// bottom margins are filled together with the first and the last line of the picture
+void Picture::extendPicBorderRows( const int lumaStart, const int lumaEnd )
+{
+  const int lumaHeight = M_BUFS( 0, PIC_RECONSTRUCTION ).get( COMPONENT_Y ).height;
+
+  for( int comp = 0; comp < getNumberValidComponents( cs->area.chromaFormat ); comp++ )
+  {
+    ComponentID compID = ComponentID( comp );
+    PelBuf p = M_BUFS( 0, PIC_RECONSTRUCTION ).get( compID );
+    const int xmargin = margin >> getComponentScaleX( compID, cs->area.chromaFormat );
+    const int ymargin = margin >> getComponentScaleY( compID, cs->area.chromaFormat );
+    const int scaleY  = getComponentScaleY( compID, cs->area.chromaFormat );
+    const int yStart  = lumaStart >> scaleY;
+    const int yEnd    = lumaEnd == lumaHeight ? (int) p.height : lumaEnd >> scaleY;
+
+    extendBorderRows( p, xmargin, 0, yStart, yEnd );
+
+    const int lineSize = sizeof( Pel ) * ( p.width + ( xmargin << 1 ) );
+    if( yStart == 0 )
+    {
+      const Pel* piTop = p.bufAt( 0, 0 ) - xmargin;
+      for( int y = 0; y < ymargin; y++ )
+      {
+        ::memcpy( (Pel*) piTop - ( y + 1 ) * p.stride, piTop, lineSize );
+      }
+    }
+    if( yEnd == (int) p.height )
+    {
+      const Pel* piBottom = p.bufAt( 0, p.height - 1 ) - xmargin;
+      for( int y = 0; y < ymargin; y++ )
+      {
+        ::memcpy( (Pel*) piBottom + ( y + 1 ) * p.stride, piBottom, lineSize );
+      }
+    }
+  }
+
+  m_wrapAroundValid  = false;
+  m_wrapAroundOffset = 0;
+}
+
+void Picture::startProgress()
+{
+  m_reconProgress.store( 0, std::memory_order_release );
+  m_motionProgress.store( 0, std::memory_order_release );
+}
+
+void Picture::setReconProgress( const int numLumaLines )
+{
+  xSetProgress( m_reconProgress, numLumaLines );
+}
+
+void Picture::setMotionProgress( const int numLumaLines )
+{
+  xSetProgress( m_motionProgress, numLumaLines );
+}
+
+// waits for the luma lines read by the motion compensation of a block, including the interpolation filter support
+void Picture::waitReconArea( const CompArea& blk ) const
+{
+  waitReconLine( ( ( blk.y + blk.height + NTAPS_LUMA ) << getComponentScaleY( blk.compID, chromaFormat ) ) - 1 );
+}
+
+void Picture::xSetProgress( std::atomic<int>& progress, const int numLumaLines )
+{
+  std::lock_guard<std::mutex> lock( m_progressMutex );
+  progress.store( numLumaLines, std::memory_order_release );
+  m_progressCond.notify_all();
+}
+
+void Picture::xWaitProgress( const std::atomic<int>& progress, const int lumaLine ) const
+{
+  const int line = std::max( lumaLine, 0 );
+  std::unique_lock<std::mutex> lock( m_progressMutex );
+  m_progressCond.wait( lock, [&]{ return progress.load( std::memory_order_acquire ) > line; } );
+}
+
 void Picture::extendWrapBorder( const PPS *pps )
 {
   for(int comp=0; comp<getNumberValidComponents( cs->area.chromaFormat ); comp++)
@@ -1028,38 +1193,11 @@ void Picture::extendWrapBorder( const PPS *pps )
     ComponentID compID = ComponentID( comp );
     PelBuf p = M_BUFS( 0, PIC_RECON_WRAP ).get( compID );
     p.copyFrom(M_BUFS( 0, PIC_RECONSTRUCTION ).get( compID ));
-    Pel *piTxt = p.bufAt(0,0);
     int xmargin = margin >> getComponentScaleX( compID, cs->area.chromaFormat );
     int ymargin = margin >> getComponentScaleY( compID, cs->area.chromaFormat );
-    Pel*  pi = piTxt;
     int xoffset = pps->getWrapAroundOffset() >> getComponentScaleX( compID, cs->area.chromaFormat );
-    for (int y = 0; y < p.height; y++)
-    {
-      for (int x = 0; x < xmargin; x++ )
-      {
-        if( x < xoffset )
-        {
-          pi[ -x - 1 ] = pi[ -x - 1 + xoffset ];
-          pi[  p.width + x ] = pi[ p.width + x - xoffset ];
-        }
-        else
-        {
-          pi[ -x - 1 ] = pi[ 0 ];
-          pi[  p.width + x ] = pi[ p.width - 1 ];
-        }
-      }
-      pi += p.stride;
-    }
-    pi -= (p.stride + xmargin);
-    for (int y = 0; y < ymargin; y++ )
-    {
-      ::memcpy( pi + (y+1)*p.stride, pi, sizeof(Pel)*(p.width + (xmargin << 1)));
-    }
-    pi -= ((p.height-1) * p.stride);
-    for (int y = 0; y < ymargin; y++ )
-    {
-      ::memcpy( pi - (y+1)*p.stride, pi, sizeof(Pel)*(p.width + (xmargin<<1)) );
-    }
+
+    extendBorder( p, xmargin, ymargin, xoffset );
   }
   m_wrapAroundValid = true;
   m_wrapAroundOffset = pps->getWrapAroundOffset();
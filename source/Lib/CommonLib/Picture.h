@@ -50,6 +50,9 @@
 #include "MCTS.h"
 #include "SEIColourTransform.h"
 #include <deque>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
 
 
 class SEI;
@@ -69,6 +72,13 @@ struct Picture : public UnitArea
 
   void createTempBuffers( const unsigned _maxCUSize );
   void destroyTempBuffers();
+
+  // memory budget mode of the encoder: buffers of coded pictures are released once they are no longer needed and
+  // re-created when the picture buffer is reused for a new input picture
+  void releaseOrigBuffers();
+  void compactRecoBuffer();
+  void restoreBuffers( const unsigned _maxCUSize, const bool gopBasedTemporalFilterEnabled );
+  bool isRecoBufferCompact() const { return m_isRecoCompact; }
   SEIColourTransformApply* m_colourTranfParams;
   PelStorage*              m_invColourTransfBuf;
   void              createColourTransfProcessor(bool firstPictureInSequence, SEIColourTransformApply* ctiCharacteristics, PelStorage* ctiBuf, int width, int height, ChromaFormat fmt, int bitDepth);
@@ -122,6 +132,7 @@ struct Picture : public UnitArea
 
   void extendPicBorder( const PPS *pps );
   void extendWrapBorder( const PPS *pps );
+  void extendPicBorderRows( const int lumaStart, const int lumaEnd );
   void finalInit( const VPS* vps, const SPS& sps, const PPS& pps, PicHeader *picHeader, APS** alfApss, APS* lmcsAps, APS* scalingListAps );
 
   int  getPOC()                               const { return poc; }
@@ -180,6 +191,29 @@ public:
   void setSubPicSaved(bool bVal) { m_isSubPicBorderSaved = bVal; }
   bool m_bIsBorderExtended;
   bool m_wrapAroundValid;
+  bool m_isRecoCompact;
+
+  // decoding progress of a picture whose in-loop filtering runs behind the reconstruction of the next pictures:
+  // number of final luma lines of the filtered and border extended reconstruction and of the refined motion field
+  void startProgress();
+  void setReconProgress ( const int numLumaLines );
+  void setMotionProgress( const int numLumaLines );
+  bool isReconComplete()                      const { return m_reconProgress.load( std::memory_order_acquire ) == MAX_INT; }
+  void waitReconLine ( const int lumaLine )   const { if( m_reconProgress.load( std::memory_order_acquire ) <= std::max( lumaLine, 0 ) ) { xWaitProgress( m_reconProgress, lumaLine ); } }
+  void waitMotionLine( const int lumaLine )   const { if( m_motionProgress.load( std::memory_order_acquire ) <= std::max( lumaLine, 0 ) ) { xWaitProgress( m_motionProgress, lumaLine ); } }
+  void waitReconComplete()                    const { waitReconLine( MAX_INT - 1 ); }
+  void waitReconArea( const CompArea& blk )   const;
+
+private:
+  void xSetProgress ( std::atomic<int>& progress, const int numLumaLines );
+  void xWaitProgress( const std::atomic<int>& progress, const int lumaLine ) const;
+
+  std::atomic<int>                m_reconProgress;
+  std::atomic<int>                m_motionProgress;
+  mutable std::mutex              m_progressMutex;
+  mutable std::condition_variable m_progressCond;
+
+public:
   unsigned m_wrapAroundOffset;
   bool referenced;
   bool reconstructed;
@@ -125,6 +125,93 @@ QpParam::QpParam(const TransformUnit& tu, const ComponentID &compIDX, const int
 }
 
 
+// ====================================================================================================================
+// Quantization kernels
+// ====================================================================================================================
+
+static void quantCoeffs( const TCoeff* src, TCoeff* dst, TCoeff* deltaU, const int numCoeff, const int* quantCoeff, const int defaultQuantCoeff,
+                         const int64_t add, const int qBits, const TCoeff entropyCodingMinimum, const TCoeff entropyCodingMaximum, TCoeff& absSum )
+{
+  const int qBits8 = qBits - 8;
+
+  for( int n = 0; n < numCoeff; n++ )
+  {
+    const TCoeff  iLevel   = src[n];
+    const TCoeff  iSign    = ( iLevel < 0 ? -1 : 1 );
+    const int64_t tmpLevel = (int64_t) abs( iLevel ) * ( quantCoeff ? quantCoeff[n] : defaultQuantCoeff );
+
+    const TCoeff quantisedMagnitude = TCoeff( ( tmpLevel + add ) >> qBits );
+    deltaU[n] = (TCoeff) ( ( tmpLevel - ( (int64_t) quantisedMagnitude << qBits ) ) >> qBits8 );
+
+    absSum += quantisedMagnitude;
+    dst[n] = Clip3<TCoeff>( entropyCodingMinimum, entropyCodingMaximum, quantisedMagnitude * iSign );
+  }
+}
+
+static void dequantCoeffs( const TCoeff* src, TCoeff* dst, const int numCoeff, const int* dequantCoeff, const int scale, const int rightShift,
+                           const Intermediate_Int inputMinimum, const Intermediate_Int inputMaximum, const TCoeff transformMinimum, const TCoeff transformMaximum )
+{
+  if( rightShift > 0 )
+  {
+    const Intermediate_Int iAdd = (Intermediate_Int) 1 << ( rightShift - 1 );
+
+    for( int n = 0; n < numCoeff; n++ )
+    {
+      const TCoeff           clipQCoef = TCoeff( Clip3<Intermediate_Int>( inputMinimum, inputMaximum, src[n] ) );
+      const Intermediate_Int iCoeffQ   = ( Intermediate_Int( clipQCoef ) * ( dequantCoeff ? dequantCoeff[n] : scale ) + iAdd ) >> rightShift;
+
+      dst[n] = TCoeff( Clip3<Intermediate_Int>( transformMinimum, transformMaximum, iCoeffQ ) );
+    }
+  }
+  else
+  {
+    const int leftShift = -rightShift;
+
+    for( int n = 0; n < numCoeff; n++ )
+    {
+      const TCoeff           clipQCoef = TCoeff( Clip3<Intermediate_Int>( inputMinimum, inputMaximum, src[n] ) );
+      const Intermediate_Int iCoeffQ   = ( Intermediate_Int( clipQCoef ) * ( dequantCoeff ? dequantCoeff[n] : scale ) ) << leftShift;
+
+      dst[n] = TCoeff( Clip3<Intermediate_Int>( transformMinimum, transformMaximum, iCoeffQ ) );
+    }
+  }
+}
+
+static bool anySigCoeff( const TCoeff* src, const int numCoeff, const int* quantCoeff, const int defaultQuantCoeff, const int64_t add, const int qBits )
+{
+  for( int n = 0; n < numCoeff; n++ )
+  {
+    const int64_t tmpLevel = (int64_t) abs( src[n] ) * ( quantCoeff ? quantCoeff[n] : defaultQuantCoeff );
+
+    if( TCoeff( ( tmpLevel + add ) >> qBits ) != 0 )
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+// scaled levels and costs of the zero level of RDOQ for the width x height top-left positions
+static void estimateRdoqLevels( const TCoeff* src, const int stride, const int width, const int height, const int* quantCoeff, const int defaultQuantCoeff,
+                                const double* errScale, const double defaultErrScale, const int qBits, Intermediate_Int* levelDouble, double* costCoeff0 )
+{
+  const int64_t maxLevelDouble = std::numeric_limits<Intermediate_Int>::max() - ( Intermediate_Int( 1 ) << ( qBits - 1 ) );
+
+  for( int y = 0; y < height; y++ )
+  {
+    for( int x = 0; x < width; x++ )
+    {
+      const int     n        = y * stride + x;
+      const int64_t tmpLevel = int64_t( abs( src[n] ) ) * ( quantCoeff ? quantCoeff[n] : defaultQuantCoeff );
+
+      levelDouble[n] = (Intermediate_Int) std::min<int64_t>( tmpLevel, maxLevelDouble );
+
+      const double dErr = double( levelDouble[n] );
+      costCoeff0[n]     = dErr * dErr * ( errScale ? errScale[n] : defaultErrScale );
+    }
+  }
+}
+
 // ====================================================================================================================
 // Quant class member functions
 // ====================================================================================================================
@@ -132,6 +219,17 @@ QpParam::QpParam(const TransformUnit& tu, const ComponentID &compIDX, const int
 Quant::Quant( const Quant* other )
 {
   xInitScalingList( other );
+
+  m_quantCoeffs        = quantCoeffs;
+  m_dequantCoeffs      = dequantCoeffs;
+  m_anySigCoeff        = anySigCoeff;
+  m_estimateRdoqLevels = estimateRdoqLevels;
+
+#if ENABLE_SIMD_OPT_QUANT
+#ifdef TARGET_SIMD_X86
+  initQuantX86();
+#endif
+#endif
 }
 
 Quant::~Quant()
@@ -416,30 +514,7 @@ void Quant::dequant(const TransformUnit &tu,
     const uint32_t uiLog2TrHeight = floorLog2(uiHeight);
     int *piDequantCoef        = getDequantCoeff(scalingListType, QP_rem, uiLog2TrWidth, uiLog2TrHeight);
 
-    if(rightShift > 0)
-    {
-      const Intermediate_Int iAdd = (Intermediate_Int) 1 << (rightShift - 1);
-
-      for( int n = 0; n < numSamplesInBlock; n++ )
-      {
-        const TCoeff           clipQCoef = TCoeff(Clip3<Intermediate_Int>(inputMinimum, inputMaximum, piQCoef[n]));
-        const Intermediate_Int iCoeffQ   = ((Intermediate_Int(clipQCoef) * piDequantCoef[n]) + iAdd ) >> rightShift;
-
-        piCoef[n] = TCoeff(Clip3<Intermediate_Int>(transformMinimum,transformMaximum,iCoeffQ));
-      }
-    }
-    else
-    {
-      const int leftShift = -rightShift;
-
-      for( int n = 0; n < numSamplesInBlock; n++ )
-      {
-        const TCoeff           clipQCoef = TCoeff(Clip3<Intermediate_Int>(inputMinimum, inputMaximum, piQCoef[n]));
-        const Intermediate_Int iCoeffQ   = (Intermediate_Int(clipQCoef) * piDequantCoef[n]) << leftShift;
-
-        piCoef[n] = TCoeff(Clip3<Intermediate_Int>(transformMinimum,transformMaximum,iCoeffQ));
-      }
-    }
+    m_dequantCoeffs( piQCoef, piCoef, numSamplesInBlock, piDequantCoef, 0, rightShift, inputMinimum, inputMaximum, transformMinimum, transformMaximum );
   }
   else
   {
@@ -453,30 +528,7 @@ void Quant::dequant(const TransformUnit &tu,
     const Intermediate_Int inputMinimum        = -(1 << (targetInputBitDepth - 1));
     const Intermediate_Int inputMaximum        =  (1 << (targetInputBitDepth - 1)) - 1;
 
-    if (rightShift > 0)
-    {
-      const Intermediate_Int iAdd = (Intermediate_Int) 1 << (rightShift - 1);
-
-      for( int n = 0; n < numSamplesInBlock; n++ )
-      {
-        const TCoeff           clipQCoef = TCoeff(Clip3<Intermediate_Int>(inputMinimum, inputMaximum, piQCoef[n]));
-        const Intermediate_Int iCoeffQ   = (Intermediate_Int(clipQCoef) * scale + iAdd) >> rightShift;
-
-        piCoef[n] = TCoeff(Clip3<Intermediate_Int>(transformMinimum,transformMaximum,iCoeffQ));
-      }
-    }
-    else
-    {
-      const int leftShift = -rightShift;
-
-      for( int n = 0; n < numSamplesInBlock; n++ )
-      {
-        const TCoeff           clipQCoef = TCoeff(Clip3<Intermediate_Int>(inputMinimum, inputMaximum, piQCoef[n]));
-        const Intermediate_Int iCoeffQ   = (Intermediate_Int(clipQCoef) * scale) << leftShift;
-
-        piCoef[n] = TCoeff(Clip3<Intermediate_Int>(transformMinimum,transformMaximum,iCoeffQ));
-      }
-    }
+    m_dequantCoeffs( piQCoef, piCoef, numSamplesInBlock, nullptr, scale, rightShift, inputMinimum, inputMaximum, transformMinimum, transformMaximum );
   }
 }
 
@@ -1009,27 +1061,37 @@ void Quant::quant(TransformUnit &tu, const ComponentID &compID, const CCoeffBuf
     const int qBits8 = iQBits - 8;
 
     const uint32_t lfnstIdx = tu.cu->lfnstIdx;
-    const int maxNumberOfCoeffs = lfnstIdx > 0 ? ((( uiWidth == 4 && uiHeight == 4 ) || ( uiWidth == 8 && uiHeight == 8) ) ? 8 : 16) : piQCoef.area();
-    memset( piQCoef.buf, 0, sizeof(TCoeff) * piQCoef.area() );
 
-    const ScanElement* scan = g_scanOrder[SCAN_GROUPED_4x4][SCAN_DIAG][gp_sizeIdxInfo->idxFrom(uiWidth)][gp_sizeIdxInfo->idxFrom(uiHeight)];
-
-    for (int uiScanPos = 0; uiScanPos < maxNumberOfCoeffs; uiScanPos++)
+    if( lfnstIdx == 0 )
     {
-      const int uiBlockPos = scan[uiScanPos].idx;
-      const TCoeff iLevel   = piCoef.buf[uiBlockPos];
-      const TCoeff iSign    = (iLevel < 0 ? -1: 1);
+      // all positions of the block are quantized, the scan order does not matter
+      m_quantCoeffs( piCoef.buf, piQCoef.buf, deltaU, piQCoef.area(), enableScalingLists ? piQuantCoeff : nullptr, defaultQuantisationCoefficient,
+                     iAdd, iQBits, entropyCodingMinimum, entropyCodingMaximum, uiAbsSum );
+    }
+    else
+    {
+      const int maxNumberOfCoeffs = (( uiWidth == 4 && uiHeight == 4 ) || ( uiWidth == 8 && uiHeight == 8) ) ? 8 : 16;
+      memset( piQCoef.buf, 0, sizeof(TCoeff) * piQCoef.area() );
+
+      const ScanElement* scan = g_scanOrder[SCAN_GROUPED_4x4][SCAN_DIAG][gp_sizeIdxInfo->idxFrom(uiWidth)][gp_sizeIdxInfo->idxFrom(uiHeight)];
+
+      for (int uiScanPos = 0; uiScanPos < maxNumberOfCoeffs; uiScanPos++)
+      {
+        const int uiBlockPos = scan[uiScanPos].idx;
+        const TCoeff iLevel   = piCoef.buf[uiBlockPos];
+        const TCoeff iSign    = (iLevel < 0 ? -1: 1);
 
-      const int64_t  tmpLevel = (int64_t)abs(iLevel) * (enableScalingLists ? piQuantCoeff[uiBlockPos] : defaultQuantisationCoefficient);
+        const int64_t  tmpLevel = (int64_t)abs(iLevel) * (enableScalingLists ? piQuantCoeff[uiBlockPos] : defaultQuantisationCoefficient);
 
-      const TCoeff quantisedMagnitude = TCoeff((tmpLevel + iAdd ) >> iQBits);
-      deltaU[uiBlockPos] = (TCoeff)((tmpLevel - ((int64_t)quantisedMagnitude<<iQBits) )>> qBits8);
+        const TCoeff quantisedMagnitude = TCoeff((tmpLevel + iAdd ) >> iQBits);
+        deltaU[uiBlockPos] = (TCoeff)((tmpLevel - ((int64_t)quantisedMagnitude<<iQBits) )>> qBits8);
 
-      uiAbsSum += quantisedMagnitude;
-      const TCoeff quantisedCoefficient = quantisedMagnitude * iSign;
+        uiAbsSum += quantisedMagnitude;
+        const TCoeff quantisedCoefficient = quantisedMagnitude * iSign;
 
-      piQCoef.buf[uiBlockPos] = Clip3<TCoeff>( entropyCodingMinimum, entropyCodingMaximum, quantisedCoefficient );
-    } // for n
+        piQCoef.buf[uiBlockPos] = Clip3<TCoeff>( entropyCodingMinimum, entropyCodingMaximum, quantisedCoefficient );
+      } // for n
+    }
     if ((tu.cu->bdpcmMode && isLuma(compID)) || (tu.cu->bdpcmModeChroma && isChroma(compID)) )
     {
       fwdResDPCM( tu, compID );
@@ -1092,18 +1154,7 @@ bool Quant::xNeedRDOQ(TransformUnit &tu, const ComponentID &compID, const CCoeff
   // iAdd is different from the iAdd used in normal quantization
   const int64_t iAdd = int64_t(compID == COMPONENT_Y ? 171 : 256) << (iQBits - 9);
 
-  for (int uiBlockPos = 0; uiBlockPos < rect.area(); uiBlockPos++)
-  {
-    const TCoeff iLevel   = piCoef.buf[uiBlockPos];
-    const int64_t  tmpLevel = (int64_t)abs(iLevel) * (enableScalingLists ? piQuantCoeff[uiBlockPos] : defaultQuantisationCoefficient);
-    const TCoeff quantisedMagnitude = TCoeff((tmpLevel + iAdd ) >> iQBits);
-
-    if (quantisedMagnitude != 0)
-    {
-      return true;
-    }
-  } // for n
-  return false;
+  return m_anySigCoeff( piCoef.buf, rect.area(), enableScalingLists ? piQuantCoeff : nullptr, defaultQuantisationCoefficient, iAdd, iQBits );
 }
 
 
@@ -58,6 +58,15 @@ struct TrQuantParams
   int     qScale;
 };
 
+// raster kernels of the quantizer, the quantization matrices quantCoeff / dequantCoeff are nullptr for flat scaling
+typedef void QuantCoeffsFunc      ( const TCoeff* src, TCoeff* dst, TCoeff* deltaU, const int numCoeff, const int* quantCoeff, const int defaultQuantCoeff,
+                                    const int64_t add, const int qBits, const TCoeff entropyCodingMinimum, const TCoeff entropyCodingMaximum, TCoeff& absSum );
+typedef void DequantCoeffsFunc    ( const TCoeff* src, TCoeff* dst, const int numCoeff, const int* dequantCoeff, const int scale, const int rightShift,
+                                    const Intermediate_Int inputMinimum, const Intermediate_Int inputMaximum, const TCoeff transformMinimum, const TCoeff transformMaximum );
+typedef bool AnySigCoeffFunc      ( const TCoeff* src, const int numCoeff, const int* quantCoeff, const int defaultQuantCoeff, const int64_t add, const int qBits );
+typedef void EstimateRdoqLevelsFunc( const TCoeff* src, const int stride, const int width, const int height, const int* quantCoeff, const int defaultQuantCoeff,
+                                    const double* errScale, const double defaultErrScale, const int qBits, Intermediate_Int* levelDouble, double* costCoeff0 );
+
 /// QP struct
 class QpParam
 {
@@ -140,6 +149,14 @@ public:
   // de-quantization
   virtual void dequant           ( const TransformUnit &tu, CoeffBuf &dstCoeff, const ComponentID &compID, const QpParam &cQP );
 
+#if ENABLE_SIMD_OPT_QUANT
+#ifdef TARGET_SIMD_X86
+  void initQuantX86();
+  template <X86_VEXT vext>
+  void _initQuantX86();
+#endif
+#endif
+
 protected:
 
 #if T0196_SELECTIVE_RDOQ
@@ -153,6 +170,11 @@ protected:
 #if T0196_SELECTIVE_RDOQ
   bool     m_useSelectiveRDOQ;
 #endif
+
+  QuantCoeffsFunc        *m_quantCoeffs;
+  DequantCoeffsFunc      *m_dequantCoeffs;
+  AnySigCoeffFunc        *m_anySigCoeff;
+  EstimateRdoqLevelsFunc *m_estimateRdoqLevels;
 private:
   void xInitScalingList   ( const Quant* other );
   void xDestroyScalingList();
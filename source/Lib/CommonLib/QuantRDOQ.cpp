@@ -679,6 +679,12 @@ void QuantRDOQ::xRateDistOptQuant(TransformUnit &tu, const ComponentID &compID,
 
   const int iCGNum = lfnstIdx > 0 ? 1 : std::min<int>(JVET_C0024_ZERO_OUT_TH, uiWidth) * std::min<int>(JVET_C0024_ZERO_OUT_TH, uiHeight) >> cctx.log2CGSize();
 
+  // scaled levels and zero level costs of all positions of the coded coefficient groups
+  const int levelsWidth  = lfnstIdx > 0 ? 1 << cctx.log2CGWidth()  : std::min<int>(JVET_C0024_ZERO_OUT_TH, uiWidth);
+  const int levelsHeight = lfnstIdx > 0 ? 1 << cctx.log2CGHeight() : std::min<int>(JVET_C0024_ZERO_OUT_TH, uiHeight);
+  m_estimateRdoqLevels( plSrcCoeff, uiWidth, levelsWidth, levelsHeight, enableScalingLists ? piQCoef : nullptr, defaultQuantisationCoefficient,
+                        enableScalingLists ? pdErrScale : nullptr, defaultErrorScale, iQBits, m_levelDouble, m_blkCostCoeff0 );
+
   for (int subSetId = iCGNum - 1; subSetId >= 0; subSetId--)
   {
     cctx.initSubblock( subSetId );
@@ -704,16 +710,13 @@ void QuantRDOQ::xRateDistOptQuant(TransformUnit &tu, const ComponentID &compID,
       uint32_t    uiBlkPos          = cctx.blockPos(iScanPos);
 
       // set coeff
-      const int    quantisationCoefficient = (enableScalingLists) ? piQCoef   [uiBlkPos]               : defaultQuantisationCoefficient;
       const double errorScale              = (enableScalingLists) ? pdErrScale[uiBlkPos]               : defaultErrorScale;
-      const int64_t  tmpLevel                = int64_t(abs(plSrcCoeff[ uiBlkPos ])) * quantisationCoefficient;
 
-      const Intermediate_Int lLevelDouble  = (Intermediate_Int)std::min<int64_t>(tmpLevel, std::numeric_limits<Intermediate_Int>::max() - (Intermediate_Int(1) << (iQBits - 1)));
+      const Intermediate_Int lLevelDouble  = m_levelDouble[uiBlkPos];
 
       uint32_t uiMaxAbsLevel        = std::min<uint32_t>(uint32_t(entropyCodingMaximum), uint32_t((lLevelDouble + (Intermediate_Int(1) << (iQBits - 1))) >> iQBits));
 
-      const double dErr         = double( lLevelDouble );
-      pdCostCoeff0[ iScanPos ]  = dErr * dErr * errorScale;
+      pdCostCoeff0[ iScanPos ]  = m_blkCostCoeff0[uiBlkPos];
       d64BlockUncodedCost      += pdCostCoeff0[ iScanPos ];
       piDstCoeff[ uiBlkPos ]    = uiMaxAbsLevel;
 
@@ -167,6 +167,9 @@ private:
   int    m_sigRateDelta       [MAX_TB_SIZEY * MAX_TB_SIZEY];
   TCoeff m_deltaU             [MAX_TB_SIZEY * MAX_TB_SIZEY];
   TCoeff m_fullCoeff          [MAX_TB_SIZEY * MAX_TB_SIZEY];
+  // scaled levels and zero level costs of the level estimation, in raster order
+  Intermediate_Int m_levelDouble  [MAX_TB_SIZEY * MAX_TB_SIZEY];
+  double           m_blkCostCoeff0[MAX_TB_SIZEY * MAX_TB_SIZEY];
   int   m_bdpcm;
   int   m_testedLevels;
 };// END CLASS DEFINITION QuantRDOQ
@@ -110,9 +110,62 @@ const SAOBlkParam& SAOBlkParam::operator= (const SAOBlkParam& src)
 
 
 
+// ====================================================================================================================
+// Offset and statistics kernels
+// ====================================================================================================================
+
+static void offsetEdgeRows( const ClpRng& clpRng, const int* offset, const Pel* src, const ptrdiff_t srcStride, Pel* res, const ptrdiff_t resStride,
+                            const int startX, const int endX, const int numRows, const ptrdiff_t nbOffset )
+{
+  for( int y = 0; y < numRows; y++, src += srcStride, res += resStride )
+  {
+    for( int x = startX; x < endX; x++ )
+    {
+      const int edgeType = sgn( src[x] - src[x - nbOffset] ) + sgn( src[x] - src[x + nbOffset] );
+      res[x] = ClipPel<int>( src[x] + offset[edgeType], clpRng );
+    }
+  }
+}
+
+static void offsetBand( const ClpRng& clpRng, const int* offset, const int shiftBits, const Pel* src, const ptrdiff_t srcStride, Pel* res, const ptrdiff_t resStride,
+                        const int width, const int height )
+{
+  for( int y = 0; y < height; y++, src += srcStride, res += resStride )
+  {
+    for( int x = 0; x < width; x++ )
+    {
+      res[x] = ClipPel<int>( src[x] + offset[src[x] >> shiftBits], clpRng );
+    }
+  }
+}
+
+static void calcEdgeStats( const Pel* src, const ptrdiff_t srcStride, const Pel* org, const ptrdiff_t orgStride, const int startX, const int endX,
+                           const int numRows, const ptrdiff_t nbOffset, int64_t* diff, int64_t* count )
+{
+  for( int y = 0; y < numRows; y++, src += srcStride, org += orgStride )
+  {
+    for( int x = startX; x < endX; x++ )
+    {
+      const int edgeType = sgn( src[x] - src[x - nbOffset] ) + sgn( src[x] - src[x + nbOffset] );
+      diff [edgeType] += org[x] - src[x];
+      count[edgeType]++;
+    }
+  }
+}
+
 SampleAdaptiveOffset::SampleAdaptiveOffset()
 {
   m_numberOfComponents = 0;
+
+  m_offsetEdgeRows = offsetEdgeRows;
+  m_offsetBand     = offsetBand;
+  m_calcEdgeStats  = calcEdgeStats;
+
+#if ENABLE_SIMD_OPT_SAO
+#ifdef TARGET_SIMD_X86
+  initSampleAdaptiveOffsetX86();
+#endif
+#endif
 }
 
 
@@ -300,6 +353,56 @@ void SampleAdaptiveOffset::offsetBlock(const int channelBitDepth, const ClpRng&
   int firstLineStartX, firstLineEndX, lastLineStartX, lastLineEndX;
   int8_t signLeft, signRight, signDown;
 
+  if( typeIdx == SAO_TYPE_BO )
+  {
+    m_offsetBand( clpRng, offset, channelBitDepth - NUM_SAO_BO_CLASSES_LOG2, srcBlk, srcStride, resBlk, resStride, width, height );
+    return;
+  }
+
+  if( !isCtuCrossedByVirtualBoundaries )
+  {
+    // the edge class of a sample only depends on its two neighbours, the first and the last line of the diagonal
+    // classes have their own ranges due to the availability of the corner CTUs
+    switch( typeIdx )
+    {
+    case SAO_TYPE_EO_0:
+      startX = isLeftAvail ? 0 : 1;
+      endX   = isRightAvail ? width : ( width - 1 );
+      m_offsetEdgeRows( clpRng, offset + 2, srcBlk, srcStride, resBlk, resStride, startX, endX, height, 1 );
+      break;
+    case SAO_TYPE_EO_90:
+      startY = isAboveAvail ? 0 : 1;
+      endY   = isBelowAvail ? height : ( height - 1 );
+      m_offsetEdgeRows( clpRng, offset + 2, srcBlk + startY * srcStride, srcStride, resBlk + startY * resStride, resStride, 0, width, endY - startY, srcStride );
+      break;
+    case SAO_TYPE_EO_135:
+      startX          = isLeftAvail ? 0 : 1;
+      endX            = isRightAvail ? width : ( width - 1 );
+      firstLineStartX = isAboveLeftAvail ? 0 : 1;
+      firstLineEndX   = isAboveAvail ? endX : 1;
+      lastLineStartX  = isBelowAvail ? startX : ( width - 1 );
+      lastLineEndX    = isBelowRightAvail ? width : ( width - 1 );
+      m_offsetEdgeRows( clpRng, offset + 2, srcBlk, srcStride, resBlk, resStride, firstLineStartX, firstLineEndX, 1, srcStride + 1 );
+      m_offsetEdgeRows( clpRng, offset + 2, srcBlk + srcStride, srcStride, resBlk + resStride, resStride, startX, endX, height - 2, srcStride + 1 );
+      m_offsetEdgeRows( clpRng, offset + 2, srcBlk + ( height - 1 ) * srcStride, srcStride, resBlk + ( height - 1 ) * resStride, resStride, lastLineStartX, lastLineEndX, 1, srcStride + 1 );
+      break;
+    case SAO_TYPE_EO_45:
+      startX          = isLeftAvail ? 0 : 1;
+      endX            = isRightAvail ? width : ( width - 1 );
+      firstLineStartX = isAboveAvail ? startX : ( width - 1 );
+      firstLineEndX   = isAboveRightAvail ? width : ( width - 1 );
+      lastLineStartX  = isBelowLeftAvail ? 0 : 1;
+      lastLineEndX    = isBelowAvail ? endX : 1;
+      m_offsetEdgeRows( clpRng, offset + 2, srcBlk, srcStride, resBlk, resStride, firstLineStartX, firstLineEndX, 1, srcStride - 1 );
+      m_offsetEdgeRows( clpRng, offset + 2, srcBlk + srcStride, srcStride, resBlk + resStride, resStride, startX, endX, height - 2, srcStride - 1 );
+      m_offsetEdgeRows( clpRng, offset + 2, srcBlk + ( height - 1 ) * srcStride, srcStride, resBlk + ( height - 1 ) * resStride, resStride, lastLineStartX, lastLineEndX, 1, srcStride - 1 );
+      break;
+    default:
+      THROW( "Not a supported SAO types\n" );
+    }
+    return;
+  }
+
   const Pel* srcLine = srcBlk;
         Pel* resLine = resBlk;
 
@@ -525,20 +628,6 @@ void SampleAdaptiveOffset::offsetBlock(const int channelBitDepth, const ClpRng&
       }
     }
     break;
-  case SAO_TYPE_BO:
-    {
-      const int shiftBits = channelBitDepth - NUM_SAO_BO_CLASSES_LOG2;
-      for (y=0; y< height; y++)
-      {
-        for (x=0; x< width; x++)
-        {
-          resLine[x] = ClipPel<int>(srcLine[x] + offset[srcLine[x] >> shiftBits], clpRng );
-        }
-        srcLine += srcStride;
-        resLine += resStride;
-      }
-    }
-    break;
   default:
     {
       THROW("Not a supported SAO types\n");
@@ -617,6 +706,32 @@ void SampleAdaptiveOffset::offsetCTU( const UnitArea& area, const CPelUnitBuf& s
 
 void SampleAdaptiveOffset::SAOProcess( CodingStructure& cs, SAOBlkParam* saoBlkParams
                                       )
+{
+  if( !SAOPrepare( cs, saoBlkParams ) )
+  {
+    return;
+  }
+
+  const PreCalcValues& pcv = *cs.pcv;
+  SAOCopyLines( cs, 0, pcv.lumaHeight );
+
+  for( int ctuRow = 0; ctuRow < pcv.heightInCtus; ctuRow++ )
+  {
+    SAOProcessCtuRow( cs, ctuRow );
+  }
+
+  DTRACE_UPDATE(g_trace_ctx, (std::make_pair("poc", cs.slice->getPOC())));
+  DTRACE_PIC_COMP(D_REC_CB_LUMA_SAO, cs, cs.getRecoBuf(), COMPONENT_Y);
+  DTRACE_PIC_COMP(D_REC_CB_CHROMA_SAO, cs, cs.getRecoBuf(), COMPONENT_Cb);
+  DTRACE_PIC_COMP(D_REC_CB_CHROMA_SAO, cs, cs.getRecoBuf(), COMPONENT_Cr);
+
+  DTRACE    ( g_trace_ctx, D_CRC, "SAO" );
+  DTRACE_CRC( g_trace_ctx, D_CRC, cs, cs.getRecoBuf() );
+
+}
+
+
+bool SampleAdaptiveOffset::SAOPrepare( CodingStructure& cs, SAOBlkParam* saoBlkParams )
 {
   CHECK(!saoBlkParams, "No parameters present");
 
@@ -631,40 +746,37 @@ void SampleAdaptiveOffset::SAOProcess( CodingStructure& cs, SAOBlkParam* saoBlkP
       bAllDisabled = false;
     }
   }
-  if (bAllDisabled)
+  return !bAllDisabled;
+}
+
+void SampleAdaptiveOffset::SAOCopyLines( CodingStructure& cs, const int lumaStart, const int lumaEnd )
+{
+  if( lumaEnd <= lumaStart )
   {
     return;
   }
+  const UnitArea lines( cs.area.chromaFormat, Area( 0, lumaStart, cs.pcv->lumaWidth, lumaEnd - lumaStart ) );
+  m_tempBuf.subBuf( lines ).copyFrom( cs.getRecoBuf( lines ) );
+}
 
+void SampleAdaptiveOffset::SAOProcessCtuRow( CodingStructure& cs, const int ctuRow )
+{
   const PreCalcValues& pcv = *cs.pcv;
   PelUnitBuf rec = cs.getRecoBuf();
-  m_tempBuf.copyFrom( rec );
 
-  int ctuRsAddr = 0;
-  for( uint32_t yPos = 0; yPos < pcv.lumaHeight; yPos += pcv.maxCUHeight )
+  const uint32_t yPos   = ctuRow * pcv.maxCUHeight;
+  const uint32_t height = (yPos + pcv.maxCUHeight > pcv.lumaHeight) ? (pcv.lumaHeight - yPos) : pcv.maxCUHeight;
+  int ctuRsAddr = ctuRow * pcv.widthInCtus;
+  for( uint32_t xPos = 0; xPos < pcv.lumaWidth; xPos += pcv.maxCUWidth )
   {
-    for( uint32_t xPos = 0; xPos < pcv.lumaWidth; xPos += pcv.maxCUWidth )
-    {
-      const uint32_t width  = (xPos + pcv.maxCUWidth  > pcv.lumaWidth)  ? (pcv.lumaWidth - xPos)  : pcv.maxCUWidth;
-      const uint32_t height = (yPos + pcv.maxCUHeight > pcv.lumaHeight) ? (pcv.lumaHeight - yPos) : pcv.maxCUHeight;
-      const UnitArea area( cs.area.chromaFormat, Area(xPos , yPos, width, height) );
+    const uint32_t width  = (xPos + pcv.maxCUWidth  > pcv.lumaWidth)  ? (pcv.lumaWidth - xPos)  : pcv.maxCUWidth;
+    const UnitArea area( cs.area.chromaFormat, Area(xPos , yPos, width, height) );
 
-      offsetCTU( area, m_tempBuf, rec, cs.picture->getSAO()[ctuRsAddr], cs);
-      ctuRsAddr++;
-    }
+    offsetCTU( area, m_tempBuf, rec, cs.picture->getSAO()[ctuRsAddr], cs);
+    ctuRsAddr++;
   }
-
-  DTRACE_UPDATE(g_trace_ctx, (std::make_pair("poc", cs.slice->getPOC())));
-  DTRACE_PIC_COMP(D_REC_CB_LUMA_SAO, cs, cs.getRecoBuf(), COMPONENT_Y);
-  DTRACE_PIC_COMP(D_REC_CB_CHROMA_SAO, cs, cs.getRecoBuf(), COMPONENT_Cb);
-  DTRACE_PIC_COMP(D_REC_CB_CHROMA_SAO, cs, cs.getRecoBuf(), COMPONENT_Cr);
-
-  DTRACE    ( g_trace_ctx, D_CRC, "SAO" );
-  DTRACE_CRC( g_trace_ctx, D_CRC, cs, cs.getRecoBuf() );
-
 }
 
-
 void SampleAdaptiveOffset::deriveLoopFilterBoundaryAvailibility(CodingStructure& cs, const Position &pos,
   bool& isLeftAvail,
   bool& isRightAvail,
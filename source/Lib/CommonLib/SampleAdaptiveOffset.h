@@ -67,10 +67,22 @@ public:
   virtual ~SampleAdaptiveOffset();
   void SAOProcess( CodingStructure& cs, SAOBlkParam* saoBlkParams
                    );
+  // CTU row interface of SAOProcess(): the deblocked lines are copied before the CTU rows they border are offset
+  bool SAOPrepare      ( CodingStructure& cs, SAOBlkParam* saoBlkParams );
+  void SAOCopyLines    ( CodingStructure& cs, const int lumaStart, const int lumaEnd );
+  void SAOProcessCtuRow( CodingStructure& cs, const int ctuRow );
   void create( int picWidth, int picHeight, ChromaFormat format, uint32_t maxCUWidth, uint32_t maxCUHeight, uint32_t maxCUDepth, uint32_t lumaBitShift, uint32_t chromaBitShift );
   void destroy();
   static int getMaxOffsetQVal(const int channelBitDepth) { return (1<<(std::min<int>(channelBitDepth,MAX_SAO_TRUNCATED_BITDEPTH)-5))-1; } //Table 9-32, inclusive
   void setReshaper(Reshape * p) { m_pcReshape = p; }
+
+#if ENABLE_SIMD_OPT_SAO
+#ifdef TARGET_SIMD_X86
+  void initSampleAdaptiveOffsetX86();
+  template <X86_VEXT vext>
+  void _initSampleAdaptiveOffsetX86();
+#endif
+#endif
 protected:
   void deriveLoopFilterBoundaryAvailibility(CodingStructure& cs, const Position &pos,
     bool& isLeftAvail,
@@ -122,6 +134,12 @@ protected:
 
   std::vector<int8_t> m_signLineBuf1;
   std::vector<int8_t> m_signLineBuf2;
+
+  // offset and statistics kernels for the rows of blocks not crossed by virtual boundaries, the edge class of a sample
+  // is given by its neighbours at -nbOffset and nbOffset, offset, diff and count point to the entries of edge class 0
+  void ( *m_offsetEdgeRows )( const ClpRng& clpRng, const int* offset, const Pel* src, const ptrdiff_t srcStride, Pel* res, const ptrdiff_t resStride, const int startX, const int endX, const int numRows, const ptrdiff_t nbOffset );
+  void ( *m_offsetBand     )( const ClpRng& clpRng, const int* offset, const int shiftBits, const Pel* src, const ptrdiff_t srcStride, Pel* res, const ptrdiff_t resStride, const int width, const int height );
+  void ( *m_calcEdgeStats  )( const Pel* src, const ptrdiff_t srcStride, const Pel* org, const ptrdiff_t orgStride, const int startX, const int endX, const int numRows, const ptrdiff_t nbOffset, int64_t* diff, int64_t* count );
 private:
   bool m_picSAOEnabled[MAX_NUM_COMPONENT];
 };
@@ -54,6 +54,9 @@
 typedef void FwdTrans(const TCoeff*, TCoeff*, int, int, int, int);
 typedef void InvTrans(const TCoeff*, TCoeff*, int, int, int, int, const TCoeff, const TCoeff);
 
+extern FwdTrans *fastFwdTrans[NUM_TRANS_TYPE][g_numTransformMatrixSizes];
+extern InvTrans *fastInvTrans[NUM_TRANS_TYPE][g_numTransformMatrixSizes];
+
 // ====================================================================================================================
 // Class definition
 // ====================================================================================================================
@@ -115,6 +118,14 @@ public:
   void   lambdaAdjustColorTrans(bool forward) { m_quant->lambdaAdjustColorTrans(forward); }
   void   resetStore() { m_quant->resetStore(); }
 
+#if ENABLE_SIMD_OPT_TRAFO
+#ifdef TARGET_SIMD_X86
+  void initTrQuantX86();
+  template <X86_VEXT vext>
+  void _initTrQuantX86();
+#endif
+#endif
+
 protected:
   TCoeff   m_tempCoeff[MAX_TB_SIZEY * MAX_TB_SIZEY];
 
@@ -128,6 +139,8 @@ private:
   std::pair<int64_t,int64_t>(*m_fwdICTMem[1+2*maxAbsIctMode])(const PelBuf&,const PelBuf&,PelBuf&,PelBuf&);
   void                      (**m_invICT)(PelBuf&,PelBuf&);
   std::pair<int64_t,int64_t>(**m_fwdICT)(const PelBuf&,const PelBuf&,PelBuf&,PelBuf&);
+  FwdTrans                   *m_fwdTrans[NUM_TRANS_TYPE][g_numTransformMatrixSizes];
+  InvTrans                   *m_invTrans[NUM_TRANS_TYPE][g_numTransformMatrixSizes];
 
 
   // forward Transform
@@ -189,6 +189,13 @@ typedef std::pair<int, int>  TrCost;
 #define ENABLE_SIMD_OPT_DIST                            ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the distortion calculations(SAD,SSE,HADAMARD), no impact on RD performance
 #define ENABLE_SIMD_OPT_AFFINE_ME                       ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for affine ME, no impact on RD performance
 #define ENABLE_SIMD_OPT_ALF                             ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for ALF
+#define ENABLE_SIMD_OPT_HASH                            ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the CRC32C block hashes of hash ME and IBC, no impact on RD performance
+#define ENABLE_SIMD_OPT_TRAFO                           ( 1 && ENABLE_SIMD_OPT && !RExt__HIGH_BIT_DEPTH_SUPPORT ) ///< SIMD optimization for the primary transforms (DCT-II, DST-VII, DCT-VIII), no impact on RD performance
+#define ENABLE_SIMD_OPT_DEPQUANT                        ( 1 && ENABLE_SIMD_OPT && !RExt__HIGH_BIT_DEPTH_SUPPORT ) ///< SIMD optimization for the rd cost decisions of the dependent quantization trellis, no impact on RD performance
+#define ENABLE_SIMD_OPT_QUANT                           ( 1 && ENABLE_SIMD_OPT && !RExt__HIGH_BIT_DEPTH_SUPPORT ) ///< SIMD optimization for the quantization, dequantization and the level estimation of RDOQ, no impact on RD performance
+#define ENABLE_SIMD_OPT_INTRAPRED                       ( 1 && ENABLE_SIMD_OPT && !RExt__HIGH_BIT_DEPTH_SUPPORT ) ///< SIMD optimization for the planar, DC, angular and matrix intra prediction and the PDPC, no impact on RD performance
+#define ENABLE_SIMD_OPT_DEBLOCK                         ( 1 && ENABLE_SIMD_OPT && !RExt__HIGH_BIT_DEPTH_SUPPORT ) ///< SIMD optimization for the deblocking edge filters and the motion vector check of the boundary strength, no impact on RD performance
+#define ENABLE_SIMD_OPT_SAO                             ( 1 && ENABLE_SIMD_OPT && !RExt__HIGH_BIT_DEPTH_SUPPORT ) ///< SIMD optimization for the SAO edge and band offsets and the edge offset statistics, no impact on RD performance
 #if ENABLE_SIMD_OPT_BUFFER
 #define ENABLE_SIMD_OPT_BCW                               1                                                 ///< SIMD optimization for Bcw
 #endif
@@ -856,7 +863,7 @@ enum ImvMode
 // Viewport adaptive
 //////////////////////////////////////////////////////////////////////////
 
-enum Viewport {
+enum Viewport : int8_t {
   CLASSIC,
   FRONT_BACK,
   LEFT_RIGHT,
@@ -1282,6 +1289,36 @@ public:
   }
 };
 
+// ---------------------------------------------------------------------------
+// dynamic arena
+// ---------------------------------------------------------------------------
+
+// bump allocator over objects taken from a dynamic_cache: the objects stay with the arena when it is reset, so that
+// resetting is O(1) and the same objects are handed out again in the same order
+template<typename T>
+class dynamic_arena
+{
+  dynamic_cache<T>& m_cache;
+  std::vector<T*>   m_entries;
+
+public:
+  dynamic_arena( dynamic_cache<T>& cache ) : m_cache( cache ) {}
+
+  T* get( size_t idx )
+  {
+    if( idx == m_entries.size() )
+    {
+      m_entries.push_back( m_cache.get() );
+    }
+    return m_entries[idx];
+  }
+
+  void release()
+  {
+    m_cache.cache( m_entries );
+  }
+};
+
 typedef dynamic_cache<struct CodingUnit    > CUCache;
 typedef dynamic_cache<struct PredictionUnit> PUCache;
 typedef dynamic_cache<struct TransformUnit > TUCache;
@@ -376,7 +376,7 @@ struct IntraPredictionData
 };
 
 /// Forward declare enum viewport
-enum Viewport;
+enum Viewport : int8_t;
 
 struct InterPredictionData
 {
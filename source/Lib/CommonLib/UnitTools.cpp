@@ -64,39 +64,57 @@ UnitArea CS::getArea( const CodingStructure &cs, const UnitArea &area, const Cha
   return isDualITree( cs ) || cs.treeType != TREE_D ? area.singleChan( chType ) : area;
 }
 
-void CS::setRefinedMotionField(CodingStructure &cs)
+static void setRefinedMotionFieldCU( CodingUnit &cu )
 {
-  for (CodingUnit *cu : cs.cus)
-  {
-    for (auto &pu : CU::traversePUs(*cu))
+  for (auto &pu : CU::traversePUs(cu))
+  {
+    PredictionUnit subPu = pu;
+    int dx, dy, x, y, num = 0;
+    dy = std::min<int>(pu.lumaSize().height, DMVR_SUBCU_HEIGHT);
+    dx = std::min<int>(pu.lumaSize().width, DMVR_SUBCU_WIDTH);
+    Position puPos = pu.lumaPos();
+    if (PU::checkDMVRCondition(pu))
     {
-      PredictionUnit subPu = pu;
-      int dx, dy, x, y, num = 0;
-      dy = std::min<int>(pu.lumaSize().height, DMVR_SUBCU_HEIGHT);
-      dx = std::min<int>(pu.lumaSize().width, DMVR_SUBCU_WIDTH);
-      Position puPos = pu.lumaPos();
-      if (PU::checkDMVRCondition(pu))
+      for (y = puPos.y; y < (puPos.y + pu.lumaSize().height); y = y + dy)
       {
-        for (y = puPos.y; y < (puPos.y + pu.lumaSize().height); y = y + dy)
+        for (x = puPos.x; x < (puPos.x + pu.lumaSize().width); x = x + dx)
         {
-          for (x = puPos.x; x < (puPos.x + pu.lumaSize().width); x = x + dx)
-          {
-            subPu.UnitArea::operator=(UnitArea(pu.chromaFormat, Area(x, y, dx, dy)));
-            subPu.mv[0] = pu.mv[0];
-            subPu.mv[1] = pu.mv[1];
-            subPu.mv[REF_PIC_LIST_0] += pu.mvdL0SubPu[num];
-            subPu.mv[REF_PIC_LIST_1] -= pu.mvdL0SubPu[num];
-            subPu.mv[REF_PIC_LIST_0].clipToStorageBitDepth();
-            subPu.mv[REF_PIC_LIST_1].clipToStorageBitDepth();
-            pu.mvdL0SubPu[num].setZero();
-            num++;
-            PU::spanMotionInfo(subPu);
-          }
+          subPu.UnitArea::operator=(UnitArea(pu.chromaFormat, Area(x, y, dx, dy)));
+          subPu.mv[0] = pu.mv[0];
+          subPu.mv[1] = pu.mv[1];
+          subPu.mv[REF_PIC_LIST_0] += pu.mvdL0SubPu[num];
+          subPu.mv[REF_PIC_LIST_1] -= pu.mvdL0SubPu[num];
+          subPu.mv[REF_PIC_LIST_0].clipToStorageBitDepth();
+          subPu.mv[REF_PIC_LIST_1].clipToStorageBitDepth();
+          pu.mvdL0SubPu[num].setZero();
+          num++;
+          PU::spanMotionInfo(subPu);
         }
       }
     }
   }
 }
+
+void CS::setRefinedMotionField(CodingStructure &cs)
+{
+  for (CodingUnit *cu : cs.cus)
+  {
+    setRefinedMotionFieldCU(*cu);
+  }
+}
+
+void CS::setRefinedMotionField(CodingStructure &cs, const int ctuRow)
+{
+  const PreCalcValues& pcv = *cs.pcv;
+  for (int ctuX = 0; ctuX < pcv.widthInCtus; ctuX++)
+  {
+    const UnitArea ctuArea(pcv.chrFormat, Area(ctuX << pcv.maxCUWidthLog2, ctuRow << pcv.maxCUHeightLog2, pcv.maxCUWidth, pcv.maxCUHeight));
+    for (auto &cu : cs.traverseCUs(CS::getArea(cs, ctuArea, CH_L), CH_L))
+    {
+      setRefinedMotionFieldCU(cu);
+    }
+  }
+}
 // CU tools
 
 bool CU::getRprScaling( const SPS* sps, const PPS* curPPS, Picture* refPic, int& xScale, int& yScale )
@@ -1919,6 +1937,7 @@ bool PU::getColocatedMVP(const PredictionUnit &pu, const RefPicList &eRefPicList
   }
   RefPicList eColRefPicList = slice.getCheckLDC() ? eRefPicList : RefPicList(slice.getColFromL0Flag());
 
+  pColPic->waitMotionLine( pos.y );
   const MotionInfo& mi = pColPic->cs->getMotionInfo( pos );
 
   if( !mi.isInter )
@@ -4171,6 +4190,7 @@ bool PU::getInterMergeSubPuMvpCand(const PredictionUnit &pu, MergeCtx& mrgCtx, b
   centerPos = Position{ PosType(centerPos.x & mask), PosType(centerPos.y & mask) };
 
   // derivation of center motion parameters from the collocated CU
+  pColPic->waitMotionLine(centerPos.y);
   const MotionInfo &mi = pColPic->cs->getMotionInfo(centerPos);
 
   if (mi.isInter && mi.isIBCmot == false)
@@ -4227,6 +4247,7 @@ bool PU::getInterMergeSubPuMvpCand(const PredictionUnit &pu, MergeCtx& mrgCtx, b
 
         colPos = Position{ PosType(colPos.x & mask), PosType(colPos.y & mask) };
 
+        pColPic->waitMotionLine(colPos.y);
         const MotionInfo &colMi = pColPic->cs->getMotionInfo(colPos);
 
         MotionInfo mi;
@@ -50,6 +50,7 @@ namespace CS
   UnitArea getArea                    ( const CodingStructure &cs, const UnitArea &area, const ChannelType chType );
   bool   isDualITree                  ( const CodingStructure &cs );
   void   setRefinedMotionField(CodingStructure &cs);
+  void   setRefinedMotionField(CodingStructure &cs, const int ctuRow);
 }
 
 
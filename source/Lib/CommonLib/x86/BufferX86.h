@@ -1793,6 +1793,271 @@ void linTf_SSE_entry( const Pel* src, int srcStride, Pel *dst, int dstStride, in
   }
 }
 
+static inline void kahanAdd( double& sum, double& comp, const double val )
+{
+  const double y = val - comp;
+  const double t = sum + y;
+  comp = ( t - sum ) - y;
+  sum  = t;
+}
+
+template< X86_VEXT vext >
+double wghtSse_SIMD( const Pel* org, int orgStride, const Pel* rec, int recStride, const double* wght, int wghtStride, int width, int height, int orgShift, int recShift )
+{
+  // the lane-wise accumulation order differs from the C version, compensated sums keep the metric stable to printed precision
+  double sum = 0, comp = 0;
+  double lanes[4], lanesComp[4];
+  int numLanes = 0;
+  const __m128i vorgShift = _mm_cvtsi32_si128( orgShift );
+  const __m128i vrecShift = _mm_cvtsi32_si128( recShift );
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 && width >= 4 )
+  {
+    __m256d vsum  = _mm256_setzero_pd();
+    __m256d vcomp = _mm256_setzero_pd();
+    for( int y = 0; y < height; y++ )
+    {
+      int x = 0;
+      for( ; x + 4 <= width; x += 4 )
+      {
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+        __m128i vorg = _mm_loadu_si128( ( const __m128i* ) &org[x] );
+        __m128i vrec = _mm_loadu_si128( ( const __m128i* ) &rec[x] );
+#else
+        __m128i vorg = _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) &org[x] ) );
+        __m128i vrec = _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) &rec[x] ) );
+#endif
+        __m256d vdiff = _mm256_cvtepi32_pd( _mm_sub_epi32( _mm_sll_epi32( vorg, vorgShift ), _mm_sll_epi32( vrec, vrecShift ) ) );
+        __m256d vterm = _mm256_mul_pd( _mm256_mul_pd( vdiff, vdiff ), _mm256_loadu_pd( &wght[x] ) );
+        __m256d vy    = _mm256_sub_pd( vterm, vcomp );
+        __m256d vt    = _mm256_add_pd( vsum, vy );
+        vcomp = _mm256_sub_pd( _mm256_sub_pd( vt, vsum ), vy );
+        vsum  = vt;
+      }
+      for( ; x < width; x++ )
+      {
+        const double diff = ( double ) ( ( org[x] << orgShift ) - ( rec[x] << recShift ) );
+        kahanAdd( sum, comp, diff * diff * wght[x] );
+      }
+      org  += orgStride;
+      rec  += recStride;
+      wght += wghtStride;
+    }
+    _mm256_storeu_pd( lanes,     vsum );
+    _mm256_storeu_pd( lanesComp, vcomp );
+    numLanes = 4;
+  }
+  else
+#endif
+  {
+    __m128d vsum  = _mm_setzero_pd();
+    __m128d vcomp = _mm_setzero_pd();
+    for( int y = 0; y < height; y++ )
+    {
+      int x = 0;
+      for( ; x + 2 <= width; x += 2 )
+      {
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+        __m128i vorg = _mm_loadl_epi64( ( const __m128i* ) &org[x] );
+        __m128i vrec = _mm_loadl_epi64( ( const __m128i* ) &rec[x] );
+#else
+        __m128i vorg = _mm_cvtepi16_epi32( _mm_cvtsi32_si128( *( const int32_t* ) &org[x] ) );
+        __m128i vrec = _mm_cvtepi16_epi32( _mm_cvtsi32_si128( *( const int32_t* ) &rec[x] ) );
+#endif
+        __m128d vdiff = _mm_cvtepi32_pd( _mm_sub_epi32( _mm_sll_epi32( vorg, vorgShift ), _mm_sll_epi32( vrec, vrecShift ) ) );
+        __m128d vterm = _mm_mul_pd( _mm_mul_pd( vdiff, vdiff ), _mm_loadu_pd( &wght[x] ) );
+        __m128d vy    = _mm_sub_pd( vterm, vcomp );
+        __m128d vt    = _mm_add_pd( vsum, vy );
+        vcomp = _mm_sub_pd( _mm_sub_pd( vt, vsum ), vy );
+        vsum  = vt;
+      }
+      for( ; x < width; x++ )
+      {
+        const double diff = ( double ) ( ( org[x] << orgShift ) - ( rec[x] << recShift ) );
+        kahanAdd( sum, comp, diff * diff * wght[x] );
+      }
+      org  += orgStride;
+      rec  += recStride;
+      wght += wghtStride;
+    }
+    _mm_storeu_pd( lanes,     vsum );
+    _mm_storeu_pd( lanesComp, vcomp );
+    numLanes = 2;
+  }
+
+  for( int i = 0; i < numLanes; i++ )
+  {
+    kahanAdd( sum, comp, lanes[i] );
+    kahanAdd( sum, comp, -lanesComp[i] );
+  }
+  return sum - comp;
+}
+
+#if !RExt__HIGH_BIT_DEPTH_SUPPORT
+template< X86_VEXT vext >
+void unpackSamples_SIMD( const uint8_t* src, Pel* dst, int width, bool is16bit )
+{
+  int x = 0;
+  if( is16bit )
+  {
+    // little-endian words map directly onto Pel
+    for( ; x + 8 <= width; x += 8 )
+    {
+      _mm_storeu_si128( ( __m128i* ) &dst[x], _mm_loadu_si128( ( const __m128i* ) &src[2 * x] ) );
+    }
+    for( ; x < width; x++ )
+    {
+      dst[x] = Pel( src[2 * x] ) | ( Pel( src[2 * x + 1] ) << 8 );
+    }
+    return;
+  }
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    for( ; x + 16 <= width; x += 16 )
+    {
+      _mm256_storeu_si256( ( __m256i* ) &dst[x], _mm256_cvtepu8_epi16( _mm_loadu_si128( ( const __m128i* ) &src[x] ) ) );
+    }
+  }
+#endif
+  for( ; x + 8 <= width; x += 8 )
+  {
+    _mm_storeu_si128( ( __m128i* ) &dst[x], _mm_cvtepu8_epi16( _mm_loadl_epi64( ( const __m128i* ) &src[x] ) ) );
+  }
+  for( ; x < width; x++ )
+  {
+    dst[x] = src[x];
+  }
+}
+
+template< X86_VEXT vext >
+void packSamples_SIMD( const Pel* src, uint8_t* dst, int width, bool is16bit )
+{
+  int x = 0;
+  if( is16bit )
+  {
+    for( ; x + 8 <= width; x += 8 )
+    {
+      _mm_storeu_si128( ( __m128i* ) &dst[2 * x], _mm_loadu_si128( ( const __m128i* ) &src[x] ) );
+    }
+    for( ; x < width; x++ )
+    {
+      dst[2 * x]     = ( src[x] >> 0 ) & 0xff;
+      dst[2 * x + 1] = ( src[x] >> 8 ) & 0xff;
+    }
+    return;
+  }
+
+  // truncate like the C version, the mask keeps packus from saturating
+  const __m128i vmask = _mm_set1_epi16( 0xff );
+  for( ; x + 16 <= width; x += 16 )
+  {
+    __m128i lo = _mm_and_si128( _mm_loadu_si128( ( const __m128i* ) &src[x] ),     vmask );
+    __m128i hi = _mm_and_si128( _mm_loadu_si128( ( const __m128i* ) &src[x + 8] ), vmask );
+    _mm_storeu_si128( ( __m128i* ) &dst[x], _mm_packus_epi16( lo, hi ) );
+  }
+  for( ; x < width; x++ )
+  {
+    dst[x] = ( uint8_t ) src[x];
+  }
+}
+
+template< X86_VEXT vext >
+void scaleSamples_SIMD( Pel* buf, int stride, int width, int height, int shift, Pel minVal, Pel maxVal )
+{
+  if( shift > 0 )
+  {
+    const __m128i vshift = _mm_cvtsi32_si128( shift );
+    for( int y = 0; y < height; y++, buf += stride )
+    {
+      int x = 0;
+#ifdef USE_AVX2
+      if( vext >= AVX2 )
+      {
+        for( ; x + 16 <= width; x += 16 )
+        {
+          __m256i v = _mm256_loadu_si256( ( const __m256i* ) &buf[x] );
+          _mm256_storeu_si256( ( __m256i* ) &buf[x], _mm256_sll_epi16( v, vshift ) );
+        }
+      }
+#endif
+      for( ; x + 8 <= width; x += 8 )
+      {
+        __m128i v = _mm_loadu_si128( ( const __m128i* ) &buf[x] );
+        _mm_storeu_si128( ( __m128i* ) &buf[x], _mm_sll_epi16( v, vshift ) );
+      }
+      for( ; x < width; x++ )
+      {
+        buf[x] <<= shift;
+      }
+    }
+  }
+  else if( shift < 0 )
+  {
+    const int     shiftr    = -shift;
+    const Pel     rounding  = 1 << ( shiftr - 1 );
+    const __m128i vshift    = _mm_cvtsi32_si128( shiftr );
+    const __m128i vrounding = _mm_set1_epi32( rounding );
+    const __m128i vmin      = _mm_set1_epi16( minVal );
+    const __m128i vmax      = _mm_set1_epi16( maxVal );
+    for( int y = 0; y < height; y++, buf += stride )
+    {
+      int x = 0;
+      for( ; x + 8 <= width; x += 8 )
+      {
+        // the rounding offset can leave the 16-bit range, shift in 32 bit
+        __m128i v  = _mm_loadu_si128( ( const __m128i* ) &buf[x] );
+        __m128i lo = _mm_sra_epi32( _mm_add_epi32( _mm_cvtepi16_epi32( v ), vrounding ), vshift );
+        __m128i hi = _mm_sra_epi32( _mm_add_epi32( _mm_cvtepi16_epi32( _mm_unpackhi_epi64( v, v ) ), vrounding ), vshift );
+        v = _mm_packs_epi32( lo, hi );
+        _mm_storeu_si128( ( __m128i* ) &buf[x], _mm_min_epi16( vmax, _mm_max_epi16( vmin, v ) ) );
+      }
+      for( ; x < width; x++ )
+      {
+        buf[x] = Clip3( minVal, maxVal, Pel( ( buf[x] + rounding ) >> shiftr ) );
+      }
+    }
+  }
+}
+
+template< X86_VEXT vext >
+bool checkSampleRange_SIMD( const Pel* buf, int stride, int width, int height, int bitDepth )
+{
+  const Pel mask = ~( ( 1 << bitDepth ) - 1 );
+  __m128i vor = _mm_setzero_si128();
+  Pel     sor = 0;
+
+  for( int y = 0; y < height; y++, buf += stride )
+  {
+    int x = 0;
+#ifdef USE_AVX2
+    if( vext >= AVX2 && width >= 16 )
+    {
+      __m256i vor256 = _mm256_setzero_si256();
+      for( ; x + 16 <= width; x += 16 )
+      {
+        vor256 = _mm256_or_si256( vor256, _mm256_loadu_si256( ( const __m256i* ) &buf[x] ) );
+      }
+      vor = _mm_or_si128( vor, _mm_or_si128( _mm256_castsi256_si128( vor256 ), _mm256_extracti128_si256( vor256, 1 ) ) );
+    }
+#endif
+    for( ; x + 8 <= width; x += 8 )
+    {
+      vor = _mm_or_si128( vor, _mm_loadu_si128( ( const __m128i* ) &buf[x] ) );
+    }
+    for( ; x < width; x++ )
+    {
+      sor |= buf[x];
+    }
+  }
+
+  // any sample with a bit set in the mask shows up in the OR over all samples
+  return _mm_testz_si128( vor, _mm_set1_epi16( mask ) ) && ( sor & mask ) == 0;
+}
+#endif
+
 template<X86_VEXT vext>
 void PelBufferOps::_initPelBufOpsX86()
 {
@@ -1841,8 +2106,14 @@ void PelBufferOps::_initPelBufOpsX86()
 #endif
   profGradFilter = gradFilter_SSE<vext, false>;
   applyPROF      = applyPROF_SSE<vext>;
+
+  unpackSamples    = unpackSamples_SIMD<vext>;
+  packSamples      = packSamples_SIMD<vext>;
+  scaleSamples     = scaleSamples_SIMD<vext>;
+  checkSampleRange = checkSampleRange_SIMD<vext>;
 #endif
   roundIntVector = roundIntVector_SIMD<vext>;
+  wghtSse        = wghtSse_SIMD<vext>;
 }
 
 template void PelBufferOps::_initPelBufOpsX86<SIMDX86>();
@@ -0,0 +1,557 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2021, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file
+ * \brief Implementation of the deblocking edge filters and the motion vector check of the boundary strength, SIMD version
+ */
+
+#include "CommonDefX86.h"
+#include "../DeblockingFilter.h"
+
+//! \ingroup CommonLib
+//! \{
+
+#ifdef TARGET_SIMD_X86
+#if ENABLE_SIMD_OPT_DEBLOCK
+
+// The lines of an edge segment are filtered in parallel, one line per 32 bit lane, so that the arithmetic is the one of
+// the scalar code. The samples across the edge are kept in v[8 + k], k = -8 .. 7, where k < 0 are the samples p(-k-1)
+// of the P side and k >= 0 the samples q(k) of the Q side. For vertical edges the rows are transposed on load and store.
+
+// samples k = kBegin .. kEnd - 1 of the 4 lines of a horizontal edge, the lines are consecutive in memory
+static inline void xLoadLinesHor( const Pel* src, const ptrdiff_t offset, const int kBegin, const int kEnd, __m128i* v )
+{
+  for( int k = kBegin; k < kEnd; k++ )
+  {
+    v[8 + k] = _mm_cvtepi16_epi32( _mm_loadl_epi64( (const __m128i*) &src[k * offset] ) );
+  }
+}
+
+static inline void xStoreLinesHor( Pel* src, const ptrdiff_t offset, const int kBegin, const int kEnd, const __m128i* v )
+{
+  for( int k = kBegin; k < kEnd; k++ )
+  {
+    _mm_storel_epi64( (__m128i*) &src[k * offset], _mm_packs_epi32( v[8 + k], v[8 + k] ) );
+  }
+}
+
+// transposes the rows r[0 .. 3] of 8 samples into the 8 columns c[0 .. 7] of 4 lines
+static inline void xTransposeRows( const __m128i* r, __m128i* c )
+{
+  const __m128i t0 = _mm_unpacklo_epi16( r[0], r[1] );
+  const __m128i t1 = _mm_unpacklo_epi16( r[2], r[3] );
+  const __m128i t2 = _mm_unpackhi_epi16( r[0], r[1] );
+  const __m128i t3 = _mm_unpackhi_epi16( r[2], r[3] );
+
+  const __m128i u0 = _mm_unpacklo_epi32( t0, t1 );
+  const __m128i u1 = _mm_unpackhi_epi32( t0, t1 );
+  const __m128i u2 = _mm_unpacklo_epi32( t2, t3 );
+  const __m128i u3 = _mm_unpackhi_epi32( t2, t3 );
+
+  c[0] = _mm_cvtepi16_epi32( u0 );
+  c[1] = _mm_cvtepi16_epi32( _mm_unpackhi_epi64( u0, u0 ) );
+  c[2] = _mm_cvtepi16_epi32( u1 );
+  c[3] = _mm_cvtepi16_epi32( _mm_unpackhi_epi64( u1, u1 ) );
+  c[4] = _mm_cvtepi16_epi32( u2 );
+  c[5] = _mm_cvtepi16_epi32( _mm_unpackhi_epi64( u2, u2 ) );
+  c[6] = _mm_cvtepi16_epi32( u3 );
+  c[7] = _mm_cvtepi16_epi32( _mm_unpackhi_epi64( u3, u3 ) );
+}
+
+// inverse of xTransposeRows
+static inline void xTransposeCols( const __m128i* c, __m128i* r )
+{
+  const __m128i u0 = _mm_packs_epi32( c[0], c[1] );
+  const __m128i u1 = _mm_packs_epi32( c[2], c[3] );
+  const __m128i u2 = _mm_packs_epi32( c[4], c[5] );
+  const __m128i u3 = _mm_packs_epi32( c[6], c[7] );
+
+  const __m128i s0 = _mm_unpacklo_epi16( u0, u1 );
+  const __m128i s1 = _mm_unpackhi_epi16( u0, u1 );
+  const __m128i s2 = _mm_unpacklo_epi16( u2, u3 );
+  const __m128i s3 = _mm_unpackhi_epi16( u2, u3 );
+
+  const __m128i x01 = _mm_unpacklo_epi16( s0, s1 );
+  const __m128i x23 = _mm_unpackhi_epi16( s0, s1 );
+  const __m128i x45 = _mm_unpacklo_epi16( s2, s3 );
+  const __m128i x67 = _mm_unpackhi_epi16( s2, s3 );
+
+  r[0] = _mm_unpacklo_epi64( x01, x45 );
+  r[1] = _mm_unpackhi_epi64( x01, x45 );
+  r[2] = _mm_unpacklo_epi64( x23, x67 );
+  r[3] = _mm_unpackhi_epi64( x23, x67 );
+}
+
+// samples k = k0 .. k0 + 7 of numLines lines of a vertical edge
+static inline void xLoadLinesVer( const Pel* src, const ptrdiff_t step, const int k0, const int numLines, __m128i* v )
+{
+  __m128i r[4];
+  for( int l = 0; l < 4; l++ )
+  {
+    r[l] = l < numLines ? _mm_loadu_si128( (const __m128i*) &src[l * step + k0] ) : _mm_setzero_si128();
+  }
+  xTransposeRows( r, &v[8 + k0] );
+}
+
+// stores the samples k = k0 + kBegin .. k0 + kEnd - 1 of numLines lines of a vertical edge, where kBegin is 0 or 4 and
+// kEnd is 4 or 8
+static inline void xStoreLinesVer( Pel* src, const ptrdiff_t step, const int k0, const int kBegin, const int kEnd, const int numLines, const __m128i* v )
+{
+  __m128i r[4];
+  xTransposeCols( &v[8 + k0], r );
+  for( int l = 0; l < numLines; l++ )
+  {
+    if( kEnd - kBegin == 8 )
+    {
+      _mm_storeu_si128( (__m128i*) &src[l * step + k0], r[l] );
+    }
+    else if( kBegin == 0 )
+    {
+      _mm_storel_epi64( (__m128i*) &src[l * step + k0], r[l] );
+    }
+    else
+    {
+      _mm_storel_epi64( (__m128i*) &src[l * step + k0 + 4], _mm_unpackhi_epi64( r[l], r[l] ) );
+    }
+  }
+}
+
+static inline __m128i xClip3( const __m128i minVal, const __m128i maxVal, const __m128i val )
+{
+  return _mm_min_epi32( maxVal, _mm_max_epi32( minVal, val ) );
+}
+
+// Clip3( val - range, val + range, filtered )
+static inline __m128i xClipDelta( const __m128i val, const __m128i range, const __m128i filtered )
+{
+  return xClip3( _mm_sub_epi32( val, range ), _mm_add_epi32( val, range ), filtered );
+}
+
+template<X86_VEXT vext>
+static void simdPelFilterLuma( Pel* src, const ptrdiff_t offset, const ptrdiff_t step, const int tc, const bool sw, const bool partPNoFilter,
+                               const bool partQNoFilter, const int thrCut, const bool filterSecondP, const bool filterSecondQ, const ClpRng& clpRng )
+{
+  const bool isVer = offset == 1;
+  __m128i    v[16];
+
+  if( isVer )
+  {
+    xLoadLinesVer( src, step, -4, 4, v );
+  }
+  else
+  {
+    xLoadLinesHor( src, offset, -4, 4, v );
+  }
+
+  const __m128i p3 = v[4], p2 = v[5], p1 = v[6], p0 = v[7];
+  const __m128i q0 = v[8], q1 = v[9], q2 = v[10], q3 = v[11];
+  const __m128i vTc  = _mm_set1_epi32( tc );
+  const __m128i vTc2 = _mm_add_epi32( vTc, vTc );
+  const __m128i vTc3 = _mm_add_epi32( vTc2, vTc );
+  const __m128i c2   = _mm_set1_epi32( 2 );
+  const __m128i c4   = _mm_set1_epi32( 4 );
+
+  if( sw )
+  {
+    const __m128i p0q0 = _mm_add_epi32( p0, q0 );
+    const __m128i sum  = _mm_add_epi32( _mm_add_epi32( p1, p0q0 ), q1 );   // p1 + p0 + q0 + q1
+
+    // ( p2 + 2 * p1 + 2 * p0 + 2 * q0 + q1 + 4 ) >> 3
+    __m128i f = _mm_add_epi32( _mm_add_epi32( sum, sum ), _mm_sub_epi32( _mm_add_epi32( p2, c4 ), q1 ) );
+    v[7]      = xClipDelta( p0, vTc3, _mm_srai_epi32( f, 3 ) );
+    // ( p1 + 2 * p0 + 2 * q0 + 2 * q1 + q2 + 4 ) >> 3
+    f         = _mm_add_epi32( _mm_add_epi32( sum, sum ), _mm_sub_epi32( _mm_add_epi32( q2, c4 ), p1 ) );
+    v[8]      = xClipDelta( q0, vTc3, _mm_srai_epi32( f, 3 ) );
+    // ( p2 + p1 + p0 + q0 + 2 ) >> 2
+    f         = _mm_add_epi32( _mm_add_epi32( p2, p1 ), _mm_add_epi32( p0q0, c2 ) );
+    v[6]      = xClipDelta( p1, vTc2, _mm_srai_epi32( f, 2 ) );
+    // ( p0 + q0 + q1 + q2 + 2 ) >> 2
+    f         = _mm_add_epi32( _mm_add_epi32( q2, q1 ), _mm_add_epi32( p0q0, c2 ) );
+    v[9]      = xClipDelta( q1, vTc2, _mm_srai_epi32( f, 2 ) );
+    // ( 2 * p3 + 3 * p2 + p1 + p0 + q0 + 4 ) >> 3
+    f         = _mm_add_epi32( _mm_add_epi32( _mm_add_epi32( p3, p3 ), _mm_add_epi32( _mm_add_epi32( p2, p2 ), p2 ) ), _mm_add_epi32( _mm_add_epi32( p1, p0q0 ), c4 ) );
+    v[5]      = xClipDelta( p2, vTc, _mm_srai_epi32( f, 3 ) );
+    // ( p0 + q0 + q1 + 3 * q2 + 2 * q3 + 4 ) >> 3
+    f         = _mm_add_epi32( _mm_add_epi32( _mm_add_epi32( q3, q3 ), _mm_add_epi32( _mm_add_epi32( q2, q2 ), q2 ) ), _mm_add_epi32( _mm_add_epi32( q1, p0q0 ), c4 ) );
+    v[10]     = xClipDelta( q2, vTc, _mm_srai_epi32( f, 3 ) );
+  }
+  else
+  {
+    const __m128i vMin = _mm_set1_epi32( clpRng.min );
+    const __m128i vMax = _mm_set1_epi32( clpRng.max );
+    const __m128i vOne = _mm_set1_epi32( 1 );
+
+    // delta = ( 9 * ( q0 - p0 ) - 3 * ( q1 - p1 ) + 8 ) >> 4
+    const __m128i d0    = _mm_sub_epi32( q0, p0 );
+    const __m128i d1    = _mm_sub_epi32( q1, p1 );
+    __m128i       delta = _mm_sub_epi32( _mm_add_epi32( _mm_slli_epi32( d0, 3 ), d0 ), _mm_add_epi32( _mm_add_epi32( d1, d1 ), d1 ) );
+    delta               = _mm_srai_epi32( _mm_add_epi32( delta, _mm_set1_epi32( 8 ) ), 4 );
+
+    const __m128i apply = _mm_cmplt_epi32( _mm_abs_epi32( delta ), _mm_set1_epi32( thrCut ) );
+    delta               = xClip3( _mm_sub_epi32( _mm_setzero_si128(), vTc ), vTc, delta );
+
+    v[7] = _mm_blendv_epi8( p0, xClip3( vMin, vMax, _mm_add_epi32( p0, delta ) ), apply );
+    v[8] = _mm_blendv_epi8( q0, xClip3( vMin, vMax, _mm_sub_epi32( q0, delta ) ), apply );
+
+    const __m128i vTcH    = _mm_set1_epi32( tc >> 1 );
+    const __m128i vTcHNeg = _mm_sub_epi32( _mm_setzero_si128(), vTcH );
+    if( filterSecondP )
+    {
+      // Clip3( -tc2, tc2, ( ( ( p2 + p0 + 1 ) >> 1 ) - p1 + delta ) >> 1 )
+      __m128i delta1 = _mm_srai_epi32( _mm_add_epi32( _mm_add_epi32( p2, p0 ), vOne ), 1 );
+      delta1         = xClip3( vTcHNeg, vTcH, _mm_srai_epi32( _mm_add_epi32( _mm_sub_epi32( delta1, p1 ), delta ), 1 ) );
+      v[6]           = _mm_blendv_epi8( p1, xClip3( vMin, vMax, _mm_add_epi32( p1, delta1 ) ), apply );
+    }
+    if( filterSecondQ )
+    {
+      // Clip3( -tc2, tc2, ( ( ( q2 + q0 + 1 ) >> 1 ) - q1 - delta ) >> 1 )
+      __m128i delta2 = _mm_srai_epi32( _mm_add_epi32( _mm_add_epi32( q2, q0 ), vOne ), 1 );
+      delta2         = xClip3( vTcHNeg, vTcH, _mm_srai_epi32( _mm_sub_epi32( _mm_sub_epi32( delta2, q1 ), delta ), 1 ) );
+      v[9]           = _mm_blendv_epi8( q1, xClip3( vMin, vMax, _mm_add_epi32( q1, delta2 ) ), apply );
+    }
+  }
+
+  // the sides which must not be filtered keep their samples
+  if( partPNoFilter )
+  {
+    v[5] = p2; v[6] = p1; v[7] = p0;
+  }
+  if( partQNoFilter )
+  {
+    v[8] = q0; v[9] = q1; v[10] = q2;
+  }
+
+  if( isVer )
+  {
+    xStoreLinesVer( src, step, -4, 0, 8, 4, v );
+  }
+  else
+  {
+    xStoreLinesHor( src, offset, partPNoFilter ? 0 : -3, partQNoFilter ? 0 : 3, v );
+  }
+}
+
+// bilinear interpolation between refMiddle and refSide of numSide samples s[0 .. numSide - 1] of one side
+static inline void xBilinearSide( __m128i* s, const int numSide, const __m128i refMiddle, const __m128i refSide, const int tc )
+{
+  static const int dbCoeffs7[7] = { 59, 50, 41, 32, 23, 14, 5 };
+  static const int dbCoeffs3[3] = { 53, 32, 11 };
+  static const int dbCoeffs5[5] = { 58, 45, 32, 19, 6 };
+  static const int tc7[7]       = { 6, 5, 4, 3, 2, 1, 1 };
+  static const int tc3[3]       = { 6, 4, 2 };
+
+  const int* dbCoeffs = numSide == 7 ? dbCoeffs7 : numSide == 5 ? dbCoeffs5 : dbCoeffs3;
+  const int* tcSide   = numSide == 3 ? tc3 : tc7;
+  const __m128i c32   = _mm_set1_epi32( 32 );
+
+  // refMiddle * c + refSide * ( 64 - c ) = ( refMiddle - refSide ) * c + refSide * 64
+  const __m128i diff = _mm_sub_epi32( refMiddle, refSide );
+  const __m128i base = _mm_add_epi32( _mm_slli_epi32( refSide, 6 ), c32 );
+
+  for( int pos = 0; pos < numSide; pos++ )
+  {
+    const __m128i filtered = _mm_srai_epi32( _mm_add_epi32( _mm_mullo_epi32( diff, _mm_set1_epi32( dbCoeffs[pos] ) ), base ), 6 );
+    s[pos]                 = xClipDelta( s[pos], _mm_set1_epi32( ( tc * tcSide[pos] ) >> 1 ), filtered );
+  }
+}
+
+template<X86_VEXT vext>
+static void simdPelFilterLumaLong( Pel* src, const ptrdiff_t offset, const ptrdiff_t step, const int numberPSide, const int numberQSide, const int tc,
+                                   const bool partPNoFilter, const bool partQNoFilter )
+{
+  CHECK( numberPSide <= 3 && numberQSide <= 3, "Short filtering in long filtering function" );
+
+  const bool isVer = offset == 1;
+  __m128i    v[16];
+
+  if( isVer )
+  {
+    xLoadLinesVer( src, step, -8, 4, v );
+    xLoadLinesVer( src, step,  0, 4, v );
+  }
+  else
+  {
+    xLoadLinesHor( src, offset, -numberPSide - 1, numberQSide + 1, v );
+  }
+
+  // p[j] and q[j] are the j-th samples of the P and Q side counted from the edge
+  __m128i p[8], q[8];
+  for( int j = 0; j <= numberPSide; j++ )
+  {
+    p[j] = v[7 - j];
+  }
+  for( int j = 0; j <= numberQSide; j++ )
+  {
+    q[j] = v[8 + j];
+  }
+
+  const __m128i c1 = _mm_set1_epi32( 1 );
+  const __m128i refP = _mm_srai_epi32( _mm_add_epi32( _mm_add_epi32( p[numberPSide - 1], p[numberPSide] ), c1 ), 1 );
+  const __m128i refQ = _mm_srai_epi32( _mm_add_epi32( _mm_add_epi32( q[numberQSide - 1], q[numberQSide] ), c1 ), 1 );
+
+  __m128i refMiddle;
+  if( numberPSide == numberQSide )
+  {
+    __m128i sum;
+    if( numberPSide == 5 )
+    {
+      // 2 * ( p0 + q0 + p1 + q1 + p2 + q2 ) + p3 + q3 + p4 + q4
+      sum = _mm_add_epi32( _mm_add_epi32( p[0], q[0] ), _mm_add_epi32( _mm_add_epi32( p[1], q[1] ), _mm_add_epi32( p[2], q[2] ) ) );
+      sum = _mm_add_epi32( _mm_add_epi32( sum, sum ), _mm_add_epi32( _mm_add_epi32( p[3], q[3] ), _mm_add_epi32( p[4], q[4] ) ) );
+    }
+    else
+    {
+      // 2 * ( p0 + q0 ) + p1 + q1 + ... + p6 + q6
+      sum = _mm_add_epi32( p[0], q[0] );
+      sum = _mm_add_epi32( sum, sum );
+      for( int j = 1; j < 7; j++ )
+      {
+        sum = _mm_add_epi32( sum, _mm_add_epi32( p[j], q[j] ) );
+      }
+    }
+    refMiddle = _mm_srai_epi32( _mm_add_epi32( sum, _mm_set1_epi32( 8 ) ), 4 );
+  }
+  else
+  {
+    // the longer side is denoted by l, the shorter one by s
+    const __m128i* l   = numberQSide > numberPSide ? q : p;
+    const __m128i* s   = numberQSide > numberPSide ? p : q;
+    const int      numL = std::max( numberPSide, numberQSide );
+    const int      numS = std::min( numberPSide, numberQSide );
+
+    __m128i sum;
+    if( numL == 7 && numS == 5 )
+    {
+      // 2 * ( p0 + q0 + p1 + q1 ) + p2 + q2 + ... + p5 + q5
+      sum = _mm_add_epi32( _mm_add_epi32( p[0], q[0] ), _mm_add_epi32( p[1], q[1] ) );
+      sum = _mm_add_epi32( sum, sum );
+      for( int j = 2; j < 6; j++ )
+      {
+        sum = _mm_add_epi32( sum, _mm_add_epi32( p[j], q[j] ) );
+      }
+      refMiddle = _mm_srai_epi32( _mm_add_epi32( sum, _mm_set1_epi32( 8 ) ), 4 );
+    }
+    else if( numL == 7 && numS == 3 )
+    {
+      // 2 * ( l0 + s0 ) + s0 + 2 * ( s1 + s2 ) + l1 + s1 + l2 + l3 + l4 + l5 + l6
+      sum = _mm_add_epi32( l[0], s[0] );
+      sum = _mm_add_epi32( _mm_add_epi32( sum, sum ), s[0] );
+      sum = _mm_add_epi32( sum, _mm_slli_epi32( _mm_add_epi32( s[1], s[2] ), 1 ) );
+      sum = _mm_add_epi32( sum, s[1] );
+      for( int j = 1; j < 7; j++ )
+      {
+        sum = _mm_add_epi32( sum, l[j] );
+      }
+      refMiddle = _mm_srai_epi32( _mm_add_epi32( sum, _mm_set1_epi32( 8 ) ), 4 );
+    }
+    else
+    {
+      // ( p0 + q0 + p1 + q1 + p2 + q2 + p3 + q3 + 4 ) >> 3
+      sum = _mm_add_epi32( _mm_add_epi32( p[0], q[0] ), _mm_add_epi32( p[1], q[1] ) );
+      sum = _mm_add_epi32( sum, _mm_add_epi32( _mm_add_epi32( p[2], q[2] ), _mm_add_epi32( p[3], q[3] ) ) );
+      refMiddle = _mm_srai_epi32( _mm_add_epi32( sum, _mm_set1_epi32( 4 ) ), 3 );
+    }
+  }
+
+  if( !partPNoFilter )
+  {
+    xBilinearSide( p, numberPSide, refMiddle, refP, tc );
+    for( int j = 0; j < numberPSide; j++ )
+    {
+      v[7 - j] = p[j];
+    }
+  }
+  if( !partQNoFilter )
+  {
+    xBilinearSide( q, numberQSide, refMiddle, refQ, tc );
+    for( int j = 0; j < numberQSide; j++ )
+    {
+      v[8 + j] = q[j];
+    }
+  }
+
+  if( isVer )
+  {
+    // the samples p7 (q7) are written back unchanged, the ones of the short side are not touched
+    if( !partPNoFilter )
+    {
+      xStoreLinesVer( src, step, -8, numberPSide > 3 ? 0 : 4, 8, 4, v );
+    }
+    if( !partQNoFilter )
+    {
+      xStoreLinesVer( src, step, 0, 0, numberQSide > 3 ? 8 : 4, 4, v );
+    }
+  }
+  else
+  {
+    xStoreLinesHor( src, offset, partPNoFilter ? 0 : -numberPSide, partQNoFilter ? 0 : numberQSide, v );
+  }
+}
+
+template<X86_VEXT vext>
+static void simdPelFilterChroma( Pel* src, const ptrdiff_t offset, const ptrdiff_t step, const int numLines, const int tc, const bool sw,
+                                 const bool partPNoFilter, const bool partQNoFilter, const ClpRng& clpRng, const bool isChromaHorCTBBoundary )
+{
+  CHECK( numLines > 4, "Too many lines in a chroma edge segment" );
+
+  const bool isVer = offset == 1;
+  __m128i    v[16];
+
+  if( isVer )
+  {
+    xLoadLinesVer( src, step, -4, numLines, v );
+  }
+  else
+  {
+    // the samples above the CTU boundary beyond p1 are not used
+    xLoadLinesHor( src, offset, isChromaHorCTBBoundary ? -2 : -4, 4, v );
+    if( isChromaHorCTBBoundary )
+    {
+      v[4] = v[5] = v[6];
+    }
+  }
+
+  const __m128i p3 = v[4], p2 = v[5], p1 = v[6], p0 = v[7];
+  const __m128i q0 = v[8], q1 = v[9], q2 = v[10], q3 = v[11];
+  const __m128i vTc = _mm_set1_epi32( tc );
+  const __m128i c4  = _mm_set1_epi32( 4 );
+
+  if( sw )
+  {
+    const __m128i sumP = _mm_add_epi32( p1, p0 );
+    const __m128i sumQ = _mm_add_epi32( q0, q1 );
+    __m128i       f;
+
+    if( isChromaHorCTBBoundary )
+    {
+      // ( 3 * p1 + 2 * p0 + q0 + q1 + q2 + 4 ) >> 3
+      f    = _mm_add_epi32( _mm_add_epi32( _mm_add_epi32( sumP, sumP ), p1 ), _mm_add_epi32( _mm_add_epi32( sumQ, q2 ), c4 ) );
+      v[7] = xClipDelta( p0, vTc, _mm_srai_epi32( f, 3 ) );
+      // ( 2 * p1 + p0 + 2 * q0 + q1 + q2 + q3 + 4 ) >> 3
+      f    = _mm_add_epi32( _mm_add_epi32( _mm_add_epi32( p1, p1 ), p0 ), _mm_add_epi32( _mm_add_epi32( _mm_add_epi32( q0, sumQ ), _mm_add_epi32( q2, q3 ) ), c4 ) );
+      v[8] = xClipDelta( q0, vTc, _mm_srai_epi32( f, 3 ) );
+    }
+    else
+    {
+      // ( 3 * p3 + 2 * p2 + p1 + p0 + q0 + 4 ) >> 3
+      f    = _mm_add_epi32( _mm_add_epi32( _mm_add_epi32( p3, p3 ), _mm_add_epi32( p3, _mm_add_epi32( p2, p2 ) ) ), _mm_add_epi32( _mm_add_epi32( sumP, q0 ), c4 ) );
+      v[5] = xClipDelta( p2, vTc, _mm_srai_epi32( f, 3 ) );
+      // ( 2 * p3 + p2 + 2 * p1 + p0 + q0 + q1 + 4 ) >> 3
+      f    = _mm_add_epi32( _mm_add_epi32( _mm_add_epi32( p3, p3 ), _mm_add_epi32( p2, _mm_add_epi32( p1, p1 ) ) ), _mm_add_epi32( _mm_add_epi32( p0, sumQ ), c4 ) );
+      v[6] = xClipDelta( p1, vTc, _mm_srai_epi32( f, 3 ) );
+      // ( p3 + p2 + p1 + 2 * p0 + q0 + q1 + q2 + 4 ) >> 3
+      f    = _mm_add_epi32( _mm_add_epi32( _mm_add_epi32( p3, p2 ), _mm_add_epi32( sumP, p0 ) ), _mm_add_epi32( _mm_add_epi32( sumQ, q2 ), c4 ) );
+      v[7] = xClipDelta( p0, vTc, _mm_srai_epi32( f, 3 ) );
+      // ( p2 + p1 + p0 + 2 * q0 + q1 + q2 + q3 + 4 ) >> 3
+      f    = _mm_add_epi32( _mm_add_epi32( _mm_add_epi32( p2, sumP ), _mm_add_epi32( q0, sumQ ) ), _mm_add_epi32( _mm_add_epi32( q2, q3 ), c4 ) );
+      v[8] = xClipDelta( q0, vTc, _mm_srai_epi32( f, 3 ) );
+    }
+    // ( p1 + p0 + q0 + 2 * q1 + q2 + 2 * q3 + 4 ) >> 3
+    f     = _mm_add_epi32( _mm_add_epi32( sumP, _mm_add_epi32( sumQ, q1 ) ), _mm_add_epi32( _mm_add_epi32( q2, _mm_add_epi32( q3, q3 ) ), c4 ) );
+    v[9]  = xClipDelta( q1, vTc, _mm_srai_epi32( f, 3 ) );
+    // ( p0 + q0 + q1 + 2 * q2 + 3 * q3 + 4 ) >> 3
+    f     = _mm_add_epi32( _mm_add_epi32( p0, sumQ ), _mm_add_epi32( _mm_add_epi32( _mm_add_epi32( q2, q2 ), _mm_add_epi32( _mm_add_epi32( q3, q3 ), q3 ) ), c4 ) );
+    v[10] = xClipDelta( q2, vTc, _mm_srai_epi32( f, 3 ) );
+  }
+  else
+  {
+    // delta = Clip3( -tc, tc, ( ( ( q0 - p0 ) << 2 ) + p1 - q1 + 4 ) >> 3 )
+    __m128i delta = _mm_add_epi32( _mm_slli_epi32( _mm_sub_epi32( q0, p0 ), 2 ), _mm_sub_epi32( p1, q1 ) );
+    delta         = xClip3( _mm_sub_epi32( _mm_setzero_si128(), vTc ), vTc, _mm_srai_epi32( _mm_add_epi32( delta, c4 ), 3 ) );
+
+    const __m128i vMin = _mm_set1_epi32( clpRng.min );
+    const __m128i vMax = _mm_set1_epi32( clpRng.max );
+    v[7] = xClip3( vMin, vMax, _mm_add_epi32( p0, delta ) );
+    v[8] = xClip3( vMin, vMax, _mm_sub_epi32( q0, delta ) );
+  }
+
+  if( partPNoFilter )
+  {
+    v[5] = p2; v[6] = p1; v[7] = p0;
+  }
+  if( partQNoFilter )
+  {
+    v[8] = q0; v[9] = q1; v[10] = q2;
+  }
+
+  const int kBegin = partPNoFilter ? 0 : sw && !isChromaHorCTBBoundary ? -3 : -1;
+  const int kEnd   = partQNoFilter ? 0 : sw ? 3 : 1;
+
+  if( isVer )
+  {
+    xStoreLinesVer( src, step, -4, 0, 8, numLines, v );
+  }
+  else if( numLines == 4 )
+  {
+    xStoreLinesHor( src, offset, kBegin, kEnd, v );
+  }
+  else
+  {
+    for( int k = kBegin; k < kEnd; k++ )
+    {
+      Pel lines[8];
+      _mm_storeu_si128( (__m128i*) lines, _mm_packs_epi32( v[8 + k], v[8 + k] ) );
+      memcpy( &src[k * offset], lines, numLines * sizeof( Pel ) );
+    }
+  }
+}
+
+// bit 0: one of the pairs ( P0, Q0 ), ( P1, Q1 ) differs by threshold or more, bit 1: one of the pairs ( P0, Q1 ), ( P1, Q0 )
+template<X86_VEXT vext>
+static int simdMvPairsDiffer( const Mv* mvP, const Mv* mvQ, const int threshold )
+{
+  const __m128i p   = _mm_loadu_si128( (const __m128i*) mvP );
+  const __m128i q   = _mm_loadu_si128( (const __m128i*) mvQ );
+  const __m128i thr = _mm_set1_epi32( threshold - 1 );
+
+  const __m128i direct  = _mm_cmpgt_epi32( _mm_abs_epi32( _mm_sub_epi32( q, p ) ), thr );
+  const __m128i crossed = _mm_cmpgt_epi32( _mm_abs_epi32( _mm_sub_epi32( q, _mm_shuffle_epi32( p, 0x4e ) ) ), thr );
+
+  return ( _mm_testz_si128( direct, direct ) ? 0 : 1 ) | ( _mm_testz_si128( crossed, crossed ) ? 0 : 2 );
+}
+
+template<X86_VEXT vext>
+void DeblockingFilter::_initDeblockingFilterX86()
+{
+  m_pelFilterLuma     = simdPelFilterLuma<vext>;
+  m_pelFilterLumaLong = simdPelFilterLumaLong<vext>;
+  m_pelFilterChroma   = simdPelFilterChroma<vext>;
+  m_mvPairsDiffer     = simdMvPairsDiffer<vext>;
+}
+
+template void DeblockingFilter::_initDeblockingFilterX86<SIMDX86>();
+
+#endif //#if ENABLE_SIMD_OPT_DEBLOCK
+#endif //#ifdef TARGET_SIMD_X86
+//! \}
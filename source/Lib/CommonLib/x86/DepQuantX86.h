@@ -0,0 +1,197 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2021, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file
+ * \brief Implementation of the rd cost decisions of the dependent quantization trellis, SIMD version
+ */
+
+#include "CommonDefX86.h"
+#include "../DepQuant.h"
+
+//! \ingroup CommonLib
+//! \{
+
+#ifdef TARGET_SIMD_X86
+#if ENABLE_SIMD_OPT_DEPQUANT
+#ifdef USE_AVX2
+
+using namespace DQIntern;
+
+// The four states are processed in the lanes of one register. The candidates of the decisions are compared in the
+// same order as in the C function DQIntern::decideRdCosts(), so that ties are resolved identically.
+
+static inline int xBitsIdx( const TCoeff absLevel )
+{
+  return absLevel < 4 ? absLevel : 4 + ( absLevel & 1 );
+}
+
+static inline int32_t xRiceBits( const int goRicePar, const TCoeff absLevel )
+{
+  const TCoeff value = ( absLevel - 4 ) >> 1;
+  return absLevel < 4 ? 0 : g_goRiceBits[goRicePar][value < RICEMAX ? value : RICEMAX - 1];
+}
+
+// bits of the absolute levels, the states 0/1 code the level levelLo and the states 2/3 the level levelHi
+static inline __m128i xLevelRate( const StateMem& states, const TCoeff levelLo, const TCoeff levelHi )
+{
+  const __m128i bits = _mm_unpacklo_epi64( _mm_loadl_epi64( (const __m128i*) &states.coeffBits[xBitsIdx( levelLo )][0] ),
+                                           _mm_loadl_epi64( (const __m128i*) &states.coeffBits[xBitsIdx( levelHi )][2] ) );
+  if( ( levelLo | levelHi ) < 4 )
+  {
+    return bits;
+  }
+  const __m128i rice = _mm_setr_epi32( xRiceBits( states.goRicePar[0], levelLo ), xRiceBits( states.goRicePar[1], levelLo ),
+                                       xRiceBits( states.goRicePar[2], levelHi ), xRiceBits( states.goRicePar[3], levelHi ) );
+  return _mm_add_epi32( bits, rice );
+}
+
+// keeps the candidate if its cost is strictly smaller
+static inline void xSelect( __m256i& bestCost, __m256i& bestLevelAndPrevId, const __m256i cost, const __m256i levelAndPrevId )
+{
+  const __m256i better = _mm256_cmpgt_epi64( bestCost, cost );
+  bestCost             = _mm256_blendv_epi8( bestCost,           cost,           better );
+  bestLevelAndPrevId   = _mm256_blendv_epi8( bestLevelAndPrevId, levelAndPrevId, better );
+}
+
+template<X86_VEXT vext>
+static void simdDecideRdCosts( const StateMem& prevStates, const StateMem& skipStates, const PQData* pqData, const ScanPosType spt,
+                               const int32_t* startBits, const int32_t lastOffset, Decision* decisions )
+{
+  static_assert( sizeof( Decision ) == 16 && sizeof( TCoeff ) == 4, "decisions are written as ( cost, level, prevId ) vectors" );
+
+  const TCoeff  level0    = pqData[0].absLevel;
+  const TCoeff  level1    = pqData[1].absLevel;
+  const TCoeff  level2    = pqData[2].absLevel;
+  const TCoeff  level3    = pqData[3].absLevel;
+  const __m128i regular   = _mm_cmpgt_epi32( _mm_loadu_si128( (const __m128i*) prevStates.remRegBins ), _mm_set1_epi32( 3 ) );
+
+  //----- rates of the regular coded states -----
+  const __m128i sig0      = _mm_loadu_si128( (const __m128i*) prevStates.sigBits[0] );
+  const __m128i sig1      = _mm_loadu_si128( (const __m128i*) prevStates.sigBits[1] );
+  __m128i       rateA     = xLevelRate( prevStates, level0, level3 );
+  __m128i       rateB     = xLevelRate( prevStates, level2, level1 );
+  __m128i       rateZ     = sig0;
+  __m128i       noZero    = _mm_setzero_si128();
+  if( spt == SCAN_EOCSBB )
+  {
+    int32_t numSigSbb;
+    ::memcpy( &numSigSbb, prevStates.numSigSbb, sizeof( numSigSbb ) );
+    const __m128i sigSbb = _mm_cmpeq_epi32( _mm_cvtepi8_epi32( _mm_cvtsi32_si128( numSigSbb ) ), _mm_setzero_si128() );
+    rateA                = _mm_add_epi32( rateA, _mm_andnot_si128( sigSbb, sig1 ) );
+    rateB                = _mm_add_epi32( rateB, _mm_andnot_si128( sigSbb, sig1 ) );
+    noZero               = _mm_and_si128( sigSbb, regular );
+  }
+  else
+  {
+    rateA                = _mm_add_epi32( rateA, sig1 );
+    rateB                = _mm_add_epi32( rateB, sig1 );
+    if( spt == SCAN_SOCSBB )
+    {
+      const __m128i sbb1 = _mm_loadu_si128( (const __m128i*) prevStates.sbbBits[1] );
+      rateA              = _mm_add_epi32( rateA, sbb1 );
+      rateB              = _mm_add_epi32( rateB, sbb1 );
+      rateZ              = _mm_add_epi32( rateZ, sbb1 );
+    }
+  }
+
+  //----- rates of the states without context coded bins left -----
+  if( !_mm_test_all_ones( regular ) )
+  {
+    int32_t escA[4], escB[4], escZ[4];
+    for( int k = 0; k < 4; k++ )
+    {
+      const int32_t* goRiceTab  = g_goRiceBits[prevStates.goRicePar[k]];
+      const int      goRiceZero = prevStates.goRiceZero[k];
+      const TCoeff   absLevelA  = k < 2 ? level0 : level3;
+      const TCoeff   absLevelB  = k < 2 ? level2 : level1;
+      escA[k] = ( 1 << SCALE_BITS ) + goRiceTab[absLevelA <= goRiceZero ? absLevelA - 1 : ( absLevelA < RICEMAX ? absLevelA : RICEMAX - 1 )];
+      escB[k] = ( 1 << SCALE_BITS ) + goRiceTab[absLevelB <= goRiceZero ? absLevelB - 1 : ( absLevelB < RICEMAX ? absLevelB : RICEMAX - 1 )];
+      escZ[k] = goRiceTab[goRiceZero];
+    }
+    rateA = _mm_blendv_epi8( _mm_loadu_si128( (const __m128i*) escA ), rateA, regular );
+    rateB = _mm_blendv_epi8( _mm_loadu_si128( (const __m128i*) escB ), rateB, regular );
+    rateZ = _mm_blendv_epi8( _mm_loadu_si128( (const __m128i*) escZ ), rateZ, regular );
+  }
+
+  //----- rd costs of the candidates A, B and zero of the states 0..3 -----
+  const __m256i rdCost = _mm256_loadu_si256( (const __m256i*) prevStates.rdCost );
+  const __m256i distA  = _mm256_setr_epi64x( pqData[0].deltaDist, pqData[0].deltaDist, pqData[3].deltaDist, pqData[3].deltaDist );
+  const __m256i distB  = _mm256_setr_epi64x( pqData[2].deltaDist, pqData[2].deltaDist, pqData[1].deltaDist, pqData[1].deltaDist );
+  const __m256i costA  = _mm256_add_epi64( _mm256_add_epi64( rdCost, distA ), _mm256_cvtepi32_epi64( rateA ) );
+  const __m256i costB  = _mm256_add_epi64( _mm256_add_epi64( rdCost, distB ), _mm256_cvtepi32_epi64( rateB ) );
+  const __m256i costZ  = _mm256_blendv_epi8( _mm256_add_epi64( rdCost, _mm256_cvtepi32_epi64( rateZ ) ),
+                                             _mm256_set1_epi64x( std::numeric_limits<int64_t>::max() ), _mm256_cvtepi32_epi64( noZero ) );
+
+  //----- candidates of the decisions 0..3 (lane = decision) -----
+  const __m256i permA  = _mm256_permute4x64_epi64( costA, 0xd8 );   // A0 A2 A1 A3
+  const __m256i permB  = _mm256_permute4x64_epi64( costB, 0x8d );   // B1 B3 B0 B2
+  const __m256i permZ  = _mm256_permute4x64_epi64( costZ, 0xd8 );   // Z0 Z2 Z1 Z3
+  __m256i       bestCost           = _mm256_set1_epi64x( std::numeric_limits<int64_t>::max() >> 2 );
+  __m256i       bestLevelAndPrevId = _mm256_setr_epi32( -1, -2, -1, -2, -1, -2, -1, -2 );
+  xSelect( bestCost, bestLevelAndPrevId, _mm256_blend_epi32( permA, permB, 0xf0 ), _mm256_setr_epi32( level0, 0, level3, 2, level2, 0, level1, 2 ) );
+  xSelect( bestCost, bestLevelAndPrevId, _mm256_blend_epi32( permZ, permA, 0xf0 ), _mm256_setr_epi32(      0, 0,      0, 2, level0, 1, level3, 3 ) );
+  xSelect( bestCost, bestLevelAndPrevId, _mm256_blend_epi32( permB, permZ, 0xf0 ), _mm256_setr_epi32( level2, 1, level1, 3,      0, 1,      0, 3 ) );
+  if( spt == SCAN_EOCSBB )
+  {
+    const __m256i skipCost = _mm256_add_epi64( _mm256_loadu_si256( (const __m256i*) skipStates.rdCost ),
+                                               _mm256_cvtepi32_epi64( _mm_loadu_si128( (const __m128i*) skipStates.sbbBits[0] ) ) );
+    xSelect( bestCost, bestLevelAndPrevId, skipCost, _mm256_setr_epi32( 0, 4, 0, 5, 0, 6, 0, 7 ) );
+  }
+  // a new last position starts the decisions 0 and 2
+  const int64_t startCost0 = pqData[0].deltaDist + lastOffset + startBits[xBitsIdx( level0 )] + xRiceBits( 0, level0 );
+  const int64_t startCost2 = pqData[2].deltaDist + lastOffset + startBits[xBitsIdx( level2 )] + xRiceBits( 0, level2 );
+  const __m256i startCost  = _mm256_setr_epi64x( startCost0, std::numeric_limits<int64_t>::max(), startCost2, std::numeric_limits<int64_t>::max() );
+  xSelect( bestCost, bestLevelAndPrevId, startCost, _mm256_setr_epi32( level0, -1, 0, 0, level2, -1, 0, 0 ) );
+
+  //----- store ( rdCost, absLevel, prevId ) -----
+  const __m256i dec02 = _mm256_unpacklo_epi64( bestCost, bestLevelAndPrevId );
+  const __m256i dec13 = _mm256_unpackhi_epi64( bestCost, bestLevelAndPrevId );
+  _mm_storeu_si128( (__m128i*) &decisions[0], _mm256_castsi256_si128     ( dec02 ) );
+  _mm_storeu_si128( (__m128i*) &decisions[1], _mm256_castsi256_si128     ( dec13 ) );
+  _mm_storeu_si128( (__m128i*) &decisions[2], _mm256_extracti128_si256   ( dec02, 1 ) );
+  _mm_storeu_si128( (__m128i*) &decisions[3], _mm256_extracti128_si256   ( dec13, 1 ) );
+}
+
+template <X86_VEXT vext>
+void DepQuant::_initDepQuantX86()
+{
+  m_decideRdCosts = simdDecideRdCosts<vext>;
+}
+
+template void DepQuant::_initDepQuantX86<SIMDX86>();
+
+#endif
+#endif
+#endif //#ifdef TARGET_SIMD_X86
+//! \}
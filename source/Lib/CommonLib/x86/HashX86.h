@@ -0,0 +1,166 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2021, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file
+ * \brief Implementation of the CRC32C block hashing
+ */
+
+#include "CommonDefX86.h"
+#include "../Hash.h"
+
+#ifdef TARGET_SIMD_X86
+
+#include <nmmintrin.h>
+
+#if defined( __x86_64__ ) || defined( _M_X64 )
+#define CRC32C_USE_U64 1
+#else
+#define CRC32C_USE_U64 0
+#endif
+
+template<X86_VEXT vext>
+static uint32_t simdCrc32cWords( uint32_t crc, const uint32_t* words, int num )
+{
+  int i = 0;
+#if CRC32C_USE_U64
+  uint64_t crc64 = crc;
+  for( ; i + 2 <= num; i += 2 )
+  {
+    crc64 = _mm_crc32_u64( crc64, uint64_t( words[i] ) | ( uint64_t( words[i + 1] ) << 32 ) );
+  }
+  crc = uint32_t( crc64 );
+#endif
+  for( ; i < num; i++ )
+  {
+    crc = _mm_crc32_u32( crc, words[i] );
+  }
+  return crc;
+}
+
+template<X86_VEXT vext>
+static uint32_t simdCrc32cWordsReversed( uint32_t crc, const uint32_t* words, int num )
+{
+  int i = num - 1;
+#if CRC32C_USE_U64
+  uint64_t crc64 = crc;
+  for( ; i >= 1; i -= 2 )
+  {
+    crc64 = _mm_crc32_u64( crc64, uint64_t( words[i] ) | ( uint64_t( words[i - 1] ) << 32 ) );
+  }
+  crc = uint32_t( crc64 );
+#endif
+  for( ; i >= 0; i-- )
+  {
+    crc = _mm_crc32_u32( crc, words[i] );
+  }
+  return crc;
+}
+
+template<X86_VEXT vext>
+static uint32_t simdCrc32cPels( uint32_t crc, const Pel* pels, int num )
+{
+  int i = 0;
+#if CRC32C_USE_U64
+  uint64_t crc64 = crc;
+  for( ; i + 4 <= num; i += 4 )
+  {
+    uint64_t data;
+    memcpy( &data, pels + i, sizeof( data ) );
+    crc64 = _mm_crc32_u64( crc64, data );
+  }
+  crc = uint32_t( crc64 );
+#endif
+  for( ; i < num; i++ )
+  {
+    crc = _mm_crc32_u16( crc, uint16_t( pels[i] ) );
+  }
+  return crc;
+}
+
+template<X86_VEXT vext>
+static void simdHashRow2x2( const Pel* src0, const Pel* src1, int num, int shift, uint32_t* hash1, uint32_t* hash2, bool* rowSame, bool* colSame )
+{
+  const __m128i vmask  = _mm_set1_epi16( 0xff );
+  const __m128i vshift = _mm_cvtsi32_si128( shift );
+  uint32_t words[8];
+
+  int x = 0;
+  // the right neighbours are read up to src[x + 8], which is inside the row as num is the width minus one
+  for( ; x + 8 <= num; x += 8 )
+  {
+    const __m128i a0 = _mm_and_si128( _mm_sra_epi16( _mm_loadu_si128( ( const __m128i* ) &src0[x] ), vshift ), vmask );
+    const __m128i a1 = _mm_and_si128( _mm_sra_epi16( _mm_loadu_si128( ( const __m128i* ) &src0[x + 1] ), vshift ), vmask );
+    const __m128i b0 = _mm_and_si128( _mm_sra_epi16( _mm_loadu_si128( ( const __m128i* ) &src1[x] ), vshift ), vmask );
+    const __m128i b1 = _mm_and_si128( _mm_sra_epi16( _mm_loadu_si128( ( const __m128i* ) &src1[x + 1] ), vshift ), vmask );
+
+    // bytes of each 2x2 block in raster order, as packed by getPixelsIn1DCharArrayByBlock2x2
+    const __m128i top = _mm_or_si128( a0, _mm_slli_epi16( a1, 8 ) );
+    const __m128i bot = _mm_or_si128( b0, _mm_slli_epi16( b1, 8 ) );
+    _mm_storeu_si128( ( __m128i* ) &words[0], _mm_unpacklo_epi16( top, bot ) );
+    _mm_storeu_si128( ( __m128i* ) &words[4], _mm_unpackhi_epi16( top, bot ) );
+
+    for( int i = 0; i < 8; i++ )
+    {
+      const uint32_t word = words[i];
+      hash1  [x + i] = _mm_crc32_u32( Crc32c::m_seed1, word );
+      hash2  [x + i] = _mm_crc32_u32( Crc32c::m_seed2, word );
+      rowSame[x + i] = ( ( word ^ ( word >>  8 ) ) & 0x00ff00ff ) == 0;
+      colSame[x + i] = ( ( word ^ ( word >> 16 ) ) & 0x0000ffff ) == 0;
+    }
+  }
+  for( ; x < num; x++ )
+  {
+    const uint32_t word = uint32_t( uint8_t( src0[x] >> shift ) ) | ( uint32_t( uint8_t( src0[x + 1] >> shift ) ) << 8 )
+                        | ( uint32_t( uint8_t( src1[x] >> shift ) ) << 16 ) | ( uint32_t( uint8_t( src1[x + 1] >> shift ) ) << 24 );
+    hash1  [x] = _mm_crc32_u32( Crc32c::m_seed1, word );
+    hash2  [x] = _mm_crc32_u32( Crc32c::m_seed2, word );
+    rowSame[x] = ( ( word ^ ( word >>  8 ) ) & 0x00ff00ff ) == 0;
+    colSame[x] = ( ( word ^ ( word >> 16 ) ) & 0x0000ffff ) == 0;
+  }
+}
+
+template <X86_VEXT vext>
+void Crc32c::_initCrc32cX86()
+{
+  computeWords         = simdCrc32cWords<vext>;
+  computeWordsReversed = simdCrc32cWordsReversed<vext>;
+  computePels          = simdCrc32cPels<vext>;
+  hashRow2x2           = simdHashRow2x2<vext>;
+}
+
+template void Crc32c::_initCrc32cX86<SIMDX86>();
+
+
+#endif //#ifdef TARGET_SIMD_X86
+//! \}
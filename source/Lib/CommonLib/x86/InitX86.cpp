@@ -41,6 +41,11 @@
 #include "CommonLib/CommonDef.h"
 #include "CommonLib/InterpolationFilter.h"
 #include "CommonLib/TrQuant.h"
+#include "CommonLib/Quant.h"
+#include "CommonLib/DepQuant.h"
+#include "CommonLib/IntraPrediction.h"
+#include "CommonLib/DeblockingFilter.h"
+#include "CommonLib/SampleAdaptiveOffset.h"
 #include "CommonLib/RdCost.h"
 #include "CommonLib/Buffer.h"
 
@@ -48,7 +53,7 @@
 
 #include "CommonLib/AdaptiveLoopFilter.h"
 
-#include "CommonLib/IbcHashMap.h"
+#include "CommonLib/Hash.h"
 
 #ifdef TARGET_SIMD_X86
 
@@ -167,8 +172,139 @@ void AdaptiveLoopFilter::initAdaptiveLoopFilterX86()
 }
 #endif
 
-#if ENABLE_SIMD_OPT_IBC
-void IbcHashMap::initIbcHashMapX86()
+#if ENABLE_SIMD_OPT_TRAFO
+void TrQuant::initTrQuantX86()
+{
+  auto vext = read_x86_extension_flags();
+  switch (vext)
+  {
+  case AVX512:
+  case AVX2:
+    _initTrQuantX86<AVX2>();
+    break;
+  case AVX:
+    _initTrQuantX86<AVX>();
+    break;
+  case SSE42:
+  case SSE41:
+    _initTrQuantX86<SSE41>();
+    break;
+  default:
+    break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_QUANT
+void Quant::initQuantX86()
+{
+  auto vext = read_x86_extension_flags();
+  switch (vext)
+  {
+  case AVX512:
+  case AVX2:
+    _initQuantX86<AVX2>();
+    break;
+  case AVX:
+    _initQuantX86<AVX>();
+    break;
+  case SSE42:
+  case SSE41:
+    _initQuantX86<SSE41>();
+    break;
+  default:
+    break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_INTRAPRED
+void IntraPrediction::initIntraPredictionX86()
+{
+  auto vext = read_x86_extension_flags();
+  switch (vext)
+  {
+  case AVX512:
+  case AVX2:
+    _initIntraPredictionX86<AVX2>();
+    break;
+  case AVX:
+    _initIntraPredictionX86<AVX>();
+    break;
+  case SSE42:
+  case SSE41:
+    _initIntraPredictionX86<SSE41>();
+    break;
+  default:
+    break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_DEBLOCK
+void DeblockingFilter::initDeblockingFilterX86()
+{
+  auto vext = read_x86_extension_flags();
+  switch (vext)
+  {
+  case AVX512:
+  case AVX2:
+    _initDeblockingFilterX86<AVX2>();
+    break;
+  case AVX:
+    _initDeblockingFilterX86<AVX>();
+    break;
+  case SSE42:
+  case SSE41:
+    _initDeblockingFilterX86<SSE41>();
+    break;
+  default:
+    break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_SAO
+void SampleAdaptiveOffset::initSampleAdaptiveOffsetX86()
+{
+  auto vext = read_x86_extension_flags();
+  switch (vext)
+  {
+  case AVX512:
+  case AVX2:
+    _initSampleAdaptiveOffsetX86<AVX2>();
+    break;
+  case AVX:
+    _initSampleAdaptiveOffsetX86<AVX>();
+    break;
+  case SSE42:
+  case SSE41:
+    _initSampleAdaptiveOffsetX86<SSE41>();
+    break;
+  default:
+    break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_DEPQUANT
+void DepQuant::initDepQuantX86()
+{
+  auto vext = read_x86_extension_flags();
+  switch (vext)
+  {
+  case AVX512:
+  case AVX2:
+    _initDepQuantX86<AVX2>();
+    break;
+  default:
+    break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_HASH
+void Crc32c::initCrc32cX86()
 {
   auto vext = read_x86_extension_flags();
   switch (vext)
@@ -177,7 +313,7 @@ void IbcHashMap::initIbcHashMapX86()
   case AVX2:
   case AVX:
   case SSE42:
-    _initIbcHashMapX86<SSE42>();
+    _initCrc32cX86<SSE42>();
     break;
   case SSE41:
   default:
@@ -0,0 +1,712 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2021, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file
+ * \brief Implementation of the intra prediction kernels (planar, DC, angular, PDPC, reference filtering, MIP), SIMD version
+ */
+
+#include "CommonDefX86.h"
+#include "../IntraPrediction.h"
+#include "../InterpolationFilter.h"
+#include "../MipData.h"
+
+//! \ingroup CommonLib
+//! \{
+
+#ifdef TARGET_SIMD_X86
+#if ENABLE_SIMD_OPT_INTRAPRED
+
+// The kernels work on 16 bit samples with 32 bit intermediates wherever the scalar code can exceed 16 bits. All of them
+// process 8 (4) samples per iteration and fall back to the scalar code for the remaining columns, so that block widths
+// of 1 and 2 (ISP sub-partitions, transposed horizontal modes) are handled as well.
+
+template<X86_VEXT vext>
+static void simdPredIntraPlanar( const CPelBuf &pSrc, PelBuf &pDst )
+{
+  const int width  = pDst.width;
+  const int height = pDst.height;
+
+  const int log2W = floorLog2( width );
+  const int log2H = floorLog2( height );
+
+  CHECK( width > MAX_CU_SIZE, "width greater than limit" );
+  CHECK( height > MAX_CU_SIZE, "height greater than limit" );
+
+  const Pel* top  = pSrc.buf + 1;
+  const Pel* left = pSrc.buf + pSrc.stride + 1;
+
+  const int bottomLeft = left[height];
+  const int topRight   = top[width];
+
+  // vertical interpolation, updated row by row: (top << log2H) + (y + 1) * (bottomLeft - top)
+  ALIGN_DATA( MEMORY_ALIGN_DEF_SIZE, int vertPred[MAX_CU_SIZE] );
+  ALIGN_DATA( MEMORY_ALIGN_DEF_SIZE, int vertStep[MAX_CU_SIZE] );
+
+  for( int x = 0; x < width; x++ )
+  {
+    vertStep[x] = bottomLeft - top[x];
+    vertPred[x] = top[x] << log2H;
+  }
+
+  const int       offset     = 1 << ( log2W + log2H );
+  const int       finalShift = 1 + log2W + log2H;
+  const __m128i   vOffset    = _mm_set1_epi32( offset );
+  const ptrdiff_t stride     = pDst.stride;
+  Pel*            pred       = pDst.buf;
+
+  for( int y = 0; y < height; y++, pred += stride )
+  {
+    // horizontal interpolation: (left << log2W) + (x + 1) * (topRight - left)
+    const int horBase = left[y] << log2W;
+    const int horStep = topRight - left[y];
+    int x = 0;
+
+#ifdef USE_AVX2
+    if( vext >= AVX2 && width >= 8 )
+    {
+      const __m256i vHorStep8 = _mm256_set1_epi32( 8 * horStep );
+      const __m256i vOffset8  = _mm256_set1_epi32( offset );
+      __m256i       hor       = _mm256_add_epi32( _mm256_set1_epi32( horBase ), _mm256_mullo_epi32( _mm256_setr_epi32( 1, 2, 3, 4, 5, 6, 7, 8 ), _mm256_set1_epi32( horStep ) ) );
+
+      for( ; x + 8 <= width; x += 8, hor = _mm256_add_epi32( hor, vHorStep8 ) )
+      {
+        __m256i vert = _mm256_load_si256( (const __m256i*) &vertPred[x] );
+        vert         = _mm256_add_epi32( vert, _mm256_load_si256( (const __m256i*) &vertStep[x] ) );
+        _mm256_store_si256( (__m256i*) &vertPred[x], vert );
+
+        __m256i sum = _mm256_add_epi32( _mm256_slli_epi32( hor, log2H ), _mm256_slli_epi32( vert, log2W ) );
+        sum         = _mm256_srai_epi32( _mm256_add_epi32( sum, vOffset8 ), finalShift );
+
+        _mm_storeu_si128( (__m128i*) &pred[x], _mm_packs_epi32( _mm256_castsi256_si128( sum ), _mm256_extracti128_si256( sum, 1 ) ) );
+      }
+    }
+#endif
+    if( x + 4 <= width )
+    {
+      const __m128i vHorStep4 = _mm_set1_epi32( 4 * horStep );
+      __m128i       hor       = _mm_add_epi32( _mm_set1_epi32( horBase ), _mm_mullo_epi32( _mm_setr_epi32( x + 1, x + 2, x + 3, x + 4 ), _mm_set1_epi32( horStep ) ) );
+
+      for( ; x + 4 <= width; x += 4, hor = _mm_add_epi32( hor, vHorStep4 ) )
+      {
+        __m128i vert = _mm_load_si128( (const __m128i*) &vertPred[x] );
+        vert         = _mm_add_epi32( vert, _mm_load_si128( (const __m128i*) &vertStep[x] ) );
+        _mm_store_si128( (__m128i*) &vertPred[x], vert );
+
+        __m128i sum = _mm_add_epi32( _mm_slli_epi32( hor, log2H ), _mm_slli_epi32( vert, log2W ) );
+        sum         = _mm_srai_epi32( _mm_add_epi32( sum, vOffset ), finalShift );
+
+        _mm_storel_epi64( (__m128i*) &pred[x], _mm_packs_epi32( sum, sum ) );
+      }
+    }
+
+    for( ; x < width; x++ )
+    {
+      vertPred[x] += vertStep[x];
+      pred[x] = ( ( ( horBase + ( x + 1 ) * horStep ) << log2H ) + ( vertPred[x] << log2W ) + offset ) >> finalShift;
+    }
+  }
+}
+
+// sum of n consecutive samples
+template<X86_VEXT vext>
+static inline int simdSumSamples( const Pel* src, const int n )
+{
+  const __m128i vOne = _mm_set1_epi16( 1 );
+  __m128i       vSum = _mm_setzero_si128();
+  int           i    = 0;
+
+  for( ; i + 8 <= n; i += 8 )
+  {
+    vSum = _mm_add_epi32( vSum, _mm_madd_epi16( _mm_loadu_si128( (const __m128i*) &src[i] ), vOne ) );
+  }
+  if( i + 4 <= n )
+  {
+    vSum = _mm_add_epi32( vSum, _mm_madd_epi16( _mm_loadl_epi64( (const __m128i*) &src[i] ), vOne ) );
+    i += 4;
+  }
+
+  vSum    = _mm_add_epi32( vSum, _mm_shuffle_epi32( vSum, 0x4e ) );
+  vSum    = _mm_add_epi32( vSum, _mm_shuffle_epi32( vSum, 0xb1 ) );
+  int sum = _mm_cvtsi128_si32( vSum );
+
+  for( ; i < n; i++ )
+  {
+    sum += src[i];
+  }
+
+  return sum;
+}
+
+template<X86_VEXT vext>
+static void simdPredIntraDc( const CPelBuf &pSrc, PelBuf &pDst, const int multiRefIdx )
+{
+  CHECK( pDst.width == 0 || pDst.height == 0, "Empty area provided" );
+
+  const int  width     = pDst.width;
+  const int  height    = pDst.height;
+  const auto denom     = ( width == height ) ? ( width << 1 ) : std::max( width, height );
+  const auto divShift  = floorLog2( denom );
+  const auto divOffset = ( denom >> 1 );
+
+  int sum = 0;
+
+  if( width >= height )
+  {
+    sum += simdSumSamples<vext>( pSrc.buf + multiRefIdx + 1, width );
+  }
+  if( width <= height )
+  {
+    sum += simdSumSamples<vext>( pSrc.buf + pSrc.stride + multiRefIdx + 1, height );
+  }
+
+  const Pel     dcVal = ( sum + divOffset ) >> divShift;
+  const __m128i vDc   = _mm_set1_epi16( dcVal );
+  Pel*          dst   = pDst.buf;
+
+  for( int y = 0; y < height; y++, dst += pDst.stride )
+  {
+    int x = 0;
+    for( ; x + 8 <= width; x += 8 )
+    {
+      _mm_storeu_si128( (__m128i*) &dst[x], vDc );
+    }
+    if( x + 4 <= width )
+    {
+      _mm_storel_epi64( (__m128i*) &dst[x], vDc );
+      x += 4;
+    }
+    for( ; x < width; x++ )
+    {
+      dst[x] = dcVal;
+    }
+  }
+}
+
+// 4-tap interpolation of refMain[0 .. 3] with the coefficient pairs (c0, c1) and (c2, c3), rounded by 6 bits
+static inline __m128i xFilter4Tap( const Pel* ref, const __m128i c01, const __m128i c23, const __m128i vOffset )
+{
+  const __m128i p0 = _mm_loadu_si128( (const __m128i*) &ref[0] );
+  const __m128i p1 = _mm_loadu_si128( (const __m128i*) &ref[1] );
+  const __m128i p2 = _mm_loadu_si128( (const __m128i*) &ref[2] );
+  const __m128i p3 = _mm_loadu_si128( (const __m128i*) &ref[3] );
+
+  __m128i lo = _mm_add_epi32( _mm_madd_epi16( _mm_unpacklo_epi16( p0, p1 ), c01 ), _mm_madd_epi16( _mm_unpacklo_epi16( p2, p3 ), c23 ) );
+  __m128i hi = _mm_add_epi32( _mm_madd_epi16( _mm_unpackhi_epi16( p0, p1 ), c01 ), _mm_madd_epi16( _mm_unpackhi_epi16( p2, p3 ), c23 ) );
+  lo         = _mm_srai_epi32( _mm_add_epi32( lo, vOffset ), 6 );
+  hi         = _mm_srai_epi32( _mm_add_epi32( hi, vOffset ), 6 );
+
+  return _mm_packs_epi32( lo, hi );
+}
+
+static inline __m128i xFilter4Tap4( const Pel* ref, const __m128i c01, const __m128i c23, const __m128i vOffset )
+{
+  const __m128i p0 = _mm_loadl_epi64( (const __m128i*) &ref[0] );
+  const __m128i p1 = _mm_loadl_epi64( (const __m128i*) &ref[1] );
+  const __m128i p2 = _mm_loadl_epi64( (const __m128i*) &ref[2] );
+  const __m128i p3 = _mm_loadl_epi64( (const __m128i*) &ref[3] );
+
+  __m128i lo = _mm_add_epi32( _mm_madd_epi16( _mm_unpacklo_epi16( p0, p1 ), c01 ), _mm_madd_epi16( _mm_unpacklo_epi16( p2, p3 ), c23 ) );
+  lo         = _mm_srai_epi32( _mm_add_epi32( lo, vOffset ), 6 );
+
+  return _mm_packs_epi32( lo, lo );
+}
+
+template<X86_VEXT vext>
+static void simdPredIntraAngLuma( Pel* pDst, const ptrdiff_t dstStride, const Pel* refMain, const int width, const int height, const int deltaPos,
+                                  const int intraPredAngle, const bool useCubicFilter, const ClpRng& clpRng )
+{
+  const __m128i vMin    = _mm_set1_epi16( clpRng.min );
+  const __m128i vMax    = _mm_set1_epi16( clpRng.max );
+  const __m128i vOffset = _mm_set1_epi32( 32 );
+
+  for( int y = 0, pos = deltaPos; y < height; y++, pos += intraPredAngle, pDst += dstStride )
+  {
+    const int deltaInt   = pos >> 5;
+    const int deltaFract = pos & 31;
+
+    const TFilterCoeff        intraSmoothingFilter[4] = { TFilterCoeff( 16 - ( deltaFract >> 1 ) ), TFilterCoeff( 32 - ( deltaFract >> 1 ) ), TFilterCoeff( 16 + ( deltaFract >> 1 ) ), TFilterCoeff( deltaFract >> 1 ) };
+    const TFilterCoeff* const f                       = useCubicFilter ? InterpolationFilter::getChromaFilterTable( deltaFract ) : intraSmoothingFilter;
+
+    const Pel* ref = refMain + deltaInt;
+    int        x   = 0;
+
+#ifdef USE_AVX2
+    if( vext >= AVX2 && width >= 16 )
+    {
+      const __m256i c01      = _mm256_set1_epi32( ( f[0] & 0xffff ) | ( f[1] << 16 ) );
+      const __m256i c23      = _mm256_set1_epi32( ( f[2] & 0xffff ) | ( f[3] << 16 ) );
+      const __m256i vOffset8 = _mm256_set1_epi32( 32 );
+      const __m256i vMin16   = _mm256_set1_epi16( clpRng.min );
+      const __m256i vMax16   = _mm256_set1_epi16( clpRng.max );
+
+      for( ; x + 16 <= width; x += 16 )
+      {
+        const __m256i p0 = _mm256_loadu_si256( (const __m256i*) &ref[x + 0] );
+        const __m256i p1 = _mm256_loadu_si256( (const __m256i*) &ref[x + 1] );
+        const __m256i p2 = _mm256_loadu_si256( (const __m256i*) &ref[x + 2] );
+        const __m256i p3 = _mm256_loadu_si256( (const __m256i*) &ref[x + 3] );
+
+        __m256i lo = _mm256_add_epi32( _mm256_madd_epi16( _mm256_unpacklo_epi16( p0, p1 ), c01 ), _mm256_madd_epi16( _mm256_unpacklo_epi16( p2, p3 ), c23 ) );
+        __m256i hi = _mm256_add_epi32( _mm256_madd_epi16( _mm256_unpackhi_epi16( p0, p1 ), c01 ), _mm256_madd_epi16( _mm256_unpackhi_epi16( p2, p3 ), c23 ) );
+        lo         = _mm256_srai_epi32( _mm256_add_epi32( lo, vOffset8 ), 6 );
+        hi         = _mm256_srai_epi32( _mm256_add_epi32( hi, vOffset8 ), 6 );
+
+        // the in-lane unpack and pack cancel out, the samples come back in order
+        const __m256i val = _mm256_min_epi16( vMax16, _mm256_max_epi16( vMin16, _mm256_packs_epi32( lo, hi ) ) );
+        _mm256_storeu_si256( (__m256i*) &pDst[x], val );
+      }
+    }
+#endif
+    const __m128i c01 = _mm_set1_epi32( ( f[0] & 0xffff ) | ( f[1] << 16 ) );
+    const __m128i c23 = _mm_set1_epi32( ( f[2] & 0xffff ) | ( f[3] << 16 ) );
+
+    for( ; x + 8 <= width; x += 8 )
+    {
+      const __m128i val = _mm_min_epi16( vMax, _mm_max_epi16( vMin, xFilter4Tap( &ref[x], c01, c23, vOffset ) ) );
+      _mm_storeu_si128( (__m128i*) &pDst[x], val );
+    }
+    if( x + 4 <= width )
+    {
+      const __m128i val = _mm_min_epi16( vMax, _mm_max_epi16( vMin, xFilter4Tap4( &ref[x], c01, c23, vOffset ) ) );
+      _mm_storel_epi64( (__m128i*) &pDst[x], val );
+      x += 4;
+    }
+
+    for( ; x < width; x++ )
+    {
+      const Pel val = ( f[0] * ref[x] + f[1] * ref[x + 1] + f[2] * ref[x + 2] + f[3] * ref[x + 3] + 32 ) >> 6;
+      pDst[x]       = ClipPel( val, clpRng );
+    }
+  }
+}
+
+// ( ( 32 - deltaFract ) * p0 + deltaFract * p1 + 16 ) >> 5 equals the scalar p0 + ( ( deltaFract * ( p1 - p0 ) + 16 ) >> 5 )
+template<X86_VEXT vext>
+static void simdPredIntraAngChroma( Pel* pDst, const ptrdiff_t dstStride, const Pel* refMain, const int width, const int height, const int deltaPos,
+                                    const int intraPredAngle )
+{
+  const __m128i vOffset = _mm_set1_epi32( 16 );
+
+  for( int y = 0, pos = deltaPos; y < height; y++, pos += intraPredAngle, pDst += dstStride )
+  {
+    const int  deltaInt   = pos >> 5;
+    const int  deltaFract = pos & 31;
+    const Pel* ref        = refMain + deltaInt + 1;
+    int        x          = 0;
+
+#ifdef USE_AVX2
+    if( vext >= AVX2 && width >= 16 )
+    {
+      const __m256i coeff    = _mm256_set1_epi32( ( 32 - deltaFract ) | ( deltaFract << 16 ) );
+      const __m256i vOffset8 = _mm256_set1_epi32( 16 );
+
+      for( ; x + 16 <= width; x += 16 )
+      {
+        const __m256i p0 = _mm256_loadu_si256( (const __m256i*) &ref[x] );
+        const __m256i p1 = _mm256_loadu_si256( (const __m256i*) &ref[x + 1] );
+        const __m256i lo = _mm256_srai_epi32( _mm256_add_epi32( _mm256_madd_epi16( _mm256_unpacklo_epi16( p0, p1 ), coeff ), vOffset8 ), 5 );
+        const __m256i hi = _mm256_srai_epi32( _mm256_add_epi32( _mm256_madd_epi16( _mm256_unpackhi_epi16( p0, p1 ), coeff ), vOffset8 ), 5 );
+        _mm256_storeu_si256( (__m256i*) &pDst[x], _mm256_packs_epi32( lo, hi ) );
+      }
+    }
+#endif
+    const __m128i coeff = _mm_set1_epi32( ( 32 - deltaFract ) | ( deltaFract << 16 ) );
+
+    for( ; x + 8 <= width; x += 8 )
+    {
+      const __m128i p0 = _mm_loadu_si128( (const __m128i*) &ref[x] );
+      const __m128i p1 = _mm_loadu_si128( (const __m128i*) &ref[x + 1] );
+      const __m128i lo = _mm_srai_epi32( _mm_add_epi32( _mm_madd_epi16( _mm_unpacklo_epi16( p0, p1 ), coeff ), vOffset ), 5 );
+      const __m128i hi = _mm_srai_epi32( _mm_add_epi32( _mm_madd_epi16( _mm_unpackhi_epi16( p0, p1 ), coeff ), vOffset ), 5 );
+      _mm_storeu_si128( (__m128i*) &pDst[x], _mm_packs_epi32( lo, hi ) );
+    }
+    if( x + 4 <= width )
+    {
+      const __m128i p0 = _mm_loadl_epi64( (const __m128i*) &ref[x] );
+      const __m128i p1 = _mm_loadl_epi64( (const __m128i*) &ref[x + 1] );
+      const __m128i lo = _mm_srai_epi32( _mm_add_epi32( _mm_madd_epi16( _mm_unpacklo_epi16( p0, p1 ), coeff ), vOffset ), 5 );
+      _mm_storel_epi64( (__m128i*) &pDst[x], _mm_packs_epi32( lo, lo ) );
+      x += 4;
+    }
+
+    for( ; x < width; x++ )
+    {
+      pDst[x] = ref[x] + ( ( deltaFract * ( ref[x + 1] - ref[x] ) + 16 ) >> 5 );
+    }
+  }
+}
+
+// the weights wL and wT vanish for x, y >= 3 << scale, only the top rows are combined over the full width
+template<X86_VEXT vext>
+static void simdPdpcPlanarDc( const CPelBuf &pSrc, PelBuf &pDst, const int scale )
+{
+  const int width  = pDst.width;
+  const int height = pDst.height;
+
+  ALIGN_DATA( MEMORY_ALIGN_DEF_SIZE, Pel wLeft[MAX_CU_SIZE] );
+  for( int x = 0; x < width; x++ )
+  {
+    wLeft[x] = 32 >> std::min( 31, ( ( x << 1 ) >> scale ) );
+  }
+
+  const Pel*    top     = pSrc.buf + 1;
+  const Pel*    left    = pSrc.buf + pSrc.stride + 1;
+  const int     wWidth  = std::min( 3 << scale, width );
+  const __m128i vOffset = _mm_set1_epi32( 32 );
+  Pel*          dst     = pDst.buf;
+
+  for( int y = 0; y < height; y++, dst += pDst.stride )
+  {
+    const int     wT     = 32 >> std::min( 31, ( ( y << 1 ) >> scale ) );
+    const int     xEnd   = wT ? width : wWidth;
+    const __m128i vLeft  = _mm_set1_epi16( left[y] );
+    const __m128i vWT    = _mm_set1_epi16( wT );
+    int           x      = 0;
+
+    for( ; x + 8 <= xEnd; x += 8 )
+    {
+      const __m128i val = _mm_loadu_si128( (const __m128i*) &dst[x] );
+      const __m128i dL  = _mm_sub_epi16( vLeft, val );
+      const __m128i dT  = _mm_sub_epi16( _mm_loadu_si128( (const __m128i*) &top[x] ), val );
+      const __m128i wL  = _mm_load_si128( (const __m128i*) &wLeft[x] );
+
+      __m128i lo = _mm_madd_epi16( _mm_unpacklo_epi16( dL, dT ), _mm_unpacklo_epi16( wL, vWT ) );
+      __m128i hi = _mm_madd_epi16( _mm_unpackhi_epi16( dL, dT ), _mm_unpackhi_epi16( wL, vWT ) );
+      lo         = _mm_srai_epi32( _mm_add_epi32( lo, vOffset ), 6 );
+      hi         = _mm_srai_epi32( _mm_add_epi32( hi, vOffset ), 6 );
+
+      _mm_storeu_si128( (__m128i*) &dst[x], _mm_add_epi16( val, _mm_packs_epi32( lo, hi ) ) );
+    }
+    if( x + 4 <= xEnd )
+    {
+      const __m128i val = _mm_loadl_epi64( (const __m128i*) &dst[x] );
+      const __m128i dL  = _mm_sub_epi16( vLeft, val );
+      const __m128i dT  = _mm_sub_epi16( _mm_loadl_epi64( (const __m128i*) &top[x] ), val );
+      const __m128i wL  = _mm_loadl_epi64( (const __m128i*) &wLeft[x] );
+
+      __m128i lo = _mm_madd_epi16( _mm_unpacklo_epi16( dL, dT ), _mm_unpacklo_epi16( wL, vWT ) );
+      lo         = _mm_srai_epi32( _mm_add_epi32( lo, vOffset ), 6 );
+
+      _mm_storel_epi64( (__m128i*) &dst[x], _mm_add_epi16( val, _mm_packs_epi32( lo, lo ) ) );
+      x += 4;
+    }
+
+    for( ; x < xEnd; x++ )
+    {
+      const Pel val = dst[x];
+      dst[x]        = val + ( ( wLeft[x] * ( left[y] - val ) + wT * ( top[x] - val ) + 32 ) >> 6 );
+    }
+  }
+}
+
+template<X86_VEXT vext>
+static void simdPdpcHorVer( Pel* pDst, const ptrdiff_t dstStride, const Pel* refSide, const Pel topLeft, const int width, const int height,
+                            const int scale, const ClpRng& clpRng )
+{
+  const int wWidth = std::min( 3 << scale, width );
+
+  if( wWidth < 4 )
+  {
+    for( int y = 0; y < height; y++, pDst += dstStride )
+    {
+      const Pel left = refSide[1 + y];
+      for( int x = 0; x < wWidth; x++ )
+      {
+        const int wL  = 32 >> ( 2 * x >> scale );
+        pDst[x]       = ClipPel( pDst[x] + ( ( wL * ( left - topLeft ) + 32 ) >> 6 ), clpRng );
+      }
+    }
+    return;
+  }
+
+  // the weights of the (at most 24) filtered columns, paired with the rounding offset for _mm_madd_epi16
+  ALIGN_DATA( MEMORY_ALIGN_DEF_SIZE, int16_t wLeft[2 * 24] );
+  for( int x = 0; x < wWidth; x++ )
+  {
+    wLeft[2 * x]     = 32 >> ( 2 * x >> scale );
+    wLeft[2 * x + 1] = 32;
+  }
+
+  const __m128i vMin = _mm_set1_epi16( clpRng.min );
+  const __m128i vMax = _mm_set1_epi16( clpRng.max );
+
+  for( int y = 0; y < height; y++, pDst += dstStride )
+  {
+    const __m128i vDelta = _mm_set1_epi32( ( ( refSide[1 + y] - topLeft ) & 0xffff ) | ( 1 << 16 ) );
+    int           x      = 0;
+
+    for( ; x + 4 <= wWidth; x += 4 )
+    {
+      const __m128i w   = _mm_load_si128( (const __m128i*) &wLeft[2 * x] );
+      const __m128i add = _mm_srai_epi32( _mm_madd_epi16( w, vDelta ), 6 );
+      const __m128i val = _mm_add_epi32( _mm_cvtepi16_epi32( _mm_loadl_epi64( (const __m128i*) &pDst[x] ) ), add );
+      _mm_storel_epi64( (__m128i*) &pDst[x], _mm_min_epi16( vMax, _mm_max_epi16( vMin, _mm_packs_epi32( val, val ) ) ) );
+    }
+    for( ; x < wWidth; x++ )
+    {
+      const int wL = 32 >> ( 2 * x >> scale );
+      pDst[x]      = ClipPel( pDst[x] + ( ( wL * ( refSide[1 + y] - topLeft ) + 32 ) >> 6 ), clpRng );
+    }
+  }
+}
+
+template<X86_VEXT vext>
+static void simdTransposeBlk( const Pel* src, const ptrdiff_t srcStride, Pel* dst, const ptrdiff_t dstStride, const int width, const int height )
+{
+  if( ( width & 3 ) || ( height & 3 ) )
+  {
+    for( int y = 0; y < height; y++, src += srcStride )
+    {
+      for( int x = 0; x < width; x++ )
+      {
+        dst[x * dstStride + y] = src[x];
+      }
+    }
+    return;
+  }
+
+  if( ( width & 7 ) == 0 && ( height & 7 ) == 0 )
+  {
+    for( int y = 0; y < height; y += 8 )
+    {
+      for( int x = 0; x < width; x += 8 )
+      {
+        const Pel* s = src + y * srcStride + x;
+        __m128i    r[8], t[8];
+
+        for( int i = 0; i < 8; i++ )
+        {
+          r[i] = _mm_loadu_si128( (const __m128i*) &s[i * srcStride] );
+        }
+
+        for( int i = 0; i < 4; i++ )
+        {
+          t[i]     = _mm_unpacklo_epi16( r[2 * i], r[2 * i + 1] );
+          t[i + 4] = _mm_unpackhi_epi16( r[2 * i], r[2 * i + 1] );
+        }
+
+        const __m128i u0 = _mm_unpacklo_epi32( t[0], t[1] );
+        const __m128i u1 = _mm_unpackhi_epi32( t[0], t[1] );
+        const __m128i u2 = _mm_unpacklo_epi32( t[2], t[3] );
+        const __m128i u3 = _mm_unpackhi_epi32( t[2], t[3] );
+        const __m128i u4 = _mm_unpacklo_epi32( t[4], t[5] );
+        const __m128i u5 = _mm_unpackhi_epi32( t[4], t[5] );
+        const __m128i u6 = _mm_unpacklo_epi32( t[6], t[7] );
+        const __m128i u7 = _mm_unpackhi_epi32( t[6], t[7] );
+
+        Pel* d = dst + x * dstStride + y;
+        _mm_storeu_si128( (__m128i*) &d[0 * dstStride], _mm_unpacklo_epi64( u0, u2 ) );
+        _mm_storeu_si128( (__m128i*) &d[1 * dstStride], _mm_unpackhi_epi64( u0, u2 ) );
+        _mm_storeu_si128( (__m128i*) &d[2 * dstStride], _mm_unpacklo_epi64( u1, u3 ) );
+        _mm_storeu_si128( (__m128i*) &d[3 * dstStride], _mm_unpackhi_epi64( u1, u3 ) );
+        _mm_storeu_si128( (__m128i*) &d[4 * dstStride], _mm_unpacklo_epi64( u4, u6 ) );
+        _mm_storeu_si128( (__m128i*) &d[5 * dstStride], _mm_unpackhi_epi64( u4, u6 ) );
+        _mm_storeu_si128( (__m128i*) &d[6 * dstStride], _mm_unpacklo_epi64( u5, u7 ) );
+        _mm_storeu_si128( (__m128i*) &d[7 * dstStride], _mm_unpackhi_epi64( u5, u7 ) );
+      }
+    }
+    return;
+  }
+
+  for( int y = 0; y < height; y += 4 )
+  {
+    for( int x = 0; x < width; x += 4 )
+    {
+      const Pel*    s  = src + y * srcStride + x;
+      const __m128i t0 = _mm_unpacklo_epi16( _mm_loadl_epi64( (const __m128i*) &s[0] ),             _mm_loadl_epi64( (const __m128i*) &s[srcStride] ) );
+      const __m128i t1 = _mm_unpacklo_epi16( _mm_loadl_epi64( (const __m128i*) &s[2 * srcStride] ), _mm_loadl_epi64( (const __m128i*) &s[3 * srcStride] ) );
+      const __m128i u0 = _mm_unpacklo_epi32( t0, t1 );
+      const __m128i u1 = _mm_unpackhi_epi32( t0, t1 );
+
+      Pel* d = dst + x * dstStride + y;
+      _mm_storel_epi64( (__m128i*) &d[0 * dstStride], u0 );
+      _mm_storel_epi64( (__m128i*) &d[1 * dstStride], _mm_unpackhi_epi64( u0, u0 ) );
+      _mm_storel_epi64( (__m128i*) &d[2 * dstStride], u1 );
+      _mm_storel_epi64( (__m128i*) &d[3 * dstStride], _mm_unpackhi_epi64( u1, u1 ) );
+    }
+  }
+}
+
+// ( a + 2 * b + c + 2 ) >> 2 == ( b + ( ( a + c ) >> 1 ) + 1 ) >> 1, evaluated with the unsigned averages without overflow
+template<X86_VEXT vext>
+static void simdFilterRefSamples( const Pel* src, Pel* dst, const int length )
+{
+  int i = 1;
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    const __m256i vOne = _mm256_set1_epi16( 1 );
+
+    for( ; i + 16 <= length; i += 16 )
+    {
+      const __m256i a  = _mm256_loadu_si256( (const __m256i*) &src[i - 1] );
+      const __m256i b  = _mm256_loadu_si256( (const __m256i*) &src[i] );
+      const __m256i c  = _mm256_loadu_si256( (const __m256i*) &src[i + 1] );
+      const __m256i ac = _mm256_sub_epi16( _mm256_avg_epu16( a, c ), _mm256_and_si256( _mm256_xor_si256( a, c ), vOne ) );
+      _mm256_storeu_si256( (__m256i*) &dst[i], _mm256_avg_epu16( b, ac ) );
+    }
+  }
+#endif
+  const __m128i vOne = _mm_set1_epi16( 1 );
+
+  for( ; i + 8 <= length; i += 8 )
+  {
+    const __m128i a  = _mm_loadu_si128( (const __m128i*) &src[i - 1] );
+    const __m128i b  = _mm_loadu_si128( (const __m128i*) &src[i] );
+    const __m128i c  = _mm_loadu_si128( (const __m128i*) &src[i + 1] );
+    const __m128i ac = _mm_sub_epi16( _mm_avg_epu16( a, c ), _mm_and_si128( _mm_xor_si128( a, c ), vOne ) );
+    _mm_storeu_si128( (__m128i*) &dst[i], _mm_avg_epu16( b, ac ) );
+  }
+
+  for( ; i < length; i++ )
+  {
+    dst[i] = ( src[i - 1] + 2 * src[i] + src[i + 1] + 2 ) >> 2;
+  }
+}
+
+// Matrix multiplication of the reduced boundary with the 8 bit weights. The boundary samples are narrowed to 16 bit for
+// _mm_madd_epi16, four outputs are reduced at once with _mm_hadd_epi32. For sizeId 2 the rows have 7 weights which are
+// applied to input[1 .. 7], the 8th loaded weight belongs to the next row and is multiplied by zero.
+template<X86_VEXT vext>
+static void simdComputeReducedPred( int* const result, const int* const input, const uint8_t* matrix, const int sizeId, const int inputOffset,
+                                    const bool transpose, const int bitDepth )
+{
+  const int inputSize       = sizeId == 0 ? 4 : 8;
+  const int reducedPredSize = sizeId < 2 ? 4 : 8;
+  const int numOutputs      = reducedPredSize * reducedPredSize;
+
+  ALIGN_DATA( MEMORY_ALIGN_DEF_SIZE, int resBufTransposed[MIP_MAX_REDUCED_OUTPUT_SAMPLES] );
+  int* const resPtr = transpose ? resBufTransposed : result;
+
+  int sum = 0;
+  for( int i = 0; i < inputSize; i++ ) { sum += input[i]; }
+  const int offset = ( 1 << ( MIP_SHIFT_MATRIX - 1 ) ) - MIP_OFFSET_MATRIX * sum;
+
+  const __m128i vOffset      = _mm_set1_epi32( offset );
+  const __m128i vInputOffset = _mm_set1_epi32( inputOffset );
+  const __m128i vMax         = _mm_set1_epi32( ( 1 << bitDepth ) - 1 );
+
+  const __m128i in0 = _mm_loadu_si128( (const __m128i*) &input[0] );
+  __m128i       vIn;
+
+  if( sizeId == 0 )
+  {
+    vIn = _mm_packs_epi32( in0, in0 );
+  }
+  else
+  {
+    vIn = _mm_packs_epi32( in0, _mm_loadu_si128( (const __m128i*) &input[4] ) );
+    if( sizeId == 2 )
+    {
+      vIn = _mm_srli_si128( vIn, 2 );
+    }
+  }
+
+  for( int k = 0; k < numOutputs; k += 4 )
+  {
+    __m128i dot;
+
+    if( sizeId == 0 )
+    {
+      const __m128i w01 = _mm_cvtepu8_epi16( _mm_loadl_epi64( (const __m128i*) &matrix[4 * k] ) );
+      const __m128i w23 = _mm_cvtepu8_epi16( _mm_loadl_epi64( (const __m128i*) &matrix[4 * k + 8] ) );
+      dot               = _mm_hadd_epi32( _mm_madd_epi16( vIn, w01 ), _mm_madd_epi16( vIn, w23 ) );
+    }
+    else
+    {
+      const int rowSize = sizeId == 1 ? 8 : 7;
+      __m128i   m[4];
+
+      for( int i = 0; i < 4; i++ )
+      {
+        const uint8_t* weight = &matrix[( k + i ) * rowSize];
+        __m128i        w;
+
+        if( sizeId == 2 && k + i == numOutputs - 1 )
+        {
+          // the last row of the matrix, avoid reading past its end
+          uint8_t lastRow[8] = { 0 };
+          memcpy( lastRow, weight, 7 );
+          w = _mm_loadl_epi64( (const __m128i*) lastRow );
+        }
+        else
+        {
+          w = _mm_loadl_epi64( (const __m128i*) weight );
+        }
+
+        m[i] = _mm_madd_epi16( vIn, _mm_cvtepu8_epi16( w ) );
+      }
+
+      dot = _mm_hadd_epi32( _mm_hadd_epi32( m[0], m[1] ), _mm_hadd_epi32( m[2], m[3] ) );
+    }
+
+    __m128i val = _mm_srai_epi32( _mm_add_epi32( dot, vOffset ), MIP_SHIFT_MATRIX );
+    val         = _mm_add_epi32( val, vInputOffset );
+    val         = _mm_min_epi32( vMax, _mm_max_epi32( _mm_setzero_si128(), val ) );
+    _mm_storeu_si128( (__m128i*) &resPtr[k], val );
+  }
+
+  if( transpose )
+  {
+    for( int y = 0; y < reducedPredSize; y++ )
+    {
+      for( int x = 0; x < reducedPredSize; x++ )
+      {
+        result[y * reducedPredSize + x] = resPtr[x * reducedPredSize + y];
+      }
+    }
+  }
+}
+
+template<X86_VEXT vext>
+void IntraPrediction::_initIntraPredictionX86()
+{
+  m_predIntraPlanar    = simdPredIntraPlanar<vext>;
+  m_predIntraDc        = simdPredIntraDc<vext>;
+  m_predIntraAngLuma   = simdPredIntraAngLuma<vext>;
+  m_predIntraAngChroma = simdPredIntraAngChroma<vext>;
+  m_pdpcPlanarDc       = simdPdpcPlanarDc<vext>;
+  m_pdpcHorVer         = simdPdpcHorVer<vext>;
+  m_transposeBlk       = simdTransposeBlk<vext>;
+  m_filterRefSamples   = simdFilterRefSamples<vext>;
+
+  m_matrixIntraPred.m_computeReducedPred = simdComputeReducedPred<vext>;
+}
+
+template void IntraPrediction::_initIntraPredictionX86<SIMDX86>();
+
+#endif //#if ENABLE_SIMD_OPT_INTRAPRED
+#endif //#ifdef TARGET_SIMD_X86
+//! \}
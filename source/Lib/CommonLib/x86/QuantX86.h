@@ -0,0 +1,349 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2021, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file
+ * \brief Implementation of the quantization, dequantization and RDOQ level estimation kernels, SIMD version
+ */
+
+#include "CommonDefX86.h"
+#include "../Quant.h"
+
+//! \ingroup CommonLib
+//! \{
+
+#ifdef TARGET_SIMD_X86
+#if ENABLE_SIMD_OPT_QUANT
+
+// The products of the absolute coefficients and the quantization scales need up to 64 bits, they are computed for the
+// even and the odd lanes with _mm_mul_epu32. With QUANT_SHIFT + per + transform shift <= 31 (true for all bit depths
+// without RExt__HIGH_BIT_DEPTH_SUPPORT) the quantized magnitudes and the remainders (deltaU) fit into 32 bits.
+
+static inline __m128i xQuantScale( const int* quantCoeff, const int defaultQuantCoeff, const int n )
+{
+  return quantCoeff ? _mm_loadu_si128( (const __m128i*) &quantCoeff[n] ) : _mm_set1_epi32( defaultQuantCoeff );
+}
+
+// 64 bit products abs * scale of the even (lo) and the odd (hi) lanes
+static inline void xMulEvenOdd( const __m128i absLevel, const __m128i scale, __m128i& lo, __m128i& hi )
+{
+  lo = _mm_mul_epu32( absLevel, scale );
+  hi = _mm_mul_epu32( _mm_srli_epi64( absLevel, 32 ), _mm_srli_epi64( scale, 32 ) );
+}
+
+// lower 32 bits of the 64 bit lanes of lo (even) and hi (odd)
+static inline __m128i xPackLow( const __m128i lo, const __m128i hi )
+{
+  return _mm_blend_epi16( lo, _mm_slli_epi64( hi, 32 ), 0xcc );
+}
+
+#ifdef USE_AVX2
+static inline __m256i xQuantScale256( const int* quantCoeff, const int defaultQuantCoeff, const int n )
+{
+  return quantCoeff ? _mm256_loadu_si256( (const __m256i*) &quantCoeff[n] ) : _mm256_set1_epi32( defaultQuantCoeff );
+}
+
+static inline void xMulEvenOdd256( const __m256i absLevel, const __m256i scale, __m256i& lo, __m256i& hi )
+{
+  lo = _mm256_mul_epu32( absLevel, scale );
+  hi = _mm256_mul_epu32( _mm256_srli_epi64( absLevel, 32 ), _mm256_srli_epi64( scale, 32 ) );
+}
+
+static inline __m256i xPackLow256( const __m256i lo, const __m256i hi )
+{
+  return _mm256_blend_epi32( lo, _mm256_slli_epi64( hi, 32 ), 0xaa );
+}
+#endif
+
+template<X86_VEXT vext>
+static void simdQuantCoeffs( const TCoeff* src, TCoeff* dst, TCoeff* deltaU, const int numCoeff, const int* quantCoeff, const int defaultQuantCoeff,
+                             const int64_t add, const int qBits, const TCoeff entropyCodingMinimum, const TCoeff entropyCodingMaximum, TCoeff& absSum )
+{
+  const __m128i vShift  = _mm_cvtsi32_si128( qBits );
+  const __m128i vShift8 = _mm_cvtsi32_si128( qBits - 8 );
+  int           n       = 0;
+  __m128i       vSum    = _mm_setzero_si128();
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    const __m256i vAdd  = _mm256_set1_epi64x( add );
+    const __m256i vMin  = _mm256_set1_epi32( entropyCodingMinimum );
+    const __m256i vMax  = _mm256_set1_epi32( entropyCodingMaximum );
+    __m256i       vSum8 = _mm256_setzero_si256();
+
+    for( ; n + 8 <= numCoeff; n += 8 )
+    {
+      const __m256i level = _mm256_loadu_si256( (const __m256i*) &src[n] );
+      __m256i tmpLo, tmpHi;
+      xMulEvenOdd256( _mm256_abs_epi32( level ), xQuantScale256( quantCoeff, defaultQuantCoeff, n ), tmpLo, tmpHi );
+
+      const __m256i qLo   = _mm256_srl_epi64( _mm256_add_epi64( tmpLo, vAdd ), vShift );
+      const __m256i qHi   = _mm256_srl_epi64( _mm256_add_epi64( tmpHi, vAdd ), vShift );
+      const __m256i q     = xPackLow256( qLo, qHi );
+      const __m256i delta = xPackLow256( _mm256_sub_epi64( tmpLo, _mm256_sll_epi64( qLo, vShift ) ), _mm256_sub_epi64( tmpHi, _mm256_sll_epi64( qHi, vShift ) ) );
+
+      _mm256_storeu_si256( (__m256i*) &deltaU[n], _mm256_sra_epi32( delta, vShift8 ) );
+      _mm256_storeu_si256( (__m256i*) &dst[n], _mm256_min_epi32( vMax, _mm256_max_epi32( vMin, _mm256_sign_epi32( q, level ) ) ) );
+      vSum8 = _mm256_add_epi32( vSum8, q );
+    }
+    vSum = _mm_add_epi32( _mm256_castsi256_si128( vSum8 ), _mm256_extracti128_si256( vSum8, 1 ) );
+  }
+#endif
+  const __m128i vAdd = _mm_set1_epi64x( add );
+  const __m128i vMin = _mm_set1_epi32( entropyCodingMinimum );
+  const __m128i vMax = _mm_set1_epi32( entropyCodingMaximum );
+
+  for( ; n + 4 <= numCoeff; n += 4 )
+  {
+    const __m128i level = _mm_loadu_si128( (const __m128i*) &src[n] );
+    __m128i tmpLo, tmpHi;
+    xMulEvenOdd( _mm_abs_epi32( level ), xQuantScale( quantCoeff, defaultQuantCoeff, n ), tmpLo, tmpHi );
+
+    const __m128i qLo   = _mm_srl_epi64( _mm_add_epi64( tmpLo, vAdd ), vShift );
+    const __m128i qHi   = _mm_srl_epi64( _mm_add_epi64( tmpHi, vAdd ), vShift );
+    const __m128i q     = xPackLow( qLo, qHi );
+    const __m128i delta = xPackLow( _mm_sub_epi64( tmpLo, _mm_sll_epi64( qLo, vShift ) ), _mm_sub_epi64( tmpHi, _mm_sll_epi64( qHi, vShift ) ) );
+
+    _mm_storeu_si128( (__m128i*) &deltaU[n], _mm_sra_epi32( delta, vShift8 ) );
+    _mm_storeu_si128( (__m128i*) &dst[n], _mm_min_epi32( vMax, _mm_max_epi32( vMin, _mm_sign_epi32( q, level ) ) ) );
+    vSum = _mm_add_epi32( vSum, q );
+  }
+
+  vSum    = _mm_add_epi32( vSum, _mm_shuffle_epi32( vSum, 0x4e ) );
+  vSum    = _mm_add_epi32( vSum, _mm_shuffle_epi32( vSum, 0xb1 ) );
+  absSum += _mm_cvtsi128_si32( vSum );
+
+  for( ; n < numCoeff; n++ )
+  {
+    const int64_t tmpLevel           = (int64_t) abs( src[n] ) * ( quantCoeff ? quantCoeff[n] : defaultQuantCoeff );
+    const TCoeff  quantisedMagnitude = TCoeff( ( tmpLevel + add ) >> qBits );
+
+    deltaU[n] = (TCoeff) ( ( tmpLevel - ( (int64_t) quantisedMagnitude << qBits ) ) >> ( qBits - 8 ) );
+    absSum   += quantisedMagnitude;
+    dst[n]    = Clip3<TCoeff>( entropyCodingMinimum, entropyCodingMaximum, src[n] < 0 ? -quantisedMagnitude : quantisedMagnitude );
+  }
+}
+
+template<X86_VEXT vext>
+static void simdDequantCoeffs( const TCoeff* src, TCoeff* dst, const int numCoeff, const int* dequantCoeff, const int scale, const int rightShift,
+                               const Intermediate_Int inputMinimum, const Intermediate_Int inputMaximum, const TCoeff transformMinimum, const TCoeff transformMaximum )
+{
+  const Intermediate_Int add    = rightShift > 0 ? (Intermediate_Int) 1 << ( rightShift - 1 ) : 0;
+  const __m128i          vShift = _mm_cvtsi32_si128( rightShift > 0 ? rightShift : -rightShift );
+  int                    n      = 0;
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    const __m256i vInMin  = _mm256_set1_epi32( inputMinimum );
+    const __m256i vInMax  = _mm256_set1_epi32( inputMaximum );
+    const __m256i vOutMin = _mm256_set1_epi32( transformMinimum );
+    const __m256i vOutMax = _mm256_set1_epi32( transformMaximum );
+    const __m256i vAdd    = _mm256_set1_epi32( add );
+
+    for( ; n + 8 <= numCoeff; n += 8 )
+    {
+      const __m256i clipQCoef = _mm256_min_epi32( vInMax, _mm256_max_epi32( vInMin, _mm256_loadu_si256( (const __m256i*) &src[n] ) ) );
+      const __m256i scaled    = _mm256_mullo_epi32( clipQCoef, xQuantScale256( dequantCoeff, scale, n ) );
+      const __m256i coeffQ    = rightShift > 0 ? _mm256_sra_epi32( _mm256_add_epi32( scaled, vAdd ), vShift ) : _mm256_sll_epi32( scaled, vShift );
+
+      _mm256_storeu_si256( (__m256i*) &dst[n], _mm256_min_epi32( vOutMax, _mm256_max_epi32( vOutMin, coeffQ ) ) );
+    }
+  }
+#endif
+  const __m128i vInMin  = _mm_set1_epi32( inputMinimum );
+  const __m128i vInMax  = _mm_set1_epi32( inputMaximum );
+  const __m128i vOutMin = _mm_set1_epi32( transformMinimum );
+  const __m128i vOutMax = _mm_set1_epi32( transformMaximum );
+  const __m128i vAdd    = _mm_set1_epi32( add );
+
+  for( ; n + 4 <= numCoeff; n += 4 )
+  {
+    const __m128i clipQCoef = _mm_min_epi32( vInMax, _mm_max_epi32( vInMin, _mm_loadu_si128( (const __m128i*) &src[n] ) ) );
+    const __m128i scaled    = _mm_mullo_epi32( clipQCoef, xQuantScale( dequantCoeff, scale, n ) );
+    const __m128i coeffQ    = rightShift > 0 ? _mm_sra_epi32( _mm_add_epi32( scaled, vAdd ), vShift ) : _mm_sll_epi32( scaled, vShift );
+
+    _mm_storeu_si128( (__m128i*) &dst[n], _mm_min_epi32( vOutMax, _mm_max_epi32( vOutMin, coeffQ ) ) );
+  }
+
+  for( ; n < numCoeff; n++ )
+  {
+    const Intermediate_Int clipQCoef = Clip3<Intermediate_Int>( inputMinimum, inputMaximum, src[n] );
+    const Intermediate_Int scaled    = clipQCoef * ( dequantCoeff ? dequantCoeff[n] : scale );
+    const Intermediate_Int coeffQ    = rightShift > 0 ? ( scaled + add ) >> rightShift : scaled << -rightShift;
+
+    dst[n] = TCoeff( Clip3<Intermediate_Int>( transformMinimum, transformMaximum, coeffQ ) );
+  }
+}
+
+template<X86_VEXT vext>
+static bool simdAnySigCoeff( const TCoeff* src, const int numCoeff, const int* quantCoeff, const int defaultQuantCoeff, const int64_t add, const int qBits )
+{
+  const __m128i vShift = _mm_cvtsi32_si128( qBits );
+  int           n      = 0;
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    const __m256i vAdd = _mm256_set1_epi64x( add );
+
+    for( ; n + 8 <= numCoeff; n += 8 )
+    {
+      __m256i tmpLo, tmpHi;
+      xMulEvenOdd256( _mm256_abs_epi32( _mm256_loadu_si256( (const __m256i*) &src[n] ) ), xQuantScale256( quantCoeff, defaultQuantCoeff, n ), tmpLo, tmpHi );
+
+      const __m256i q = xPackLow256( _mm256_srl_epi64( _mm256_add_epi64( tmpLo, vAdd ), vShift ), _mm256_srl_epi64( _mm256_add_epi64( tmpHi, vAdd ), vShift ) );
+      if( !_mm256_testz_si256( q, q ) )
+      {
+        return true;
+      }
+    }
+  }
+#endif
+  const __m128i vAdd = _mm_set1_epi64x( add );
+
+  for( ; n + 4 <= numCoeff; n += 4 )
+  {
+    __m128i tmpLo, tmpHi;
+    xMulEvenOdd( _mm_abs_epi32( _mm_loadu_si128( (const __m128i*) &src[n] ) ), xQuantScale( quantCoeff, defaultQuantCoeff, n ), tmpLo, tmpHi );
+
+    const __m128i q = xPackLow( _mm_srl_epi64( _mm_add_epi64( tmpLo, vAdd ), vShift ), _mm_srl_epi64( _mm_add_epi64( tmpHi, vAdd ), vShift ) );
+    if( !_mm_testz_si128( q, q ) )
+    {
+      return true;
+    }
+  }
+
+  for( ; n < numCoeff; n++ )
+  {
+    const int64_t tmpLevel = (int64_t) abs( src[n] ) * ( quantCoeff ? quantCoeff[n] : defaultQuantCoeff );
+
+    if( TCoeff( ( tmpLevel + add ) >> qBits ) != 0 )
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+// the scaled levels are limited to maxLevelDouble = INT32_MAX - half, tmpLevel > maxLevelDouble is detected as
+// ( tmpLevel + half ) >> 31 != 0
+template<X86_VEXT vext>
+static void simdEstimateRdoqLevels( const TCoeff* src, const int stride, const int width, const int height, const int* quantCoeff, const int defaultQuantCoeff,
+                                    const double* errScale, const double defaultErrScale, const int qBits, Intermediate_Int* levelDouble, double* costCoeff0 )
+{
+  const Intermediate_Int half           = Intermediate_Int( 1 ) << ( qBits - 1 );
+  const Intermediate_Int maxLevelDouble = std::numeric_limits<Intermediate_Int>::max() - half;
+  // complete rows are processed as one row
+  const int              rowLength      = width == stride ? width * height : width;
+  const int              numRows        = width == stride ? 1 : height;
+
+  for( int y = 0; y < numRows; y++ )
+  {
+    const int offset = y * stride;
+    int       x      = 0;
+
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      const __m256i vHalf  = _mm256_set1_epi64x( half );
+      const __m256i vLimit = _mm256_set1_epi32( maxLevelDouble );
+
+      for( ; x + 8 <= rowLength; x += 8 )
+      {
+        const int n = offset + x;
+        __m256i tmpLo, tmpHi;
+        xMulEvenOdd256( _mm256_abs_epi32( _mm256_loadu_si256( (const __m256i*) &src[n] ) ), xQuantScale256( quantCoeff, defaultQuantCoeff, n ), tmpLo, tmpHi );
+
+        const __m256i over  = xPackLow256( _mm256_srli_epi64( _mm256_add_epi64( tmpLo, vHalf ), 31 ), _mm256_srli_epi64( _mm256_add_epi64( tmpHi, vHalf ), 31 ) );
+        const __m256i level = _mm256_blendv_epi8( xPackLow256( tmpLo, tmpHi ), vLimit, _mm256_cmpgt_epi32( over, _mm256_setzero_si256() ) );
+        _mm256_storeu_si256( (__m256i*) &levelDouble[n], level );
+
+        const __m256d err0  = _mm256_cvtepi32_pd( _mm256_castsi256_si128( level ) );
+        const __m256d err1  = _mm256_cvtepi32_pd( _mm256_extracti128_si256( level, 1 ) );
+        const __m256d scale0 = errScale ? _mm256_loadu_pd( &errScale[n] )     : _mm256_set1_pd( defaultErrScale );
+        const __m256d scale1 = errScale ? _mm256_loadu_pd( &errScale[n + 4] ) : _mm256_set1_pd( defaultErrScale );
+        _mm256_storeu_pd( &costCoeff0[n],     _mm256_mul_pd( _mm256_mul_pd( err0, err0 ), scale0 ) );
+        _mm256_storeu_pd( &costCoeff0[n + 4], _mm256_mul_pd( _mm256_mul_pd( err1, err1 ), scale1 ) );
+      }
+    }
+#endif
+    const __m128i vHalf  = _mm_set1_epi64x( half );
+    const __m128i vLimit = _mm_set1_epi32( maxLevelDouble );
+
+    for( ; x + 4 <= rowLength; x += 4 )
+    {
+      const int n = offset + x;
+      __m128i tmpLo, tmpHi;
+      xMulEvenOdd( _mm_abs_epi32( _mm_loadu_si128( (const __m128i*) &src[n] ) ), xQuantScale( quantCoeff, defaultQuantCoeff, n ), tmpLo, tmpHi );
+
+      const __m128i over  = xPackLow( _mm_srli_epi64( _mm_add_epi64( tmpLo, vHalf ), 31 ), _mm_srli_epi64( _mm_add_epi64( tmpHi, vHalf ), 31 ) );
+      const __m128i level = _mm_blendv_epi8( xPackLow( tmpLo, tmpHi ), vLimit, _mm_cmpgt_epi32( over, _mm_setzero_si128() ) );
+      _mm_storeu_si128( (__m128i*) &levelDouble[n], level );
+
+      const __m128d err0   = _mm_cvtepi32_pd( level );
+      const __m128d err1   = _mm_cvtepi32_pd( _mm_unpackhi_epi64( level, level ) );
+      const __m128d scale0 = errScale ? _mm_loadu_pd( &errScale[n] )     : _mm_set1_pd( defaultErrScale );
+      const __m128d scale1 = errScale ? _mm_loadu_pd( &errScale[n + 2] ) : _mm_set1_pd( defaultErrScale );
+      _mm_storeu_pd( &costCoeff0[n],     _mm_mul_pd( _mm_mul_pd( err0, err0 ), scale0 ) );
+      _mm_storeu_pd( &costCoeff0[n + 2], _mm_mul_pd( _mm_mul_pd( err1, err1 ), scale1 ) );
+    }
+
+    for( ; x < rowLength; x++ )
+    {
+      const int     n        = offset + x;
+      const int64_t tmpLevel = int64_t( abs( src[n] ) ) * ( quantCoeff ? quantCoeff[n] : defaultQuantCoeff );
+
+      levelDouble[n] = (Intermediate_Int) std::min<int64_t>( tmpLevel, maxLevelDouble );
+
+      const double dErr = double( levelDouble[n] );
+      costCoeff0[n]     = dErr * dErr * ( errScale ? errScale[n] : defaultErrScale );
+    }
+  }
+}
+
+template<X86_VEXT vext>
+void Quant::_initQuantX86()
+{
+  m_quantCoeffs        = simdQuantCoeffs<vext>;
+  m_dequantCoeffs      = simdDequantCoeffs<vext>;
+  m_anySigCoeff        = simdAnySigCoeff<vext>;
+  m_estimateRdoqLevels = simdEstimateRdoqLevels<vext>;
+}
+
+template void Quant::_initQuantX86<SIMDX86>();
+
+#endif //#if ENABLE_SIMD_OPT_QUANT
+#endif //#ifdef TARGET_SIMD_X86
+//! \}
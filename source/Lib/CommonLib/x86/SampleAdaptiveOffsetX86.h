@@ -0,0 +1,319 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2021, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/**
+ * \file
+ * \brief Implementation of the SAO offset and statistics kernels, SIMD version
+ */
+
+#include "CommonDefX86.h"
+#include "../SampleAdaptiveOffset.h"
+
+//! \ingroup CommonLib
+//! \{
+
+#ifdef TARGET_SIMD_X86
+#if ENABLE_SIMD_OPT_SAO
+
+// The offsets are looked up with a byte shuffle from tables of 8 16 bit entries, the control selects the bytes
+// 2 * idx and 2 * idx + 1 of the table for an index idx < 8 in each 16 bit lane.
+static inline __m128i xShuffleCtrl( const __m128i idx )
+{
+  const __m128i idx2 = _mm_add_epi16( idx, idx );
+  return _mm_add_epi16( _mm_add_epi16( idx2, _mm_slli_epi16( idx2, 8 ) ), _mm_set1_epi16( 0x0100 ) );
+}
+
+// edge class + 2 = sgn( c - a ) + sgn( c - b ) + 2 of the samples c with their neighbours a and b
+static inline __m128i xEdgeIdx( const __m128i c, const __m128i a, const __m128i b )
+{
+  const __m128i signA = _mm_sub_epi16( _mm_cmpgt_epi16( a, c ), _mm_cmpgt_epi16( c, a ) );
+  const __m128i signB = _mm_sub_epi16( _mm_cmpgt_epi16( b, c ), _mm_cmpgt_epi16( c, b ) );
+  return _mm_add_epi16( _mm_add_epi16( signA, signB ), _mm_set1_epi16( 2 ) );
+}
+
+#ifdef USE_AVX2
+static inline __m256i xShuffleCtrl( const __m256i idx )
+{
+  const __m256i idx2 = _mm256_add_epi16( idx, idx );
+  return _mm256_add_epi16( _mm256_add_epi16( idx2, _mm256_slli_epi16( idx2, 8 ) ), _mm256_set1_epi16( 0x0100 ) );
+}
+
+static inline __m256i xEdgeIdx( const __m256i c, const __m256i a, const __m256i b )
+{
+  const __m256i signA = _mm256_sub_epi16( _mm256_cmpgt_epi16( a, c ), _mm256_cmpgt_epi16( c, a ) );
+  const __m256i signB = _mm256_sub_epi16( _mm256_cmpgt_epi16( b, c ), _mm256_cmpgt_epi16( c, b ) );
+  return _mm256_add_epi16( _mm256_add_epi16( signA, signB ), _mm256_set1_epi16( 2 ) );
+}
+#endif
+
+template<X86_VEXT vext>
+static void simdOffsetEdgeRows( const ClpRng& clpRng, const int* offset, const Pel* src, const ptrdiff_t srcStride, Pel* res,
+                                const ptrdiff_t resStride, const int startX, const int endX, const int numRows, const ptrdiff_t nbOffset )
+{
+  const __m128i table = _mm_setr_epi16( offset[-2], offset[-1], offset[0], offset[1], offset[2], 0, 0, 0 );
+  const __m128i vMin  = _mm_set1_epi16( clpRng.min );
+  const __m128i vMax  = _mm_set1_epi16( clpRng.max );
+#ifdef USE_AVX2
+  const __m256i table256 = _mm256_broadcastsi128_si256( table );
+  const __m256i vMin256  = _mm256_set1_epi16( clpRng.min );
+  const __m256i vMax256  = _mm256_set1_epi16( clpRng.max );
+#endif
+
+  for( int y = 0; y < numRows; y++, src += srcStride, res += resStride )
+  {
+    int x = startX;
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      for( ; x + 16 <= endX; x += 16 )
+      {
+        const __m256i c   = _mm256_loadu_si256( (const __m256i*) &src[x] );
+        const __m256i a   = _mm256_loadu_si256( (const __m256i*) &src[x - nbOffset] );
+        const __m256i b   = _mm256_loadu_si256( (const __m256i*) &src[x + nbOffset] );
+        const __m256i off = _mm256_shuffle_epi8( table256, xShuffleCtrl( xEdgeIdx( c, a, b ) ) );
+        const __m256i r   = _mm256_min_epi16( vMax256, _mm256_max_epi16( vMin256, _mm256_add_epi16( c, off ) ) );
+        _mm256_storeu_si256( (__m256i*) &res[x], r );
+      }
+    }
+#endif
+    for( ; x + 8 <= endX; x += 8 )
+    {
+      const __m128i c   = _mm_loadu_si128( (const __m128i*) &src[x] );
+      const __m128i a   = _mm_loadu_si128( (const __m128i*) &src[x - nbOffset] );
+      const __m128i b   = _mm_loadu_si128( (const __m128i*) &src[x + nbOffset] );
+      const __m128i off = _mm_shuffle_epi8( table, xShuffleCtrl( xEdgeIdx( c, a, b ) ) );
+      _mm_storeu_si128( (__m128i*) &res[x], _mm_min_epi16( vMax, _mm_max_epi16( vMin, _mm_add_epi16( c, off ) ) ) );
+    }
+    for( ; x < endX; x++ )
+    {
+      const int edgeType = sgn( src[x] - src[x - nbOffset] ) + sgn( src[x] - src[x + nbOffset] );
+      res[x] = ClipPel<int>( src[x] + offset[edgeType], clpRng );
+    }
+  }
+}
+
+// band offsets of the 32 bands from four tables, selected by bit 3 and bit 4 of the band index
+static inline __m128i xBandOffset( const __m128i band, const __m128i* table )
+{
+  const __m128i ctrl = xShuffleCtrl( _mm_and_si128( band, _mm_set1_epi16( 7 ) ) );
+  const __m128i sel8 = _mm_srai_epi16( _mm_slli_epi16( band, 12 ), 15 );
+  const __m128i sel16 = _mm_srai_epi16( _mm_slli_epi16( band, 11 ), 15 );
+  const __m128i lo = _mm_blendv_epi8( _mm_shuffle_epi8( table[0], ctrl ), _mm_shuffle_epi8( table[1], ctrl ), sel8 );
+  const __m128i hi = _mm_blendv_epi8( _mm_shuffle_epi8( table[2], ctrl ), _mm_shuffle_epi8( table[3], ctrl ), sel8 );
+  return _mm_blendv_epi8( lo, hi, sel16 );
+}
+
+#ifdef USE_AVX2
+static inline __m256i xBandOffset( const __m256i band, const __m256i* table )
+{
+  const __m256i ctrl = xShuffleCtrl( _mm256_and_si256( band, _mm256_set1_epi16( 7 ) ) );
+  const __m256i sel8 = _mm256_srai_epi16( _mm256_slli_epi16( band, 12 ), 15 );
+  const __m256i sel16 = _mm256_srai_epi16( _mm256_slli_epi16( band, 11 ), 15 );
+  const __m256i lo = _mm256_blendv_epi8( _mm256_shuffle_epi8( table[0], ctrl ), _mm256_shuffle_epi8( table[1], ctrl ), sel8 );
+  const __m256i hi = _mm256_blendv_epi8( _mm256_shuffle_epi8( table[2], ctrl ), _mm256_shuffle_epi8( table[3], ctrl ), sel8 );
+  return _mm256_blendv_epi8( lo, hi, sel16 );
+}
+#endif
+
+template<X86_VEXT vext>
+static void simdOffsetBand( const ClpRng& clpRng, const int* offset, const int shiftBits, const Pel* src, const ptrdiff_t srcStride, Pel* res,
+                            const ptrdiff_t resStride, const int width, const int height )
+{
+  __m128i table[4];
+  for( int i = 0; i < 4; i++ )
+  {
+    const int* o = &offset[8 * i];
+    table[i] = _mm_setr_epi16( o[0], o[1], o[2], o[3], o[4], o[5], o[6], o[7] );
+  }
+  const __m128i shift = _mm_cvtsi32_si128( shiftBits );
+  const __m128i vMin  = _mm_set1_epi16( clpRng.min );
+  const __m128i vMax  = _mm_set1_epi16( clpRng.max );
+#ifdef USE_AVX2
+  __m256i table256[4];
+  for( int i = 0; i < 4; i++ )
+  {
+    table256[i] = _mm256_broadcastsi128_si256( table[i] );
+  }
+  const __m256i vMin256 = _mm256_set1_epi16( clpRng.min );
+  const __m256i vMax256 = _mm256_set1_epi16( clpRng.max );
+#endif
+
+  for( int y = 0; y < height; y++, src += srcStride, res += resStride )
+  {
+    int x = 0;
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      for( ; x + 16 <= width; x += 16 )
+      {
+        const __m256i c   = _mm256_loadu_si256( (const __m256i*) &src[x] );
+        const __m256i off = xBandOffset( _mm256_srl_epi16( c, shift ), table256 );
+        const __m256i r   = _mm256_min_epi16( vMax256, _mm256_max_epi16( vMin256, _mm256_add_epi16( c, off ) ) );
+        _mm256_storeu_si256( (__m256i*) &res[x], r );
+      }
+    }
+#endif
+    for( ; x + 8 <= width; x += 8 )
+    {
+      const __m128i c   = _mm_loadu_si128( (const __m128i*) &src[x] );
+      const __m128i off = xBandOffset( _mm_srl_epi16( c, shift ), table );
+      _mm_storeu_si128( (__m128i*) &res[x], _mm_min_epi16( vMax, _mm_max_epi16( vMin, _mm_add_epi16( c, off ) ) ) );
+    }
+    for( ; x < width; x++ )
+    {
+      res[x] = ClipPel<int>( src[x] + offset[src[x] >> shiftBits], clpRng );
+    }
+  }
+}
+
+// The differences org - src of each edge class are summed up in 32 bit lanes (at most 128 x 128 samples of up to
+// 12 bits per block), the counts in 16 bit lanes, which are widened after each row.
+template<X86_VEXT vext>
+static void simdCalcEdgeStats( const Pel* src, const ptrdiff_t srcStride, const Pel* org, const ptrdiff_t orgStride, const int startX,
+                               const int endX, const int numRows, const ptrdiff_t nbOffset, int64_t* diff, int64_t* count )
+{
+  if( numRows <= 0 || startX >= endX )
+  {
+    return;
+  }
+
+  const __m128i one = _mm_set1_epi16( 1 );
+  __m128i       sumDiff[NUM_SAO_EO_CLASSES], sumCount[NUM_SAO_EO_CLASSES];
+  for( int k = 0; k < NUM_SAO_EO_CLASSES; k++ )
+  {
+    sumDiff[k] = sumCount[k] = _mm_setzero_si128();
+  }
+#ifdef USE_AVX2
+  const __m256i one256 = _mm256_set1_epi16( 1 );
+  __m256i       sumDiff256[NUM_SAO_EO_CLASSES], sumCount256[NUM_SAO_EO_CLASSES];
+  for( int k = 0; k < NUM_SAO_EO_CLASSES; k++ )
+  {
+    sumDiff256[k] = sumCount256[k] = _mm256_setzero_si256();
+  }
+#endif
+  int64_t tailDiff[NUM_SAO_EO_CLASSES]  = { 0 };
+  int64_t tailCount[NUM_SAO_EO_CLASSES] = { 0 };
+
+  for( int y = 0; y < numRows; y++, src += srcStride, org += orgStride )
+  {
+    int x = startX;
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      __m256i rowCount[NUM_SAO_EO_CLASSES];
+      for( int k = 0; k < NUM_SAO_EO_CLASSES; k++ )
+      {
+        rowCount[k] = _mm256_setzero_si256();
+      }
+      for( ; x + 16 <= endX; x += 16 )
+      {
+        const __m256i c   = _mm256_loadu_si256( (const __m256i*) &src[x] );
+        const __m256i a   = _mm256_loadu_si256( (const __m256i*) &src[x - nbOffset] );
+        const __m256i b   = _mm256_loadu_si256( (const __m256i*) &src[x + nbOffset] );
+        const __m256i d   = _mm256_sub_epi16( _mm256_loadu_si256( (const __m256i*) &org[x] ), c );
+        const __m256i idx = xEdgeIdx( c, a, b );
+        for( int k = 0; k < NUM_SAO_EO_CLASSES; k++ )
+        {
+          const __m256i mask = _mm256_cmpeq_epi16( idx, _mm256_set1_epi16( k ) );
+          sumDiff256[k] = _mm256_add_epi32( sumDiff256[k], _mm256_madd_epi16( _mm256_and_si256( d, mask ), one256 ) );
+          rowCount[k]   = _mm256_sub_epi16( rowCount[k], mask );
+        }
+      }
+      for( int k = 0; k < NUM_SAO_EO_CLASSES; k++ )
+      {
+        sumCount256[k] = _mm256_add_epi32( sumCount256[k], _mm256_madd_epi16( rowCount[k], one256 ) );
+      }
+    }
+#endif
+    __m128i rowCount[NUM_SAO_EO_CLASSES];
+    for( int k = 0; k < NUM_SAO_EO_CLASSES; k++ )
+    {
+      rowCount[k] = _mm_setzero_si128();
+    }
+    for( ; x + 8 <= endX; x += 8 )
+    {
+      const __m128i c   = _mm_loadu_si128( (const __m128i*) &src[x] );
+      const __m128i a   = _mm_loadu_si128( (const __m128i*) &src[x - nbOffset] );
+      const __m128i b   = _mm_loadu_si128( (const __m128i*) &src[x + nbOffset] );
+      const __m128i d   = _mm_sub_epi16( _mm_loadu_si128( (const __m128i*) &org[x] ), c );
+      const __m128i idx = xEdgeIdx( c, a, b );
+      for( int k = 0; k < NUM_SAO_EO_CLASSES; k++ )
+      {
+        const __m128i mask = _mm_cmpeq_epi16( idx, _mm_set1_epi16( k ) );
+        sumDiff[k]  = _mm_add_epi32( sumDiff[k], _mm_madd_epi16( _mm_and_si128( d, mask ), one ) );
+        rowCount[k] = _mm_sub_epi16( rowCount[k], mask );
+      }
+    }
+    for( int k = 0; k < NUM_SAO_EO_CLASSES; k++ )
+    {
+      sumCount[k] = _mm_add_epi32( sumCount[k], _mm_madd_epi16( rowCount[k], one ) );
+    }
+    for( ; x < endX; x++ )
+    {
+      const int edgeType = sgn( src[x] - src[x - nbOffset] ) + sgn( src[x] - src[x + nbOffset] ) + 2;
+      tailDiff[edgeType] += org[x] - src[x];
+      tailCount[edgeType]++;
+    }
+  }
+
+  for( int k = 0; k < NUM_SAO_EO_CLASSES; k++ )
+  {
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      sumDiff[k]  = _mm_add_epi32( sumDiff[k], _mm_add_epi32( _mm256_castsi256_si128( sumDiff256[k] ), _mm256_extracti128_si256( sumDiff256[k], 1 ) ) );
+      sumCount[k] = _mm_add_epi32( sumCount[k], _mm_add_epi32( _mm256_castsi256_si128( sumCount256[k] ), _mm256_extracti128_si256( sumCount256[k], 1 ) ) );
+    }
+#endif
+    int32_t d[4], c[4];
+    _mm_storeu_si128( (__m128i*) d, sumDiff[k] );
+    _mm_storeu_si128( (__m128i*) c, sumCount[k] );
+    diff [k - 2] += tailDiff[k] + (int64_t) d[0] + d[1] + d[2] + d[3];
+    count[k - 2] += tailCount[k] + (int64_t) c[0] + c[1] + c[2] + c[3];
+  }
+}
+
+template<X86_VEXT vext>
+void SampleAdaptiveOffset::_initSampleAdaptiveOffsetX86()
+{
+  m_offsetEdgeRows = simdOffsetEdgeRows<vext>;
+  m_offsetBand     = simdOffsetBand<vext>;
+  m_calcEdgeStats  = simdCalcEdgeStats<vext>;
+}
+
+template void SampleAdaptiveOffset::_initSampleAdaptiveOffsetX86<SIMDX86>();
+
+#endif //#if ENABLE_SIMD_OPT_SAO
+#endif //#ifdef TARGET_SIMD_X86
+//! \}
@@ -0,0 +1,385 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2021, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file
+ * \brief Implementation of the primary transforms (DCT-II, DST-VII, DCT-VIII), SIMD version
+ */
+
+#include "CommonDefX86.h"
+#include "../Rom.h"
+#include "../TrQuant.h"
+
+#include <vector>
+
+//! \ingroup CommonLib
+//! \{
+
+#ifdef TARGET_SIMD_X86
+#if ENABLE_SIMD_OPT_TRAFO
+
+// The partial butterflies of TrQuant_EMT.cpp evaluate the same integer polynomial as the plain matrix multiplication,
+// so the kernels below multiply with the transform matrix on 16-bit samples (_mm_madd_epi16). This is bit-exact with
+// the C code as long as all input values fit into 16 bits, blocks which do not are handed over to the C functions.
+// The 4-point butterflies are cheaper than the matrix multiplication and stay with the C code.
+
+static inline const TMatrixCoeff* xTrMatrix( const int trType, const int trSize, const int dir )
+{
+  const TMatrixCoeff* const trMatrix[NUM_TRANS_TYPE][g_numTransformMatrixSizes] =
+  {
+    { g_trCoreDCT2P2[dir][0], g_trCoreDCT2P4[dir][0], g_trCoreDCT2P8[dir][0], g_trCoreDCT2P16[dir][0], g_trCoreDCT2P32[dir][0], g_trCoreDCT2P64[dir][0] },
+    { nullptr,                g_trCoreDCT8P4[dir][0], g_trCoreDCT8P8[dir][0], g_trCoreDCT8P16[dir][0], g_trCoreDCT8P32[dir][0], nullptr                 },
+    { nullptr,                g_trCoreDST7P4[dir][0], g_trCoreDST7P8[dir][0], g_trCoreDST7P16[dir][0], g_trCoreDST7P32[dir][0], nullptr                 },
+  };
+
+  return trMatrix[trType][floorLog2( trSize ) - 1];
+}
+
+static inline int32_t xPack16( const TCoeff lo, const TCoeff hi )
+{
+  return int32_t( uint32_t( uint16_t( lo ) ) | ( uint32_t( uint16_t( hi ) ) << 16 ) );
+}
+
+static inline bool xFits16( const TCoeff val )
+{
+  return val >= std::numeric_limits<int16_t>::min() && val <= std::numeric_limits<int16_t>::max();
+}
+
+static inline bool xFits16( const __m128i vmin, const __m128i vmax )
+{
+  const __m128i outOfRange = _mm_or_si128( _mm_cmplt_epi32( vmin, _mm_set1_epi32( std::numeric_limits<int16_t>::min() ) ),
+                                           _mm_cmpgt_epi32( vmax, _mm_set1_epi32( std::numeric_limits<int16_t>::max() ) ) );
+  return _mm_test_all_zeros( outOfRange, outOfRange ) != 0;
+}
+
+static inline void xStoreCoeffs( TCoeff* dst, const __m128i val, const int num )
+{
+  if( num >= 4 )
+  {
+    _mm_storeu_si128( ( __m128i* ) dst, val );
+  }
+  else
+  {
+    TCoeff tmp[4];
+    _mm_storeu_si128( ( __m128i* ) tmp, val );
+    memcpy( dst, tmp, num * sizeof( TCoeff ) );
+  }
+}
+
+// inverse matrix with the rows ( 2p, 2p + 1 ) interleaved into 16-bit pairs per column
+template<int trType, int trSize>
+static const int32_t* xInvTrMatrixPairs()
+{
+  static const std::vector<int32_t> pairs = []()
+  {
+    const TMatrixCoeff*  tc = xTrMatrix( trType, trSize, TRANSFORM_INVERSE );
+    std::vector<int32_t> res( trSize * trSize / 2 );
+
+    for( int p = 0; p < trSize / 2; p++ )
+    {
+      for( int j = 0; j < trSize; j++ )
+      {
+        res[p * trSize + j] = xPack16( tc[2 * p * trSize + j], tc[( 2 * p + 1 ) * trSize + j] );
+      }
+    }
+    return res;
+  }();
+
+  return pairs.data();
+}
+
+// dst[j * line + i] = sum_k src[i * trSize + k] * tc[j * trSize + k] for the lines i < reducedLine and the rows j < numRows
+template<X86_VEXT vext, int trSize>
+static bool simdFwdTrMM( const TCoeff* src, TCoeff* dst, const int shift, const int line, const int reducedLine, const int numRows, const TMatrixCoeff* tc )
+{
+  static const TCoeff zeroLine[trSize] = { 0 };
+
+  const int numPairs = trSize >> 1;
+  const int stride   = ( reducedLine + 7 ) & ~7;
+
+  ALIGN_DATA( MEMORY_ALIGN_DEF_SIZE, int32_t pairs[( MAX_TB_SIZEY >> 1 ) * MAX_TB_SIZEY] );
+
+  // transpose groups of four lines into vectors holding the sample pairs ( 2p, 2p + 1 ) of these lines
+  __m128i vmin = _mm_setzero_si128();
+  __m128i vmax = _mm_setzero_si128();
+
+  for( int i = 0; i < stride; i += 4 )
+  {
+    const TCoeff* lines[4];
+    for( int r = 0; r < 4; r++ )
+    {
+      lines[r] = i + r < reducedLine ? src + ( i + r ) * trSize : zeroLine;
+    }
+
+    for( int k = 0; k < trSize; k += 8 )
+    {
+      __m128i v[4];
+      for( int r = 0; r < 4; r++ )
+      {
+        const __m128i lo = _mm_loadu_si128( ( const __m128i* ) &lines[r][k] );
+        const __m128i hi = _mm_loadu_si128( ( const __m128i* ) &lines[r][k + 4] );
+        vmin = _mm_min_epi32( vmin, _mm_min_epi32( lo, hi ) );
+        vmax = _mm_max_epi32( vmax, _mm_max_epi32( lo, hi ) );
+        v[r] = _mm_packs_epi32( lo, hi );
+      }
+
+      const __m128i t0 = _mm_unpacklo_epi32( v[0], v[1] );
+      const __m128i t1 = _mm_unpacklo_epi32( v[2], v[3] );
+      const __m128i t2 = _mm_unpackhi_epi32( v[0], v[1] );
+      const __m128i t3 = _mm_unpackhi_epi32( v[2], v[3] );
+      _mm_storeu_si128( ( __m128i* ) &pairs[( ( k >> 1 ) + 0 ) * stride + i], _mm_unpacklo_epi64( t0, t1 ) );
+      _mm_storeu_si128( ( __m128i* ) &pairs[( ( k >> 1 ) + 1 ) * stride + i], _mm_unpackhi_epi64( t0, t1 ) );
+      _mm_storeu_si128( ( __m128i* ) &pairs[( ( k >> 1 ) + 2 ) * stride + i], _mm_unpacklo_epi64( t2, t3 ) );
+      _mm_storeu_si128( ( __m128i* ) &pairs[( ( k >> 1 ) + 3 ) * stride + i], _mm_unpackhi_epi64( t2, t3 ) );
+    }
+  }
+
+  if( !xFits16( vmin, vmax ) )
+  {
+    return false;
+  }
+
+  const TCoeff  rnd    = shift > 0 ? TCoeff( 1 ) << ( shift - 1 ) : 0;
+  const __m128i vshift = _mm_cvtsi32_si128( shift );
+
+  for( int j = 0; j < numRows; j++ )
+  {
+    const TMatrixCoeff* iT = tc + j * trSize;
+    TCoeff*             d  = dst + j * line;
+    int32_t             coef[numPairs];
+
+    for( int p = 0; p < numPairs; p++ )
+    {
+      coef[p] = xPack16( iT[2 * p], iT[2 * p + 1] );
+    }
+
+    int i = 0;
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      for( ; i + 4 < reducedLine; i += 8 )
+      {
+        __m256i acc = _mm256_set1_epi32( rnd );
+        for( int p = 0; p < numPairs; p++ )
+        {
+          acc = _mm256_add_epi32( acc, _mm256_madd_epi16( _mm256_loadu_si256( ( const __m256i* ) &pairs[p * stride + i] ), _mm256_set1_epi32( coef[p] ) ) );
+        }
+        acc = _mm256_sra_epi32( acc, vshift );
+        xStoreCoeffs( d + i,     _mm256_castsi256_si128( acc ),      reducedLine - i );
+        xStoreCoeffs( d + i + 4, _mm256_extracti128_si256( acc, 1 ), reducedLine - i - 4 );
+      }
+    }
+#endif
+    for( ; i < reducedLine; i += 4 )
+    {
+      __m128i acc = _mm_set1_epi32( rnd );
+      for( int p = 0; p < numPairs; p++ )
+      {
+        acc = _mm_add_epi32( acc, _mm_madd_epi16( _mm_loadu_si128( ( const __m128i* ) &pairs[p * stride + i] ), _mm_set1_epi32( coef[p] ) ) );
+      }
+      xStoreCoeffs( d + i, _mm_sra_epi32( acc, vshift ), reducedLine - i );
+    }
+  }
+
+  return true;
+}
+
+// dst[i * trSize + j] = clip( sum_k src[k * line + i] * tc[k * trSize + j] ) for the lines i < reducedLine and the rows k < 2 * numPairs
+template<X86_VEXT vext, int trSize>
+static bool simdInvTrMM( const TCoeff* src, TCoeff* dst, const int shift, const int line, const int reducedLine, const int numPairs, const int32_t* tcPairs, const TCoeff outputMinimum, const TCoeff outputMaximum )
+{
+  const int stride = ( reducedLine + 7 ) & ~7;
+
+  ALIGN_DATA( MEMORY_ALIGN_DEF_SIZE, int32_t pairs[( MAX_TB_SIZEY >> 1 ) * MAX_TB_SIZEY] );
+
+  // interleave the coefficient rows ( 2p, 2p + 1 ) into sample pairs per line
+  __m128i vmin    = _mm_setzero_si128();
+  __m128i vmax    = _mm_setzero_si128();
+  bool    inRange = true;
+
+  for( int p = 0; p < numPairs; p++ )
+  {
+    const TCoeff* src0 = src + 2 * p * line;
+    const TCoeff* src1 = src0 + line;
+    int32_t*      pp   = pairs + p * stride;
+
+    int i = 0;
+    for( ; i + 8 <= reducedLine; i += 8 )
+    {
+      const __m128i a0 = _mm_loadu_si128( ( const __m128i* ) &src0[i] );
+      const __m128i a1 = _mm_loadu_si128( ( const __m128i* ) &src0[i + 4] );
+      const __m128i b0 = _mm_loadu_si128( ( const __m128i* ) &src1[i] );
+      const __m128i b1 = _mm_loadu_si128( ( const __m128i* ) &src1[i + 4] );
+      vmin = _mm_min_epi32( vmin, _mm_min_epi32( _mm_min_epi32( a0, a1 ), _mm_min_epi32( b0, b1 ) ) );
+      vmax = _mm_max_epi32( vmax, _mm_max_epi32( _mm_max_epi32( a0, a1 ), _mm_max_epi32( b0, b1 ) ) );
+
+      const __m128i a = _mm_packs_epi32( a0, a1 );
+      const __m128i b = _mm_packs_epi32( b0, b1 );
+      _mm_storeu_si128( ( __m128i* ) &pp[i],     _mm_unpacklo_epi16( a, b ) );
+      _mm_storeu_si128( ( __m128i* ) &pp[i + 4], _mm_unpackhi_epi16( a, b ) );
+    }
+    for( ; i < reducedLine; i++ )
+    {
+      inRange = inRange && xFits16( src0[i] ) && xFits16( src1[i] );
+      pp[i]   = xPack16( src0[i], src1[i] );
+    }
+  }
+
+  if( !inRange || !xFits16( vmin, vmax ) )
+  {
+    return false;
+  }
+
+  const TCoeff  rnd    = shift > 0 ? TCoeff( 1 ) << ( shift - 1 ) : 0;
+  const __m128i vshift = _mm_cvtsi32_si128( shift );
+
+  for( int i = 0; i < reducedLine; i++ )
+  {
+    TCoeff* d = dst + i * trSize;
+
+    int j = 0;
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      const __m256i vmin256 = _mm256_set1_epi32( outputMinimum );
+      const __m256i vmax256 = _mm256_set1_epi32( outputMaximum );
+
+      for( ; j < trSize; j += 8 )
+      {
+        __m256i acc = _mm256_set1_epi32( rnd );
+        for( int p = 0; p < numPairs; p++ )
+        {
+          acc = _mm256_add_epi32( acc, _mm256_madd_epi16( _mm256_set1_epi32( pairs[p * stride + i] ), _mm256_loadu_si256( ( const __m256i* ) &tcPairs[p * trSize + j] ) ) );
+        }
+        acc = _mm256_min_epi32( vmax256, _mm256_max_epi32( vmin256, _mm256_sra_epi32( acc, vshift ) ) );
+        _mm256_storeu_si256( ( __m256i* ) &d[j], acc );
+      }
+    }
+#endif
+    const __m128i vmin128 = _mm_set1_epi32( outputMinimum );
+    const __m128i vmax128 = _mm_set1_epi32( outputMaximum );
+
+    for( ; j < trSize; j += 4 )
+    {
+      __m128i acc = _mm_set1_epi32( rnd );
+      for( int p = 0; p < numPairs; p++ )
+      {
+        acc = _mm_add_epi32( acc, _mm_madd_epi16( _mm_set1_epi32( pairs[p * stride + i] ), _mm_loadu_si128( ( const __m128i* ) &tcPairs[p * trSize + j] ) ) );
+      }
+      acc = _mm_min_epi32( vmax128, _mm_max_epi32( vmin128, _mm_sra_epi32( acc, vshift ) ) );
+      _mm_storeu_si128( ( __m128i* ) &d[j], acc );
+    }
+  }
+
+  return true;
+}
+
+template<X86_VEXT vext, int trType, int trSize>
+static void simdFastForwardTrans( const TCoeff* src, TCoeff* dst, int shift, int line, int iSkipLine, int iSkipLine2 )
+{
+  static const TMatrixCoeff* const tc = xTrMatrix( trType, trSize, TRANSFORM_FORWARD );
+
+  const int reducedLine = line - iSkipLine;
+  const int cutoff      = trSize - iSkipLine2;
+  // like the C functions, the DCT-II butterflies up to 32 points fill all rows regardless of iSkipLine2
+  const int numRows     = trSize == 64 || trType != DCT2 ? cutoff : trSize;
+
+  if( !simdFwdTrMM<vext, trSize>( src, dst, shift, line, reducedLine, numRows, tc ) )
+  {
+    fastFwdTrans[trType][floorLog2( trSize ) - 1]( src, dst, shift, line, iSkipLine, iSkipLine2 );
+    return;
+  }
+
+  if( iSkipLine )
+  {
+    for( int j = 0; j < numRows; j++ )
+    {
+      memset( dst + j * line + reducedLine, 0, sizeof( TCoeff ) * iSkipLine );
+    }
+  }
+  if( numRows < trSize )
+  {
+    memset( dst + numRows * line, 0, sizeof( TCoeff ) * line * ( trSize - numRows ) );
+  }
+}
+
+template<X86_VEXT vext, int trType, int trSize>
+static void simdFastInverseTrans( const TCoeff* src, TCoeff* dst, int shift, int line, int iSkipLine, int iSkipLine2, const TCoeff outputMinimum, const TCoeff outputMaximum )
+{
+  const int reducedLine = line - iSkipLine;
+  // like the C functions, only the 8-point matrix multiplications and the 64-point DCT-II skip the zeroed-out rows
+  const int cutoff      = trSize == 64 ? ( iSkipLine2 >= 32 ? 32 : 64 ) : trType != DCT2 && trSize == 8 ? trSize - iSkipLine2 : trSize;
+
+  if( !simdInvTrMM<vext, trSize>( src, dst, shift, line, reducedLine, cutoff >> 1, xInvTrMatrixPairs<trType, trSize>(), outputMinimum, outputMaximum ) )
+  {
+    fastInvTrans[trType][floorLog2( trSize ) - 1]( src, dst, shift, line, iSkipLine, iSkipLine2, outputMinimum, outputMaximum );
+    return;
+  }
+
+  if( iSkipLine )
+  {
+    memset( dst + reducedLine * trSize, 0, sizeof( TCoeff ) * trSize * iSkipLine );
+  }
+}
+
+template<X86_VEXT vext>
+void TrQuant::_initTrQuantX86()
+{
+  m_fwdTrans[DCT2][2] = simdFastForwardTrans<vext, DCT2,  8>;
+  m_fwdTrans[DCT2][3] = simdFastForwardTrans<vext, DCT2, 16>;
+  m_fwdTrans[DCT2][4] = simdFastForwardTrans<vext, DCT2, 32>;
+  m_fwdTrans[DCT2][5] = simdFastForwardTrans<vext, DCT2, 64>;
+  m_fwdTrans[DCT8][2] = simdFastForwardTrans<vext, DCT8,  8>;
+  m_fwdTrans[DCT8][3] = simdFastForwardTrans<vext, DCT8, 16>;
+  m_fwdTrans[DCT8][4] = simdFastForwardTrans<vext, DCT8, 32>;
+  m_fwdTrans[DST7][2] = simdFastForwardTrans<vext, DST7,  8>;
+  m_fwdTrans[DST7][3] = simdFastForwardTrans<vext, DST7, 16>;
+  m_fwdTrans[DST7][4] = simdFastForwardTrans<vext, DST7, 32>;
+
+  m_invTrans[DCT2][2] = simdFastInverseTrans<vext, DCT2,  8>;
+  m_invTrans[DCT2][3] = simdFastInverseTrans<vext, DCT2, 16>;
+  m_invTrans[DCT2][4] = simdFastInverseTrans<vext, DCT2, 32>;
+  m_invTrans[DCT2][5] = simdFastInverseTrans<vext, DCT2, 64>;
+  m_invTrans[DCT8][2] = simdFastInverseTrans<vext, DCT8,  8>;
+  m_invTrans[DCT8][3] = simdFastInverseTrans<vext, DCT8, 16>;
+  m_invTrans[DCT8][4] = simdFastInverseTrans<vext, DCT8, 32>;
+  m_invTrans[DST7][2] = simdFastInverseTrans<vext, DST7,  8>;
+  m_invTrans[DST7][3] = simdFastInverseTrans<vext, DST7, 16>;
+  m_invTrans[DST7][4] = simdFastInverseTrans<vext, DST7, 32>;
+}
+
+template void TrQuant::_initTrQuantX86<SIMDX86>();
+
+#endif //#if ENABLE_SIMD_OPT_TRAFO
+#endif //#ifdef TARGET_SIMD_X86
+//! \}
@@ -31,32 +31,4 @@
  * THE POSSIBILITY OF SUCH DAMAGE.
  */
 
-/**
- * \file
- * \brief Implementation of IbcHashMap class
- */
-
-#include "CommonDefX86.h"
-#include "../IbcHashMap.h"
-
-#ifdef TARGET_SIMD_X86
-
-#include <nmmintrin.h>
-
-template<X86_VEXT vext>
-static uint32_t simdComputeCrc32c16bit(uint32_t crc, const Pel pel)
-{
-  return _mm_crc32_u16(crc, pel);
-}
-
-template <X86_VEXT vext>
-void IbcHashMap::_initIbcHashMapX86()
-{
-  m_computeCrc32c = simdComputeCrc32c16bit<vext>;
-}
-
-template void IbcHashMap::_initIbcHashMapX86<SIMDX86>();
-
-
-#endif //#ifdef TARGET_SIMD_X86
-//! \}
+#include "../DeblockingFilterX86.h"
@@ -1 +0,0 @@
-#include "../IbcHashMapX86.h"
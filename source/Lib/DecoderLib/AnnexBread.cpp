@@ -39,11 +39,28 @@
 
 #include <stdint.h>
 #include <vector>
+#include <algorithm>
 #include "AnnexBread.h"
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
 #include "CommonLib/CodingStatistics.h"
 #endif
 
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef TARGET_SIMD_X86
+#include <emmintrin.h>
+#endif
+
 using namespace std;
 
 //! \ingroup DecoderLib
@@ -189,6 +206,8 @@ _byteStreamNALUnit(
   }
 }
 
+static bool xByteStreamNALUnitMapped(InputByteStream& bs, const uint8_t*& nalData, size_t& nalSize, AnnexBStats& stats);
+
 /**
  * Parse an AVC AnnexB Bytestream bs to extract a single nalUnit
  * while accumulating bytestream statistics into stats.
@@ -202,6 +221,16 @@ byteStreamNALUnit(
   vector<uint8_t>& nalUnit,
   AnnexBStats& stats)
 {
+  if (bs.isMapped())
+  {
+    const uint8_t* nalData = nullptr;
+    size_t         nalSize = 0;
+    const bool     eof     = xByteStreamNALUnitMapped(bs, nalData, nalSize, stats);
+    nalUnit.insert(nalUnit.end(), nalData, nalData + nalSize);
+    stats.m_numBytesInNALUnit = uint32_t(nalUnit.size());
+    return eof;
+  }
+
   bool eof = false;
   try
   {
@@ -214,4 +243,251 @@ byteStreamNALUnit(
   stats.m_numBytesInNALUnit = uint32_t(nalUnit.size());
   return eof;
 }
+
+const uint8_t* findZeroBytePair(const uint8_t* begin, const uint8_t* end)
+{
+  const uint8_t* p = begin;
+#ifdef TARGET_SIMD_X86
+  // SSE2 is part of the x86-64 baseline, so no run-time dispatch is needed
+  const __m128i vzero = _mm_setzero_si128();
+  while (end - p >= 17)
+  {
+    const __m128i cur  = _mm_loadu_si128((const __m128i*) p);
+    const __m128i next = _mm_loadu_si128((const __m128i*) (p + 1));
+    const int     mask = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_or_si128(cur, next), vzero));
+    if (mask)
+    {
+      return p + floorLog2(uint32_t(mask & -mask));
+    }
+    p += 16;
+  }
+#endif
+  for (; end - p >= 2; p++)
+  {
+    if (p[0] == 0 && p[1] == 0)
+    {
+      return p;
+    }
+  }
+  return end;
+}
+
+/**
+ * Returns the first start_code_prefix_one_3bytes (0x000001) in [p, end),
+ * or end if there is none.
+ */
+static const uint8_t* findStartCode(const uint8_t* p, const uint8_t* end)
+{
+  while (true)
+  {
+    p = findZeroBytePair(p, end);
+    if (end - p < 3)
+    {
+      return end;
+    }
+    if (p[2] == 0x01)
+    {
+      return p;
+    }
+    p++;
+  }
+}
+
+/**
+ * Mapped counterpart of _byteStreamNALUnit(): the same byte stream
+ * syntax is parsed, but each step locates its end with a vectorized
+ * scan instead of moving forward one byte at a time. The NAL unit is
+ * returned as a view into the mapped buffer.
+ *
+ * Returns false if EOF was reached (NB, nalunit data may be valid),
+ *         otherwise true.
+ */
+static bool
+xByteStreamNALUnitMapped(
+  InputByteStream& bs,
+  const uint8_t*& nalData,
+  size_t& nalSize,
+  AnnexBStats& stats)
+{
+  const uint8_t* const data  = bs.getMappedData();
+  const uint8_t* const end   = data + bs.getMappedSize();
+  const uint8_t*       p     = data + bs.getMappedPosition();
+  const auto           nonZero = [](uint8_t b) { return b != 0; };
+
+  nalData = p;
+  nalSize = 0;
+
+  /* leading_zero_8bits up to the four-byte sequence 0x00000001 (or a
+   * three-byte start code at the very beginning), followed by zero_byte */
+  const uint8_t* startCode = findStartCode(p, end);
+  const uint8_t* zeroByte  = (startCode != end && startCode > p && startCode[-1] == 0) ? startCode - 1 : startCode;
+  const uint8_t* badByte   = std::find_if(p, zeroByte, nonZero);
+  if (badByte != zeroByte || startCode == end)
+  {
+    /* "Leading zero bits not zero", or EOF before any start code. As in
+     * the istream case, the four-byte look-ahead at the offending byte
+     * already hits EOF near the end of the stream */
+    stats.m_numLeadingZero8BitsBytes += uint32_t(badByte - p);
+    p = std::min(badByte + 1, end);
+    bs.setMappedPositionAndEof(size_t(p - data), end - badByte < 4);
+    return true;
+  }
+  stats.m_numLeadingZero8BitsBytes += uint32_t(zeroByte - p);
+  stats.m_numZeroByteBytes         += uint32_t(startCode - zeroByte);
+  stats.m_numStartCodePrefixBytes  += 3;
+  p = startCode + 3;
+
+  /* NAL unit payload, terminated by 0x000000, 0x000001, 0x000002 or EOF */
+  const uint8_t* nalEnd = p;
+  while (true)
+  {
+    nalEnd = findZeroBytePair(nalEnd, end);
+    if (end - nalEnd < 3)
+    {
+      nalEnd = end;
+      break;
+    }
+    if (nalEnd[2] <= 0x02)
+    {
+      break;
+    }
+    nalEnd++;
+  }
+  nalData = p;
+  nalSize = size_t(nalEnd - p);
+
+  /* trailing_zero_8bits up to the next start code */
+  const uint8_t* nextStartCode = findStartCode(nalEnd, end);
+  const uint8_t* nextSync      = (nextStartCode != end && nextStartCode > nalEnd && nextStartCode[-1] == 0) ? nextStartCode - 1 : nextStartCode;
+  badByte                      = std::find_if(nalEnd, nextSync, nonZero);
+  stats.m_numTrailingZero8BitsBytes += uint32_t(badByte - nalEnd);
+  if (badByte != nextSync)
+  {
+    /* "Trailing zero bits not '0'" */
+    p = badByte + 1;
+    bs.setMappedPositionAndEof(size_t(p - data), end - badByte < 4);
+    return true;
+  }
+
+  bs.setMappedPositionAndEof(size_t(nextSync - data), nextSync == end);
+  return nextSync == end;
+}
+
+/**
+ * Parse an AVC AnnexB Bytestream bs to extract a single nalUnit into
+ * nalu. For a mapped byte stream the NAL unit is not copied but set as
+ * payload view of nalu; read(InputNALUnit&) then removes the emulation
+ * prevention bytes while transferring it into the bitstream.
+ *
+ * Returns false if EOF was reached (NB, nalunit data may be valid),
+ *         otherwise true.
+ */
+bool
+byteStreamNALUnit(
+  InputByteStream& bs,
+  InputNALUnit& nalu,
+  AnnexBStats& stats)
+{
+  if (!bs.isMapped())
+  {
+    return byteStreamNALUnit(bs, nalu.getBitstream().getFifo(), stats);
+  }
+
+  const uint8_t* nalData = nullptr;
+  size_t         nalSize = 0;
+  const bool     eof     = xByteStreamNALUnitMapped(bs, nalData, nalSize, stats);
+  nalu.setPayloadView(nalData, nalSize);
+  stats.m_numBytesInNALUnit = uint32_t(nalSize);
+  return eof;
+}
+
+MappedBitstreamFile::MappedBitstreamFile()
+: m_data(nullptr)
+, m_size(0)
+#ifdef _WIN32
+, m_file(nullptr)
+, m_mapping(nullptr)
+#endif
+{
+}
+
+MappedBitstreamFile::~MappedBitstreamFile()
+{
+  close();
+}
+
+bool MappedBitstreamFile::open(const std::string& fileName)
+{
+  close();
+#ifdef _WIN32
+  HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+  {
+    return false;
+  }
+  LARGE_INTEGER fileSize;
+  if (GetFileType(file) != FILE_TYPE_DISK || !GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+  {
+    CloseHandle(file);
+    return false;
+  }
+  HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  const void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+  if (!view)
+  {
+    if (mapping)
+    {
+      CloseHandle(mapping);
+    }
+    CloseHandle(file);
+    return false;
+  }
+  m_file    = file;
+  m_mapping = mapping;
+  m_data    = (const uint8_t*) view;
+  m_size    = size_t(fileSize.QuadPart);
+#else
+  const int fd = ::open(fileName.c_str(), O_RDONLY);
+  if (fd < 0)
+  {
+    return false;
+  }
+  struct stat fileStat;
+  if (fstat(fd, &fileStat) != 0 || !S_ISREG(fileStat.st_mode) || fileStat.st_size == 0)
+  {
+    ::close(fd);
+    return false;
+  }
+  const size_t size = size_t(fileStat.st_size);
+  void* view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);   // the mapping stays valid without the descriptor
+  if (view == MAP_FAILED)
+  {
+    return false;
+  }
+  madvise(view, size, MADV_SEQUENTIAL);
+  m_data = (const uint8_t*) view;
+  m_size = size;
+#endif
+  return true;
+}
+
+void MappedBitstreamFile::close()
+{
+  if (!m_data)
+  {
+    return;
+  }
+#ifdef _WIN32
+  UnmapViewOfFile(m_data);
+  CloseHandle(m_mapping);
+  CloseHandle(m_file);
+  m_mapping = nullptr;
+  m_file    = nullptr;
+#else
+  munmap((void*) m_data, m_size);
+#endif
+  m_data = nullptr;
+  m_size = 0;
+}
 //! \}
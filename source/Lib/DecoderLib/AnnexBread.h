@@ -43,9 +43,11 @@
 
 #include <stdint.h>
 #include <istream>
+#include <string>
 #include <vector>
 
 #include "CommonLib/CommonDef.h"
+#include "NALread.h"
 
 //! \ingroup DecoderLib
 //! \{
@@ -65,11 +67,34 @@ public:
   InputByteStream(std::istream& istream)
   : m_NumFutureBytes(0)
   , m_FutureBytes(0)
-  , m_Input(istream)
+  , m_Input(&istream)
+  , m_MappedData(nullptr)
+  , m_MappedSize(0)
+  , m_MappedPos(0)
+  , m_MappedEof(false)
   {
     istream.exceptions(std::istream::eofbit | std::istream::badbit);
   }
 
+  /**
+   * Create a bytestream reader on a complete byte stream held in
+   * memory, e.g. a MappedBitstreamFile. Start codes are located by a
+   * vectorized scan and NAL units are handed out as views into the
+   * buffer, see byteStreamNALUnit(InputByteStream&, InputNALUnit&, AnnexBStats&).
+   *
+   * The buffer must stay valid while the InputByteStream is in use.
+   */
+  InputByteStream(const uint8_t* data, size_t size)
+  : m_NumFutureBytes(0)
+  , m_FutureBytes(0)
+  , m_Input(nullptr)
+  , m_MappedData(data)
+  , m_MappedSize(size)
+  , m_MappedPos(0)
+  , m_MappedEof(size == 0)
+  {
+  }
+
   /**
    * Reset the internal state.  Must be called if input stream is
    * modified externally to this class
@@ -80,6 +105,38 @@ public:
     m_FutureBytes = 0;
   }
 
+  /**
+   * returns true while the end of the byte stream has not been hit,
+   * i.e. the equivalent of testing the underlying istream.
+   */
+  bool isGood() const { return isMapped() ? !m_MappedEof : !m_Input->fail(); }
+
+  bool           isMapped         () const { return m_MappedData != nullptr; }
+  const uint8_t* getMappedData    () const { return m_MappedData; }
+  size_t         getMappedSize    () const { return m_MappedSize; }
+  size_t         getMappedPosition() const { return m_MappedPos; }
+
+  /**
+   * move the read position of a mapped byte stream, clearing the EOF
+   * state (the equivalent of istream::clear() followed by seekg()).
+   */
+  void setMappedPosition(size_t pos)
+  {
+    CHECK(pos > m_MappedSize, "Position outside of the mapped byte stream");
+    m_MappedPos = pos;
+    m_MappedEof = false;
+  }
+
+  /**
+   * advance the read position of a mapped byte stream, setting the EOF
+   * state once the end of the buffer is reached.
+   */
+  void setMappedPositionAndEof(size_t pos, bool eof)
+  {
+    m_MappedPos = pos;
+    m_MappedEof = eof;
+  }
+
   /**
    * returns true if an EOF will be encountered within the next
    * n bytes.
@@ -97,7 +154,7 @@ public:
     {
       for (uint32_t i = 0; i < n; i++)
       {
-        m_FutureBytes = (m_FutureBytes << 8) | m_Input.get();
+        m_FutureBytes = (m_FutureBytes << 8) | m_Input->get();
         m_NumFutureBytes++;
       }
     }
@@ -136,7 +193,7 @@ public:
   {
     if (!m_NumFutureBytes)
     {
-      uint8_t byte = m_Input.get();
+      uint8_t byte = m_Input->get();
       return byte;
     }
     m_NumFutureBytes--;
@@ -167,7 +224,44 @@ public:
 private:
   uint32_t m_NumFutureBytes; /* number of valid bytes in m_FutureBytes */
   uint32_t m_FutureBytes; /* bytes that have been peeked */
-  std::istream& m_Input; /* Input stream to read from */
+  std::istream* m_Input; /* Input stream to read from, nullptr for a mapped byte stream */
+
+  const uint8_t* m_MappedData; /* complete byte stream held in memory */
+  size_t m_MappedSize;
+  size_t m_MappedPos; /* offset of the next unread byte in m_MappedData */
+  bool m_MappedEof; /* set once the end of m_MappedData has been reached */
+};
+
+/**
+ * Read-only memory mapping of a bitstream file.
+ *
+ * open() fails for anything that cannot be mapped (pipes, character
+ * devices, empty files); the caller is then expected to fall back to
+ * an istream based InputByteStream.
+ */
+class MappedBitstreamFile
+{
+public:
+  MappedBitstreamFile();
+  ~MappedBitstreamFile();
+
+  bool open(const std::string& fileName);
+  void close();
+
+  bool           isOpen() const { return m_data != nullptr; }
+  const uint8_t* data  () const { return m_data; }
+  size_t         size  () const { return m_size; }
+
+private:
+  MappedBitstreamFile(const MappedBitstreamFile&) = delete;
+  MappedBitstreamFile& operator=(const MappedBitstreamFile&) = delete;
+
+  const uint8_t* m_data;
+  size_t m_size;
+#ifdef _WIN32
+  void* m_file;
+  void* m_mapping;
+#endif
 };
 
 /**
@@ -193,6 +287,14 @@ struct AnnexBStats
 };
 
 bool byteStreamNALUnit(InputByteStream& bs, std::vector<uint8_t>& nalUnit, AnnexBStats& stats);
+bool byteStreamNALUnit(InputByteStream& bs, InputNALUnit& nalu, AnnexBStats& stats);
+
+/**
+ * Returns the first position p in [begin, end - 1) with p[0] == 0 and
+ * p[1] == 0, or end if there is none. Shared by the start code scan of
+ * mapped byte streams and the emulation prevention removal.
+ */
+const uint8_t* findZeroBytePair(const uint8_t* begin, const uint8_t* end);
 
 //! \}
 
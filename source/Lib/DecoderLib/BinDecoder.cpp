@@ -38,23 +38,25 @@
 
 #include "BinDecoder.h"
 #include "CommonLib/Rom.h"
-#if RExt__DECODER_DEBUG_BIT_STATISTICS
-#include "CommonLib/CodingStatistics.h"
-#endif
-
-#include "CommonLib/dtrace_next.h"
 
 #define CNT_OFFSET 0
 
+// the window holds the 9 bit offset of the arithmetic decoder and up to 55 bits read ahead
+static const int MAX_BITS_BUFFERED = 55;
+
 
 
 template <class BinProbModel>
 BinDecoderBase::BinDecoderBase( const BinProbModel* dummy )
-  : Ctx         ( dummy )
-  , m_Bitstream ( 0 )
-  , m_Range     ( 0 )
-  , m_Value     ( 0 )
-  , m_bitsNeeded( 0 )
+  : Ctx           ( dummy )
+  , m_Bitstream   ( 0 )
+  , m_byteStart   ( nullptr )
+  , m_bytePtr     ( nullptr )
+  , m_byteEnd     ( nullptr )
+  , m_numPadBytes ( 0 )
+  , m_Range       ( 0 )
+  , m_Value       ( 0 )
+  , m_bitsBuffered( 0 )
 {}
 
 
@@ -76,18 +78,47 @@ void BinDecoderBase::start()
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
   CodingStatistics::UpdateCABACStat(STATS__CABAC_INITIALISATION, 512, 510, 0);
 #endif
-  m_Range       = 510;
-  m_Value       = ( m_Bitstream->readByte() << 8 ) + m_Bitstream->readByte();
-  m_bitsNeeded  = -8;
+  const std::vector<uint8_t>& fifo = m_Bitstream->getFifo();
+  m_byteStart    = fifo.data() + m_Bitstream->getByteLocation();
+  m_bytePtr      = m_byteStart;
+  m_byteEnd      = fifo.data() + fifo.size();
+  m_numPadBytes  = 0;
+  m_Range        = 510;
+  m_Value        = 0;
+  for( int i = 0; i < 8; i++ )
+  {
+    m_Value <<= 8;
+    if( m_bytePtr < m_byteEnd )
+    {
+      m_Value += *m_bytePtr++;
+    }
+    else
+    {
+      m_numPadBytes++;
+    }
+  }
+  m_bitsBuffered = MAX_BITS_BUFFERED;
 }
 
 
 void BinDecoderBase::finish()
 {
+  // return the bytes read ahead to the bitstream, which is left at the position of a decoder reading byte by byte
+  const unsigned numBytesRead = xGetNumBytesRead() - ( m_bitsBuffered >> 3 );
+  CHECK( numBytesRead > unsigned( m_bytePtr - m_byteStart ), "FIFO exceeded" );
+  for( unsigned i = 0; i < numBytesRead; i++ )
+  {
+    m_Bitstream->readByte();
+  }
+  m_byteStart   = m_byteStart + numBytesRead;
+  m_bytePtr     = m_byteStart;
+  m_numPadBytes = 0;
+
   unsigned lastByte;
   m_Bitstream->peekPreviousByte( lastByte );
-  CHECK( ( ( lastByte << ( 8 + m_bitsNeeded ) ) & 0xff ) != 0x80,
+  CHECK( ( ( lastByte << ( 7 - ( m_bitsBuffered & 7 ) ) ) & 0xff ) != 0x80,
         "No proper stop/alignment pattern at end of CABAC stream." );
+  m_bitsBuffered &= 7;
 }
 
 
@@ -102,83 +133,59 @@ void BinDecoderBase::riceStatReset(int bitDepth, bool persistentRiceAdaptationEn
   Ctx::riceStatReset(bitDepth, persistentRiceAdaptationEnabledFlag);
 }
 
-unsigned BinDecoderBase::decodeBinEP()
-{
-  m_Value            += m_Value;
-  if( ++m_bitsNeeded >= 0 )
-  {
-    m_Value          += m_Bitstream->readByte();
-    m_bitsNeeded      = -8;
-  }
-
-  unsigned bin = 0;
-  unsigned SR  = m_Range << 7;
-  if( m_Value >= SR )
-  {
-    m_Value   -= SR;
-    bin        = 1;
-  }
-#if RExt__DECODER_DEBUG_BIT_STATISTICS
-  CodingStatistics::IncrementStatisticEP( *ptype, 1, int(bin) );
-#endif
-  DTRACE( g_trace_ctx, D_CABAC, "%d" "  " "%d" "  EP=%d \n",  DTRACE_GET_COUNTER( g_trace_ctx, D_CABAC ), m_Range, bin );
-  return bin;
-}
-
 
-unsigned BinDecoderBase::decodeBinsEP( unsigned numBins )
+void BinDecoderBase::xReadBytes()
 {
-#if ENABLE_TRACING
-  int numBinsOrig = numBins;
-#endif
-
-  if( m_Range == 256 )
+  const int numBytes = ( MAX_BITS_BUFFERED - m_bitsBuffered ) >> 3;
+  if( m_byteEnd - m_bytePtr >= 8 )
   {
-    return decodeAlignedBinsEP( numBins );
+    uint64_t word = 0;
+    for( int i = 0; i < 8; i++ )
+    {
+      word = ( word << 8 ) | m_bytePtr[i];
+    }
+    m_Value    = ( m_Value << ( numBytes << 3 ) ) | ( word >> ( 64 - ( numBytes << 3 ) ) );
+    m_bytePtr += numBytes;
   }
-  unsigned remBins = numBins;
-  unsigned bins    = 0;
-  while(   remBins > 8 )
+  else
   {
-    m_Value     = ( m_Value << 8 ) + ( m_Bitstream->readByte() << ( 8 + m_bitsNeeded ) );
-    unsigned SR =   m_Range << 15;
-    for( int i = 0; i < 8; i++ )
+    for( int i = 0; i < numBytes; i++ )
     {
-      bins += bins;
-      SR  >>= 1;
-      if( m_Value >= SR )
+      m_Value <<= 8;
+      if( m_bytePtr < m_byteEnd )
+      {
+        m_Value += *m_bytePtr++;
+      }
+      else
       {
-        bins    ++;
-        m_Value -= SR;
+        m_numPadBytes++;
       }
     }
-    remBins -= 8;
   }
-  m_bitsNeeded   += remBins;
-  m_Value       <<= remBins;
-  if( m_bitsNeeded >= 0 )
-  {
-    m_Value      += m_Bitstream->readByte() << m_bitsNeeded;
-    m_bitsNeeded -= 8;
-  }
-  unsigned SR = m_Range << ( remBins + 7 );
-  for ( int i = 0; i < remBins; i++ )
+  m_bitsBuffered += numBytes << 3;
+}
+
+
+unsigned BinDecoderBase::decodeBinsEP( unsigned numBins )
+{
+  if( m_bitsBuffered < int( numBins ) )
   {
-    bins += bins;
-    SR  >>= 1;
-    if( m_Value >= SR )
-    {
-      bins    ++;
-      m_Value -= SR;
-    }
+    xReadBytes();
   }
+  m_bitsBuffered -= numBins;
+
+  // decoding n bypass bins is a long division of the offset extended by the next n bits by the range
+  const uint64_t value = m_Value >> m_bitsBuffered;
+  const unsigned bins  = unsigned( m_Range == 256 ? value >> 8 : value / m_Range );
+  m_Value             -= ( uint64_t( bins ) * m_Range ) << m_bitsBuffered;
+
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
   CodingStatistics::IncrementStatisticEP( *ptype, numBins, int(bins) );
 #endif
 #if ENABLE_TRACING
-  for( int i = 0; i < numBinsOrig; i++ )
+  for( int i = 0; i < numBins; i++ )
   {
-    DTRACE( g_trace_ctx, D_CABAC, "%d" "  " "%d" "  EP=%d \n", DTRACE_GET_COUNTER( g_trace_ctx, D_CABAC ), m_Range, ( bins >> ( numBinsOrig - 1 - i ) ) & 1 );
+    DTRACE( g_trace_ctx, D_CABAC, "%d" "  " "%d" "  EP=%d \n", DTRACE_GET_COUNTER( g_trace_ctx, D_CABAC ), m_Range, ( bins >> ( numBins - 1 - i ) ) & 1 );
   }
 #endif
   return bins;
@@ -188,14 +195,29 @@ unsigned BinDecoderBase::decodeRemAbsEP(unsigned goRicePar, unsigned cutoff, int
 {
   unsigned prefix = 0;
   {
+    // decode the longest possible unary prefix at once, the prefix ends with the first zero bin
     const unsigned  maxPrefix = 32 - maxLog2TrDynamicRange;
-    unsigned        codeWord = 0;
-    do
+    if( m_bitsBuffered < int( maxPrefix ) )
     {
-      prefix++;
-      codeWord = decodeBinEP();
-    } while (codeWord && prefix < maxPrefix);
-    prefix -= 1 - codeWord;
+      xReadBytes();
+    }
+    const int      shift    = m_bitsBuffered - maxPrefix;
+    const uint64_t value    = m_Value >> shift;
+    const unsigned bins     = unsigned( m_Range == 256 ? value >> 8 : value / m_Range );
+    const unsigned ones     = bins == ( 1u << maxPrefix ) - 1 ? maxPrefix : maxPrefix - 1 - floorLog2( ~bins & ( ( 1u << maxPrefix ) - 1 ) );
+    const unsigned numBins  = std::min( ones + 1, maxPrefix );
+    prefix                  = ones;
+    m_bitsBuffered         -= numBins;
+    m_Value                -= ( uint64_t( bins >> ( maxPrefix - numBins ) ) * m_Range ) << m_bitsBuffered;
+#if RExt__DECODER_DEBUG_BIT_STATISTICS
+    CodingStatistics::IncrementStatisticEP( *ptype, numBins, int( bins >> ( maxPrefix - numBins ) ) );
+#endif
+#if ENABLE_TRACING
+    for( unsigned i = 0; i < numBins; i++ )
+    {
+      DTRACE( g_trace_ctx, D_CABAC, "%d" "  " "%d" "  EP=%d \n", DTRACE_GET_COUNTER( g_trace_ctx, D_CABAC ), m_Range, ( bins >> ( maxPrefix - 1 - i ) ) & 1 );
+    }
+#endif
   }
 
   unsigned length = goRicePar, offset;
@@ -216,13 +238,17 @@ unsigned BinDecoderBase::decodeRemAbsEP(unsigned goRicePar, unsigned cutoff, int
 
 unsigned BinDecoderBase::decodeBinTrm()
 {
+  if( m_bitsBuffered < 1 )
+  {
+    xReadBytes();
+  }
   m_Range    -= 2;
-  unsigned SR = m_Range << 7;
+  const uint64_t SR = uint64_t( m_Range ) << m_bitsBuffered;
   if( m_Value >= SR )
   {
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
     CodingStatistics::UpdateCABACStat     ( STATS__CABAC_TRM_BITS,       m_Range+2, 2, 1 );
-    CodingStatistics::IncrementStatisticEP( STATS__BYTE_ALIGNMENT_BITS, -m_bitsNeeded, 0 );
+    CodingStatistics::IncrementStatisticEP( STATS__BYTE_ALIGNMENT_BITS, ( m_bitsBuffered & 7 ) + 1, 0 );
 #endif
     return 1;
   }
@@ -234,12 +260,7 @@ unsigned BinDecoderBase::decodeBinTrm()
     if( m_Range < 256 )
     {
       m_Range += m_Range;
-      m_Value += m_Value;
-      if( ++m_bitsNeeded == 0 )
-      {
-        m_Value      += m_Bitstream->readByte();
-        m_bitsNeeded  = -8;
-      }
+      m_bitsBuffered--;
     }
     return 0;
   }
@@ -257,49 +278,6 @@ void BinDecoderBase::align()
 }
 
 
-unsigned BinDecoderBase::decodeAlignedBinsEP( unsigned numBins )
-{
-#if ENABLE_TRACING
-  int numBinsOrig = numBins;
-#endif
-  unsigned remBins = numBins;
-  unsigned bins    = 0;
-  while(   remBins > 0 )
-  {
-    // The MSB of m_Value is known to be 0 because range is 256. Therefore:
-    //   > The comparison against the symbol range of 128 is simply a test on the next-most-significant bit
-    //   > "Subtracting" the symbol range if the decoded bin is 1 simply involves clearing that bit.
-    //  As a result, the required bins are simply the <binsToRead> next-most-significant bits of m_Value
-    //  (m_Value is stored MSB-aligned in a 16-bit buffer - hence the shift of 15)
-    //
-    //    m_Value = |0|V|V|V|V|V|V|V|V|B|B|B|B|B|B|B|        (V = usable bit, B = potential buffered bit (buffer refills when m_bitsNeeded >= 0))
-    //
-    unsigned binsToRead = std::min<unsigned>( remBins, 8 ); //read bytes if able to take advantage of the system's byte-read function
-    unsigned binMask    = ( 1 << binsToRead ) - 1;
-    unsigned newBins    = ( m_Value >> (15 - binsToRead) ) & binMask;
-    bins                = ( bins    << binsToRead) | newBins;
-    m_Value             = ( m_Value << binsToRead) & 0x7FFF;
-    remBins            -= binsToRead;
-    m_bitsNeeded       += binsToRead;
-    if( m_bitsNeeded >= 0 )
-    {
-      m_Value          |= m_Bitstream->readByte() << m_bitsNeeded;
-      m_bitsNeeded     -= 8;
-    }
-  }
-#if RExt__DECODER_DEBUG_BIT_STATISTICS
-  CodingStatistics::IncrementStatisticEP( *ptype, numBins, int(bins) );
-#endif
-#if ENABLE_TRACING
-  for( int i = 0; i < numBinsOrig; i++ )
-  {
-    DTRACE( g_trace_ctx, D_CABAC, "%d" "  " "%d" "  " "EP=%d \n", DTRACE_GET_COUNTER( g_trace_ctx, D_CABAC ), m_Range, ( bins >> ( numBinsOrig - 1 - i ) ) & 1 );
-  }
-#endif
-  return bins;
-}
-
-
 
 
 template <class BinProbModel>
@@ -309,62 +287,5 @@ TBinDecoder<BinProbModel>::TBinDecoder()
 {}
 
 
-template <class BinProbModel>
-unsigned TBinDecoder<BinProbModel>::decodeBin( unsigned ctxId )
-{
-  BinProbModel& rcProbModel = m_Ctx[ctxId];
-  unsigned      bin         = rcProbModel.mps();
-  uint32_t      LPS         = rcProbModel.getLPS( m_Range );
-
-  DTRACE( g_trace_ctx, D_CABAC, "%d" " %d " "%d" "  " "[%d:%d]" "  " "%2d(MPS=%d)"  "  " , DTRACE_GET_COUNTER( g_trace_ctx, D_CABAC ), ctxId, m_Range, m_Range-LPS, LPS, ( unsigned int )( rcProbModel.state() ), m_Value < ( ( m_Range - LPS ) << 7 ) );
-  //DTRACE( g_trace_ctx, D_CABAC, " %d " "%d" "  " "[%d:%d]" "  " "%2d(MPS=%d)"  "  ", DTRACE_GET_COUNTER( g_trace_ctx, D_CABAC ), m_Range, m_Range - LPS, LPS, (unsigned int)( rcProbModel.state() ), m_Value < ( ( m_Range - LPS ) << 7 ) );
-
-  m_Range   -=  LPS;
-  uint32_t      SR          = m_Range << 7;
-  if( m_Value < SR )
-  {
-#if RExt__DECODER_DEBUG_BIT_STATISTICS
-    CodingStatistics::UpdateCABACStat( *ptype, m_Range+LPS, m_Range, int( bin ) );
-#endif
-    // MPS path
-    if( m_Range < 256 )
-    {
-      int numBits   = rcProbModel.getRenormBitsRange( m_Range );
-      m_Range     <<= numBits;
-      m_Value     <<= numBits;
-      m_bitsNeeded += numBits;
-      if( m_bitsNeeded >= 0 )
-      {
-        m_Value      += m_Bitstream->readByte() << m_bitsNeeded;
-        m_bitsNeeded -= 8;
-      }
-    }
-  }
-  else
-  {
-    bin = 1 - bin;
-#if RExt__DECODER_DEBUG_BIT_STATISTICS
-    CodingStatistics::UpdateCABACStat( *ptype, m_Range+LPS, LPS, int( bin ) );
-#endif
-    // LPS path
-    int numBits   = rcProbModel.getRenormBitsLPS( LPS );
-    m_Value      -= SR;
-    m_Value       = m_Value << numBits;
-    m_Range       = LPS     << numBits;
-    m_bitsNeeded += numBits;
-    if( m_bitsNeeded >= 0 )
-    {
-      m_Value      += m_Bitstream->readByte() << m_bitsNeeded;
-      m_bitsNeeded -= 8;
-    }
-  }
-  rcProbModel.update( bin );
-  //DTRACE_DECR_COUNTER( g_trace_ctx, D_CABAC );
-  DTRACE_WITHOUT_COUNT( g_trace_ctx, D_CABAC, "  -  " "%d" "\n", bin );
-  return  bin;
-}
-
-
 
 template class TBinDecoder<BinProbModel_Std>;
-
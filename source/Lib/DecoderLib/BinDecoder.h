@@ -40,14 +40,21 @@
 
 #include "CommonLib/Contexts.h"
 #include "CommonLib/BitStream.h"
+#include "CommonLib/dtrace_next.h"
 
 
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
-class CodingStatisticsClassType;
+#include "CommonLib/CodingStatistics.h"
 #endif
 
 
 
+/// arithmetic decoding engine
+///
+/// The decoder keeps the 9 bit offset of the arithmetic decoder and up to 55 bits read ahead from the bitstream in a
+/// 64 bit window: m_Value = offset << m_bitsBuffered | next m_bitsBuffered bits. Renormalization only decrements
+/// m_bitsBuffered, the window is refilled with several bytes at once and a run of bypass bins is decoded with a
+/// single division.
 class BinDecoderBase : public Ctx
 {
 protected:
@@ -66,23 +73,25 @@ public:
   void      set     ( const CodingStatisticsClassType& type) { ptype = &type; }
 #endif
 
-public:
-  virtual unsigned  decodeBin           ( unsigned ctxId    ) = 0;
-
 public:
   unsigned          decodeBinEP         ();
   unsigned          decodeBinsEP        ( unsigned numBins  );
   unsigned          decodeRemAbsEP      ( unsigned goRicePar, unsigned cutoff, int maxLog2TrDynamicRange );
   unsigned          decodeBinTrm        ();
   void              align               ();
-  unsigned          getNumBitsRead      () { return m_Bitstream->getNumBitsRead() + m_bitsNeeded; }
-private:
-  unsigned          decodeAlignedBinsEP ( unsigned numBins  );
+  unsigned          getNumBitsRead      () { return m_Bitstream->getNumBitsRead() + 8 * xGetNumBytesRead() - m_bitsBuffered - 1; }
+protected:
+  void              xReadBytes          ();
+  unsigned          xGetNumBytesRead    () const { return unsigned( m_bytePtr - m_byteStart ) + m_numPadBytes; }
 protected:
   InputBitstream*   m_Bitstream;
+  const uint8_t*    m_byteStart;                ///< first byte of the bitstream read by the arithmetic decoder
+  const uint8_t*    m_bytePtr;                  ///< next byte to be read into the window
+  const uint8_t*    m_byteEnd;
+  unsigned          m_numPadBytes;              ///< zero bytes read beyond the end of the bitstream
   uint32_t          m_Range;
-  uint32_t          m_Value;
-  int32_t           m_bitsNeeded;
+  uint64_t          m_Value;
+  int32_t           m_bitsBuffered;
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
   const CodingStatisticsClassType* ptype;
 #endif
@@ -91,7 +100,7 @@ protected:
 
 
 template <class BinProbModel>
-class TBinDecoder : public BinDecoderBase
+class TBinDecoder final : public BinDecoderBase
 {
 public:
   TBinDecoder ();
@@ -103,6 +112,76 @@ private:
 
 
 
-typedef TBinDecoder<BinProbModel_Std>   BinDecoder_Std;
+inline unsigned BinDecoderBase::decodeBinEP()
+{
+  if( m_bitsBuffered < 1 )
+  {
+    xReadBytes();
+  }
+  m_bitsBuffered--;
+
+  unsigned       bin = 0;
+  const uint64_t SR  = uint64_t( m_Range ) << m_bitsBuffered;
+  if( m_Value >= SR )
+  {
+    m_Value   -= SR;
+    bin        = 1;
+  }
+#if RExt__DECODER_DEBUG_BIT_STATISTICS
+  CodingStatistics::IncrementStatisticEP( *ptype, 1, int(bin) );
+#endif
+  DTRACE( g_trace_ctx, D_CABAC, "%d" "  " "%d" "  EP=%d \n",  DTRACE_GET_COUNTER( g_trace_ctx, D_CABAC ), m_Range, bin );
+  return bin;
+}
+
+
+template <class BinProbModel>
+inline unsigned TBinDecoder<BinProbModel>::decodeBin( unsigned ctxId )
+{
+  // the LPS path renormalizes by up to 6 bits
+  if( m_bitsBuffered < 6 )
+  {
+    xReadBytes();
+  }
+
+  BinProbModel& rcProbModel = m_Ctx[ctxId];
+  unsigned      bin         = rcProbModel.mps();
+  uint32_t      LPS         = rcProbModel.getLPS( m_Range );
+
+  DTRACE( g_trace_ctx, D_CABAC, "%d" " %d " "%d" "  " "[%d:%d]" "  " "%2d(MPS=%d)"  "  " , DTRACE_GET_COUNTER( g_trace_ctx, D_CABAC ), ctxId, m_Range, m_Range-LPS, LPS, ( unsigned int )( rcProbModel.state() ), m_Value < ( uint64_t( m_Range - LPS ) << m_bitsBuffered ) );
+
+  m_Range   -=  LPS;
+  const uint64_t SR         = uint64_t( m_Range ) << m_bitsBuffered;
+  if( m_Value < SR )
+  {
+#if RExt__DECODER_DEBUG_BIT_STATISTICS
+    CodingStatistics::UpdateCABACStat( *ptype, m_Range+LPS, m_Range, int( bin ) );
+#endif
+    // MPS path
+    if( m_Range < 256 )
+    {
+      int numBits     = rcProbModel.getRenormBitsRange( m_Range );
+      m_Range       <<= numBits;
+      m_bitsBuffered -= numBits;
+    }
+  }
+  else
+  {
+    bin = 1 - bin;
+#if RExt__DECODER_DEBUG_BIT_STATISTICS
+    CodingStatistics::UpdateCABACStat( *ptype, m_Range+LPS, LPS, int( bin ) );
+#endif
+    // LPS path, the range is renormalized to 9 bits
+    int numBits     = 8 - floorLog2( LPS );
+    m_Value        -= SR;
+    m_Range         = LPS << numBits;
+    m_bitsBuffered -= numBits;
+  }
+  rcProbModel.update( bin );
+  DTRACE_WITHOUT_COUNT( g_trace_ctx, D_CABAC, "  -  " "%d" "\n", bin );
+  return  bin;
+}
 
 
+
+typedef TBinDecoder<BinProbModel_Std>   BinDecoder_Std;
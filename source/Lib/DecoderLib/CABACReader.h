@@ -48,7 +48,7 @@
 class CABACReader
 {
 public:
-  CABACReader(BinDecoderBase& binDecoder) : m_BinDecoder(binDecoder), m_Bitstream(0) {}
+  CABACReader(BinDecoder_Std& binDecoder) : m_BinDecoder(binDecoder), m_Bitstream(0) {}
   virtual ~CABACReader() {}
 
 public:
@@ -156,7 +156,7 @@ private:
   void        xAdjustPLTIndex           ( CodingUnit& cu,           Pel curLevel,          uint32_t idx, PelBuf& paletteIdx, PLTtypeBuf& paletteRunType, int maxSymbol, ComponentID compBegin );
 public:
 private:
-  BinDecoderBase& m_BinDecoder;
+  BinDecoder_Std& m_BinDecoder;
   InputBitstream* m_Bitstream;
   ScanElement*    m_scanOrder;
 };
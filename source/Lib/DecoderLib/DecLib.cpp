@@ -420,6 +420,12 @@ DecLib::DecLib()
   , m_deblockingFilter()
   , m_cSAO()
   , m_cReshaper()
+  , m_loopFilter()
+  , m_parallelLoopFilter(false)
+  , m_loopFilterSlice(nullptr)
+  , m_loopFilterSliceType(0)
+  , m_loopFilterTMVP(false)
+  , m_loopFilterMsgLevel(INFO)
 #if JVET_J0090_MEMORY_BANDWITH_MEASURE
   , m_cacheModel()
 #endif
@@ -516,6 +522,9 @@ void DecLib::create()
 
 void DecLib::destroy()
 {
+  finishLoopFilter();
+  m_loopFilter.destroy();
+
   delete m_apcSlicePilot;
   m_apcSlicePilot = NULL;
 
@@ -545,6 +554,8 @@ void DecLib::init(
 
 void DecLib::deletePicBuffer ( )
 {
+  finishLoopFilter();
+
   PicList::iterator  iterPic   = m_cListPic.begin();
   int iSize = int( m_cListPic.size() );
 
@@ -602,6 +613,11 @@ Picture* DecLib::xGetNewPicBuffer( const SPS &sps, const PPS &pps, const uint32_
     }
   }
 
+  if( bBufferIsAvailable && pcPic == m_loopFilter.getPicture() )
+  {
+    finishLoopFilter();
+  }
+
   if( ! bBufferIsAvailable )
   {
     //There is no room for this picture, either because of faulty encoder or dropped NAL. Extend the buffer.
@@ -644,10 +660,27 @@ void DecLib::executeLoopFilters()
     return; // nothing to deblock
   }
 
+  finishLoopFilter();
+
   m_pcPic->cs->slice->startProcessingTimer();
 
   CodingStructure& cs = *m_pcPic->cs;
 
+  // the filtering of the picture overlaps with the decoding of the next picture, which waits for the lines it references
+  if( m_parallelLoopFilter && !m_targetSubPicIdx && cs.pps->getNumSubPics() <= 1 && !cs.pps->getWrapAroundEnabledFlag() )
+  {
+    // the loop filters leave the slice of the last CTU in the coding structure
+    m_loopFilterSlice = cs.getCU( Position( ( cs.pcv->widthInCtus - 1 ) * cs.pcv->maxCUWidth, ( cs.pcv->heightInCtus - 1 ) * cs.pcv->maxCUHeight ), CHANNEL_TYPE_LUMA )->slice;
+    if( cs.sps->getUseLmcs() && cs.picHeader->getLmcsEnabledFlag() )
+    {
+      m_cReshaper.setRecReshaped( false );
+    }
+    m_pcPic->setBorderExtension( true );
+    m_loopFilter.create();
+    m_loopFilter.filterPicture( *m_pcPic, m_cReshaper, m_cALF );
+    return;
+  }
+
   if (cs.sps->getUseLmcs() && cs.picHeader->getLmcsEnabledFlag())
   {
       const PreCalcValues& pcv = *cs.pcv;
@@ -761,7 +794,8 @@ void DecLib::finishPicture(int &poc, PicList *&rpcListPic, MsgLevel msgl, bool a
   s.pixels = s.count * m_pcPic->Y().width * m_pcPic->Y().height;
 #endif
 
-  Slice*  pcSlice = m_pcPic->cs->slice;
+  const bool parallelLoopFilter = m_pcPic == m_loopFilter.getPicture();
+  Slice*  pcSlice = parallelLoopFilter ? m_loopFilterSlice : m_pcPic->cs->slice;
   m_prevPicPOC = pcSlice->getPOC();
 
   char c = (pcSlice->isIntra() ? 'I' : pcSlice->isInterP() ? 'P' : 'B');
@@ -773,11 +807,119 @@ void DecLib::finishPicture(int &poc, PicList *&rpcListPic, MsgLevel msgl, bool a
   if (pcSlice->isDRAP()) c = 'D';
   if (pcSlice->getEdrapRapId() > 0) c = 'E';
 
+  // the picture is reported when its filtering has been finished
+  if( parallelLoopFilter )
+  {
+    m_loopFilterSliceType = c;
+    m_loopFilterTMVP      = pcSlice->getPicHeader()->getEnableTMVPFlag();
+    m_loopFilterMsgLevel  = msgl;
+  }
+  else
+  {
+    xReportPicture( m_pcPic, pcSlice, c, pcSlice->getPicHeader()->getEnableTMVPFlag(), msgl );
+  }
+
+  m_pcPic->neededForOutput = (pcSlice->getPicHeader()->getPicOutputFlag() ? true : false);
+  if (associatedWithNewClvs && m_pcPic->neededForOutput)
+  {
+    if (!pcSlice->getPPS()->getMixedNaluTypesInPicFlag() && pcSlice->getNalUnitType() == NAL_UNIT_CODED_SLICE_RASL)
+    {
+      m_pcPic->neededForOutput = false;
+    }
+    else if (pcSlice->getPPS()->getMixedNaluTypesInPicFlag())
+    {
+      bool isRaslPic = true;
+      for (int i = 0; isRaslPic && i < m_pcPic->numSlices; i++)
+      {
+        if (!(pcSlice->getNalUnitType() == NAL_UNIT_CODED_SLICE_RASL || pcSlice->getNalUnitType() == NAL_UNIT_CODED_SLICE_RADL))
+        {
+          isRaslPic = false;
+        }
+      }
+      if (isRaslPic)
+      {
+        m_pcPic->neededForOutput = false;
+      }
+    }
+  }
+
+  const VPS *vps = pcSlice->getVPS();
+  if (vps != nullptr)
+  {
+    if (!vps->getEachLayerIsAnOlsFlag())
+    {
+      const int layerId        = pcSlice->getNalUnitLayerId();
+      const int generalLayerId = vps->getGeneralLayerIdx(layerId);
+      bool      layerIsOutput  = true;
+
+      if (vps->getOlsModeIdc() == 0)
+      {
+        layerIsOutput = generalLayerId == vps->m_targetOlsIdx;
+      }
+      else if (vps->getOlsModeIdc() == 1)
+      {
+        layerIsOutput = generalLayerId <= vps->m_targetOlsIdx;
+      }
+      else if (vps->getOlsModeIdc() == 2)
+      {
+        layerIsOutput = vps->getOlsOutputLayerFlag(vps->m_targetOlsIdx, generalLayerId);
+      }
+      if (!layerIsOutput)
+      {
+        m_pcPic->neededForOutput = false;
+      }
+    }
+  }
+  m_pcPic->reconstructed = true;
+
+  // process buffered suffix APS NALUs
+  processSuffixApsNalus();
+
+  Slice::sortPicList( m_cListPic ); // sorting for application output
+  poc                 = pcSlice->getPOC();
+  rpcListPic          = &m_cListPic;
+  m_bFirstSliceInPicture  = true; // TODO: immer true? hier ist irgendwas faul
+  m_maxDecSubPicIdx = 0;
+  m_maxDecSliceAddrInSubPic = -1;
+
+  if( parallelLoopFilter )
+  {
+    // the intermediate data is still used by the loop filters and released in finishLoopFilter()
+    m_loopFilter.getPicHeader()->initPicHeader();
+  }
+  else
+  {
+    m_pcPic->destroyTempBuffers();
+    m_pcPic->cs->destroyCoeffs();
+    m_pcPic->cs->releaseIntermediateData();
+    m_pcPic->cs->picHeader->initPicHeader();
+  }
+  m_puCounter++;
+}
+
+void DecLib::finishLoopFilter()
+{
+  Picture* pcPic = m_loopFilter.finishPicture();
+  if( pcPic == nullptr )
+  {
+    return;
+  }
+
+  xReportPicture( pcPic, m_loopFilterSlice, m_loopFilterSliceType, m_loopFilterTMVP, m_loopFilterMsgLevel );
+  m_loopFilterSlice = nullptr;
+
+  pcPic->destroyTempBuffers();
+  pcPic->cs->destroyCoeffs();
+  pcPic->cs->releaseIntermediateData();
+}
+
+void DecLib::xReportPicture( Picture* pcPic, Slice* pcSlice, const char sliceType, const bool enableTMVP, MsgLevel msgl )
+{
   //-- For time output for each slice
   msg( msgl, "POC %4d LId: %2d TId: %1d ( %s, %c-SLICE, QP%3d ) ", pcSlice->getPOC(), pcSlice->getPic()->layerId,
          pcSlice->getTLayer(),
          nalUnitTypeToString(pcSlice->getNalUnitType()),
-         c,
+         sliceType,
          pcSlice->getSliceQp() );
   msg( msgl, "[DT %6.3f] ", pcSlice->getProcessingTime() );
 
@@ -788,7 +930,7 @@ void DecLib::finishPicture(int &poc, PicList *&rpcListPic, MsgLevel msgl, bool a
     {
       const std::pair<int, int>& scaleRatio = pcSlice->getScalingRatio( RefPicList( iRefList ), iRefIndex );
 
-      if( pcSlice->getPicHeader()->getEnableTMVPFlag() && pcSlice->getColFromL0Flag() == bool(1 - iRefList) && pcSlice->getColRefIdx() == iRefIndex )
+      if( enableTMVP && pcSlice->getColFromL0Flag() == bool(1 - iRefList) && pcSlice->getColRefIdx() == iRefIndex )
       {
         if( scaleRatio.first != 1 << SCALE_RATIO_BITS || scaleRatio.second != 1 << SCALE_RATIO_BITS )
         {
@@ -820,15 +962,15 @@ void DecLib::finishPicture(int &poc, PicList *&rpcListPic, MsgLevel msgl, bool a
   }
   if (m_decodedPictureHashSEIEnabled)
   {
-    SEIMessages pictureHashes = getSeisByType(m_pcPic->SEIs, SEI::DECODED_PICTURE_HASH );
+    SEIMessages pictureHashes = getSeisByType(pcPic->SEIs, SEI::DECODED_PICTURE_HASH );
     const SEIDecodedPictureHash *hash = ( pictureHashes.size() > 0 ) ? (SEIDecodedPictureHash*) *(pictureHashes.begin()) : NULL;
     if (pictureHashes.size() > 1)
     {
       msg( WARNING, "Warning: Got multiple decoded picture hash SEI messages. Using first.");
     }
-    m_numberOfChecksumErrorsDetected += calcAndPrintHashStatus(((const Picture*) m_pcPic)->getRecoBuf(), hash, pcSlice->getSPS()->getBitDepths(), msgl);
+    m_numberOfChecksumErrorsDetected += calcAndPrintHashStatus(((const Picture*) pcPic)->getRecoBuf(), hash, pcSlice->getSPS()->getBitDepths(), msgl);
 
-    SEIMessages scalableNestingSeis = getSeisByType(m_pcPic->SEIs, SEI::SCALABLE_NESTING );
+    SEIMessages scalableNestingSeis = getSeisByType(pcPic->SEIs, SEI::SCALABLE_NESTING );
     for (auto seiIt : scalableNestingSeis)
     {
       SEIScalableNesting *nestingSei = dynamic_cast<SEIScalableNesting*>(seiIt);
@@ -840,7 +982,7 @@ void DecLib::finishPicture(int &poc, PicList *&rpcListPic, MsgLevel msgl, bool a
         {
           const SubPic& subpic = pcSlice->getPPS()->getSubPic(subpicId);
           const UnitArea area = UnitArea(pcSlice->getSPS()->getChromaFormatIdc(), Area(subpic.getSubPicLeft(), subpic.getSubPicTop(), subpic.getSubPicWidthInLumaSample(), subpic.getSubPicHeightInLumaSample()));
-          PelUnitBuf recoBuf = m_pcPic->cs->getRecoBuf(area);
+          PelUnitBuf recoBuf = pcPic->cs->getRecoBuf(area);
           m_numberOfChecksumErrorsDetected += calcAndPrintHashStatus(recoBuf, dynamic_cast<SEIDecodedPictureHash*>(decPicHash), pcSlice->getSPS()->getBitDepths(), msgl);
         }
       }
@@ -850,79 +992,10 @@ void DecLib::finishPicture(int &poc, PicList *&rpcListPic, MsgLevel msgl, bool a
   msg( msgl, "\n");
 
 #if JVET_J0090_MEMORY_BANDWITH_MEASURE
-    m_cacheModel.reportFrame();
-    m_cacheModel.accumulateFrame();
-    m_cacheModel.clear();
+  m_cacheModel.reportFrame();
+  m_cacheModel.accumulateFrame();
+  m_cacheModel.clear();
 #endif
-
-  m_pcPic->neededForOutput = (pcSlice->getPicHeader()->getPicOutputFlag() ? true : false);
-  if (associatedWithNewClvs && m_pcPic->neededForOutput)
-  {
-    if (!pcSlice->getPPS()->getMixedNaluTypesInPicFlag() && pcSlice->getNalUnitType() == NAL_UNIT_CODED_SLICE_RASL)
-    {
-      m_pcPic->neededForOutput = false;
-    }
-    else if (pcSlice->getPPS()->getMixedNaluTypesInPicFlag())
-    {
-      bool isRaslPic = true;
-      for (int i = 0; isRaslPic && i < m_pcPic->numSlices; i++)
-      {
-        if (!(pcSlice->getNalUnitType() == NAL_UNIT_CODED_SLICE_RASL || pcSlice->getNalUnitType() == NAL_UNIT_CODED_SLICE_RADL))
-        {
-          isRaslPic = false;
-        }
-      }
-      if (isRaslPic)
-      {
-        m_pcPic->neededForOutput = false;
-      }
-    }
-  }
-
-  const VPS *vps = pcSlice->getVPS();
-  if (vps != nullptr)
-  {
-    if (!vps->getEachLayerIsAnOlsFlag())
-    {
-      const int layerId        = pcSlice->getNalUnitLayerId();
-      const int generalLayerId = vps->getGeneralLayerIdx(layerId);
-      bool      layerIsOutput  = true;
-
-      if (vps->getOlsModeIdc() == 0)
-      {
-        layerIsOutput = generalLayerId == vps->m_targetOlsIdx;
-      }
-      else if (vps->getOlsModeIdc() == 1)
-      {
-        layerIsOutput = generalLayerId <= vps->m_targetOlsIdx;
-      }
-      else if (vps->getOlsModeIdc() == 2)
-      {
-        layerIsOutput = vps->getOlsOutputLayerFlag(vps->m_targetOlsIdx, generalLayerId);
-      }
-      if (!layerIsOutput)
-      {
-        m_pcPic->neededForOutput = false;
-      }
-    }
-  }
-  m_pcPic->reconstructed = true;
-
-  // process buffered suffix APS NALUs
-  processSuffixApsNalus();
-
-  Slice::sortPicList( m_cListPic ); // sorting for application output
-  poc                 = pcSlice->getPOC();
-  rpcListPic          = &m_cListPic;
-  m_bFirstSliceInPicture  = true; // TODO: immer true? hier ist irgendwas faul
-  m_maxDecSubPicIdx = 0;
-  m_maxDecSliceAddrInSubPic = -1;
-
-  m_pcPic->destroyTempBuffers();
-  m_pcPic->cs->destroyCoeffs();
-  m_pcPic->cs->releaseIntermediateData();
-  m_pcPic->cs->picHeader->initPicHeader();
-  m_puCounter++;
 }
 
 void DecLib::checkNoOutputPriorPics (PicList* pcListPic)
@@ -984,6 +1057,7 @@ void DecLib::xCreateLostPicture( int iLostPoc, const int layerId )
     if(abs(rpcPic->getPOC() -iLostPoc)==closestPoc&&rpcPic->getPOC()!=m_apcSlicePilot->getPOC())
     {
       msg( INFO, "copying picture %d to %d (%d)\n",rpcPic->getPOC() ,iLostPoc,m_apcSlicePilot->getPOC());
+      rpcPic->waitReconComplete();
       cFillPic->getRecoBuf().copyFrom( rpcPic->getRecoBuf() );
       break;
     }
@@ -3314,6 +3388,7 @@ void DecLib::xDecodeSPS( InputNALUnit& nalu )
   m_HLSReader.parseSPS( sps );
   sps->setLayerId( nalu.m_nuhLayerId );
   DTRACE( g_trace_ctx, D_QP_PER_CTU, "CTU Size: %dx%d", sps->getMaxCUWidth(), sps->getMaxCUHeight() );
+  finishLoopFilter();   // the stored parameter set may replace the one of the picture being filtered
   m_parameterSetManager.storeSPS( sps, nalu.getBitstream().getFifo() );
   m_accessUnitSpsNumSubpic[nalu.m_nuhLayerId] = sps->getNumSubPics();
 }
@@ -3326,6 +3401,7 @@ void DecLib::xDecodePPS( InputNALUnit& nalu )
   pps->setLayerId( nalu.m_nuhLayerId );
   pps->setTemporalId( nalu.m_temporalId );
   pps->setPuCounter( m_puCounter );
+  finishLoopFilter();   // the stored parameter set may replace the one of the picture being filtered
   m_parameterSetManager.storePPS( pps, nalu.getBitstream().getFifo() );
 }
 
@@ -3351,6 +3427,11 @@ void DecLib::xDecodeAPS(InputNALUnit& nalu)
     m_accessUnitApsNals.pop_back();
   }
 
+  if( aps->getAPSType() == ALF_APS && m_loopFilter.usesAlfAps( aps->getAPSId() ) )
+  {
+    finishLoopFilter();
+  }
+
   // aps will be deleted if it was already stored (and did not changed),
   // thus, storing it must be last action.
   m_parameterSetManager.storeAPS(aps, nalu.getBitstream().getFifo());
@@ -3697,16 +3778,17 @@ bool DecLib::isNewPicture(std::ifstream *bitstreamFile, class InputByteStream *b
   CodingStatistics::CodingStatisticsData* backupStats = new CodingStatistics::CodingStatisticsData(CodingStatistics::GetStatistics());
   std::streampos location = bitstreamFile->tellg() - std::streampos(bytestream->GetNumBufferedBytes());
 #else
-  std::streampos location = bitstreamFile->tellg();
+  std::streampos location = bytestream->isMapped() ? std::streampos(0) : bitstreamFile->tellg();
+  const size_t mappedLocation = bytestream->getMappedPosition();
 #endif
 
   // look ahead until picture start location is determined
-  while (!finished && !!(*bitstreamFile))
+  while (!finished && bytestream->isGood())
   {
     AnnexBStats stats = AnnexBStats();
     InputNALUnit nalu;
-    byteStreamNALUnit(*bytestream, nalu.getBitstream().getFifo(), stats);
-    if (nalu.getBitstream().getFifo().empty())
+    byteStreamNALUnit(*bytestream, nalu, stats);
+    if (nalu.isPayloadEmpty())
     {
       msg( ERROR, "Warning: Attempt to decode an empty NAL unit\n");
     }
@@ -3778,9 +3860,16 @@ bool DecLib::isNewPicture(std::ifstream *bitstreamFile, class InputByteStream *b
   CodingStatistics::SetStatistics(*backupStats);
   delete backupStats;
 #else
-  bitstreamFile->clear();
-  bitstreamFile->seekg(location-std::streamoff(3));
-  bytestream->reset();
+  if (bytestream->isMapped())
+  {
+    bytestream->setMappedPosition(mappedLocation);
+  }
+  else
+  {
+    bitstreamFile->clear();
+    bitstreamFile->seekg(location-std::streamoff(3));
+    bytestream->reset();
+  }
 #endif
 
   // return TRUE if next NAL unit is the start of a new picture
@@ -3806,16 +3895,17 @@ bool DecLib::isNewAccessUnit( bool newPicture, std::ifstream *bitstreamFile, cla
   CodingStatistics::CodingStatisticsData* backupStats = new CodingStatistics::CodingStatisticsData(CodingStatistics::GetStatistics());
   std::streampos location = bitstreamFile->tellg() - std::streampos(bytestream->GetNumBufferedBytes());
 #else
-  std::streampos location = bitstreamFile->tellg();
+  std::streampos location = bytestream->isMapped() ? std::streampos(0) : bitstreamFile->tellg();
+  const size_t mappedLocation = bytestream->getMappedPosition();
 #endif
 
   // look ahead until access unit start location is determined
-  while (!finished && !!(*bitstreamFile))
+  while (!finished && bytestream->isGood())
   {
     AnnexBStats stats = AnnexBStats();
     InputNALUnit nalu;
-    byteStreamNALUnit(*bytestream, nalu.getBitstream().getFifo(), stats);
-    if (nalu.getBitstream().getFifo().empty())
+    byteStreamNALUnit(*bytestream, nalu, stats);
+    if (nalu.isPayloadEmpty())
     {
       msg( ERROR, "Warning: Attempt to decode an empty NAL unit\n");
     }
@@ -3869,9 +3959,16 @@ bool DecLib::isNewAccessUnit( bool newPicture, std::ifstream *bitstreamFile, cla
   CodingStatistics::SetStatistics(*backupStats);
   delete backupStats;
 #else
-  bitstreamFile->clear();
-  bitstreamFile->seekg(location);
-  bytestream->reset();
+  if (bytestream->isMapped())
+  {
+    bytestream->setMappedPosition(mappedLocation);
+  }
+  else
+  {
+    bitstreamFile->clear();
+    bitstreamFile->seekg(location);
+    bytestream->reset();
+  }
 #endif
 
   // return TRUE if next NAL unit is the start of a new picture
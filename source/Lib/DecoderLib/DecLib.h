@@ -39,6 +39,7 @@
 #define __DECLIB__
 
 #include "DecSlice.h"
+#include "DecLoopFilter.h"
 #include "CABACReader.h"
 #include "VLCReader.h"
 #include "SEIread.h"
@@ -120,6 +121,12 @@ private:
   SampleAdaptiveOffset    m_cSAO;
   AdaptiveLoopFilter      m_cALF;
   Reshape                 m_cReshaper;                        ///< reshaper class
+  DecLoopFilter           m_loopFilter;                       ///< in-loop filter running behind the decoding of the next picture
+  bool                    m_parallelLoopFilter;
+  Slice*                  m_loopFilterSlice;                  ///< slice reported for the picture being filtered
+  char                    m_loopFilterSliceType;
+  bool                    m_loopFilterTMVP;
+  MsgLevel                m_loopFilterMsgLevel;
   HRD                     m_HRD;
   // decoder side RD cost computation
   RdCost                  m_cRdCost;                      ///< RD cost computation class
@@ -234,6 +241,7 @@ public:
   void  destroy ();
 
   void  setDecodedPictureHashSEIEnabled(int enabled) { m_decodedPictureHashSEIEnabled=enabled; }
+  void  setParallelLoopFilter(bool enabled)         { m_parallelLoopFilter = enabled; }
 
   void  init(
 #if JVET_J0090_MEMORY_BANDWITH_MEASURE
@@ -244,6 +252,7 @@ public:
   void  deletePicBuffer();
 
   void  executeLoopFilters();
+  void  finishLoopFilter();
   void finishPicture(int &poc, PicList *&rpcListPic, MsgLevel msgl = INFO, bool associatedWithNewClvs = false);
   void  finishPictureLight(int& poc, PicList*& rpcListPic );
   void  checkNoOutputPriorPics (PicList* rpcListPic);
@@ -320,6 +329,7 @@ public:
 protected:
   void  xUpdateRasInit(Slice* slice);
 
+  void  xReportPicture( Picture* pcPic, Slice* pcSlice, const char sliceType, const bool enableTMVP, MsgLevel msgl );
   Picture * xGetNewPicBuffer( const SPS &sps, const PPS &pps, const uint32_t temporalLayer, const int layerId );
   void  xCreateLostPicture( int iLostPOC, const int layerId );
   void  xCreateUnavailablePicture( const PPS *pps, const int iUnavailablePoc, const bool longTermFlag, const int temporalId, const int layerId, const bool interLayerRefPicFlag );
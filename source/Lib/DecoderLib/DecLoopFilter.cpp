@@ -0,0 +1,311 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2021, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     DecLoopFilter.cpp
+    \brief    in-loop filtering of decoded pictures on a worker thread
+*/
+
+#include "DecLoopFilter.h"
+#include "CommonLib/UnitTools.h"
+
+//! \ingroup DecoderLib
+//! \{
+
+// the horizontal edges at the top of a CTU row modify up to 7 luma lines of the CTU row above it
+static const int DEBLOCK_PENDING_LINES = 8;
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+
+DecLoopFilter::DecLoopFilter()
+  : m_pcPic      ( nullptr )
+  , m_pcPicHeader( nullptr )
+  , m_lmcs       ( false )
+  , m_pending    ( false )
+  , m_done       ( false )
+  , m_stop       ( false )
+{
+  std::fill_n( m_filterParams, 8, -1 );
+}
+
+DecLoopFilter::~DecLoopFilter()
+{
+  destroy();
+}
+
+void DecLoopFilter::create()
+{
+  if( !m_thread.joinable() )
+  {
+    m_stop   = false;
+    m_thread = std::thread( &DecLoopFilter::xThreadLoop, this );
+  }
+}
+
+void DecLoopFilter::destroy()
+{
+  finishPicture();
+  if( m_thread.joinable() )
+  {
+    {
+      std::unique_lock<std::mutex> lock( m_mutex );
+      m_stop = true;
+    }
+    m_cond.notify_all();
+    m_thread.join();
+  }
+  m_deblockingFilter.destroy();
+  m_cSAO.destroy();
+  m_cALF.destroy();
+  std::fill_n( m_filterParams, 8, -1 );
+}
+
+void DecLoopFilter::filterPicture( Picture& pic, Reshape& reshaper, AdaptiveLoopFilter& alf )
+{
+  CHECK( m_pcPic != nullptr, "The previous picture has not been finished" );
+  CodingStructure& cs = *pic.cs;
+
+  xCreateFilters( *cs.sps, *cs.pps );
+
+  // the inverse mapping table and the CC-ALF control flags are overwritten by the next picture
+  m_lmcs = cs.sps->getUseLmcs() && cs.picHeader->getLmcsEnabledFlag();
+  if( m_lmcs )
+  {
+    m_invLUT = reshaper.getInvLUT();
+  }
+  if( cs.sps->getALFEnabledFlag() )
+  {
+    m_cALF.setCcAlfControlIdc( COMPONENT_Cb, alf.getCcAlfControlIdc( COMPONENT_Cb ) );
+    m_cALF.setCcAlfControlIdc( COMPONENT_Cr, alf.getCcAlfControlIdc( COMPONENT_Cr ) );
+  }
+  m_picHeader   = *cs.picHeader;
+  m_pcPicHeader = cs.picHeader;
+  cs.picHeader  = &m_picHeader;
+
+  pic.startProgress();
+  m_pcPic = &pic;
+
+  {
+    std::unique_lock<std::mutex> lock( m_mutex );
+    m_pending = true;
+    m_done    = false;
+  }
+  m_cond.notify_all();
+}
+
+Picture* DecLoopFilter::finishPicture()
+{
+  Picture* pic = m_pcPic;
+  if( pic == nullptr )
+  {
+    return nullptr;
+  }
+
+  {
+    std::unique_lock<std::mutex> lock( m_mutex );
+    m_cond.wait( lock, [this] { return m_done; } );
+  }
+  pic->cs->picHeader = m_pcPicHeader;
+  m_pcPic            = nullptr;
+  m_pcPicHeader      = nullptr;
+  return pic;
+}
+
+bool DecLoopFilter::usesAlfAps( const int apsId ) const
+{
+  if( m_pcPic == nullptr )
+  {
+    return false;
+  }
+  for( int i = 0; i < m_pcPic->numSlices; i++ )
+  {
+    const Slice* slice = m_pcPic->slices[i];
+    if( slice->getAlfEnabledFlag( COMPONENT_Y ) )
+    {
+      const std::vector<int> apsIds = slice->getAlfApsIdsLuma();
+      if( std::find( apsIds.begin(), apsIds.end(), apsId ) != apsIds.end() )
+      {
+        return true;
+      }
+    }
+    if( ( slice->getAlfEnabledFlag( COMPONENT_Cb ) || slice->getAlfEnabledFlag( COMPONENT_Cr ) ) && slice->getAlfApsIdChroma() == apsId )
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+void DecLoopFilter::xThreadLoop()
+{
+  std::unique_lock<std::mutex> lock( m_mutex );
+  while( true )
+  {
+    m_cond.wait( lock, [this] { return m_pending || m_stop; } );
+    if( m_stop )
+    {
+      return;
+    }
+    m_pending = false;
+    lock.unlock();
+
+    xFilterPicture();
+
+    lock.lock();
+    m_done = true;
+    m_cond.notify_all();
+  }
+}
+
+void DecLoopFilter::xCreateFilters( const SPS& sps, const PPS& pps )
+{
+  const int params[8] = { pps.getPicWidthInLumaSamples(), pps.getPicHeightInLumaSamples(), sps.getChromaFormatIdc(),
+                          (int) sps.getMaxCUWidth(), (int) sps.getMaxCUHeight(), pps.pcv->minCUWidthLog2,
+                          sps.getBitDepth( CHANNEL_TYPE_LUMA ), sps.getBitDepth( CHANNEL_TYPE_CHROMA ) };
+  if( std::equal( params, params + 8, m_filterParams ) )
+  {
+    return;
+  }
+  std::copy_n( params, 8, m_filterParams );
+
+  // same set up as in DecLib::xActivateParameterSets()
+  const int maxDepth = floorLog2( sps.getMaxCUWidth() ) - pps.pcv->minCUWidthLog2;
+  const uint32_t  log2SaoOffsetScaleLuma   = (uint32_t) std::max( 0, sps.getBitDepth( CHANNEL_TYPE_LUMA   ) - MAX_SAO_TRUNCATED_BITDEPTH );
+  const uint32_t  log2SaoOffsetScaleChroma = (uint32_t) std::max( 0, sps.getBitDepth( CHANNEL_TYPE_CHROMA ) - MAX_SAO_TRUNCATED_BITDEPTH );
+  m_cSAO.create( pps.getPicWidthInLumaSamples(), pps.getPicHeightInLumaSamples(),
+                 sps.getChromaFormatIdc(),
+                 sps.getMaxCUWidth(), sps.getMaxCUHeight(),
+                 maxDepth,
+                 log2SaoOffsetScaleLuma, log2SaoOffsetScaleChroma );
+  m_deblockingFilter.create( maxDepth );
+
+  const int alfMaxDepth = floorLog2( sps.getMaxCUWidth() ) - sps.getLog2MinCodingBlockSize();
+  m_cALF.create( pps.getPicWidthInLumaSamples(), pps.getPicHeightInLumaSamples(), sps.getChromaFormatIdc(), sps.getMaxCUWidth(), sps.getMaxCUHeight(), alfMaxDepth, sps.getBitDepths().recon );
+}
+
+/**
+ - filter the CTU rows of the picture in a wavefront: in step k the CTU row k is inverse mapped and deblocked, the
+   motion of CTU row k - 1 is refined, SAO is applied to CTU row k - 1 and ALF to CTU row k - 2
+ .
+ */
+void DecLoopFilter::xFilterPicture()
+{
+  Picture&             pic        = *m_pcPic;
+  CodingStructure&     cs         = *pic.cs;
+  const PreCalcValues& pcv        = *cs.pcv;
+  const int            ctuHeight  = pcv.maxCUHeight;
+  const int            numCtuRows = pcv.heightInCtus;
+  const int            lumaHeight = pcv.lumaHeight;
+
+  const bool sao = cs.sps->getSAOEnabledFlag() && m_cSAO.SAOPrepare( cs, pic.getSAO() );
+  const bool alf = cs.sps->getALFEnabledFlag();
+  if( alf )
+  {
+    m_cALF.getCcAlfFilterParam() = cs.slice->m_ccAlfFilterParam;
+    m_cALF.ALFPrepare( cs );
+  }
+
+  int saoLines  = 0;
+  int finalRows = 0;
+  for( int step = 0; step <= numCtuRows; step++ )
+  {
+    if( step < numCtuRows )
+    {
+      const int yPos = step * ctuHeight;
+      if( m_lmcs )
+      {
+        const int height = std::min( ctuHeight, lumaHeight - yPos );
+        for( int xPos = 0; xPos < pcv.lumaWidth; xPos += pcv.maxCUWidth )
+        {
+          const CodingUnit* cu = cs.getCU( Position( xPos, yPos ), CHANNEL_TYPE_LUMA );
+          if( cu->slice->getLmcsEnabledFlag() )
+          {
+            const int width = std::min<int>( pcv.maxCUWidth, pcv.lumaWidth - xPos );
+            const UnitArea area( cs.area.chromaFormat, Area( xPos, yPos, width, height ) );
+            cs.getRecoBuf( area ).get( COMPONENT_Y ).rspSignal( m_invLUT );
+          }
+        }
+      }
+      m_deblockingFilter.deblockingFilterCtuRow( cs, step );
+    }
+
+    if( step > 0 )
+    {
+      CS::setRefinedMotionField( cs, step - 1 );
+      pic.setMotionProgress( step == numCtuRows ? MAX_INT : step * ctuHeight );
+    }
+
+    const int deblockedLines = step >= numCtuRows - 1 ? lumaHeight : ( step + 1 ) * ctuHeight - DEBLOCK_PENDING_LINES;
+    if( sao )
+    {
+      m_cSAO.SAOCopyLines( cs, saoLines, deblockedLines );
+      saoLines = deblockedLines;
+      if( step > 0 )
+      {
+        m_cSAO.SAOProcessCtuRow( cs, step - 1 );
+      }
+    }
+
+    int numFinalRows = step;
+    if( alf )
+    {
+      if( step > 0 )
+      {
+        m_cALF.ALFCopyLines( cs, ( step - 1 ) * ctuHeight, std::min( step * ctuHeight, lumaHeight ) );
+      }
+      if( step > 1 )
+      {
+        m_cALF.ALFProcessCtuRow( cs, step - 2 );
+      }
+      if( step == numCtuRows )
+      {
+        m_cALF.ALFProcessCtuRow( cs, numCtuRows - 1 );
+      }
+      numFinalRows = step == numCtuRows ? numCtuRows : std::max( step - 1, 0 );
+    }
+
+    if( numFinalRows > finalRows )
+    {
+      const int lumaStart = finalRows * ctuHeight;
+      const int lumaEnd   = std::min( numFinalRows * ctuHeight, lumaHeight );
+      pic.extendPicBorderRows( lumaStart, lumaEnd );
+      pic.setReconProgress( lumaEnd == lumaHeight ? MAX_INT : lumaEnd );
+      finalRows = numFinalRows;
+    }
+  }
+
+  cs.slice->stopProcessingTimer();
+}
+
+//! \}
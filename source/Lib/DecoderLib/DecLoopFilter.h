@@ -0,0 +1,114 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2021, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     DecLoopFilter.h
+    \brief    in-loop filtering of decoded pictures on a worker thread (header)
+*/
+
+#ifndef __DECLOOPFILTER__
+#define __DECLOOPFILTER__
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include "CommonLib/CommonDef.h"
+#include "CommonLib/Picture.h"
+#include "CommonLib/DeblockingFilter.h"
+#include "CommonLib/SampleAdaptiveOffset.h"
+#include "CommonLib/AdaptiveLoopFilter.h"
+#include "CommonLib/Reshape.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+//! \ingroup DecoderLib
+//! \{
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// in-loop filter of a decoded picture running on a worker thread while the next picture is parsed and reconstructed
+///
+/// The CTU rows go through the inverse luma mapping, deblocking, the DMVR motion field refinement, SAO, ALF and the
+/// border extension in a wavefront that keeps each filter the lines behind the previous one that its support needs.
+/// Final lines are published through the reconstruction and motion progress of the picture, on which the motion
+/// compensation and the temporal motion vector prediction of the following pictures wait.
+class DecLoopFilter
+{
+public:
+  DecLoopFilter();
+  ~DecLoopFilter();
+
+  void      create            ();
+  void      destroy           ();
+
+  /// starts filtering the reconstructed picture, the picture header of the picture is replaced by a private copy until
+  /// finishPicture(); the picture has to be finished before the next one can be filtered
+  void      filterPicture     ( Picture& pic, Reshape& reshaper, AdaptiveLoopFilter& alf );
+  /// waits for the filtering of the picture and restores its picture header
+  Picture*  finishPicture     ();
+
+  Picture*  getPicture        () const { return m_pcPic; }
+  PicHeader* getPicHeader     () const { return m_pcPicHeader; }
+  bool      usesAlfAps        ( const int apsId ) const;
+
+private:
+  void      xThreadLoop       ();
+  void      xFilterPicture    ();
+  void      xCreateFilters    ( const SPS& sps, const PPS& pps );
+
+  Picture*                m_pcPic;                    ///< picture being filtered, nullptr when idle
+  PicHeader*              m_pcPicHeader;              ///< original picture header of the picture
+  PicHeader               m_picHeader;                ///< copy of the picture header used while filtering
+  bool                    m_lmcs;
+  std::vector<Pel>        m_invLUT;
+
+  DeblockingFilter        m_deblockingFilter;
+  SampleAdaptiveOffset    m_cSAO;
+  AdaptiveLoopFilter      m_cALF;
+  int                     m_filterParams[8];          ///< parameters the filters have been created for
+
+  bool                    m_pending;
+  bool                    m_done;
+  bool                    m_stop;
+  std::mutex              m_mutex;
+  std::condition_variable m_cond;
+  std::thread             m_thread;
+};
+
+//! \}
+
+#endif
@@ -42,6 +42,7 @@
 #include <ostream>
 
 #include "NALread.h"
+#include "AnnexBread.h"
 
 #include "CommonLib/NAL.h"
 #include "CommonLib/BitStream.h"
@@ -106,6 +107,80 @@ static void convertPayloadToRBSP(vector<uint8_t>& nalUnitBuf, InputBitstream *bi
   nalUnitBuf.resize(it_write - nalUnitBuf.begin());
 }
 
+/**
+ * Same as convertPayloadToRBSP(), but reading from a NAL unit view into a
+ * mapped byte stream and writing into the (empty) fifo of bitstream in
+ * the same pass. Runs without 0x0000 byte pairs, which cannot contain an
+ * emulation prevention byte, are located with a vectorized scan and
+ * copied as a whole; only the bytes following such a pair go through
+ * the per-byte state machine.
+ */
+static void convertPayloadViewToRBSP(const uint8_t* src, size_t size, InputBitstream *bitstream, bool isVclNalUnit)
+{
+  vector<uint8_t>& nalUnitBuf = bitstream->getFifo();
+  nalUnitBuf.resize(size);
+
+  const uint8_t* const end = src + size;
+  const uint8_t*       in  = src;
+  uint8_t*             out = nalUnitBuf.data();
+  uint32_t zeroCount = 0;
+
+  bitstream->clearEmulationPreventionByteLocation();
+  while (in != end)
+  {
+    if (zeroCount == 0)
+    {
+      const uint8_t* pair = findZeroBytePair(in, end);
+      memcpy(out, in, pair - in);
+      out += pair - in;
+      in   = pair;
+      if (in == end)
+      {
+        zeroCount = out[-1] == 0x00 ? 1 : 0;
+        break;
+      }
+    }
+
+    CHECK(zeroCount >= 2 && *in < 0x03, "Zero count is '2' and read value is small than '3'");
+    if (zeroCount == 2 && *in == 0x03)
+    {
+      bitstream->pushEmulationPreventionByteLocation( uint32_t(in - src) );
+      in++;
+      zeroCount = 0;
+#if RExt__DECODER_DEBUG_BIT_STATISTICS
+      CodingStatistics::IncrementStatisticEP(STATS__EMULATION_PREVENTION_3_BYTES, 8, 0);
+#endif
+      if (in == end)
+      {
+        break;
+      }
+      CHECK(*in > 0x03, "Read a value bigger than '3'");
+    }
+    zeroCount = (*in == 0x00) ? zeroCount+1 : 0;
+    *out++ = *in++;
+  }
+  CHECK(zeroCount != 0, "Zero count not '0'");
+
+  if (isVclNalUnit)
+  {
+    // Remove cabac_zero_word from payload if present
+    int n = 0;
+
+    while (out[-1] == 0x00)
+    {
+      out--;
+      n++;
+    }
+
+    if (n > 0)
+    {
+      msg( NOTICE, "\nDetected %d instances of cabac_zero_word\n", n/2);
+    }
+  }
+
+  nalUnitBuf.resize(out - nalUnitBuf.data());
+}
+
 #if ENABLE_TRACING
 static void xTraceNalUnitHeader(InputNALUnit& nalu)
 {
@@ -164,8 +239,17 @@ void read(InputNALUnit& nalu)
   InputBitstream &bitstream = nalu.getBitstream();
   vector<uint8_t>& nalUnitBuf=bitstream.getFifo();
   // perform anti-emulation prevention
-  const NalUnitType nut = (NalUnitType)(nalUnitBuf[1] >> 3);
-  convertPayloadToRBSP(nalUnitBuf, &bitstream, nut <= NAL_UNIT_RESERVED_IRAP_VCL_11);
+  if (nalu.getPayloadView())
+  {
+    const NalUnitType nut = (NalUnitType)(nalu.getPayloadView()[1] >> 3);
+    convertPayloadViewToRBSP(nalu.getPayloadView(), nalu.getPayloadViewSize(), &bitstream, nut <= NAL_UNIT_RESERVED_IRAP_VCL_11);
+    nalu.setPayloadView(nullptr, 0);
+  }
+  else
+  {
+    const NalUnitType nut = (NalUnitType)(nalUnitBuf[1] >> 3);
+    convertPayloadToRBSP(nalUnitBuf, &bitstream, nut <= NAL_UNIT_RESERVED_IRAP_VCL_11);
+  }
   bitstream.resetToStart();
   readNalUnitHeader(nalu);
 }
@@ -56,13 +56,20 @@ class InputNALUnit : public NALUnit
 {
   private:
     InputBitstream m_Bitstream;
+    const uint8_t* m_payloadView;      ///< NAL unit bytes inside a mapped byte stream, transferred into m_Bitstream by read()
+    size_t         m_payloadViewSize;
 
   public:
-    InputNALUnit(const InputNALUnit &src) : NALUnit(src), m_Bitstream(src.m_Bitstream) {};
-    InputNALUnit() : NALUnit(NAL_UNIT_INVALID), m_Bitstream() {};
+    InputNALUnit(const InputNALUnit &src) : NALUnit(src), m_Bitstream(src.m_Bitstream), m_payloadView(src.m_payloadView), m_payloadViewSize(src.m_payloadViewSize) {};
+    InputNALUnit() : NALUnit(NAL_UNIT_INVALID), m_Bitstream(), m_payloadView(nullptr), m_payloadViewSize(0) {};
     virtual ~InputNALUnit() { }
     const InputBitstream &getBitstream() const { return m_Bitstream; }
           InputBitstream &getBitstream()       { return m_Bitstream; }
+
+    void           setPayloadView    ( const uint8_t* data, size_t size ) { m_payloadView = data; m_payloadViewSize = size; }
+    const uint8_t* getPayloadView    () const { return m_payloadView; }
+    size_t         getPayloadViewSize() const { return m_payloadViewSize; }
+    bool           isPayloadEmpty    () const { return m_payloadView ? m_payloadViewSize == 0 : m_Bitstream.getFifo().empty(); }
 };
 
 void read(InputNALUnit& nalu);
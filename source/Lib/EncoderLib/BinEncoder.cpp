@@ -72,7 +72,7 @@ uint32_t BinCounter::getAll() const
 
 template <class BinProbModel>
 BinEncoderBase::BinEncoderBase( const BinProbModel* dummy )
-  : BinEncIf          ( dummy )
+  : BinEncIf          ( dummy, true )
   , m_Bitstream       ( 0 )
   , m_Low             ( 0 )
   , m_Range           ( 0 )
@@ -97,14 +97,14 @@ void BinEncoderBase::start()
   m_Range             = 510;
   m_bufferedByte      = 0xff;
   m_numBufferedBytes  = 0;
-  m_bitsLeft          = 23;
+  m_bitsLeft          = 55;
   BinCounter::reset();
   m_BinStore. reset();
 }
 
 void BinEncoderBase::finish()
 {
-  if( m_Low >> ( 32 - m_bitsLeft ) )
+  if( m_Low >> ( 64 - m_bitsLeft ) )
   {
     m_Bitstream->write( m_bufferedByte + 1, 8 );
     while( m_numBufferedBytes > 1 )
@@ -112,7 +112,7 @@ void BinEncoderBase::finish()
       m_Bitstream->write( 0x00, 8 );
       m_numBufferedBytes--;
     }
-    m_Low -= 1 << ( 32 - m_bitsLeft );
+    m_Low -= uint64_t( 1 ) << ( 64 - m_bitsLeft );
   }
   else
   {
@@ -126,7 +126,7 @@ void BinEncoderBase::finish()
       m_numBufferedBytes--;
     }
   }
-  m_Bitstream->write( m_Low >> 8, 24 - m_bitsLeft );
+  m_Bitstream->write( uint32_t( m_Low >> 8 ), 56 - m_bitsLeft );
 }
 
 void BinEncoderBase::restart()
@@ -135,7 +135,7 @@ void BinEncoderBase::restart()
   m_Range             = 510;
   m_bufferedByte      = 0xff;
   m_numBufferedBytes  = 0;
-  m_bitsLeft          = 23;
+  m_bitsLeft          = 55;
 }
 
 void BinEncoderBase::reset( int qp, int initId )
@@ -149,62 +149,10 @@ void BinEncoderBase::resetBits()
   m_Low               = 0;
   m_bufferedByte      = 0xff;
   m_numBufferedBytes  = 0;
-  m_bitsLeft          = 23;
+  m_bitsLeft          = 55;
   BinCounter::reset();
 }
 
-void BinEncoderBase::encodeBinEP( unsigned bin )
-{
-  DTRACE( g_trace_ctx, D_CABAC, "%d" "  " "%d" "  EP=%d \n", DTRACE_GET_COUNTER( g_trace_ctx, D_CABAC ), m_Range, bin );
-
-  BinCounter::addEP();
-  m_Low <<= 1;
-  if( bin )
-  {
-    m_Low += m_Range;
-  }
-  m_bitsLeft--;
-  if( m_bitsLeft < 12 )
-  {
-    writeOut();
-  }
-}
-
-void BinEncoderBase::encodeBinsEP( unsigned bins, unsigned numBins )
-{
-  for(int i = 0; i < numBins; i++)
-  {
-    DTRACE( g_trace_ctx, D_CABAC, "%d" "  " "%d" "  EP=%d \n", DTRACE_GET_COUNTER( g_trace_ctx, D_CABAC ), m_Range, ( bins >> ( numBins - 1 - i ) ) & 1 );
-  }
-
-  BinCounter::addEP( numBins );
-  if( m_Range == 256 )
-  {
-    encodeAlignedBinsEP( bins, numBins );
-    return;
-  }
-  while( numBins > 8 )
-  {
-    numBins          -= 8;
-    unsigned pattern  = bins >> numBins;
-    m_Low           <<= 8;
-    m_Low            += m_Range * pattern;
-    bins             -= pattern << numBins;
-    m_bitsLeft       -= 8;
-    if( m_bitsLeft < 12 )
-    {
-      writeOut();
-    }
-  }
-  m_Low     <<= numBins;
-  m_Low      += m_Range * bins;
-  m_bitsLeft -= numBins;
-  if( m_bitsLeft < 12 )
-  {
-    writeOut();
-  }
-}
-
 void BinEncoderBase::encodeRemAbsEP(unsigned bins, unsigned goRicePar, unsigned cutoff, int maxLog2TrDynamicRange)
 {
   const unsigned threshold = cutoff << goRicePar;
@@ -264,7 +212,7 @@ void BinEncoderBase::encodeBinTrm( unsigned bin )
     m_Range   <<= 1;
     m_bitsLeft--;
   }
-  if( m_bitsLeft < 12 )
+  if( m_bitsLeft < 33 )
   {
     writeOut();
   }
@@ -277,44 +225,19 @@ void BinEncoderBase::align()
 }
 
 
-void BinEncoderBase::encodeAlignedBinsEP( unsigned bins, unsigned numBins )
+void BinEncoderBase::writeOut()
 {
-  unsigned remBins = numBins;
-  while( remBins > 0 )
+  while( m_bitsLeft < 48 )
   {
-    //The process of encoding an EP bin is the same as that of coding a normal
-    //bin where the symbol ranges for 1 and 0 are both half the range:
-    //
-    //  low = (low + range/2) << 1       (to encode a 1)
-    //  low =  low            << 1       (to encode a 0)
-    //
-    //  i.e.
-    //  low = (low + (bin * range/2)) << 1
-    //
-    //  which is equivalent to:
-    //
-    //  low = (low << 1) + (bin * range)
-    //
-    //  this can be generalised for multiple bins, producing the following expression:
-    //
-    unsigned binsToCode = std::min<unsigned>( remBins, 8); //code bytes if able to take advantage of the system's byte-write function
-    unsigned binMask    = ( 1 << binsToCode ) - 1;
-    unsigned newBins    = ( bins >> ( remBins - binsToCode ) ) & binMask;
-    m_Low               = ( m_Low << binsToCode ) + ( newBins << 8 ); //range is known to be 256
-    remBins            -= binsToCode;
-    m_bitsLeft         -= binsToCode;
-    if( m_bitsLeft < 12 )
-    {
-      writeOut();
-    }
+    xWriteByte();
   }
 }
 
-void BinEncoderBase::writeOut()
+void BinEncoderBase::xWriteByte()
 {
-  unsigned leadByte = m_Low >> ( 24 - m_bitsLeft );
+  unsigned leadByte = unsigned( m_Low >> ( 56 - m_bitsLeft ) );
   m_bitsLeft       += 8;
-  m_Low            &= 0xffffffffu >> m_bitsLeft;
+  m_Low            &= ~uint64_t( 0 ) >> m_bitsLeft;
   if( leadByte == 0xff )
   {
     m_numBufferedBytes++;
@@ -350,46 +273,6 @@ TBinEncoder<BinProbModel>::TBinEncoder()
   , m_Ctx         ( static_cast<CtxStore<BinProbModel>&>( *this   ) )
 {}
 
-template <class BinProbModel>
-void TBinEncoder<BinProbModel>::encodeBin( unsigned bin, unsigned ctxId )
-{
-  BinCounter::addCtx( ctxId );
-  BinProbModel& rcProbModel = m_Ctx[ctxId];
-  uint32_t      LPS         = rcProbModel.getLPS( m_Range );
-
-  DTRACE( g_trace_ctx, D_CABAC, "%d" " %d " "%d" "  " "[%d:%d]" "  " "%2d(MPS=%d)"  "  " "  -  " "%d" "\n", DTRACE_GET_COUNTER( g_trace_ctx, D_CABAC ), ctxId, m_Range, m_Range - LPS, LPS, ( unsigned int ) ( rcProbModel.state() ), bin == rcProbModel.mps(), bin );
-
-  m_Range   -=  LPS;
-  if( bin != rcProbModel.mps() )
-  {
-    int numBits   = rcProbModel.getRenormBitsLPS( LPS );
-    m_bitsLeft   -= numBits;
-    m_Low        += m_Range;
-    m_Low         = m_Low << numBits;
-    m_Range       = LPS   << numBits;
-    if( m_bitsLeft < 12 )
-    {
-      writeOut();
-    }
-  }
-  else
-  {
-    if( m_Range < 256 )
-    {
-      int numBits   = rcProbModel.getRenormBitsRange( m_Range );
-      m_bitsLeft   -= numBits;
-      m_Low       <<= numBits;
-      m_Range     <<= numBits;
-      if( m_bitsLeft < 12 )
-      {
-        writeOut();
-      }
-    }
-  }
-  rcProbModel.update( bin );
-  BinEncoderBase::m_BinStore.addBin( bin, ctxId );
-}
-
 template <class BinProbModel>
 BinEncIf* TBinEncoder<BinProbModel>::getTestBinEncoder() const
 {
@@ -407,7 +290,7 @@ BinEncIf* TBinEncoder<BinProbModel>::getTestBinEncoder() const
 
 template <class BinProbModel>
 BitEstimatorBase::BitEstimatorBase( const BinProbModel* dummy )
-  : BinEncIf      ( dummy )
+  : BinEncIf      ( dummy, false )
 {
   m_EstFracBits = 0;
 }
@@ -94,11 +94,15 @@ private:
 };
 
 
+/// common interface of the arithmetic encoder and the bit estimator
+///
+/// The per-bin functions are not virtual: they dispatch on the kind of coder, which is fixed at construction, and call
+/// the inline implementations of BinEncoder_Std and BitEstimator_Std directly.
 class BinEncIf : public Ctx
 {
 protected:
   template <class BinProbModel>
-  BinEncIf( const BinProbModel* dummy ) : Ctx( dummy ) {}
+  BinEncIf( const BinProbModel* dummy, bool isEncoder ) : Ctx( dummy ), m_isEncoder( isEncoder ) {}
 public:
   virtual ~BinEncIf() {}
 public:
@@ -113,14 +117,14 @@ public:
   virtual uint64_t  getEstFracBits    ()                              const = 0;
   virtual unsigned  getNumBins        ( unsigned    ctxId )           const = 0;
 public:
-  virtual void      encodeBin         ( unsigned bin,   unsigned ctxId    ) = 0;
-  virtual void      encodeBinEP       ( unsigned bin                      ) = 0;
-  virtual void      encodeBinsEP      ( unsigned bins,  unsigned numBins  ) = 0;
-  virtual void      encodeRemAbsEP    ( unsigned bins,
+  inline  void      encodeBin         ( unsigned bin,   unsigned ctxId    );
+  inline  void      encodeBinEP       ( unsigned bin                      );
+  inline  void      encodeBinsEP      ( unsigned bins,  unsigned numBins  );
+  inline  void      encodeRemAbsEP    ( unsigned bins,
                                         unsigned goRicePar,
                                         unsigned cutoff,
-                                        int      maxLog2TrDynamicRange    ) = 0;
-  virtual void      encodeBinTrm      ( unsigned bin                      ) = 0;
+                                        int      maxLog2TrDynamicRange    );
+  inline  void      encodeBinTrm      ( unsigned bin                      );
   virtual void      align             ()                                    = 0;
 public:
   virtual uint32_t  getNumBins        ()                                    = 0;
@@ -130,6 +134,8 @@ public:
   virtual void            setBinStorage     ( bool b )                      = 0;
   virtual const BinStore* getBinStore       ()                        const = 0;
   virtual BinEncIf*       getTestBinEncoder ()                        const = 0;
+private:
+  const bool        m_isEncoder;
 };
 
 
@@ -186,16 +192,16 @@ public:
                                   int      maxLog2TrDynamicRange    );
   void      encodeBinTrm        ( unsigned bin                      );
   void      align               ();
-  unsigned  getNumWrittenBits   () { return ( m_Bitstream->getNumberOfWrittenBits() + 8 * m_numBufferedBytes + 23 - m_bitsLeft ); }
+  unsigned  getNumWrittenBits   () { return ( m_Bitstream->getNumberOfWrittenBits() + 8 * m_numBufferedBytes + 55 - m_bitsLeft ); }
 public:
   uint32_t  getNumBins          ()                          { return BinCounter::getAll(); }
   bool      isEncoding          ()                          { return true; }
 protected:
-  void      encodeAlignedBinsEP ( unsigned bins,  unsigned numBins  );
   void      writeOut            ();
+  void      xWriteByte          ();
 protected:
   OutputBitstream*        m_Bitstream;
-  uint32_t                m_Low;
+  uint64_t                m_Low;
   uint32_t                m_Range;
   uint32_t                m_bufferedByte;
   int32_t                 m_numBufferedBytes;
@@ -206,7 +212,7 @@ protected:
 
 
 template <class BinProbModel>
-class TBinEncoder : public BinEncoderBase
+class TBinEncoder final : public BinEncoderBase
 {
 public:
   TBinEncoder ();
@@ -263,7 +269,7 @@ protected:
 
 
 template <class BinProbModel>
-class TBitEstimator : public BitEstimatorBase
+class TBitEstimator final : public BitEstimatorBase
 {
 public:
   TBitEstimator ();
@@ -284,3 +290,146 @@ typedef TBinEncoder  <BinProbModel_Std>   BinEncoder_Std;
 typedef TBitEstimator<BinProbModel_Std>   BitEstimator_Std;
 
 
+
+// the 64 bit register m_Low holds up to 55 - m_bitsLeft pending bits, bytes are written out once fewer than 33 bits are
+// left, so that up to 32 bypass bins can be added in a single step
+inline void BinEncoderBase::encodeBinEP( unsigned bin )
+{
+  DTRACE( g_trace_ctx, D_CABAC, "%d" "  " "%d" "  EP=%d \n", DTRACE_GET_COUNTER( g_trace_ctx, D_CABAC ), m_Range, bin );
+
+  BinCounter::addEP();
+  m_Low <<= 1;
+  if( bin )
+  {
+    m_Low += m_Range;
+  }
+  m_bitsLeft--;
+  if( m_bitsLeft < 33 )
+  {
+    writeOut();
+  }
+}
+
+inline void BinEncoderBase::encodeBinsEP( unsigned bins, unsigned numBins )
+{
+#if ENABLE_TRACING
+  for( int i = 0; i < numBins; i++ )
+  {
+    DTRACE( g_trace_ctx, D_CABAC, "%d" "  " "%d" "  EP=%d \n", DTRACE_GET_COUNTER( g_trace_ctx, D_CABAC ), m_Range, ( bins >> ( numBins - 1 - i ) ) & 1 );
+  }
+#endif
+
+  // coding n bypass bins is the same as coding one bin n times: low = ( low << n ) + bins * range
+  BinCounter::addEP( numBins );
+  m_Low       = ( m_Low << numBins ) + uint64_t( m_Range ) * bins;
+  m_bitsLeft -= numBins;
+  if( m_bitsLeft < 33 )
+  {
+    writeOut();
+  }
+}
+
+template <class BinProbModel>
+inline void TBinEncoder<BinProbModel>::encodeBin( unsigned bin, unsigned ctxId )
+{
+  BinCounter::addCtx( ctxId );
+  BinProbModel& rcProbModel = m_Ctx[ctxId];
+  uint32_t      LPS         = rcProbModel.getLPS( m_Range );
+
+  DTRACE( g_trace_ctx, D_CABAC, "%d" " %d " "%d" "  " "[%d:%d]" "  " "%2d(MPS=%d)"  "  " "  -  " "%d" "\n", DTRACE_GET_COUNTER( g_trace_ctx, D_CABAC ), ctxId, m_Range, m_Range - LPS, LPS, ( unsigned int ) ( rcProbModel.state() ), bin == rcProbModel.mps(), bin );
+
+  m_Range   -=  LPS;
+  if( bin != rcProbModel.mps() )
+  {
+    // the range is renormalized to 9 bits
+    int numBits   = 8 - floorLog2( LPS );
+    m_bitsLeft   -= numBits;
+    m_Low        += m_Range;
+    m_Low         = m_Low << numBits;
+    m_Range       = LPS   << numBits;
+    if( m_bitsLeft < 33 )
+    {
+      writeOut();
+    }
+  }
+  else
+  {
+    if( m_Range < 256 )
+    {
+      int numBits   = rcProbModel.getRenormBitsRange( m_Range );
+      m_bitsLeft   -= numBits;
+      m_Low       <<= numBits;
+      m_Range     <<= numBits;
+      if( m_bitsLeft < 33 )
+      {
+        writeOut();
+      }
+    }
+  }
+  rcProbModel.update( bin );
+  BinEncoderBase::m_BinStore.addBin( bin, ctxId );
+}
+
+
+
+inline void BinEncIf::encodeBin( unsigned bin, unsigned ctxId )
+{
+  if( m_isEncoder )
+  {
+    static_cast<BinEncoder_Std*>  ( this )->encodeBin( bin, ctxId );
+  }
+  else
+  {
+    static_cast<BitEstimator_Std*>( this )->encodeBin( bin, ctxId );
+  }
+}
+
+inline void BinEncIf::encodeBinEP( unsigned bin )
+{
+  if( m_isEncoder )
+  {
+    static_cast<BinEncoder_Std*>  ( this )->encodeBinEP( bin );
+  }
+  else
+  {
+    static_cast<BitEstimator_Std*>( this )->encodeBinEP( bin );
+  }
+}
+
+inline void BinEncIf::encodeBinsEP( unsigned bins, unsigned numBins )
+{
+  if( m_isEncoder )
+  {
+    static_cast<BinEncoder_Std*>  ( this )->encodeBinsEP( bins, numBins );
+  }
+  else
+  {
+    static_cast<BitEstimator_Std*>( this )->encodeBinsEP( bins, numBins );
+  }
+}
+
+inline void BinEncIf::encodeRemAbsEP( unsigned bins, unsigned goRicePar, unsigned cutoff, int maxLog2TrDynamicRange )
+{
+  if( m_isEncoder )
+  {
+    static_cast<BinEncoder_Std*>  ( this )->encodeRemAbsEP( bins, goRicePar, cutoff, maxLog2TrDynamicRange );
+  }
+  else
+  {
+    static_cast<BitEstimator_Std*>( this )->encodeRemAbsEP( bins, goRicePar, cutoff, maxLog2TrDynamicRange );
+  }
+}
+
+inline void BinEncIf::encodeBinTrm( unsigned bin )
+{
+  if( m_isEncoder )
+  {
+    static_cast<BinEncoder_Std*>  ( this )->encodeBinTrm( bin );
+  }
+  else
+  {
+    static_cast<BitEstimator_Std*>( this )->encodeBinTrm( bin );
+  }
+}
+
+
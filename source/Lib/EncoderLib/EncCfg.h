@@ -355,6 +355,7 @@ protected:
   bool      m_Geo;
 
   bool      m_VA;
+  bool      m_vaFastSearch;
   bool      m_vaMVP;
   int       m_vaOffset4x4;
   int       m_projectionFct;
@@ -529,6 +530,7 @@ protected:
   bool      m_bFastMEForGenBLowDelayEnabled;
   bool      m_bUseBLambdaForNonKeyLowDelayPictures;
   bool      m_gopBasedTemporalFilterEnabled;
+  bool      m_memoryBudget;                                   ///< release buffers of coded pictures that are no longer needed
   bool      m_noPicPartitionFlag;                             ///< no picture partitioning flag (single tile, single slice)
   bool      m_mixedLossyLossless;                             ///< enable mixed lossy/lossless coding
   std::vector<uint16_t> m_sliceLosslessArray;                      ///< Slice lossless array
@@ -1242,6 +1244,8 @@ public:
   bool      getUseGeo                       ()         const { return m_Geo; }
   void      setUseVA(bool b) { m_VA = b; }
   bool      getUseVA() const { return m_VA; }
+  void      setUseVAFastSearch(bool b) { m_vaFastSearch = b; }
+  bool      getUseVAFastSearch() const { return m_vaFastSearch; }
   void      setUseVAMVP(bool b) { m_vaMVP = b; }
   bool      getUseVAMVP() const { return m_vaMVP; }
   void      setVaOffset4x4(int value) { m_vaOffset4x4 = value; }
@@ -1580,6 +1584,8 @@ public:
   bool      getUseBLambdaForNonKeyLowDelayPictures () { return m_bUseBLambdaForNonKeyLowDelayPictures; }
   void  setGopBasedTemporalFilterEnabled(bool flag) { m_gopBasedTemporalFilterEnabled = flag; }
   bool  getGopBasedTemporalFilterEnabled()          { return m_gopBasedTemporalFilterEnabled; }
+  void      setUseMemoryBudget              ( bool b )       { m_memoryBudget = b; }
+  bool      getUseMemoryBudget              ()         const { return m_memoryBudget; }
 
   bool      getUseReconBasedCrossCPredictionEstimate ()                const { return m_reconBasedCrossCPredictionEstimate;  }
   void      setUseReconBasedCrossCPredictionEstimate (const bool value)      { m_reconBasedCrossCPredictionEstimate = value; }
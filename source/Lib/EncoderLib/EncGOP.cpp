@@ -1831,6 +1831,40 @@ void EncGOP::xPicInitHashME( Picture *pic, const PPS *pps, PicList &rcListPic )
   }
 }
 
+// memory budget mode: the original buffers of coded pictures are released unless they are still needed to build the
+// hash table of a reference picture or for the PSNR of a field pair, reconstructions that are no longer referenced are
+// only kept for output and are stored without margins
+void EncGOP::xReleasePicBuffers( PicList &rcListPic, std::list<PelUnitBuf*> &rcListPicYuvRecOut, const bool isField )
+{
+  for( Picture *pic : rcListPic )
+  {
+    if( !pic->reconstructed || pic->layerId != m_pcEncLib->getLayerId() )
+    {
+      continue;
+    }
+
+    if( !isField && ( !pic->referenced || !m_pcCfg->getUseHashME() || pic->getHashMap()->isInitial() ) )
+    {
+      pic->releaseOrigBuffers();
+    }
+
+    if( !pic->referenced && !pic->isRecoBufferCompact() )
+    {
+      const Pel *prevBuf = pic->getRecoBuf().Y().buf;
+      pic->compactRecoBuffer();
+
+      // the reconstruction output of the GOP refers to the picture buffer
+      for( PelUnitBuf *recOut : rcListPicYuvRecOut )
+      {
+        if( !recOut->bufs.empty() && recOut->Y().buf == prevBuf )
+        {
+          *recOut = pic->getRecoBuf();
+        }
+      }
+    }
+  }
+}
+
 void EncGOP::xPicInitRateControl(int &estimatedBits, int gopId, double &lambda, Picture *pic, Slice *slice)
 {
   if ( !m_pcCfg->getUseRateCtrl() ) // TODO: does this work with multiple slices and slice-segments?
@@ -2147,6 +2181,7 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
 
     //-- For time output for each slice
     auto beforeTime = std::chrono::steady_clock::now();
+    CtxCopyStats::reset();
 
 #if !X0038_LAMBDA_FROM_QP_CAPABILITY
     uint32_t uiColDir = calculateCollocatedFromL1Flag(m_pcCfg, iGOPid, m_iGopSize);
@@ -4020,6 +4055,11 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
     pcPic->destroyTempBuffers();
     pcPic->cs->destroyCoeffs();
     pcPic->cs->releaseIntermediateData();
+
+    if( m_pcCfg->getUseMemoryBudget() )
+    {
+      xReleasePicBuffers( rcListPic, rcListPicYuvRecOut, isField );
+    }
   } // iGOPid-loop
 
   delete pcBitstreamRedirect;
@@ -4917,6 +4957,7 @@ void EncGOP::xCalculateAddPSNR(Picture* pcPic, PelUnitBuf cPicD, const AccessUni
     }
 #endif
     msg( NOTICE, " [ET %5.0f ]", dEncTime );
+    msg( DETAILS, " [CTX %" PRIu64 " kB of %" PRIu64 " kB]", CtxCopyStats::getBytesCopied() >> 10, CtxCopyStats::getBytesFullCopy() >> 10 );
 
     // msg( SOME, " [WP %d]", pcSlice->getUseWeightedPrediction());
 
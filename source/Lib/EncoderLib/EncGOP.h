@@ -282,6 +282,7 @@ protected:
     , bool isEncodeLtRef
   );
   void  xPicInitHashME( Picture *pic, const PPS *pps, PicList &rcListPic );
+  void  xReleasePicBuffers( PicList &rcListPic, std::list<PelUnitBuf*> &rcListPicYuvRecOut, const bool isField );
   void  xPicInitRateControl(int &estimatedBits, int gopId, double &lambda, Picture *pic, Slice *slice);
   void  xPicInitLMCS       (Picture *pic, PicHeader *picHeader, Slice *slice);
   void  xGetBuffer        ( PicList& rcListPic, std::list<PelUnitBuf*>& rcListPicYuvRecOut,
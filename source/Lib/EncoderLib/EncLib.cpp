@@ -940,6 +940,11 @@ void EncLib::xGetNewPicBuffer ( std::list<PelUnitBuf*>& rcListPicYuvRecOut, Pict
 
     m_cListPic.push_back( rpcPic );
   }
+  else if( m_memoryBudget )
+  {
+    // buffers released after the previous use of the picture
+    rpcPic->restoreBuffers( sps.getMaxCUWidth(), m_gopBasedTemporalFilterEnabled );
+  }
 
   rpcPic->setBorderExtension( false );
   rpcPic->reconstructed = false;
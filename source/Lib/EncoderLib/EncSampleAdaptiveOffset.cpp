@@ -1142,6 +1142,13 @@ void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const int c
     SAOStatData& statsData= statsDataTypes[typeIdx];
     statsData.reset();
 
+    if( !isCtuCrossedByVirtualBoundaries && typeIdx != SAO_TYPE_BO )
+    {
+      getBlkEdgeStats( typeIdx, statsData, srcBlk, orgBlk, srcStride, orgStride, width, height, isLeftAvail, isRightAvail, isAboveAvail, isBelowAvail,
+                       isAboveLeftAvail, isAboveRightAvail, isCalculatePreDeblockSamples, skipLinesR[typeIdx], skipLinesB[typeIdx] );
+      continue;
+    }
+
     srcLine = srcBlk;
     orgLine = orgBlk;
     diff    = statsData.diff;
@@ -1539,6 +1546,73 @@ void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const int c
   }
 }
 
+// Edge offset statistics of a block not crossed by virtual boundaries, covering the same samples as getBlkStats()
+void EncSampleAdaptiveOffset::getBlkEdgeStats( const int typeIdx, SAOStatData& statsData, const Pel* srcBlk, const Pel* orgBlk, const int srcStride, const int orgStride, const int width, const int height
+                                             , const bool isLeftAvail, const bool isRightAvail, const bool isAboveAvail, const bool isBelowAvail, const bool isAboveLeftAvail, const bool isAboveRightAvail
+                                             , const bool isCalculatePreDeblockSamples, const int skipLinesR, const int skipLinesB )
+{
+  int64_t* diff  = statsData.diff + 2;
+  int64_t* count = statsData.count + 2;
+
+  // the deblocked columns, or the ones right of them which are not deblocked yet
+  const int startX = (!isCalculatePreDeblockSamples) ? (isLeftAvail  ? 0 : 1)
+                                                     : (isRightAvail ? (width - skipLinesR) : (width - 1));
+  const int endX   = (!isCalculatePreDeblockSamples) ? (isRightAvail ? (width - skipLinesR) : (width - 1))
+                                                     : (isRightAvail ? width : (width - 1));
+  const int endY   = isBelowAvail ? (height - skipLinesB) : (height - 1);
+
+  ptrdiff_t nbOffset = 0;
+
+  switch( typeIdx )
+  {
+  case SAO_TYPE_EO_0:
+    {
+      nbOffset = 1;
+      m_calcEdgeStats( srcBlk, srcStride, orgBlk, orgStride, startX, endX, isBelowAvail ? endY : height, nbOffset, diff, count );
+    }
+    break;
+  case SAO_TYPE_EO_90:
+    {
+      nbOffset = srcStride;
+      const int startX90 = (!isCalculatePreDeblockSamples) ? 0 : (isRightAvail ? (width - skipLinesR) : width);
+      const int endX90   = (!isCalculatePreDeblockSamples) ? (isRightAvail ? (width - skipLinesR) : width) : width;
+      const int startY   = isAboveAvail ? 0 : 1;
+      m_calcEdgeStats( srcBlk + startY * srcStride, srcStride, orgBlk + startY * orgStride, orgStride, startX90, endX90, endY - startY, nbOffset, diff, count );
+    }
+    break;
+  case SAO_TYPE_EO_135:
+    {
+      nbOffset = srcStride + 1;
+      const int firstLineStartX = (!isCalculatePreDeblockSamples) ? (isAboveLeftAvail ? 0    : 1) : startX;
+      const int firstLineEndX   = (!isCalculatePreDeblockSamples) ? (isAboveAvail     ? endX : 1) : endX;
+      m_calcEdgeStats( srcBlk, srcStride, orgBlk, orgStride, firstLineStartX, firstLineEndX, 1, nbOffset, diff, count );
+      m_calcEdgeStats( srcBlk + srcStride, srcStride, orgBlk + orgStride, orgStride, startX, endX, endY - 1, nbOffset, diff, count );
+    }
+    break;
+  case SAO_TYPE_EO_45:
+    {
+      nbOffset = srcStride - 1;
+      const int firstLineStartX = (!isCalculatePreDeblockSamples) ? (isAboveAvail ? startX : endX) : startX;
+      const int firstLineEndX   = (!isCalculatePreDeblockSamples) ? ((!isRightAvail && isAboveRightAvail) ? width : endX) : endX;
+      m_calcEdgeStats( srcBlk, srcStride, orgBlk, orgStride, firstLineStartX, firstLineEndX, 1, nbOffset, diff, count );
+      m_calcEdgeStats( srcBlk + srcStride, srcStride, orgBlk + orgStride, orgStride, startX, endX, endY - 1, nbOffset, diff, count );
+    }
+    break;
+  default:
+    {
+      THROW("Not a supported SAO type");
+    }
+  }
+
+  if( isCalculatePreDeblockSamples && isBelowAvail )
+  {
+    // the lines above the bottom CTU boundary, which are not deblocked yet
+    const int lineStartX = typeIdx == SAO_TYPE_EO_90 ? 0 : (isLeftAvail ? 0 : 1);
+    const int lineEndX   = typeIdx == SAO_TYPE_EO_90 ? width : (isRightAvail ? width : (width - 1));
+    m_calcEdgeStats( srcBlk + endY * srcStride, srcStride, orgBlk + endY * orgStride, orgStride, lineStartX, lineEndX, skipLinesB, nbOffset, diff, count );
+  }
+}
+
 void EncSampleAdaptiveOffset::deriveLoopFilterBoundaryAvailibility(CodingStructure& cs, const Position &pos, bool& isLeftAvail, bool& isAboveAvail, bool& isAboveLeftAvail) const
 {
   bool isLoopFiltAcrossSlicePPS = cs.pps->getLoopFilterAcrossSlicesEnabledFlag();
@@ -83,6 +83,12 @@ static const Mv s_acMvRefineQ[9] =
   Mv(  1,  1 )  // 8
 };
 
+// Hierarchical MPA search
+static const int VA_COARSE_REF_MARGIN      = ( MAX_CU_SIZE >> 1 ) + 16;  // margin of the half resolution reference
+static const int VA_HIER_NUM_CANDIDATES    = 2;                          // coarse candidates refined at full resolution
+static const int VA_HIER_MAX_REFINE_ROUNDS = 4;                          // full resolution square refinement rounds
+static const int VA_HASH_NEAR_EXACT_SAD    = 1;                          // mean 8-bit luma error of an accepted reprojected hash match
+
 
 InterSearch::InterSearch()
   : m_modeCtrl                    (nullptr)
@@ -181,6 +187,16 @@ void InterSearch::destroy()
   m_isInitialized = false;
 
   m_tmpVaStorage.destroy();
+  m_vaCoarseOrg.destroy();
+  m_vaCoarsePred.destroy();
+  for( int i = 0; i < NUM_REF_PIC_LIST_01; i++ )
+  {
+    for( int j = 0; j < MAX_NUM_REF; j++ )
+    {
+      m_vaCoarseRef[i][j].buf.destroy();
+      m_vaCoarseRef[i][j].pic = nullptr;
+    }
+  }
 }
 
 void InterSearch::setTempBuffers( CodingStructure ****pSplitCS, CodingStructure ****pFullCS, CodingStructure **pSaveCS )
@@ -292,6 +308,8 @@ void InterSearch::init( EncCfg*        pcEncCfg,
 
   // Viewport-adaptive
   m_tmpVaStorage.create(Size(MAX_CU_SIZE, MAX_CU_SIZE));
+  m_vaCoarseOrg.create(Size(MAX_CU_SIZE >> 1, MAX_CU_SIZE >> 1));
+  m_vaCoarsePred.create(Size(MAX_CU_SIZE >> 1, MAX_CU_SIZE >> 1));
 }
 
 void InterSearch::resetSavedAffineMotion()
@@ -372,8 +390,7 @@ inline void InterSearch::xTZSearchHelp( IntTZSearchStruct& rcStruct, const int i
 
   if( 1 == rcStruct.subShiftMode )
   {
-    // Only valid for viewport 'CLASSIC'
-    CHECK (rcStruct.viewport != CLASSIC, "rcStruct.subShiftMode == 1 is not allowed for viewports other than 'CLASSIC'.");
+    // reference rows are addressed through cur.stride, which covers both the picture and the reprojected prediction buffer
     const Pel* const piRefSrch = m_cDistParam.cur.buf;
     // motion cost
     Distortion uiBitCost = m_pcRdCost->getCostOfVectorWithPredictor( iSearchX, iSearchY, rcStruct.imvShift );
@@ -394,7 +411,7 @@ inline void InterSearch::xTZSearchHelp( IntTZSearchStruct& rcStruct, const int i
         {
           int isubShift           = m_cDistParam.subShift -1;
           m_cDistParam.org.buf = rcStruct.pcPatternKey->buf + (rcStruct.pcPatternKey->stride << isubShift);
-          m_cDistParam.cur.buf = piRefSrch + (rcStruct.pcRefBuf->stride << isubShift);
+          m_cDistParam.cur.buf = piRefSrch + (m_cDistParam.cur.stride << isubShift);
           uiTempSad            = m_cDistParam.distFunc( m_cDistParam );
           uiSad               += uiTempSad >> m_cDistParam.subShift;
 
@@ -2013,7 +2030,6 @@ void InterSearch::selectRectangleMatchesInter(const MapIterator& itBegin, int co
 
 bool InterSearch::xRectHashInterEstimation(PredictionUnit& pu, RefPicList& bestRefPicList, int& bestRefIndex, Mv& bestMv, Mv& bestMvd, int& bestMVPIndex, bool& isPerfectMatch)
 {
-  CHECK( true, "xRectHashInterEstimation not allowed in VA-VVC." );
   int width = pu.cu->lumaSize().width;
   int height = pu.cu->lumaSize().height;
 
@@ -2351,7 +2367,6 @@ bool InterSearch::xRectHashInterEstimation(PredictionUnit& pu, RefPicList& bestR
 
 bool InterSearch::xHashInterEstimation(PredictionUnit& pu, RefPicList& bestRefPicList, int& bestRefIndex, Mv& bestMv, Mv& bestMvd, int& bestMVPIndex, bool& isPerfectMatch)
 {
-  CHECK( true, "xHashInterEstimation not allowed in VA-VVC." );
   int width = pu.cu->lumaSize().width;
   int height = pu.cu->lumaSize().height;
   if (width != height)
@@ -2668,6 +2683,8 @@ bool InterSearch::predInterHashSearch(CodingUnit& cu, Partitioner& partitioner,
   auto &pu = *cu.firstPU;
 
   Mv cMvZero;
+  pu.viewport[REF_PIC_LIST_0] = CLASSIC;
+  pu.viewport[REF_PIC_LIST_1] = CLASSIC;
   pu.mv[REF_PIC_LIST_0] = Mv();
   pu.mv[REF_PIC_LIST_1] = Mv();
   pu.mvd[REF_PIC_LIST_0] = cMvZero;
@@ -4950,6 +4967,7 @@ void InterSearch::xMotionEstimation(PredictionUnit& pu, PelUnitBuf& origBuf, Ref
   IntTZSearchStruct cStruct;
   cStruct.pcPatternKey  = pcPatternKey;
   cStruct.pcRefBuf      = &buf;
+  cStruct.refPic        = refPic;
   cStruct.blkPos        = pu.lumaPos();
   cStruct.blkSize       = pu.lumaSize();
   cStruct.viewport      = pu.viewport[eRefPicList];
@@ -5250,6 +5268,19 @@ void InterSearch::xPatternSearch( IntTZSearchStruct& cStruct, Mv& rcMv, Distorti
 
   const SearchRange& sr = cStruct.searchRange;
 
+  if ( xUseVAHierSearch( cStruct ) )
+  {
+    cStruct.uiBestSad = std::numeric_limits<Distortion>::max();
+    cStruct.iBestX    = 0;
+    cStruct.iBestY    = 0;
+    m_cDistParam.maximumDistortionForEarlyExit = cStruct.uiBestSad;
+    xTZSearchVAHier( cStruct, 0, true );
+
+    rcMv.set( cStruct.iBestX, cStruct.iBestY );
+    ruiSAD = cStruct.uiBestSad - m_pcRdCost->getCostOfVectorWithPredictor( cStruct.iBestX, cStruct.iBestY, cStruct.imvShift );
+    return;
+  }
+
   for ( int y = sr.top; y <= sr.bottom; y++ )
   {
     for ( int x = sr.left; x <= sr.right; x++ )
@@ -5487,6 +5518,16 @@ void InterSearch::xTZSearch( const PredictionUnit& pu,
     if (minSize < 128 && minSize >= 4)
     {
       int numberOfOtherMvps = m_numHashMVStoreds[m_currRefPicList][m_currRefPicIndex];
+      if (cStruct.viewport != CLASSIC)
+      {
+        if (xTZSearchHashVA(cStruct))
+        {
+          rcMv.set(cStruct.iBestX, cStruct.iBestY);
+          ruiSAD = cStruct.uiBestSad - m_pcRdCost->getCostOfVectorWithPredictor(cStruct.iBestX, cStruct.iBestY, cStruct.imvShift);
+          return;
+        }
+        numberOfOtherMvps = 0;
+      }
       for (int i = 0; i < numberOfOtherMvps; i++)
       {
         xTZSearchHelp(cStruct, m_hashMVStoreds[m_currRefPicList][m_currRefPicIndex][i].getHor(), m_hashMVStoreds[m_currRefPicList][m_currRefPicIndex][i].getVer(), 0, 0);
@@ -5502,6 +5543,16 @@ void InterSearch::xTZSearch( const PredictionUnit& pu,
     }
   }
 
+  if( xUseVAHierSearch( cStruct ) )
+  {
+    // replaces the diamond, raster and star stages for projected predictions
+    xTZSearchVAHier( cStruct, iSearchRange, false );
+
+    rcMv.set( cStruct.iBestX, cStruct.iBestY );
+    ruiSAD = cStruct.uiBestSad - m_pcRdCost->getCostOfVectorWithPredictor( cStruct.iBestX, cStruct.iBestY, cStruct.imvShift );
+    return;
+  }
+
   // start search
   int  iDist = 0;
   int  iStartX = cStruct.iBestX;
@@ -5688,6 +5739,294 @@ void InterSearch::xTZSearch( const PredictionUnit& pu,
 }
 
 
+bool InterSearch::xTZSearchHashVA( IntTZSearchStruct& cStruct )
+{
+  // the stored hash matches are classic integer vectors; reproject each one into the plane and verify it
+  // with a projected prediction, the plane search is terminated when the best candidate is (nearly) exact
+  const int          numHashMvs = m_numHashMVStoreds[m_currRefPicList][m_currRefPicIndex];
+  const SearchRange& sr         = cStruct.searchRange;
+  if( numHashMvs == 0 || !m_mvReprojection )
+  {
+    return false;
+  }
+
+  for( int i = 0; i < numHashMvs; i++ )
+  {
+    const Mv mv = m_mvReprojection->motionVectorInDesiredViewport( cStruct.blkPos, m_hashMVStoreds[m_currRefPicList][m_currRefPicIndex][i], CLASSIC, cStruct.viewport, 0, 0 );
+    if( mv.hor < sr.left || mv.hor > sr.right || mv.ver < sr.top || mv.ver > sr.bottom )
+    {
+      continue;
+    }
+    xTZSearchHelp( cStruct, mv.hor, mv.ver, 0, 0 );
+  }
+
+  const Distortion dist = cStruct.uiBestSad - m_pcRdCost->getCostOfVectorWithPredictor( cStruct.iBestX, cStruct.iBestY, cStruct.imvShift );
+  if( dist > ( ( Distortion ) cStruct.blkSize.area() * VA_HASH_NEAR_EXACT_SAD << std::max( 0, m_lumaClpRng.bd - 8 ) ) )
+  {
+    return false;
+  }
+  m_skipFracME = dist == 0;
+  return true;
+}
+
+bool InterSearch::xUseVAHierSearch( const IntTZSearchStruct& cStruct ) const
+{
+  return m_pcEncCfg->getUseVAFastSearch() && cStruct.viewport != CLASSIC && !cStruct.inCtuSearch && m_mvReprojection
+    && cStruct.blkSize.width >= 16 && cStruct.blkSize.height >= 16
+    && ( cStruct.blkSize.width & 7 ) == 0 && ( cStruct.blkSize.height & 7 ) == 0
+    && ( cStruct.blkPos.x & 7 ) == 0 && ( cStruct.blkPos.y & 7 ) == 0;
+}
+
+CPelBuf InterSearch::xGetVACoarseRef( const IntTZSearchStruct& cStruct )
+{
+  const Picture* refPic    = cStruct.refPic;
+  const CPelBuf& refBuf    = *cStruct.pcRefBuf;
+  VACoarseRef&   coarseRef = m_vaCoarseRef[m_currRefPicList][m_currRefPicIndex];
+  const int width  = refBuf.width  >> 1;
+  const int height = refBuf.height >> 1;
+
+  if( coarseRef.pic == refPic && coarseRef.poc == refPic->getPOC() )
+  {
+    return coarseRef.buf.Y();
+  }
+  if( !coarseRef.buf.bufs.empty() && ( coarseRef.buf.Y().width != width || coarseRef.buf.Y().height != height ) )
+  {
+    coarseRef.buf.destroy();
+  }
+  if( coarseRef.buf.bufs.empty() )
+  {
+    coarseRef.buf.create( CHROMA_400, Area( 0, 0, width, height ), 0, VA_COARSE_REF_MARGIN );
+  }
+
+  // 2x2 average, as in EncTemporalFilter::subsampleLuma
+  PelBuf dst = coarseRef.buf.Y();
+  const Pel* srcRow = refBuf.buf;
+  Pel* dstRow = dst.buf;
+  for( int y = 0; y < height; y++, srcRow += 2 * refBuf.stride, dstRow += dst.stride )
+  {
+    const Pel* srcRowBelow = srcRow + refBuf.stride;
+    for( int x = 0; x < width; x++ )
+    {
+      dstRow[x] = ( srcRow[2 * x] + srcRow[2 * x + 1] + srcRowBelow[2 * x] + srcRowBelow[2 * x + 1] + 2 ) >> 2;
+    }
+  }
+
+  // horizontal margins wrap around for equirectangular content, vertical margins are replicated
+  const bool wrap = m_mvReprojection->isEquirectangular();
+  dstRow = dst.buf;
+  for( int y = 0; y < height; y++, dstRow += dst.stride )
+  {
+    for( int x = 1; x <= VA_COARSE_REF_MARGIN; x++ )
+    {
+      dstRow[-x]            = wrap ? dstRow[( ( width - x ) % width + width ) % width] : dstRow[0];
+      dstRow[width - 1 + x] = wrap ? dstRow[( x - 1 ) % width]                         : dstRow[width - 1];
+    }
+  }
+  const size_t rowSize = sizeof( Pel ) * ( width + 2 * VA_COARSE_REF_MARGIN );
+  Pel* topRow    = dst.buf - VA_COARSE_REF_MARGIN;
+  Pel* bottomRow = topRow + ( height - 1 ) * dst.stride;
+  for( int y = 1; y <= VA_COARSE_REF_MARGIN; y++ )
+  {
+    ::memcpy( topRow    - y * dst.stride, topRow,    rowSize );
+    ::memcpy( bottomRow + y * dst.stride, bottomRow, rowSize );
+  }
+
+  coarseRef.pic = refPic;
+  coarseRef.poc = refPic->getPOC();
+  return dst;
+}
+
+Distortion InterSearch::xGetVACoarseCost( const IntTZSearchStruct& cStruct, const CPelBuf& coarseRef, DistParam& distParam, const int iMvX, const int iMvY )
+{
+  // integer motion in full resolution units, one reprojected position per 8x8 subblock (4x4 at half resolution)
+  const Mv mv( iMvX << 1, iMvY << 1 );
+  ArrayXXFixedPtrPair cart2DProjMoved8x8 = m_mvReprojection->reprojectMotionVector8x8( cStruct.blkPos, cStruct.blkSize, mv, cStruct.viewport, 0, 0 );
+  const ArrayXXFixed& xPos = *std::get<0>( cart2DProjMoved8x8 );
+  const ArrayXXFixed& yPos = *std::get<1>( cart2DProjMoved8x8 );
+
+  const bool wrap   = m_mvReprojection->isEquirectangular();
+  const int  width  = coarseRef.width;
+  const int  height = coarseRef.height;
+  for( int row = 0; row < ( cStruct.blkSize.height >> 3 ); row++ )
+  {
+    for( int col = 0; col < ( cStruct.blkSize.width >> 3 ); col++ )
+    {
+      int x = ( xPos( row, col ) + 1 ) >> 1;
+      int y = ( yPos( row, col ) + 1 ) >> 1;
+      x = wrap ? ( x % width + width ) % width : Clip3( -VA_COARSE_REF_MARGIN, width + VA_COARSE_REF_MARGIN - 4, x );
+      y = Clip3( -VA_COARSE_REF_MARGIN, height + VA_COARSE_REF_MARGIN - 4, y );
+
+      const Pel* src = coarseRef.bufAt( x, y );
+      Pel*       dst = m_vaCoarsePred.bufAt( col << 2, row << 2 );
+      for( int i = 0; i < 4; i++, src += coarseRef.stride, dst += m_vaCoarsePred.stride )
+      {
+        ::memcpy( dst, src, 4 * sizeof( Pel ) );
+      }
+    }
+  }
+
+  // the half resolution SAD covers a quarter of the samples
+  return ( distParam.distFunc( distParam ) << 2 ) + m_pcRdCost->getCostOfVectorWithPredictor( mv.hor, mv.ver, cStruct.imvShift );
+}
+
+void InterSearch::xTZSearchVAHier( IntTZSearchStruct& cStruct, const int iSearchRange, const bool bExhaustive )
+{
+  const CPelBuf coarseRef = xGetVACoarseRef( cStruct );
+
+  // half resolution search pattern
+  const CPelBuf& pattern = *cStruct.pcPatternKey;
+  PelBuf coarseOrg( m_vaCoarseOrg.buf, m_vaCoarseOrg.stride, pattern.width >> 1, pattern.height >> 1 );
+  for( int y = 0; y < coarseOrg.height; y++ )
+  {
+    const Pel* src      = pattern.bufAt( 0, 2 * y );
+    const Pel* srcBelow = src + pattern.stride;
+    Pel*       dst      = coarseOrg.bufAt( 0, y );
+    for( int x = 0; x < coarseOrg.width; x++ )
+    {
+      dst[x] = ( src[2 * x] + src[2 * x + 1] + srcBelow[2 * x] + srcBelow[2 * x + 1] + 2 ) >> 2;
+    }
+  }
+
+  DistParam distParam;
+  m_pcRdCost->setDistParam( distParam, coarseOrg, m_vaCoarsePred.buf, m_vaCoarsePred.stride, m_lumaClpRng.bd, COMPONENT_Y, 2 );
+
+  const SearchRange& sr = cStruct.searchRange;
+  const int left   = sr.left   / 2;
+  const int right  = sr.right  / 2;
+  const int top    = sr.top    / 2;
+  const int bottom = sr.bottom / 2;
+
+  // best coarse candidates, sorted by cost
+  struct CoarseCand { int x; int y; Distortion cost; };
+  CoarseCand cands[VA_HIER_NUM_CANDIDATES];
+  int numCands = 0;
+
+  auto checkCoarse = [&]( const int x, const int y )
+  {
+    if( x < left || x > right || y < top || y > bottom )
+    {
+      return;
+    }
+    for( int i = 0; i < numCands; i++ )
+    {
+      if( cands[i].x == x && cands[i].y == y )
+      {
+        return;
+      }
+    }
+    const Distortion cost = xGetVACoarseCost( cStruct, coarseRef, distParam, x, y );
+    int pos = numCands;
+    while( pos > 0 && cands[pos - 1].cost > cost )
+    {
+      pos--;
+    }
+    if( pos >= VA_HIER_NUM_CANDIDATES )
+    {
+      return;
+    }
+    numCands = std::min( numCands + 1, VA_HIER_NUM_CANDIDATES );
+    for( int i = numCands - 1; i > pos; i-- )
+    {
+      cands[i] = cands[i - 1];
+    }
+    cands[pos] = { x, y, cost };
+  };
+
+  if( bExhaustive )
+  {
+    // coarse stage: every second full resolution position of the search window
+    for( int y = top; y <= bottom; y++ )
+    {
+      for( int x = left; x <= right; x++ )
+      {
+        checkCoarse( x, y );
+      }
+    }
+  }
+  else
+  {
+    // coarse stage: expanding diamond around the best start candidate, then square refinement
+    const int startX = ( cStruct.iBestX + 1 ) >> 1;
+    const int startY = ( cStruct.iBestY + 1 ) >> 1;
+    checkCoarse( startX, startY );
+    for( int iDist = 1; iDist <= std::max( 1, iSearchRange >> 1 ); iDist *= 2 )
+    {
+      const int iDist2 = std::max( 1, iDist >> 1 );
+      checkCoarse( startX,          startY - iDist  );
+      checkCoarse( startX - iDist,  startY          );
+      checkCoarse( startX + iDist,  startY          );
+      checkCoarse( startX,          startY + iDist  );
+      if( iDist > 1 )
+      {
+        checkCoarse( startX - iDist2, startY - iDist2 );
+        checkCoarse( startX + iDist2, startY - iDist2 );
+        checkCoarse( startX - iDist2, startY + iDist2 );
+        checkCoarse( startX + iDist2, startY + iDist2 );
+      }
+    }
+    for( int round = 0; round < VA_HIER_MAX_REFINE_ROUNDS && numCands > 0; round++ )
+    {
+      const int bestX = cands[0].x;
+      const int bestY = cands[0].y;
+      for( int i = 1; i < 9; i++ )
+      {
+        checkCoarse( bestX + s_acMvRefineH[i].hor, bestY + s_acMvRefineH[i].ver );
+      }
+      if( cands[0].x == bestX && cands[0].y == bestY )
+      {
+        break;
+      }
+    }
+  }
+
+  // full resolution stage: projected predictions only around the best coarse candidates, each position once
+  const int maxVisited = VA_HIER_NUM_CANDIDATES * 9 + VA_HIER_MAX_REFINE_ROUNDS * 8 + 1;
+  Mv  visited[maxVisited];
+  int numVisited = 0;
+  if( cStruct.uiBestSad != std::numeric_limits<Distortion>::max() )
+  {
+    visited[numVisited++] = Mv( cStruct.iBestX, cStruct.iBestY );
+  }
+  auto checkFull = [&]( const int x, const int y )
+  {
+    if( x < sr.left || x > sr.right || y < sr.top || y > sr.bottom || numVisited >= maxVisited )
+    {
+      return;
+    }
+    for( int i = 0; i < numVisited; i++ )
+    {
+      if( visited[i].hor == x && visited[i].ver == y )
+      {
+        return;
+      }
+    }
+    visited[numVisited++] = Mv( x, y );
+    xTZSearchHelp( cStruct, x, y, 0, 0 );
+  };
+
+  for( int i = 0; i < numCands; i++ )
+  {
+    for( int j = 0; j < 9; j++ )
+    {
+      checkFull( ( cands[i].x << 1 ) + s_acMvRefineH[j].hor, ( cands[i].y << 1 ) + s_acMvRefineH[j].ver );
+    }
+  }
+  for( int round = 0; round < VA_HIER_MAX_REFINE_ROUNDS; round++ )
+  {
+    const int bestX = cStruct.iBestX;
+    const int bestY = cStruct.iBestY;
+    for( int j = 1; j < 9; j++ )
+    {
+      checkFull( bestX + s_acMvRefineH[j].hor, bestY + s_acMvRefineH[j].ver );
+    }
+    if( cStruct.iBestX == bestX && cStruct.iBestY == bestY )
+    {
+      break;
+    }
+  }
+}
+
+
 void InterSearch::xTZSearchSelective( const PredictionUnit& pu,
                                       RefPicList            eRefPicList,
                                       int                   iRefIdxPred,
@@ -5796,6 +6135,16 @@ void InterSearch::xTZSearchSelective( const PredictionUnit& pu,
     if (minSize < 128 && minSize >= 4)
     {
       int numberOfOtherMvps = m_numHashMVStoreds[m_currRefPicList][m_currRefPicIndex];
+      if (cStruct.viewport != CLASSIC)
+      {
+        if (xTZSearchHashVA(cStruct))
+        {
+          rcMv.set(cStruct.iBestX, cStruct.iBestY);
+          ruiSAD = cStruct.uiBestSad - m_pcRdCost->getCostOfVectorWithPredictor(cStruct.iBestX, cStruct.iBestY, cStruct.imvShift);
+          return;
+        }
+        numberOfOtherMvps = 0;
+      }
       for (int i = 0; i < numberOfOtherMvps; i++)
       {
         xTZSearchHelp(cStruct, m_hashMVStoreds[m_currRefPicList][m_currRefPicIndex][i].getHor(), m_hashMVStoreds[m_currRefPicList][m_currRefPicIndex][i].getVer(), 0, 0);
@@ -6193,16 +6542,14 @@ void InterSearch::xPatternSearchFracDIFProjected(const PredictionUnit& pu, const
 {
   if (m_skipFracME)
   {
-    CHECK( true, "m_skipFracME=true not compatible with VA-VVC yet.")
-    //    //  Reference pattern initialization (integer scale)
-    //    int         iOffset    = rcMvInt.getHor() + rcMvInt.getVer() * cStruct.iRefStride;
-    //    CPelBuf cPatternRoi(cStruct.piRefY + iOffset, cStruct.iRefStride, *cStruct.pcPatternKey);
-    //    Mv baseRefMv(0, 0);
-    //    rcMvHalf.setZero();
-    //    m_pcRdCost->setCostScale(0);
-    //    xExtDIFUpSamplingH(&cPatternRoi, cStruct.useAltHpelIf);
-    //    rcMvQter = rcMvInt;   rcMvQter <<= 2;    // for mv-cost
-    //    ruiCost = xPatternRefinement(cStruct.pcPatternKey, baseRefMv, 1, rcMvQter, !pu.cs->slice->getDisableSATDForRD());
+    // exact reprojected hash match, only the integer vector is evaluated
+    m_pcRdCost->setDistParam(m_cDistParam, *cStruct.pcPatternKey, m_tmpVaStorage.buf, m_tmpVaStorage.stride, m_lumaClpRng.bd, COMPONENT_Y, 0, 1, m_pcEncCfg->getUseHADME() && !pu.cs->slice->getDisableSATDForRD());
+    m_pcRdCost->setCostScale(0);
+    xMVReprojectionInterpolation(cStruct.blkPos, cStruct.blkSize, *cStruct.pcRefBuf, rcMvBaseI, MV_PRECISION_INT, m_tmpVaStorage, cStruct.viewport, m_lumaClpRng);
+    rcMvRefinedQ = rcMvBaseI;
+    rcMvRefinedQ.changePrecision(MV_PRECISION_INT, MV_PRECISION_QUARTER);
+    ruiCost = m_cDistParam.distFunc( m_cDistParam );
+    ruiCost += m_pcRdCost->getCostOfVectorWithPredictor( rcMvRefinedQ.getHor(), rcMvRefinedQ.getVer(), 0 );
     return;
   }
 
@@ -6343,10 +6690,11 @@ void InterSearch::xMVReprojectionInterpolation(const Position &cuPosition,
 #if INTERPRED_PROFILING
   auto start_interpolTime = std::chrono::high_resolution_clock::now();
 #endif
-  int maxCUWidth = 0; // int(m_pcEncCfg->getMaxCUWidth());
   for (int col = 0; col < cuSize.width / 4; ++col) {
     for (int row = 0; row < cuSize.height / 4; ++row) {
-      if (xPos(row, col) < -maxCUWidth or yPos(row, col) < -maxCUWidth or xPos(row, col) >= refBuf.width + maxCUWidth - 4 or yPos(row, col) >= refBuf.height + maxCUWidth - 4)
+      const Pel* refBlk;
+      int refBlkStride;
+      if (!xGetVARefBlock4x4(refBuf, xPos(row, col), yPos(row, col), refBlk, refBlkStride))
       {
         dstBuf.subBuf(col * 4, row * 4, 4, 4).memset(0);
         continue;
@@ -6355,8 +6703,8 @@ void InterSearch::xMVReprojectionInterpolation(const Position &cuPosition,
       if (yFrac(row, col) == 0)
       {
         m_if.filterHor(COMPONENT_Y,
-                       (Pel *) refBuf.buf + yPos(row, col) * refBuf.stride + xPos(row, col),
-                       refBuf.stride,
+                       (Pel *) refBlk,
+                       refBlkStride,
                        dstBuf.buf + row * 4 * dstBuf.stride + col * 4,
                        dstBuf.stride,
                        4, 4, xFrac(row, col), rndRes, clpRng, nFilterIdx, biMCForDMVR, useAltHpelIf);
@@ -6364,8 +6712,8 @@ void InterSearch::xMVReprojectionInterpolation(const Position &cuPosition,
       else if (xFrac(row, col) == 0)
       {
         m_if.filterVer(COMPONENT_Y,
-                       (Pel *) refBuf.buf + yPos(row, col) * refBuf.stride + xPos(row, col),
-                       refBuf.stride,
+                       (Pel *) refBlk,
+                       refBlkStride,
                        dstBuf.buf + row * 4 * dstBuf.stride + col * 4,
                        dstBuf.stride,
                        4, 4, yFrac(row, col), true, rndRes, clpRng, nFilterIdx, biMCForDMVR, useAltHpelIf);
@@ -6379,8 +6727,8 @@ void InterSearch::xMVReprojectionInterpolation(const Position &cuPosition,
         {
           vFilterSize = NTAPS_BILINEAR;
         }
-        m_if.filterHor(COMPONENT_Y, (Pel *) refBuf.buf + yPos(row, col) * refBuf.stride + xPos(row, col) - ((vFilterSize >> 1) - 1) * refBuf.stride,
-                       refBuf.stride,
+        m_if.filterHor(COMPONENT_Y, (Pel *) refBlk - ((vFilterSize >> 1) - 1) * refBlkStride,
+                       refBlkStride,
                        tmpBuf.buf,
                        tmpBuf.stride,
                        4, 4 + vFilterSize - 1, xFrac(row, col), false, clpRng, nFilterIdx, biMCForDMVR, useAltHpelIf);
@@ -192,6 +192,15 @@ protected:
 
   // Viewport-adaptive
   CompStorage m_tmpVaStorage;  // Buffer for interpolated reprojected pixel data during motion estimation
+  struct VACoarseRef
+  {
+    const Picture* pic = nullptr;
+    int            poc = 0;
+    PelStorage     buf;
+  };
+  VACoarseRef m_vaCoarseRef[NUM_REF_PIC_LIST_01][MAX_NUM_REF];  // Half resolution reference luma for the hierarchical search, built once per reference picture
+  CompStorage m_vaCoarseOrg;   // Half resolution search pattern
+  CompStorage m_vaCoarsePred;  // Half resolution reprojected prediction
 
 public:
   InterSearch();
@@ -388,6 +397,7 @@ protected:
     Viewport        viewport;
     const CPelBuf*  pcPatternKey;
     const CPelBuf*  pcRefBuf;
+    const Picture*  refPic;
     int             iBestX;
     int             iBestY;
     uint32_t        uiBestRound;
@@ -631,6 +641,12 @@ protected:
 
   inline void xApplyMvVA(const IntTZSearchStruct &rcStruct, const Mv &rMv, MvPrecision mvPrec);
 
+  bool xTZSearchHashVA            ( IntTZSearchStruct& cStruct );
+  bool xUseVAHierSearch           ( const IntTZSearchStruct& cStruct ) const;
+  CPelBuf xGetVACoarseRef         ( const IntTZSearchStruct& cStruct );
+  Distortion xGetVACoarseCost     ( const IntTZSearchStruct& cStruct, const CPelBuf& coarseRef, DistParam& distParam, const int iMvX, const int iMvY );
+  void xTZSearchVAHier            ( IntTZSearchStruct& cStruct, const int iSearchRange, const bool bExhaustive );
+
   void xMVReprojectionInterpolation ( const Position&  cuPosition,
                                       const Size&      cuSize,
                                       const CPelBuf&   refBuf,
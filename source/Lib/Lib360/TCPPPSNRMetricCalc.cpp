@@ -49,10 +49,16 @@ TCPPPSNRMetric::TCPPPSNRMetric()
   m_pcReferenceGeomtry = nullptr;
   m_pcOutputCPPGeomtry = nullptr;
   m_pcRefCPPGeomtry    = nullptr;
+  for (Int comp = 0; comp < MAX_NUM_COMPONENT; comp++)
+  {
+    m_pMaskPlane[comp] = nullptr;
+  }
+  xDestroyMaskPlanes();
 }
 
 TCPPPSNRMetric::~TCPPPSNRMetric()
 {
+  xDestroyMaskPlanes();
   if(m_pCart2D)
   {
     free(m_pCart2D); m_pCart2D = nullptr;
@@ -428,6 +434,78 @@ Void TCPPPSNRMetric::initCPPPSNR(InputGeoParam inputGeoParam, Int cppWidth, Int
 #endif
 }
 
+Void TCPPPSNRMetric::xDestroyMaskPlanes()
+{
+  for (Int comp = 0; comp < MAX_NUM_COMPONENT; comp++)
+  {
+    if (m_pMaskPlane[comp])
+    {
+      free(m_pMaskPlane[comp]);
+      m_pMaskPlane[comp] = nullptr;
+    }
+    m_iMaskPlaneWidth[comp] = 0;
+    m_iMaskPlaneHeight[comp] = 0;
+    m_iMaskPlaneSize[comp] = 0;
+  }
+}
+
+//marks the samples inside the Crasters parabolic projection area once, instead of per picture;
+Void TCPPPSNRMetric::xInitMaskPlanes(PelUnitBuf* pcCppYuv)
+{
+  for(Int chan=0; chan<getNumberValidComponents(pcCppYuv->chromaFormat); chan++)
+  {
+    const ComponentID ch=ComponentID(chan);
+    const Int   iWidth     = pcCppYuv->get(ch).width;
+    const Int   iHeight    = pcCppYuv->get(ch).height;
+    if (m_pMaskPlane[ch] && m_iMaskPlaneWidth[ch] == iWidth && m_iMaskPlaneHeight[ch] == iHeight)
+    {
+      continue;
+    }
+    if (m_pMaskPlane[ch])
+    {
+      free(m_pMaskPlane[ch]);
+    }
+    m_pMaskPlane[ch] = (Double*)malloc(iWidth*iHeight*sizeof(Double));
+    m_iMaskPlaneWidth[ch] = iWidth;
+    m_iMaskPlaneHeight[ch] = iHeight;
+
+    Int   iSize            = 0;
+    double fPhi, fLambda;
+    double fIdxX, fIdxY;
+    double fLamdaX, fLamdaY;
+
+    for(Int y=0;y<iHeight;y++)
+    {
+      Double *pMask = m_pMaskPlane[ch] + y*iWidth;
+      for(Int x=0;x<iWidth;x++)
+      {
+        fLamdaX = ((double)x / (iWidth)) * (2 * S_PI) - S_PI;
+        fLamdaY = ((double)y / (iHeight)) * S_PI - (S_PI_2);
+
+        fPhi = 3 * sasin(fLamdaY / S_PI);
+        fLambda = fLamdaX / (2 * scos(2 * fPhi / 3) - 1);
+
+        fLamdaX = (fLambda + S_PI) / 2 / S_PI * (iWidth);
+        fLamdaY = (fPhi + (S_PI / 2)) / S_PI *  (iHeight);
+
+        fIdxX = (int)((fLamdaX < 0) ? fLamdaX - 0.5 : fLamdaX + 0.5);
+        fIdxY = (int)((fLamdaY < 0) ? fLamdaY - 0.5 : fLamdaY + 0.5);
+
+        if(fIdxY >= 0 && fIdxX >= 0 && fIdxX < iWidth && fIdxY < iHeight)
+        {
+          pMask[x] = 1;
+          iSize++;
+        }
+        else
+        {
+          pMask[x] = 0;
+        }
+      }
+    }
+    m_iMaskPlaneSize[ch] = iSize;
+  }
+}
+
 Void TCPPPSNRMetric::xCalculateCPPPSNR( PelUnitBuf* pcOrgPicYuv, PelUnitBuf* pcPicD)
 {
   Int iBitDepthForPSNRCalc[MAX_NUM_CHANNEL_TYPE];
@@ -482,7 +560,9 @@ Void TCPPPSNRMetric::xCalculateCPPPSNR( PelUnitBuf* pcOrgPicYuv, PelUnitBuf* pcP
 #endif
   m_pcOutputCPPGeomtry->framePack(TPicYUVOutCPP);
 
- for(Int chan=0; chan<getNumberValidComponents(pcPicD->chromaFormat); chan++)
+  xInitMaskPlanes(TPicYUVRefCPP);
+
+  for(Int chan=0; chan<getNumberValidComponents(pcPicD->chromaFormat); chan++)
   {
     const ComponentID ch=ComponentID(chan);
     const Pel*  pOrg       = TPicYUVOutCPP->get(ch).bufAt(0, 0);
@@ -492,42 +572,12 @@ Void TCPPPSNRMetric::xCalculateCPPPSNR( PelUnitBuf* pcOrgPicYuv, PelUnitBuf* pcP
     const Int   iWidth     = TPicYUVRefCPP->get(ch).width;
     const Int   iHeight    = TPicYUVRefCPP->get(ch).height;
 
-    Int   iSize            = 0;
-    double fPhi, fLambda;
-    double fIdxX, fIdxY;
-    double fLamdaX, fLamdaY;
-
-    for(Int y=0;y<iHeight;y++)
-    {
-      for(Int x=0;x<iWidth;x++)
-      {
-        fLamdaX = ((double)x / (iWidth)) * (2 * S_PI) - S_PI;
-        fLamdaY = ((double)y / (iHeight)) * S_PI - (S_PI_2);
-
-        fPhi = 3 * sasin(fLamdaY / S_PI);
-        fLambda = fLamdaX / (2 * scos(2 * fPhi / 3) - 1);
-
-        fLamdaX = (fLambda + S_PI) / 2 / S_PI * (iWidth);
-        fLamdaY = (fPhi + (S_PI / 2)) / S_PI *  (iHeight);
-
-        fIdxX = (int)((fLamdaX < 0) ? fLamdaX - 0.5 : fLamdaX + 0.5);
-        fIdxY = (int)((fLamdaY < 0) ? fLamdaY - 0.5 : fLamdaY + 0.5);
-
-        if(fIdxY >= 0 && fIdxX >= 0 && fIdxX < iWidth && fIdxY < iHeight)
-        {
 #if SVIDEO_CPP_FIX
-          Intermediate_Int iDifflp = (Intermediate_Int)((pOrg[x] << iOutputBitShift[toChannelType(ch)]) - (pRec[x] << iReferenceBitShift[toChannelType(ch)]));
+    SCPPDspsnr[chan] = g_pelBufOP.wghtSse(pOrg, iOrgStride, pRec, iRecStride, m_pMaskPlane[ch], iWidth, iWidth, iHeight, iOutputBitShift[toChannelType(ch)], iReferenceBitShift[toChannelType(ch)]);
 #else
-          Intermediate_Int iDifflp  = (Intermediate_Int)((pOrg[x]<<iReferenceBitShift[toChannelType(ch)]) - (pRec[x]<<iOutputBitShift[toChannelType(ch)]) );
+    SCPPDspsnr[chan] = g_pelBufOP.wghtSse(pOrg, iOrgStride, pRec, iRecStride, m_pMaskPlane[ch], iWidth, iWidth, iHeight, iReferenceBitShift[toChannelType(ch)], iOutputBitShift[toChannelType(ch)]);
 #endif
-          SCPPDspsnr[chan]         += iDifflp * iDifflp;
-          iSize++;
-        }
-      }
-      pOrg += iOrgStride;
-      pRec += iRecStride;
-    }
-    SCPPDspsnr[chan] /= iSize;
+    SCPPDspsnr[chan] /= m_iMaskPlaneSize[ch];
   }
 
   for (Int ch_indx = 0; ch_indx < getNumberValidComponents(pcPicD->chromaFormat); ch_indx++)
@@ -78,6 +78,15 @@ private:
   TGeometry     *m_pcOutputCPPGeomtry;
   TGeometry     *m_pcRefCPPGeomtry;
 
+  //per-sample validity mask of the CPP projection area;
+  Double*       m_pMaskPlane[MAX_NUM_COMPONENT];
+  Int           m_iMaskPlaneWidth[MAX_NUM_COMPONENT];
+  Int           m_iMaskPlaneHeight[MAX_NUM_COMPONENT];
+  Int           m_iMaskPlaneSize[MAX_NUM_COMPONENT];
+
+  Void          xInitMaskPlanes(PelUnitBuf* pcCppYuv);
+  Void          xDestroyMaskPlanes();
+
 public:
   TCPPPSNRMetric();
   virtual ~TCPPPSNRMetric();
@@ -346,18 +346,19 @@ Void TEquiRect::spherePadding(Bool bEnforced)
     Int nMarginX = m_iMarginX >> getComponentScaleX(chId);
     Int nMarginY = m_iMarginY >> getComponentScaleY(chId);
 
-    //left and right;
-    Pel *pSrc = m_pFacesOrig[0][ch];
-    Pel *pDst = pSrc + nWidth;
+    //left and right; rows are independent;
+    Int iStride = getStride(ComponentID(ch));
+#if _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
     for(Int i=0; i<nHeight; i++)
     {
-      sPadH(pSrc, pDst, nMarginX);
-      pSrc += getStride(ComponentID(ch));
-      pDst += getStride(ComponentID(ch));
+      Pel *pRow = m_pFacesOrig[0][ch] + i*iStride;
+      sPadH(pRow, pRow + nWidth, nMarginX);
     }
     //top;
-    pSrc = m_pFacesOrig[0][ch] - nMarginX;
-    pDst = pSrc + (nWidth>>1);
+    Pel *pSrc = m_pFacesOrig[0][ch] - nMarginX;
+    Pel *pDst = pSrc + (nWidth>>1);
     for(Int i=-nMarginX; i<((nWidth>>1)+nMarginX); i++)  //only top and bottom padding is necessary for the first stage vertical upsampling;
     {
       sPadV(pSrc, pDst, getStride(ComponentID(ch)), nMarginY);
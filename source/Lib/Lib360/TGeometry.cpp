@@ -1457,6 +1457,10 @@ Void TGeometry::spherePadding(Bool bEnforced)
       if (fIdx == virtualFaceIdx)
         continue;
     }
+#endif
+    // the channels use separate buffers; faces and rows are kept in order since padded samples may be interpolated from already padded ones;
+#if _OPENMP
+#pragma omp parallel for schedule(dynamic)
 #endif
     for (Int ch = 0; ch < getNumChannels(); ch++)
     {
@@ -203,6 +203,13 @@
 #endif
 // 360Lib-12.0;
 #define SVIDEO_GCMP_BLENDING                             1      //JVET-T0118
+#if SVIDEO_VIEWPORT_PSNR
+#define SVIDEO_VIEWPORT_CACHE                            1      // reuse viewport mappings and renders across frames and viewport metrics
+#if SVIDEO_VIEWPORT_CACHE
+#define SVIDEO_VIEWPORT_CACHE_SIZE                       16     // max. number of cached viewports (mapping + render)
+#define SVIDEO_VIEWPORT_CACHE_PRECISION                  100    // viewport angles are quantized to 1/100 degree
+#endif
+#endif
 
 //#define SV_MAX_NUM_SAMPLING          64
 #define SV_MAX_NUM_FACES             20
@@ -56,10 +56,16 @@ TSPSNRMetric::TSPSNRMetric()
 #endif
 {
   m_dSPSNR[0] = m_dSPSNR[1] = m_dSPSNR[2] = 0;
+  for (Int comp = 0; comp < MAX_NUM_COMPONENT; comp++)
+  {
+    m_pPointPlane[comp] = nullptr;
+  }
+  xDestroyPointPlanes();
 }
 
 TSPSNRMetric::~TSPSNRMetric()
 {
+  xDestroyPointPlanes();
   if(m_pCart2D)
   {
     free(m_pCart2D); m_pCart2D = nullptr;
@@ -179,6 +185,7 @@ void TSPSNRMetric::createTable(TGeometry *pcCodingGeomtry)
   CPos2D In2d;
   CPos3D Out3d;
   SPos posIn, posOut;
+  xDestroyPointPlanes();
   m_fpTable = (IPos2D*)malloc(iNumPoints * sizeof(IPos2D));
 #if SVIDEO_CHROMA_TYPES_SUPPORT
   m_fpTableC = (IPos2D*)malloc(iNumPoints * sizeof(IPos2D));
@@ -222,163 +229,151 @@ void TSPSNRMetric::createTable(TGeometry *pcCodingGeomtry)
     }
 }
 
-Void TSPSNRMetric::xCalculateSPSNR(PelUnitBuf& cOrgPicYuv, PelUnitBuf& cPicD)
+#if SVIDEO_FISHEYE
+Bool TSPSNRMetric::xIsInsideFisheye(ComponentID ch, Int x_loc, Int y_loc, Int iWidth, Int iHeight, ChromaFormat fmt)
 {
-  Int iNumPoints = m_iSphNumPoints;
-  Int iBitDepthForPSNRCalc[MAX_NUM_CHANNEL_TYPE];
-  Int iReferenceBitShift[MAX_NUM_CHANNEL_TYPE];
-  Int iOutputBitShift[MAX_NUM_CHANNEL_TYPE];
-  iBitDepthForPSNRCalc[CHANNEL_TYPE_LUMA] = std::max(m_outputBitDepth[CHANNEL_TYPE_LUMA], m_referenceBitDepth[CHANNEL_TYPE_LUMA]);
-  iBitDepthForPSNRCalc[CHANNEL_TYPE_CHROMA] = std::max(m_outputBitDepth[CHANNEL_TYPE_CHROMA], m_referenceBitDepth[CHANNEL_TYPE_CHROMA]);
-  iReferenceBitShift[CHANNEL_TYPE_LUMA] = iBitDepthForPSNRCalc[CHANNEL_TYPE_LUMA] - m_referenceBitDepth[CHANNEL_TYPE_LUMA];
-  iReferenceBitShift[CHANNEL_TYPE_CHROMA] = iBitDepthForPSNRCalc[CHANNEL_TYPE_CHROMA] - m_referenceBitDepth[CHANNEL_TYPE_CHROMA];
-  iOutputBitShift[CHANNEL_TYPE_LUMA] = iBitDepthForPSNRCalc[CHANNEL_TYPE_LUMA] - m_outputBitDepth[CHANNEL_TYPE_LUMA];
-  iOutputBitShift[CHANNEL_TYPE_CHROMA] = iBitDepthForPSNRCalc[CHANNEL_TYPE_CHROMA] - m_outputBitDepth[CHANNEL_TYPE_CHROMA];
+  iWidth = iWidth << ::getComponentScaleX(ch, fmt);
+  iHeight = iHeight << ::getComponentScaleY(ch, fmt);
 
-  memset(m_dSPSNR, 0, sizeof(Double) * 3);
-  //PelUnitBuf &picd=cPicD;
-  Double SSDspsnr[3] = { 0, 0 ,0 };
-#if SVIDEO_FISHEYE  
-  Int num_subset[3] = { 0, 0, 0 };
-#endif
-  for (Int chan = 0; chan<getNumberValidComponents(cPicD.chromaFormat); chan++)
-  {
-    const ComponentID ch = ComponentID(chan);
-    const Pel*  pOrg = cOrgPicYuv.get(ch).bufAt(0, 0);
-    const Int   iOrgStride = cOrgPicYuv.get(ch).stride;
-    const Pel*  pRec = cPicD.get(ch).bufAt(0, 0);
-    const Int   iRecStride = cPicD.get(ch).stride;
-#if SVIDEO_FISHEYE
-    num_subset[chan] = 0;
-#endif
-    for (Int np = 0; np < iNumPoints; np++)
-    {
-      if (!chan)
-      {
-        Int x_loc = (Int)(m_fpTable[np].x);
-        Int y_loc = (Int)(m_fpTable[np].y);
-        Intermediate_Int iDifflp = (pOrg[x_loc + (y_loc*iOrgStride)] << iReferenceBitShift[toChannelType(ch)]) - (pRec[x_loc + (y_loc*iRecStride)] << iOutputBitShift[toChannelType(ch)]);
-#if SVIDEO_FISHEYE
-        if (m_refVideoInfo.geoType == SVIDEO_EQUIRECT && m_codingVideoInfo.geoType == SVIDEO_FISHEYE_CIRCULAR)
-        {
-          Int iWidth = cPicD.get(ch).width << ::getComponentScaleX(ch, cPicD.chromaFormat);
-          Int iHeight = cPicD.get(ch).height << ::getComponentScaleY(ch, cPicD.chromaFormat);
+  // for fisheye center
+  Double  max_angle_rad = m_codingVideoInfo.sFisheyeInfo.fFOV /SVIDEO_ROT_PRECISION/ 2.0 * S_PI / 180.0;
 
-          // for fisheye center
-          Double  max_angle_rad = m_codingVideoInfo.sFisheyeInfo.fFOV /SVIDEO_ROT_PRECISION/ 2.0 * S_PI / 180.0;
+  Double  ctr_yaw = m_codingVideoInfo.sFisheyeInfo.fCentreAzimuth / SVIDEO_ROT_PRECISION * S_PI / 180;
+  Double  ctr_pitch = -m_codingVideoInfo.sFisheyeInfo.fCentreElevation / SVIDEO_ROT_PRECISION * S_PI / 180;
 
-          Double  ctr_yaw = m_codingVideoInfo.sFisheyeInfo.fCentreAzimuth / SVIDEO_ROT_PRECISION * S_PI / 180;
-          Double  ctr_pitch = -m_codingVideoInfo.sFisheyeInfo.fCentreElevation / SVIDEO_ROT_PRECISION * S_PI / 180;
+  // ERP 2D to 3D mapping
+  Double  ctr_sphere_x = scos(ctr_pitch)*scos(ctr_yaw);
+  Double  ctr_sphere_y = ssin(ctr_pitch);
+  Double  ctr_sphere_z = -scos(ctr_pitch)*ssin(ctr_yaw);
 
-          // ERP 2D to 3D mapping
-          Double  ctr_sphere_x = scos(ctr_pitch)*scos(ctr_yaw);
-          Double  ctr_sphere_y = ssin(ctr_pitch);
-          Double  ctr_sphere_z = -scos(ctr_pitch)*ssin(ctr_yaw);
+  Double  ctr_norm = ssqrt(ctr_sphere_x*ctr_sphere_x + ctr_sphere_y*ctr_sphere_y + ctr_sphere_z*ctr_sphere_z);
 
-          Double  ctr_norm = ssqrt(ctr_sphere_x*ctr_sphere_x + ctr_sphere_y*ctr_sphere_y + ctr_sphere_z*ctr_sphere_z);
+  // for this position
+  Int    xx = x_loc << ::getComponentScaleX(ch, fmt);
+  Int    yy = y_loc << ::getComponentScaleY(ch, fmt);
 
+  Double  yaw = ((xx + 0.5) / iWidth - 0.5) * 2 * S_PI;
+  Double  pitch = ((yy + 0.5) / iHeight - 0.5) * -S_PI;
 
-          // for this position
-          Int    xx = x_loc << ::getComponentScaleX(ch, cPicD.chromaFormat);
-          Int    yy = y_loc << ::getComponentScaleY(ch, cPicD.chromaFormat);
+  // ERP 2D to 3D mapping
+  Double  sphere_x = scos(pitch)*scos(yaw);
+  Double  sphere_y = ssin(pitch);
+  Double  sphere_z = -scos(pitch)*ssin(yaw);
 
-          Double  yaw = ((xx + 0.5) / iWidth - 0.5) * 2 * S_PI;
-          Double  pitch = ((yy + 0.5) / iHeight - 0.5) * -S_PI;
+  Double  norm = ssqrt(sphere_x*sphere_x + sphere_y*sphere_y + sphere_z*sphere_z);
 
-          // ERP 2D to 3D mapping
-          Double  sphere_x = scos(pitch)*scos(yaw);
-          Double  sphere_y = ssin(pitch);
-          Double  sphere_z = -scos(pitch)*ssin(yaw);
+  // theta 
+  Double  innerProduct = sphere_x*ctr_sphere_x + sphere_y*ctr_sphere_y + sphere_z*ctr_sphere_z;
+  Double  theta_rad = acos(innerProduct / (norm * ctr_norm));
 
-          Double  norm = ssqrt(sphere_x*sphere_x + sphere_y*sphere_y + sphere_z*sphere_z);
+  return theta_rad < max_angle_rad;
+}
+#endif
 
-          // theta 
-          Double  innerProduct = sphere_x*ctr_sphere_x + sphere_y*ctr_sphere_y + sphere_z*ctr_sphere_z;
-          Double  theta_rad = acos(innerProduct / (norm * ctr_norm));
+Void TSPSNRMetric::xDestroyPointPlanes()
+{
+  for (Int comp = 0; comp < MAX_NUM_COMPONENT; comp++)
+  {
+    if (m_pPointPlane[comp])
+    {
+      free(m_pPointPlane[comp]);
+      m_pPointPlane[comp] = nullptr;
+    }
+    m_iPointPlaneWidth[comp] = 0;
+    m_iPointPlaneHeight[comp] = 0;
+    m_iPointPlaneCount[comp] = 0;
+  }
+}
 
-          if (theta_rad < max_angle_rad)
-          {
-            SSDspsnr[chan] += iDifflp*iDifflp;
-            num_subset[chan]++;
-          }
-        }
-        else
-#endif
-          SSDspsnr[chan] += iDifflp*iDifflp;
+//accumulates the sphere sampling points into a per-sample hit count plane, so that S-PSNR becomes a weighted SSE;
+Void TSPSNRMetric::xInitPointPlanes(PelUnitBuf& cPicD)
+{
+  const ChromaFormat fmt = cPicD.chromaFormat;
+  for (Int chan = 0; chan < getNumberValidComponents(fmt); chan++)
+  {
+    const ComponentID ch = ComponentID(chan);
+    const Int iWidth  = cPicD.get(ch).width;
+    const Int iHeight = cPicD.get(ch).height;
+    if (m_pPointPlane[ch] && m_iPointPlaneWidth[ch] == iWidth && m_iPointPlaneHeight[ch] == iHeight)
+    {
+      continue;
+    }
+    if (m_pPointPlane[ch])
+    {
+      free(m_pPointPlane[ch]);
+    }
+    m_pPointPlane[ch] = (Double*)calloc(iWidth*iHeight, sizeof(Double));
+    m_iPointPlaneWidth[ch] = iWidth;
+    m_iPointPlaneHeight[ch] = iHeight;
+    m_iPointPlaneCount[ch] = 0;
+
+    for (Int np = 0; np < m_iSphNumPoints; np++)
+    {
+      Int x_loc, y_loc;
+      if (!chan)
+      {
+        x_loc = (Int)(m_fpTable[np].x);
+        y_loc = (Int)(m_fpTable[np].y);
       }
       else
       {
 #if SVIDEO_CHROMA_TYPES_SUPPORT
-        Int x_loc = Int(m_fpTableC[np].x);
-        Int y_loc = Int(m_fpTableC[np].y);
+        x_loc = Int(m_fpTableC[np].x);
+        y_loc = Int(m_fpTableC[np].y);
 #else
-        Int x_loc = Int(m_fpTable[np].x >> ::getComponentScaleX(COMPONENT_Cb, cPicD.chromaFormat));
-        Int y_loc = Int(m_fpTable[np].y >> ::getComponentScaleY(COMPONENT_Cb, cPicD.chromaFormat));
+        x_loc = Int(m_fpTable[np].x >> ::getComponentScaleX(COMPONENT_Cb, fmt));
+        y_loc = Int(m_fpTable[np].y >> ::getComponentScaleY(COMPONENT_Cb, fmt));
 #endif
-        Intermediate_Int iDifflp = (pOrg[x_loc + (y_loc*iOrgStride)] << iReferenceBitShift[toChannelType(ch)]) - (pRec[x_loc + (y_loc*iRecStride)] << iOutputBitShift[toChannelType(ch)]);
-
+      }
 #if SVIDEO_FISHEYE
-        if (m_refVideoInfo.geoType == SVIDEO_EQUIRECT && m_codingVideoInfo.geoType == SVIDEO_FISHEYE_CIRCULAR)
-        {
-          Int iWidth = cPicD.get(ch).width << ::getComponentScaleX(ch, cPicD.chromaFormat);
-          Int iHeight = cPicD.get(ch).height << ::getComponentScaleY(ch, cPicD.chromaFormat);
-
-          // for fisheye center
-          Double  max_angle_rad = m_codingVideoInfo.sFisheyeInfo.fFOV / SVIDEO_ROT_PRECISION / 2.0 * S_PI / 180.0;
-
-          Double  ctr_yaw = m_codingVideoInfo.sFisheyeInfo.fCentreAzimuth / SVIDEO_ROT_PRECISION * S_PI / 180 ;
-          Double  ctr_pitch = -m_codingVideoInfo.sFisheyeInfo.fCentreElevation / SVIDEO_ROT_PRECISION * S_PI / 180;
-
-          // ERP 2D to 3D mapping
-          Double  ctr_sphere_x = scos(ctr_pitch)*scos(ctr_yaw);
-          Double  ctr_sphere_y = ssin(ctr_pitch);
-          Double  ctr_sphere_z = -scos(ctr_pitch)*ssin(ctr_yaw);
-
-          Double  ctr_norm = ssqrt(ctr_sphere_x*ctr_sphere_x + ctr_sphere_y*ctr_sphere_y + ctr_sphere_z*ctr_sphere_z);
-
-
-          // for this position
-          Int    xx = x_loc << ::getComponentScaleX(ch, cPicD.chromaFormat);
-          Int    yy = y_loc << ::getComponentScaleY(ch, cPicD.chromaFormat);
-
-          Double  yaw = ((xx + 0.5) / iWidth - 0.5) * 2 * S_PI;
-          Double  pitch = ((yy + 0.5) / iHeight - 0.5) * -S_PI;
-
-          // ERP 2D to 3D mapping
-          Double  sphere_x = scos(pitch)*scos(yaw);
-          Double  sphere_y = ssin(pitch);
-          Double  sphere_z = -scos(pitch)*ssin(yaw);
-
-          Double  norm = ssqrt(sphere_x*sphere_x + sphere_y*sphere_y + sphere_z*sphere_z);
-
-          // theta 
-          Double  innerProduct = sphere_x*ctr_sphere_x + sphere_y*ctr_sphere_y + sphere_z*ctr_sphere_z;
-          Double  theta_rad = acos(innerProduct / (norm * ctr_norm));
-
-          if (theta_rad < max_angle_rad)
-          {
-            SSDspsnr[chan] += iDifflp*iDifflp;
-            num_subset[chan]++;
-          }
-        }
-        else
-#endif
-          SSDspsnr[chan] += iDifflp*iDifflp;
+      if (m_refVideoInfo.geoType == SVIDEO_EQUIRECT && m_codingVideoInfo.geoType == SVIDEO_FISHEYE_CIRCULAR && !xIsInsideFisheye(ch, x_loc, y_loc, iWidth, iHeight, fmt))
+      {
+        continue;
       }
+#endif
+      m_pPointPlane[ch][y_loc*iWidth + x_loc] += 1;
+      m_iPointPlaneCount[ch]++;
     }
   }
+}
 
-  for (Int ch_indx = 0; ch_indx < getNumberValidComponents(cPicD.chromaFormat); ch_indx++)
+Void TSPSNRMetric::xCalculateSPSNR(PelUnitBuf& cOrgPicYuv, PelUnitBuf& cPicD)
+{
+  Int iNumPoints = m_iSphNumPoints;
+  Int iBitDepthForPSNRCalc[MAX_NUM_CHANNEL_TYPE];
+  Int iReferenceBitShift[MAX_NUM_CHANNEL_TYPE];
+  Int iOutputBitShift[MAX_NUM_CHANNEL_TYPE];
+  iBitDepthForPSNRCalc[CHANNEL_TYPE_LUMA] = std::max(m_outputBitDepth[CHANNEL_TYPE_LUMA], m_referenceBitDepth[CHANNEL_TYPE_LUMA]);
+  iBitDepthForPSNRCalc[CHANNEL_TYPE_CHROMA] = std::max(m_outputBitDepth[CHANNEL_TYPE_CHROMA], m_referenceBitDepth[CHANNEL_TYPE_CHROMA]);
+  iReferenceBitShift[CHANNEL_TYPE_LUMA] = iBitDepthForPSNRCalc[CHANNEL_TYPE_LUMA] - m_referenceBitDepth[CHANNEL_TYPE_LUMA];
+  iReferenceBitShift[CHANNEL_TYPE_CHROMA] = iBitDepthForPSNRCalc[CHANNEL_TYPE_CHROMA] - m_referenceBitDepth[CHANNEL_TYPE_CHROMA];
+  iOutputBitShift[CHANNEL_TYPE_LUMA] = iBitDepthForPSNRCalc[CHANNEL_TYPE_LUMA] - m_outputBitDepth[CHANNEL_TYPE_LUMA];
+  iOutputBitShift[CHANNEL_TYPE_CHROMA] = iBitDepthForPSNRCalc[CHANNEL_TYPE_CHROMA] - m_outputBitDepth[CHANNEL_TYPE_CHROMA];
+
+  memset(m_dSPSNR, 0, sizeof(Double) * 3);
+  xInitPointPlanes(cPicD);
+
+  for (Int chan = 0; chan<getNumberValidComponents(cPicD.chromaFormat); chan++)
   {
-    const ComponentID ch = ComponentID(ch_indx);
+    const ComponentID ch = ComponentID(chan);
+    const Pel*  pOrg = cOrgPicYuv.get(ch).bufAt(0, 0);
+    const Int   iOrgStride = cOrgPicYuv.get(ch).stride;
+    const Pel*  pRec = cPicD.get(ch).bufAt(0, 0);
+    const Int   iRecStride = cPicD.get(ch).stride;
+    const Int   iWidth = cPicD.get(ch).width;
+    const Int   iHeight = cPicD.get(ch).height;
+
+    //the hit counts are integers, the weighted sum thus equals the per-point sum exactly;
+    Double SSDspsnr = g_pelBufOP.wghtSse(pOrg, iOrgStride, pRec, iRecStride, m_pPointPlane[ch], iWidth, iWidth, iHeight, iReferenceBitShift[toChannelType(ch)], iOutputBitShift[toChannelType(ch)]);
+
     const Int maxval = 255 << (iBitDepthForPSNRCalc[toChannelType(ch)] - 8);
 
     Double fReflpsnr = Double(iNumPoints)*maxval*maxval;
 #if SVIDEO_FISHEYE
     if (m_refVideoInfo.geoType == SVIDEO_EQUIRECT && m_codingVideoInfo.geoType == SVIDEO_FISHEYE_CIRCULAR)
-      fReflpsnr = Double(num_subset[ch_indx])*maxval*maxval;
+      fReflpsnr = Double(m_iPointPlaneCount[ch])*maxval*maxval;
 #endif
-    m_dSPSNR[ch_indx] = (SSDspsnr[ch_indx] ? 10.0 * log10(fReflpsnr / (Double)SSDspsnr[ch_indx]) : 999.99);
+    m_dSPSNR[chan] = (SSDspsnr ? 10.0 * log10(fReflpsnr / SSDspsnr) : 999.99);
   }
 }
 
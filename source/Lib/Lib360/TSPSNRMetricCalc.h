@@ -78,6 +78,17 @@ private:
   IPos*       m_pSamplePosCTable;  
   IPos*       m_pSamplePosCRecTable;
 #endif
+#endif
+  //per-sample sampling point counts, derived once from the frame packing tables;
+  Double*   m_pPointPlane[MAX_NUM_COMPONENT];
+  Int       m_iPointPlaneWidth[MAX_NUM_COMPONENT];
+  Int       m_iPointPlaneHeight[MAX_NUM_COMPONENT];
+  Int       m_iPointPlaneCount[MAX_NUM_COMPONENT];
+
+  Void      xInitPointPlanes(PelUnitBuf& cPicD);
+  Void      xDestroyPointPlanes();
+#if SVIDEO_FISHEYE
+  Bool      xIsInsideFisheye(ComponentID ch, Int x_loc, Int y_loc, Int iWidth, Int iHeight, ChromaFormat fmt);
 #endif
 public:
   TSPSNRMetric();
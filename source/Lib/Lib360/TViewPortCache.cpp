@@ -0,0 +1,210 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2018, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TViewPortCache.cpp
+    \brief    ViewPortCache class
+*/
+
+#include <math.h>
+#include "TViewPortCache.h"
+
+#if SVIDEO_VIEWPORT_CACHE
+
+static inline Int quantizeAngle(Float fAngle)
+{
+  return (Int)sfloor(fAngle*SVIDEO_VIEWPORT_CACHE_PRECISION + 0.5);
+}
+
+static inline Float dequantizeAngle(Int iAngle)
+{
+  return (Float)iAngle/SVIDEO_VIEWPORT_CACHE_PRECISION;
+}
+
+Bool ViewPortCacheKey::operator==(const ViewPortCacheKey& k) const
+{
+  return iSrcGeoType == k.iSrcGeoType && iSrcFaceWidth == k.iSrcFaceWidth && iSrcFaceHeight == k.iSrcFaceHeight
+      && iSrcNumFaces == k.iSrcNumFaces && iSrcCompactFP == k.iSrcCompactFP
+      && iSrcRot[0] == k.iSrcRot[0] && iSrcRot[1] == k.iSrcRot[1] && iSrcRot[2] == k.iSrcRot[2]
+      && bRec == k.bRec
+      && iWidth == k.iWidth && iHeight == k.iHeight && iChromaFmt == k.iChromaFmt
+      && iHFOV == k.iHFOV && iVFOV == k.iVFOV && iYaw == k.iYaw && iPitch == k.iPitch;
+}
+
+TViewPortCache::TViewPortCache(Int iCapacity)
+: m_iCapacity(std::max(iCapacity, 2))  //the reference and the reconstructed viewport are used at the same time;
+, m_uiMappingHits(0)
+, m_uiMappingMisses(0)
+, m_uiRenderHits(0)
+{
+}
+
+TViewPortCache::~TViewPortCache()
+{
+  for(std::list<ViewPortCacheEntry>::iterator it = m_entries.begin(); it != m_entries.end(); it++)
+  {
+    xDestroyEntry(*it);
+  }
+  m_entries.clear();
+}
+
+Void TViewPortCache::xDestroyEntry(ViewPortCacheEntry& entry)
+{
+  if(entry.pViewPort)
+  {
+    delete entry.pViewPort;
+    entry.pViewPort = nullptr;
+  }
+  if(entry.pRender)
+  {
+    entry.pRender->destroy();
+    delete entry.pRender;
+    entry.pRender = nullptr;
+  }
+}
+
+Void TViewPortCache::xMakeKey(TGeometry *pSrcGeometry, SVideoInfo& sViewPortInfo, Bool bRec, ViewPortCacheKey& key)
+{
+  SVideoInfo *pSrcInfo = pSrcGeometry->getSVideoInfo();
+  key.iSrcGeoType    = pSrcInfo->geoType;
+  key.iSrcFaceWidth  = pSrcInfo->iFaceWidth;
+  key.iSrcFaceHeight = pSrcInfo->iFaceHeight;
+  key.iSrcNumFaces   = pSrcInfo->iNumFaces;
+  key.iSrcCompactFP  = pSrcInfo->iCompactFPStructure;
+  for(Int i=0; i<3; i++)
+  {
+    key.iSrcRot[i] = pSrcInfo->sVideoRotation.degree[i];
+  }
+  key.bRec       = bRec;
+  key.iWidth     = sViewPortInfo.iFaceWidth;
+  key.iHeight    = sViewPortInfo.iFaceHeight;
+  key.iChromaFmt = sViewPortInfo.framePackStruct.chromaFormatIDC;
+  key.iHFOV      = quantizeAngle(sViewPortInfo.viewPort.hFOV);
+  key.iVFOV      = quantizeAngle(sViewPortInfo.viewPort.vFOV);
+  key.iYaw       = quantizeAngle(sViewPortInfo.viewPort.fYaw);
+  key.iPitch     = quantizeAngle(sViewPortInfo.viewPort.fPitch);
+}
+
+std::list<ViewPortCacheEntry>::iterator TViewPortCache::xFind(const ViewPortCacheKey& key)
+{
+  std::list<ViewPortCacheEntry>::iterator it = m_entries.begin();
+  for(; it != m_entries.end(); it++)
+  {
+    if(it->key == key)
+    {
+      break;
+    }
+  }
+  return it;
+}
+
+PelStorage* TViewPortCache::getRender(TGeometry *pSrcGeometry, SVideoInfo& sViewPortInfo, Bool bRec, Int iFrameId)
+{
+  if(iFrameId < 0)
+  {
+    return nullptr;
+  }
+  ViewPortCacheKey key;
+  xMakeKey(pSrcGeometry, sViewPortInfo, bRec, key);
+  std::list<ViewPortCacheEntry>::iterator it = xFind(key);
+  if(it == m_entries.end() || it->iFrameId != iFrameId)
+  {
+    return nullptr;
+  }
+  m_entries.splice(m_entries.begin(), m_entries, it);
+  m_uiRenderHits++;
+  return it->pRender;
+}
+
+PelStorage* TViewPortCache::render(TGeometry *pSrcGeometry, SVideoInfo& sViewPortInfo, InputGeoParam *pInGeoParam, Bool bRec, Int iFrameId)
+{
+  ViewPortCacheKey key;
+  xMakeKey(pSrcGeometry, sViewPortInfo, bRec, key);
+  std::list<ViewPortCacheEntry>::iterator it = xFind(key);
+  if(it != m_entries.end())
+  {
+    m_entries.splice(m_entries.begin(), m_entries, it);
+    m_uiMappingHits++;
+  }
+  else
+  {
+    ViewPortCacheEntry entry;
+    entry.pViewPort = nullptr;
+    entry.pRender = nullptr;
+    if((Int)m_entries.size() >= m_iCapacity)
+    {
+      //recycle the least recently used viewport; its mapping is rebuilt for the new key;
+      entry = m_entries.back();
+      m_entries.pop_back();
+      if(entry.key.iWidth != key.iWidth || entry.key.iHeight != key.iHeight || entry.key.iChromaFmt != key.iChromaFmt)
+      {
+        xDestroyEntry(entry);
+      }
+    }
+    entry.key = key;
+    entry.iFrameId = -1;
+
+    Float fHFOV  = dequantizeAngle(key.iHFOV);
+    Float fVFOV  = dequantizeAngle(key.iVFOV);
+    Float fYaw   = dequantizeAngle(key.iYaw);
+    Float fPitch = dequantizeAngle(key.iPitch);
+    if(!entry.pViewPort)
+    {
+      SVideoInfo sInfo = sViewPortInfo;
+      sInfo.viewPort.hFOV   = fHFOV;
+      sInfo.viewPort.vFOV   = fVFOV;
+      sInfo.viewPort.fYaw   = fYaw;
+      sInfo.viewPort.fPitch = fPitch;
+      entry.pViewPort = TGeometry::create(sInfo, pInGeoParam);
+      entry.pRender = new PelStorage;
+      entry.pRender->create(sInfo.framePackStruct.chromaFormatIDC, Area(Position(), Size(sInfo.iFaceWidth, sInfo.iFaceHeight)), 0, S_PAD_MAX, MEMORY_ALIGN_DEF_SIZE);
+    }
+    else
+    {
+      ((TViewPort *)entry.pViewPort)->setViewPort(fHFOV, fVFOV, fYaw, fPitch);
+    }
+    m_entries.push_front(entry);
+    it = m_entries.begin();
+    m_uiMappingMisses++;
+  }
+
+  pSrcGeometry->geoConvert(it->pViewPort
+#if SVIDEO_ROT_FIX
+    , bRec
+#endif
+    );
+  it->pViewPort->framePack(it->pRender);
+  it->iFrameId = iFrameId;
+  return it->pRender;
+}
+
+#endif
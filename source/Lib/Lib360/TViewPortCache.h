@@ -0,0 +1,106 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2018, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TViewPortCache.h
+    \brief    ViewPortCache class (header)
+*/
+
+#ifndef __TVIEWPORTCACHE__
+#define __TVIEWPORTCACHE__
+#include <list>
+#include "TGeometry.h"
+#include "TViewPort.h"
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+#if SVIDEO_VIEWPORT_CACHE
+
+struct ViewPortCacheKey
+{
+  //source geometry;
+  Int  iSrcGeoType;
+  Int  iSrcFaceWidth;
+  Int  iSrcFaceHeight;
+  Int  iSrcNumFaces;
+  Int  iSrcCompactFP;
+  Int  iSrcRot[3];
+  Bool bRec;              //reconstructed source; also separates the ref/rec entries of the same geometry;
+  //viewport, angles in 1/SVIDEO_VIEWPORT_CACHE_PRECISION degree;
+  Int  iWidth;
+  Int  iHeight;
+  Int  iChromaFmt;
+  Int  iHFOV;
+  Int  iVFOV;
+  Int  iYaw;
+  Int  iPitch;
+
+  Bool operator==(const ViewPortCacheKey& k) const;
+};
+
+struct ViewPortCacheEntry
+{
+  ViewPortCacheKey key;
+  TGeometry       *pViewPort;     //owns the geometry mapping of the viewport;
+  PelStorage      *pRender;
+  Int              iFrameId;      //frame of the cached render; -1: no valid render;
+};
+
+class TViewPortCache
+{
+private:
+  std::list<ViewPortCacheEntry> m_entries;   //most recently used first;
+  Int     m_iCapacity;
+  UInt    m_uiMappingHits;
+  UInt    m_uiMappingMisses;
+  UInt    m_uiRenderHits;
+
+  Void xMakeKey(TGeometry *pSrcGeometry, SVideoInfo& sViewPortInfo, Bool bRec, ViewPortCacheKey& key);
+  std::list<ViewPortCacheEntry>::iterator xFind(const ViewPortCacheKey& key);
+  Void xDestroyEntry(ViewPortCacheEntry& entry);
+public:
+  TViewPortCache(Int iCapacity = SVIDEO_VIEWPORT_CACHE_SIZE);
+  virtual ~TViewPortCache();
+
+  //cached render of frame iFrameId, nullptr if not available;
+  PelStorage* getRender(TGeometry *pSrcGeometry, SVideoInfo& sViewPortInfo, Bool bRec, Int iFrameId);
+  //renders the viewport from the (converted) source geometry; iFrameId<0 disables render reuse;
+  PelStorage* render(TGeometry *pSrcGeometry, SVideoInfo& sViewPortInfo, InputGeoParam *pInGeoParam, Bool bRec, Int iFrameId);
+
+  UInt getMappingHits()   { return m_uiMappingHits;   }
+  UInt getMappingMisses() { return m_uiMappingMisses; }
+  UInt getRenderHits()    { return m_uiRenderHits;    }
+};
+
+#endif
+#endif // __TVIEWPORTCACHE__
@@ -41,14 +41,21 @@
 #if SVIDEO_VIEWPORT_PSNR
 TViewPortPSNR::TViewPortPSNR() 
 : m_pRefGeometry(nullptr)
-, m_pRefViewPortList(nullptr)
 , m_pRecGeometry(nullptr)
+#if SVIDEO_VIEWPORT_CACHE
+, m_pcViewPortCache(nullptr)
+, m_bViewPortCacheOwner(false)
+#else
+, m_pRefViewPortList(nullptr)
 , m_pRecViewPortList(nullptr)
+#endif
 #if !SVIDEO_E2E_METRICS
 , m_pcOrgPicYuv(nullptr)
 #endif
+#if !SVIDEO_VIEWPORT_CACHE
 , m_pRefViewPortYuv(nullptr)
 , m_pRecViewPortYuv(nullptr)
+#endif
 , m_pdPSNRSum(nullptr)
 , m_pdMSESum(nullptr)
 , m_pdPSNR(nullptr)
@@ -85,6 +92,13 @@ TViewPortPSNR::~TViewPortPSNR()
     delete m_pRecGeometry;
     m_pRecGeometry = nullptr;
   }
+#if SVIDEO_VIEWPORT_CACHE
+  if(m_bViewPortCacheOwner)
+  {
+    delete m_pcViewPortCache;
+  }
+  m_pcViewPortCache = nullptr;
+#else
 #if SVIDEO_DYNAMIC_VIEWPORT_PSNR
   for(Int i=0; i<m_iNumViewPorts; i++)
 #else
@@ -113,6 +127,7 @@ TViewPortPSNR::~TViewPortPSNR()
     delete[] m_pRecViewPortList;
     m_pRecViewPortList = nullptr;
   }
+#endif
 #if !SVIDEO_E2E_METRICS
   if(m_pcOrgPicYuv)
   {
@@ -120,6 +135,7 @@ TViewPortPSNR::~TViewPortPSNR()
     delete m_pcOrgPicYuv;
   }
 #endif
+#if !SVIDEO_VIEWPORT_CACHE
   if(m_pRefViewPortYuv)
   {
     m_pRefViewPortYuv->destroy();
@@ -132,6 +148,7 @@ TViewPortPSNR::~TViewPortPSNR()
     delete m_pRecViewPortYuv;
     m_pRecViewPortYuv = nullptr;
   }
+#endif
 
   if(m_pdPSNRSum)
   {
@@ -179,8 +196,10 @@ Void TViewPortPSNR::init(SVideoInfo& sRefVideoInfo, SVideoInfo& sRecVideoInfo, I
 #endif
     m_pRefGeometry = TGeometry::create(sRefVideoInfo, pInGeoParam);
     m_pRecGeometry = TGeometry::create(sRecVideoInfo, pInGeoParam);
+#if !SVIDEO_VIEWPORT_CACHE
     m_pRefViewPortList = new TGeometry*[iNumViewPorts];
     m_pRecViewPortList = new TGeometry*[iNumViewPorts];
+#endif
     SVideoInfo sViewPortInfo;
     memset(&sViewPortInfo, 0, sizeof(sViewPortInfo));
     sViewPortInfo.geoType = SVIDEO_VIEWPORT;
@@ -192,12 +211,16 @@ Void TViewPortPSNR::init(SVideoInfo& sRefVideoInfo, SVideoInfo& sRecVideoInfo, I
     sViewPortInfo.iNumFaces = 1;
     sViewPortInfo.iFaceWidth = m_viewPortPSNRParam.iViewPortWidth;
     sViewPortInfo.iFaceHeight = m_viewPortPSNRParam.iViewPortHeight;
+#if SVIDEO_VIEWPORT_CACHE
+    xInitViewPortCache(sViewPortInfo, pInGeoParam);
+#else
     for(Int i=0; i<iNumViewPorts; i++)
     {
       sViewPortInfo.viewPort = m_viewPortPSNRParam.viewPortSettingsList[i];
       m_pRefViewPortList[i] = TGeometry::create(sViewPortInfo, pInGeoParam);
       m_pRecViewPortList[i] = TGeometry::create(sViewPortInfo, pInGeoParam);
     }
+#endif
 #if SVIDEO_VIEWPORT_BILINEAR_FILTER_FIX
     for(Int ch = CHANNEL_TYPE_LUMA; ch < MAX_NUM_CHANNEL_TYPE; ch++)
     {
@@ -211,10 +234,12 @@ Void TViewPortPSNR::init(SVideoInfo& sRefVideoInfo, SVideoInfo& sRecVideoInfo, I
     m_pdPSNR = new Double[iNumViewPorts][3];
     memset(m_pdPSNR[0], 0, sizeof(Double)*iNumViewPorts*3);
 
+#if !SVIDEO_VIEWPORT_CACHE
     m_pRefViewPortYuv = new PelStorage;
     m_pRefViewPortYuv->create(sViewPortInfo.framePackStruct.chromaFormatIDC, Area(Position(), Size(m_viewPortPSNRParam.iViewPortWidth, m_viewPortPSNRParam.iViewPortHeight)), 0, S_PAD_MAX, MEMORY_ALIGN_DEF_SIZE);
     m_pRecViewPortYuv = new PelStorage;
     m_pRecViewPortYuv->create(sViewPortInfo.framePackStruct.chromaFormatIDC, Area(Position(), Size(m_viewPortPSNRParam.iViewPortWidth, m_viewPortPSNRParam.iViewPortHeight)), 0, S_PAD_MAX, MEMORY_ALIGN_DEF_SIZE);
+#endif
 #if !SVIDEO_E2E_METRICS    
     m_iInputWidth = iInputWidth;
     m_iInputHeight = iInputHeight;
@@ -252,8 +277,10 @@ Void TViewPortPSNR::initDynamicViewPort(SVideoInfo& sRefVideoInfo, SVideoInfo& s
 #endif
     m_pRefGeometry = TGeometry::create(sRefVideoInfo, pInGeoParam);
     m_pRecGeometry = TGeometry::create(sRecVideoInfo, pInGeoParam);
+#if !SVIDEO_VIEWPORT_CACHE
     m_pRefViewPortList = new TGeometry*[iNumViewPorts];
     m_pRecViewPortList = new TGeometry*[iNumViewPorts];
+#endif
     SVideoInfo sViewPortInfo;
     memset(&sViewPortInfo, 0, sizeof(sViewPortInfo));
     sViewPortInfo.geoType = SVIDEO_VIEWPORT;
@@ -265,6 +292,9 @@ Void TViewPortPSNR::initDynamicViewPort(SVideoInfo& sRefVideoInfo, SVideoInfo& s
     sViewPortInfo.iNumFaces = 1;
     sViewPortInfo.iFaceWidth = m_dynamicViewPortPSNRParam.iViewPortWidth;
     sViewPortInfo.iFaceHeight = m_dynamicViewPortPSNRParam.iViewPortHeight;
+#if SVIDEO_VIEWPORT_CACHE
+    xInitViewPortCache(sViewPortInfo, pInGeoParam);
+#else
     for(Int i=0; i<iNumViewPorts; i++)
     {
       ViewPortSettings& viewPort = sViewPortInfo.viewPort;
@@ -276,6 +306,7 @@ Void TViewPortPSNR::initDynamicViewPort(SVideoInfo& sRefVideoInfo, SVideoInfo& s
       m_pRefViewPortList[i] = TGeometry::create(sViewPortInfo, pInGeoParam);
       m_pRecViewPortList[i] = TGeometry::create(sViewPortInfo, pInGeoParam);
     }
+#endif
 #if SVIDEO_VIEWPORT_BILINEAR_FILTER_FIX
     for(Int ch = CHANNEL_TYPE_LUMA; ch < MAX_NUM_CHANNEL_TYPE; ch++)
     {
@@ -290,10 +321,12 @@ Void TViewPortPSNR::initDynamicViewPort(SVideoInfo& sRefVideoInfo, SVideoInfo& s
     m_pdPSNR = new Double[iNumViewPorts][3];
     memset(m_pdPSNR[0], 0, sizeof(Double)*iNumViewPorts*3);
 
+#if !SVIDEO_VIEWPORT_CACHE
     m_pRefViewPortYuv = new PelStorage;
     m_pRefViewPortYuv->create(sViewPortInfo.framePackStruct.chromaFormatIDC, Area(Position(), Size(m_dynamicViewPortPSNRParam.iViewPortWidth, m_dynamicViewPortPSNRParam.iViewPortHeight)), 0, S_PAD_MAX, MEMORY_ALIGN_DEF_SIZE);
     m_pRecViewPortYuv = new PelStorage;
     m_pRecViewPortYuv->create(sViewPortInfo.framePackStruct.chromaFormatIDC, Area(Position(), Size(m_dynamicViewPortPSNRParam.iViewPortWidth, m_dynamicViewPortPSNRParam.iViewPortHeight)), 0, S_PAD_MAX, MEMORY_ALIGN_DEF_SIZE);
+#endif
 
     m_iViewPortBitDepth = pInGeoParam->nOutputBitDepth;
     m_iRefBitDepth = pInGeoParam->nOutputBitDepth;
@@ -303,6 +336,45 @@ Void TViewPortPSNR::initDynamicViewPort(SVideoInfo& sRefVideoInfo, SVideoInfo& s
 }
 #endif
 
+Void TViewPortPSNR::xConvertSource(TGeometry *pGeometry, PelUnitBuf *pcPicYuv)
+{
+  if((pGeometry->getType() == SVIDEO_OCTAHEDRON || pGeometry->getType() == SVIDEO_ICOSAHEDRON) && pGeometry->getSVideoInfo()->iCompactFPStructure) 
+    pGeometry->compactFramePackConvertYuv(pcPicYuv);
+  else
+    pGeometry->convertYuv(pcPicYuv);
+}
+
+#if SVIDEO_VIEWPORT_CACHE
+Void TViewPortPSNR::xInitViewPortCache(SVideoInfo& sViewPortInfo, InputGeoParam *pInGeoParam)
+{
+  m_sViewPortInfo = sViewPortInfo;
+  m_viewPortGeoParam = *pInGeoParam;
+  if(!m_pcViewPortCache)
+  {
+    m_pcViewPortCache = new TViewPortCache;
+    m_bViewPortCacheOwner = true;
+  }
+}
+
+Void TViewPortPSNR::xGenerateViewPorts(PelUnitBuf *pcOrgPicYuv, Int iFrameId, Bool &bRefConverted, PelStorage *&pRefViewPortYuv, PelStorage *&pRecViewPortYuv)
+{
+  //generate reference viewport; the render of the original is reused across viewport metrics;
+  pRefViewPortYuv = m_pcViewPortCache->getRender(m_pRefGeometry, m_sViewPortInfo, false, iFrameId);
+  if(!pRefViewPortYuv)
+  {
+    if(!bRefConverted)
+    {
+      xConvertSource(m_pRefGeometry, pcOrgPicYuv);
+      bRefConverted = true;
+    }
+    pRefViewPortYuv = m_pcViewPortCache->render(m_pRefGeometry, m_sViewPortInfo, &m_viewPortGeoParam, false, iFrameId);
+  }
+
+  //generate reconstructed viewport; never reused since the reconstruction is only known per call;
+  pRecViewPortYuv = m_pcViewPortCache->render(m_pRecGeometry, m_sViewPortInfo, &m_viewPortGeoParam, true, -1);
+}
+#endif
+
 Void TViewPortPSNR::xCalculatePSNRInternal(PelUnitBuf *pcOrgPicYuv, PelUnitBuf *pcPicD, Double *pdPSNR, Double *pdMSE)
 {
   for(Int i=0; i<MAX_NUM_COMPONENT; i++)
@@ -384,36 +456,35 @@ Void TViewPortPSNR::xCalculatePSNR( Picture* pcPic)
   PelUnitBuf tmp;
   m_pcTVideoIOYuvInputFile->read(tmp, m_pcOrgPicYuv, IPCOLOURSPACE_UNCHANGED, aiPad, m_inputChromaFomat, false );
   m_iLastFrmPOC = pcPic->getPOC()*m_temporalSubsampleRatio+1;
+  PelUnitBuf *pcOrgPicYuv = m_pcOrgPicYuv;
 #endif
   Int iNumOfViewPorts = (Int)m_viewPortPSNRParam.viewPortSettingsList.size(); 
-#if SVIDEO_E2E_METRICS
-  if((m_pRefGeometry->getType() == SVIDEO_OCTAHEDRON || m_pRefGeometry->getType() == SVIDEO_ICOSAHEDRON) && m_pRefGeometry->getSVideoInfo()->iCompactFPStructure) 
-    m_pRefGeometry->compactFramePackConvertYuv(pcOrgPicYuv);
-  else
-    m_pRefGeometry->convertYuv(pcOrgPicYuv);
+#if SVIDEO_VIEWPORT_CACHE
+  Bool bRefConverted = false;
 #else
-  if((m_pRefGeometry->getType() == SVIDEO_OCTAHEDRON || m_pRefGeometry->getType() == SVIDEO_ICOSAHEDRON) && m_pRefGeometry->getSVideoInfo()->iCompactFPStructure) 
-    m_pRefGeometry->compactFramePackConvertYuv(m_pcOrgPicYuv);
-  else
-    m_pRefGeometry->convertYuv(m_pcOrgPicYuv);
+  xConvertSource(m_pRefGeometry, pcOrgPicYuv);
 #endif
   PelUnitBuf pRecPicYuv = pcPic->getRecoBuf();
-  if((m_pRecGeometry->getType() == SVIDEO_OCTAHEDRON || m_pRecGeometry->getType() == SVIDEO_ICOSAHEDRON) && m_pRecGeometry->getSVideoInfo()->iCompactFPStructure) 
-    m_pRecGeometry->compactFramePackConvertYuv(&pRecPicYuv);
-  else
-    m_pRecGeometry->convertYuv(&pRecPicYuv);
+  xConvertSource(m_pRecGeometry, &pRecPicYuv);
 
   for(Int i=0; i<iNumOfViewPorts; i++)
   {
     Double *dPSNR = m_pdPSNR[i];
     Double dMSE[MAX_NUM_COMPONENT];
 
+#if SVIDEO_VIEWPORT_CACHE
+    PelStorage *pRefViewPortYuv, *pRecViewPortYuv;
+    m_sViewPortInfo.viewPort = m_viewPortPSNRParam.viewPortSettingsList[i];
+    xGenerateViewPorts(pcOrgPicYuv, pcPic->getPOC(), bRefConverted, pRefViewPortYuv, pRecViewPortYuv);
+#else
+    PelStorage *pRefViewPortYuv = m_pRefViewPortYuv;
+    PelStorage *pRecViewPortYuv = m_pRecViewPortYuv;
     //generate reference viewport;
     m_pRefGeometry->geoConvert(m_pRefViewPortList[i]);
     if((m_pRefViewPortList[i]->getType() == SVIDEO_OCTAHEDRON || m_pRefViewPortList[i]->getType() == SVIDEO_ICOSAHEDRON) && m_pRefViewPortList[i]->getSVideoInfo()->iCompactFPStructure)
-      m_pRefViewPortList[i]->compactFramePack(m_pRefViewPortYuv);
+      m_pRefViewPortList[i]->compactFramePack(pRefViewPortYuv);
     else
-      m_pRefViewPortList[i]->framePack(m_pRefViewPortYuv);
+      m_pRefViewPortList[i]->framePack(pRefViewPortYuv);
     
     //generate reconstructed viewport;
 #if SVIDEO_ROT_FIX
@@ -422,12 +493,13 @@ Void TViewPortPSNR::xCalculatePSNR( Picture* pcPic)
     m_pRecGeometry->geoConvert(m_pRecViewPortList[i]);
 #endif
     if((m_pRecViewPortList[i]->getType() == SVIDEO_OCTAHEDRON || m_pRecViewPortList[i]->getType() == SVIDEO_ICOSAHEDRON) && m_pRecViewPortList[i]->getSVideoInfo()->iCompactFPStructure)
-      m_pRecViewPortList[i]->compactFramePack(m_pRecViewPortYuv);
+      m_pRecViewPortList[i]->compactFramePack(pRecViewPortYuv);
     else
-      m_pRecViewPortList[i]->framePack(m_pRecViewPortYuv);
+      m_pRecViewPortList[i]->framePack(pRecViewPortYuv);
+#endif
 
     //calculate viewport PSNR;
-    xCalculatePSNRInternal(m_pRefViewPortYuv, m_pRecViewPortYuv, dPSNR, dMSE);
+    xCalculatePSNRInternal(pRefViewPortYuv, pRecViewPortYuv, dPSNR, dMSE);
     //added frame based metrics;
     for(Int j=0; j<MAX_NUM_COMPONENT; j++)
     {
@@ -439,11 +511,11 @@ Void TViewPortPSNR::xCalculatePSNR( Picture* pcPic)
     BitDepths bd;
     bd.recon[CHANNEL_TYPE_LUMA] =bd.recon[CHANNEL_TYPE_CHROMA] = m_iRefBitDepth;
     sprintf(fileName, "ref_viewport%d_%dx%d_BD%d.yuv", i, m_viewPortPSNRParam.iViewPortWidth, m_viewPortPSNRParam.iViewPortHeight, m_iRefBitDepth);
-    m_pRefViewPortYuv->dump(fileName, bd, pcPic->getPOC()!=0);
+    pRefViewPortYuv->dump(fileName, bd, pcPic->getPOC()!=0);
     
     bd.recon[CHANNEL_TYPE_LUMA] =bd.recon[CHANNEL_TYPE_CHROMA] = m_iViewPortBitDepth;
     sprintf(fileName, "rec_viewport%d_%dx%d_BD%d.yuv", i, m_viewPortPSNRParam.iViewPortWidth, m_viewPortPSNRParam.iViewPortHeight, m_iViewPortBitDepth);
-    m_pRecViewPortYuv->dump(fileName, bd, pcPic->getPOC()!=0);
+    pRecViewPortYuv->dump(fileName, bd, pcPic->getPOC()!=0);
 #endif
   }
 }
@@ -454,16 +526,13 @@ Void TViewPortPSNR::xCalculateDynamicViewPSNR( Picture* pcPic, PelUnitBuf *pcOrg
   if(!m_dynamicViewPortPSNRParam.bViewPortPSNREnabled)
     return;
 
-  if((m_pRefGeometry->getType() == SVIDEO_OCTAHEDRON || m_pRefGeometry->getType() == SVIDEO_ICOSAHEDRON) && m_pRefGeometry->getSVideoInfo()->iCompactFPStructure) 
-    m_pRefGeometry->compactFramePackConvertYuv(pcOrgPicYuv);
-  else
-    m_pRefGeometry->convertYuv(pcOrgPicYuv);
-
+#if SVIDEO_VIEWPORT_CACHE
+  Bool bRefConverted = false;
+#else
+  xConvertSource(m_pRefGeometry, pcOrgPicYuv);
+#endif
   PelUnitBuf pRecPicYuv = pcPic->getRecoBuf();
-  if((m_pRecGeometry->getType() == SVIDEO_OCTAHEDRON || m_pRecGeometry->getType() == SVIDEO_ICOSAHEDRON) && m_pRecGeometry->getSVideoInfo()->iCompactFPStructure) 
-    m_pRecGeometry->compactFramePackConvertYuv(&pRecPicYuv);
-  else
-    m_pRecGeometry->convertYuv(&pRecPicYuv);
+  xConvertSource(m_pRecGeometry, &pRecPicYuv);
 
   for(Int i=0; i<m_iNumViewPorts; i++)
   {
@@ -477,22 +546,32 @@ Void TViewPortPSNR::xCalculateDynamicViewPSNR( Picture* pcPic, PelUnitBuf *pcOrg
 
     Float dCurrPitch  = (iTotalNumFrame) ? ( dStartPitch + (dEndPitch - dStartPitch)/Float(iTotalNumFrame)*Float(iCurPOC) ) : dStartPitch;
     Float dCurrYaw    = (iTotalNumFrame) ? ( dStartYaw + (dEndYaw - dStartYaw)/Float(iTotalNumFrame)*Float(iCurPOC) ) : dStartYaw;
+
+    Double *dPSNR = m_pdPSNR[i];
+    Double dMSE[MAX_NUM_COMPONENT];
+
+#if SVIDEO_VIEWPORT_CACHE
+    PelStorage *pRefViewPortYuv, *pRecViewPortYuv;
+    m_sViewPortInfo.viewPort.hFOV   = dynViewPort.hFOV;
+    m_sViewPortInfo.viewPort.vFOV   = dynViewPort.vFOV;
+    m_sViewPortInfo.viewPort.fPitch = dCurrPitch;
+    m_sViewPortInfo.viewPort.fYaw   = dCurrYaw;
+    xGenerateViewPorts(pcOrgPicYuv, pcPic->getPOC(), bRefConverted, pRefViewPortYuv, pRecViewPortYuv);
+#else
+    PelStorage *pRefViewPortYuv = m_pRefViewPortYuv;
+    PelStorage *pRecViewPortYuv = m_pRecViewPortYuv;
     m_pRefViewPortList[i]->getSVideoInfo()->viewPort.fPitch = dCurrPitch;
     m_pRefViewPortList[i]->getSVideoInfo()->viewPort.fYaw   = dCurrYaw;
     m_pRecViewPortList[i]->getSVideoInfo()->viewPort.fPitch = dCurrPitch;
     m_pRecViewPortList[i]->getSVideoInfo()->viewPort.fYaw   = dCurrYaw;
 
-
-    Double *dPSNR = m_pdPSNR[i];
-    Double dMSE[MAX_NUM_COMPONENT];
-
     //generate reference viewport;
     m_pRefViewPortList[i]->setGeometryMapping(false);
     m_pRefGeometry->geoConvert(m_pRefViewPortList[i]);
     if((m_pRefViewPortList[i]->getType() == SVIDEO_OCTAHEDRON || m_pRefViewPortList[i]->getType() == SVIDEO_ICOSAHEDRON) && m_pRefViewPortList[i]->getSVideoInfo()->iCompactFPStructure)
-      m_pRefViewPortList[i]->compactFramePack(m_pRefViewPortYuv);
+      m_pRefViewPortList[i]->compactFramePack(pRefViewPortYuv);
     else
-      m_pRefViewPortList[i]->framePack(m_pRefViewPortYuv);
+      m_pRefViewPortList[i]->framePack(pRefViewPortYuv);
 
     //generate reconstructed viewport;
     m_pRecViewPortList[i]->setGeometryMapping(false);
@@ -502,12 +581,13 @@ Void TViewPortPSNR::xCalculateDynamicViewPSNR( Picture* pcPic, PelUnitBuf *pcOrg
     m_pRecGeometry->geoConvert(m_pRecViewPortList[i]);
 #endif
     if((m_pRecViewPortList[i]->getType() == SVIDEO_OCTAHEDRON || m_pRecViewPortList[i]->getType() == SVIDEO_ICOSAHEDRON) && m_pRecViewPortList[i]->getSVideoInfo()->iCompactFPStructure)
-      m_pRecViewPortList[i]->compactFramePack(m_pRecViewPortYuv);
+      m_pRecViewPortList[i]->compactFramePack(pRecViewPortYuv);
     else
-      m_pRecViewPortList[i]->framePack(m_pRecViewPortYuv);
+      m_pRecViewPortList[i]->framePack(pRecViewPortYuv);
+#endif
 
     //calculate viewport PSNR;
-    xCalculatePSNRInternal(m_pRefViewPortYuv, m_pRecViewPortYuv, dPSNR, dMSE);
+    xCalculatePSNRInternal(pRefViewPortYuv, pRecViewPortYuv, dPSNR, dMSE);
     //added frame based metrics;
     for(Int j=0; j<MAX_NUM_COMPONENT; j++)
     {
@@ -519,11 +599,11 @@ Void TViewPortPSNR::xCalculateDynamicViewPSNR( Picture* pcPic, PelUnitBuf *pcOrg
       BitDepths bd;
       bd.recon[CHANNEL_TYPE_LUMA] =bd.recon[CHANNEL_TYPE_CHROMA] = m_iRefBitDepth;
       sprintf(fileName, "ref_dynamic_viewport%d_%dx%d_BD%d.yuv", i, m_dynamicViewPortPSNRParam.iViewPortWidth, m_dynamicViewPortPSNRParam.iViewPortHeight, m_iRefBitDepth);
-      m_pRefViewPortYuv->dump(fileName, bd, pcPic->getPOC()!=0);
+      pRefViewPortYuv->dump(fileName, bd, pcPic->getPOC()!=0);
 
       bd.recon[CHANNEL_TYPE_LUMA] =bd.recon[CHANNEL_TYPE_CHROMA] = m_iViewPortBitDepth;
       sprintf(fileName, "rec_dynamic_viewport%d_%dx%d_BD%d.yuv", i, m_dynamicViewPortPSNRParam.iViewPortWidth, m_dynamicViewPortPSNRParam.iViewPortHeight, m_iViewPortBitDepth);
-      m_pRecViewPortYuv->dump(fileName, bd, pcPic->getPOC()!=0);
+      pRecViewPortYuv->dump(fileName, bd, pcPic->getPOC()!=0);
 #endif
   }
 }
@@ -39,6 +39,7 @@
 #define __TVIEWPORTPSNR__
 #include "TGeometry.h"
 #include "TViewPort.h"
+#include "TViewPortCache.h"
 #include "../Utilities/VideoIOYuv.h"
 #include "../CommonLib/Picture.h"
 #include "../Utilities/VideoIOYuv.h"
@@ -53,14 +54,23 @@ class TViewPortPSNR
 private:
   ViewPortPSNRParam m_viewPortPSNRParam;
   TGeometry *m_pRefGeometry;
-  TGeometry **m_pRefViewPortList;
   TGeometry *m_pRecGeometry;
+#if SVIDEO_VIEWPORT_CACHE
+  TViewPortCache *m_pcViewPortCache;
+  Bool            m_bViewPortCacheOwner;
+  SVideoInfo      m_sViewPortInfo;
+  InputGeoParam   m_viewPortGeoParam;   //with bilinear interpolation;
+#else
+  TGeometry **m_pRefViewPortList;
   TGeometry **m_pRecViewPortList;
+#endif
 #if !SVIDEO_E2E_METRICS  
   PelUnitBuf *m_pcOrgPicYuv;
 #endif
+#if !SVIDEO_VIEWPORT_CACHE
   PelStorage *m_pRefViewPortYuv;
   PelStorage *m_pRecViewPortYuv;
+#endif
   Double (*m_pdPSNRSum)[3];
   Double (*m_pdMSESum)[3];
   Double (*m_pdPSNR)[3];
@@ -87,6 +97,11 @@ private:
 
   Void xCalculatePSNRInternal(PelUnitBuf *pcOrgPicYuv, PelUnitBuf *pcPicD, Double *pdPSNR, Double *pdMSE);
   Void calculateCombinedValues(Int vpIdx, UInt uiNumPics, Double &PSNRyuv, Double &MSEyuv);
+  Void xConvertSource(TGeometry *pGeometry, PelUnitBuf *pcPicYuv);
+#if SVIDEO_VIEWPORT_CACHE
+  Void xInitViewPortCache(SVideoInfo& sViewPortInfo, InputGeoParam *pInGeoParam);
+  Void xGenerateViewPorts(PelUnitBuf *pcOrgPicYuv, Int iFrameId, Bool &bRefConverted, PelStorage *&pRefViewPortYuv, PelStorage *&pRecViewPortYuv);
+#endif
 public:
   TViewPortPSNR();
   virtual ~TViewPortPSNR();
@@ -112,6 +127,10 @@ public:
   Bool isEnabled() { return m_viewPortPSNRParam.bViewPortPSNREnabled; }
 #endif
   Void printSummary(UInt uiNumPics);
+#if SVIDEO_VIEWPORT_CACHE
+  //share the cache between viewport metrics; must be called before init;
+  Void setViewPortCache(TViewPortCache *pcViewPortCache) { m_pcViewPortCache = pcViewPortCache; }
+#endif
 #if SVIDEO_DYNAMIC_VIEWPORT_PSNR
   Void initDynamicViewPort(SVideoInfo& sRefVideoInfo, SVideoInfo& sRecVideoInfo, InputGeoParam *pInGeoParam, DynamicViewPortPSNRParam& param, UInt numFrameSkipped, UInt tempSubsampleRatio);
   Void xCalculateDynamicViewPSNR( Picture* pcPic, PelUnitBuf *pcOrgPicYuv);
@@ -90,10 +90,16 @@ TWSPSNRMetric::TWSPSNRMetric()
 #endif
 {
   m_dWSPSNR[0] = m_dWSPSNR[1] = m_dWSPSNR[2] = 0;
+  for (Int comp = 0; comp < MAX_NUM_COMPONENT; comp++)
+  {
+    m_pWeightPlane[comp] = nullptr;
+  }
+  xDestroyWeightPlanes();
 }
 
 TWSPSNRMetric::~TWSPSNRMetric()
 {
+  xDestroyWeightPlanes();
   if (m_fErpWeight_Y)
   {
     free(m_fErpWeight_Y);
@@ -302,6 +308,7 @@ void TWSPSNRMetric::createTable(PelUnitBuf* pcPicD, TGeometry *pcCodingGeomtry)
   {
     return;
   }
+  xDestroyWeightPlanes();
 
   SVideoInfo *pCodingSVideoInfo = pcCodingGeomtry->getSVideoInfo();
   Int iFaceWidth = pCodingSVideoInfo->iFaceWidth;
@@ -2885,314 +2892,278 @@ void TWSPSNRMetric::createTable(PelUnitBuf* pcPicD, TGeometry *pcCodingGeomtry)
   }
 }
 
-Void TWSPSNRMetric::xCalculateWSPSNR( PelUnitBuf* pcOrgPicYuv, PelUnitBuf* pcPicD )
+Double TWSPSNRMetric::xGetSampleWeight(ComponentID ch, Int x, Int y, Int iWidth, Int iHeight, ChromaFormat fmt)
 {
-  Int iBitDepthForPSNRCalc[MAX_NUM_CHANNEL_TYPE];
-  Int iReferenceBitShift[MAX_NUM_CHANNEL_TYPE];
-  Int iOutputBitShift[MAX_NUM_CHANNEL_TYPE];
-  iBitDepthForPSNRCalc[CHANNEL_TYPE_LUMA] = std::max(m_outputBitDepth[CHANNEL_TYPE_LUMA], m_referenceBitDepth[CHANNEL_TYPE_LUMA]);
-  iBitDepthForPSNRCalc[CHANNEL_TYPE_CHROMA] = std::max(m_outputBitDepth[CHANNEL_TYPE_CHROMA], m_referenceBitDepth[CHANNEL_TYPE_CHROMA]);
-  iReferenceBitShift[CHANNEL_TYPE_LUMA] = iBitDepthForPSNRCalc[CHANNEL_TYPE_LUMA] - m_referenceBitDepth[CHANNEL_TYPE_LUMA];
-  iReferenceBitShift[CHANNEL_TYPE_CHROMA] = iBitDepthForPSNRCalc[CHANNEL_TYPE_CHROMA] - m_referenceBitDepth[CHANNEL_TYPE_CHROMA];
-  iOutputBitShift[CHANNEL_TYPE_LUMA] = iBitDepthForPSNRCalc[CHANNEL_TYPE_LUMA] - m_outputBitDepth[CHANNEL_TYPE_LUMA];
-  iOutputBitShift[CHANNEL_TYPE_CHROMA] = iBitDepthForPSNRCalc[CHANNEL_TYPE_CHROMA] - m_outputBitDepth[CHANNEL_TYPE_CHROMA];
+  const Int chan = (Int)ch;
+  Double fWeight = 1;
 
-  memset(m_dWSPSNR, 0, sizeof(Double)*3);
-  PelUnitBuf &picd=*pcPicD;
-  //Double SSDspsnr[3]={0, 0 ,0};
-  //ChromaFormat chromaFormat = pcPicD->chromaFormat;
-
-  for(Int chan=0; chan< getNumberValidComponents(pcPicD->chromaFormat); chan++)
+#if SVIDEO_HEMI_PROJECTIONS
+  if (m_recGeoType == SVIDEO_HCMP || m_recGeoType == SVIDEO_HEAC)
   {
-    const ComponentID ch=ComponentID(chan);
-    const Pel*  pOrg       = pcOrgPicYuv->get(ch).bufAt(0, 0);
-    const Int   iOrgStride = pcOrgPicYuv->get(ch).stride;
-    const Pel*  pRec       = picd.get(ch).bufAt(0, 0);
-    const Int   iRecStride = picd.get(ch).stride;
-#if SVIDEO_HEMI_PROJECTIONS || SVIDEO_FISHEYE
-    Int Width_from = 0;
-    Int Width_to = 0;
-    Int iWidth = pcPicD->get(ch).width;
-    Int iHeight = pcPicD->get(ch).height;
-  
-    if (m_recGeoType == SVIDEO_HCMP || m_recGeoType == SVIDEO_HEAC)
-    {
-      Width_from = iWidth / 4;
-      Width_to = iWidth - iWidth / 4;
-    }
-    else
+    if (x < iWidth / 4 || x >= iWidth - iWidth / 4)
     {
-      Width_to = iWidth;
+      return 0;
     }
-
-#else
-    const Int   iWidth  = pcPicD->get(ch).width ;
-    const Int   iHeight = pcPicD->get(ch).height ;
+  }
 #endif
-    Double fWeight =1;
-    Double fWeightSum=0;
-    //Int   iSize   = iWidth*iHeight;
 
-    Double SSDwpsnr=0;
-      
-      
-    //WS-PSNR
-    for(Int y = 0; y < iHeight; y++ )
-    {
-        
-      if (m_codingGeoType==SVIDEO_EQUIRECT)
-      {      
-        if(!chan)
-        {
-          fWeight=m_fErpWeight_Y[y];
-        }
-        else
-        {
-          fWeight=m_fErpWeight_C[y];
-        }
-      }
-#if SVIDEO_HEMI_PROJECTIONS 
-      for (Int x = Width_from; x < Width_to; x++)
-#else
-      for(Int x = 0; x < iWidth; x++ )
-#endif
-      {
-        Intermediate_Int iDiff = (Intermediate_Int)( (pOrg[x]<<iReferenceBitShift[toChannelType(ch)]) - (pRec[x]<<iOutputBitShift[toChannelType(ch)]) );
-        if(  (m_codingGeoType == SVIDEO_CUBEMAP) 
+  if (m_codingGeoType==SVIDEO_EQUIRECT)
+  {
+    fWeight = (!chan)? m_fErpWeight_Y[y] : m_fErpWeight_C[y];
+  }
+
+  if(  (m_codingGeoType == SVIDEO_CUBEMAP) 
 #if SVIDEO_ADJUSTED_CUBEMAP
-          || (m_codingGeoType == SVIDEO_ADJUSTEDCUBEMAP)
+    || (m_codingGeoType == SVIDEO_ADJUSTEDCUBEMAP)
 #endif
 #if SVIDEO_EQUATORIAL_CYLINDRICAL && !SVIDEO_ECP_WSPSNR_FIX_TICKET56
-          || (m_codingGeoType == SVIDEO_EQUATORIALCYLINDRICAL)
+    || (m_codingGeoType == SVIDEO_EQUATORIALCYLINDRICAL)
 #endif
 #if SVIDEO_EQUIANGULAR_CUBEMAP
-          || (m_codingGeoType == SVIDEO_EQUIANGULARCUBEMAP)
+    || (m_codingGeoType == SVIDEO_EQUIANGULARCUBEMAP)
 #endif
 #if SVIDEO_HEMI_PROJECTIONS
-          || (m_codingGeoType == SVIDEO_HCMP)
-          || (m_codingGeoType == SVIDEO_HEAC)
+    || (m_codingGeoType == SVIDEO_HCMP)
+    || (m_codingGeoType == SVIDEO_HEAC)
 #endif
-          )
-        {
-          if(!chan)
-          {
-            if(iWidth/4 == iHeight/3 && x >= iWidth/4 && (y< iHeight/3 || y>= 2*iHeight/3))
-            {
-              fWeight=0;
-            }
-            else 
-            {
-              fWeight=m_fCubeWeight_Y[(m_iCodingFaceWidth)*(y%(m_iCodingFaceHeight)) +(x%(m_iCodingFaceWidth))];
-            }
-
-          }
-          else
-          {
-            if(iWidth/4 == iHeight/3 && x >= iWidth/4 && (y< iHeight/3 || y>= 2*iHeight/3))
-            {
-              fWeight=0;
-            }
-            else
-            {
-              fWeight=m_fCubeWeight_C[(m_iCodingFaceWidth>>(::getComponentScaleX(COMPONENT_Cb, pcPicD->chromaFormat)))*(y%(m_iCodingFaceHeight>>(::getComponentScaleY(COMPONENT_Cb, pcPicD->chromaFormat)))) +(x%(m_iCodingFaceWidth>>(::getComponentScaleX(COMPONENT_Cb,pcPicD->chromaFormat))))];
-            }  
-          }
-        }
+    )
+  {
+    if(iWidth/4 == iHeight/3 && x >= iWidth/4 && (y< iHeight/3 || y>= 2*iHeight/3))
+    {
+      fWeight=0;
+    }
+    else if(!chan)
+    {
+      fWeight=m_fCubeWeight_Y[(m_iCodingFaceWidth)*(y%(m_iCodingFaceHeight)) +(x%(m_iCodingFaceWidth))];
+    }
+    else
+    {
+      fWeight=m_fCubeWeight_C[(m_iCodingFaceWidth>>(::getComponentScaleX(COMPONENT_Cb, fmt)))*(y%(m_iCodingFaceHeight>>(::getComponentScaleY(COMPONENT_Cb, fmt)))) +(x%(m_iCodingFaceWidth>>(::getComponentScaleX(COMPONENT_Cb, fmt))))];
+    }
+  }
 #if SVIDEO_ADJUSTED_EQUALAREA
-        else if (m_codingGeoType==SVIDEO_ADJUSTEDEQUALAREA)
+  else if (m_codingGeoType==SVIDEO_ADJUSTEDEQUALAREA)
 #else
-        else if (m_codingGeoType==SVIDEO_EQUALAREA)
+  else if (m_codingGeoType==SVIDEO_EQUALAREA)
 #endif
-        {
-          if(!chan)
-          {
-            fWeight=m_fEapWeight_Y[y*iWidth+x];
-          }
-          else
-          {
-            fWeight=m_fEapWeight_C[y*iWidth+x];
-          }
-        }
-        else if (m_codingGeoType==SVIDEO_OCTAHEDRON )
-        {
-          if(!chan)
-          {
-            fWeight=m_fOctaWeight_Y[iWidth*y +x];
-          }
-          else
-          {
-            fWeight=m_fOctaWeight_C[y*iWidth+x];
-          }
-        }
-        else if ( m_codingGeoType==SVIDEO_ICOSAHEDRON)
-        {
-          if(!chan)
-          {
-            fWeight=m_fIcoWeight_Y[iWidth*y +x];
-          }
-          else
-          {
-            fWeight=m_fIcoWeight_C[y*iWidth+x];
-          }
-        }
+  {
+    fWeight = (!chan)? m_fEapWeight_Y[y*iWidth+x] : m_fEapWeight_C[y*iWidth+x];
+  }
+  else if (m_codingGeoType==SVIDEO_OCTAHEDRON )
+  {
+    fWeight = (!chan)? m_fOctaWeight_Y[y*iWidth+x] : m_fOctaWeight_C[y*iWidth+x];
+  }
+  else if ( m_codingGeoType==SVIDEO_ICOSAHEDRON)
+  {
+    fWeight = (!chan)? m_fIcoWeight_Y[y*iWidth+x] : m_fIcoWeight_C[y*iWidth+x];
+  }
 #if SVIDEO_WSPSNR_SSP
-        else if (m_codingGeoType == SVIDEO_SEGMENTEDSPHERE)
-        {
-            if (!chan)
-            {
-                fWeight = m_fSspWeight_Y[iWidth*y + x];
-            }
-            else
-            {
-                fWeight = m_fSspWeight_C[y*iWidth + x];
-            }
-        }
+  else if (m_codingGeoType == SVIDEO_SEGMENTEDSPHERE)
+  {
+    fWeight = (!chan)? m_fSspWeight_Y[y*iWidth+x] : m_fSspWeight_C[y*iWidth+x];
+  }
 #endif
 #if SVIDEO_ROTATED_SPHERE
-        else if (m_codingGeoType==SVIDEO_ROTATEDSPHERE)
-        {
-            if(!chan)
-            {
-                fWeight = m_fRspWeight_Y[iWidth*y + x];
-            }
-            else
-            {
-                fWeight = m_fRspWeight_C[y*iWidth + x];
-            }
-        }
+  else if (m_codingGeoType==SVIDEO_ROTATEDSPHERE)
+  {
+    fWeight = (!chan)? m_fRspWeight_Y[y*iWidth+x] : m_fRspWeight_C[y*iWidth+x];
+  }
 #endif
 #if SVIDEO_ECP_WSPSNR_FIX_TICKET56
-        else if (m_codingGeoType==SVIDEO_EQUATORIALCYLINDRICAL)
-        {
-            if(!chan)
-            {
-                fWeight = m_fEcpWeight_Y[iWidth*y + x];
-            }
-            else
-            {
-                fWeight = m_fEcpWeight_C[y*iWidth + x];
-            }
-        }
+  else if (m_codingGeoType==SVIDEO_EQUATORIALCYLINDRICAL)
+  {
+    fWeight = (!chan)? m_fEcpWeight_Y[y*iWidth+x] : m_fEcpWeight_C[y*iWidth+x];
+  }
 #endif
 #if SVIDEO_ERP_PADDING
-        else if (m_codingGeoType == SVIDEO_EQUIRECT && m_bPERP )
-        {
-#if 1
-            ChromaFormat fmt = pcPicD->chromaFormat;                
-            if ((x < (SVIDEO_ERP_PAD_L >> getComponentScaleX(ch, fmt))) || (x >= (iWidth - (SVIDEO_ERP_PAD_R >> getComponentScaleX(ch, fmt)))))
-                fWeight = 0;
-            else
-                fWeight = (!chan)? m_fErpWeight_Y[y] : m_fErpWeight_C[y];
-#else
-            if (!chan)
-            {
-                if( (x < SVIDEO_ERP_PAD_L) || (x >= (iWidth - SVIDEO_ERP_PAD_R)))
-                    fWeight = 0;
-                else
-                    fWeight = m_fErpWeight_Y[y];
-            }
-            else
-            {
-                ComponentID chId = ComponentID(chan);
-                ChromaFormat fmt = pcPicD->chromaFormat;
-                
-                if ((x < (SVIDEO_ERP_PAD_L >> getComponentScaleX(chId, fmt))) || (x >= (iWidth - (SVIDEO_ERP_PAD_R >> getComponentScaleX(chId, fmt)))))
-                    fWeight = 0;
-                else
-                    fWeight = m_fErpWeight_C[y];
-            }
-#endif
-        }
+  else if (m_codingGeoType == SVIDEO_EQUIRECT && m_bPERP )
+  {
+    if ((x < (SVIDEO_ERP_PAD_L >> getComponentScaleX(ch, fmt))) || (x >= (iWidth - (SVIDEO_ERP_PAD_R >> getComponentScaleX(ch, fmt)))))
+      fWeight = 0;
+  }
 #endif
 #if SVIDEO_HYBRID_EQUIANGULAR_CUBEMAP
-        else if (m_codingGeoType == SVIDEO_HYBRIDEQUIANGULARCUBEMAP)
-        {
-          if(!chan)
-          {
-            fWeight=m_fHecWeight_Y[y*iWidth+x];
-          }
-          else
-          {
-            fWeight=m_fHecWeight_C[y*iWidth+x];
-          }
-        }
+  else if (m_codingGeoType == SVIDEO_HYBRIDEQUIANGULARCUBEMAP)
+  {
+    fWeight = (!chan)? m_fHecWeight_Y[y*iWidth+x] : m_fHecWeight_C[y*iWidth+x];
+  }
 #endif
 #if SVIDEO_GENERALIZED_CUBEMAP
-        else if (m_codingGeoType == SVIDEO_GENERALIZEDCUBEMAP)
-        {
-          if(!chan)
-          {
-            fWeight=m_fGcmpWeight_Y[y*iWidth+x];
-          }
-          else
-          {
-            fWeight=m_fGcmpWeight_C[y*iWidth+x];
-          }
-        }
+  else if (m_codingGeoType == SVIDEO_GENERALIZEDCUBEMAP)
+  {
+    fWeight = (!chan)? m_fGcmpWeight_Y[y*iWidth+x] : m_fGcmpWeight_C[y*iWidth+x];
+  }
 #endif
 
-
 #if SVIDEO_FISHEYE
-    if (m_codingGeoType == SVIDEO_EQUIRECT && m_recGeoType == SVIDEO_FISHEYE_CIRCULAR)
-    {
-      Double  max_angle_rad = m_fisheyeInfo.fFOV / SVIDEO_ROT_PRECISION / 2 * S_PI / 180.0;
+  if (m_codingGeoType == SVIDEO_EQUIRECT && m_recGeoType == SVIDEO_FISHEYE_CIRCULAR)
+  {
+    Double  max_angle_rad = m_fisheyeInfo.fFOV / SVIDEO_ROT_PRECISION / 2 * S_PI / 180.0;
+
+    Double  ctr_yaw = m_fisheyeInfo.fCentreAzimuth/SVIDEO_ROT_PRECISION * S_PI / 180;
+    Double  ctr_pitch = -m_fisheyeInfo.fCentreElevation/SVIDEO_ROT_PRECISION  * S_PI / 180;
 
-      Double  ctr_yaw = m_fisheyeInfo.fCentreAzimuth/SVIDEO_ROT_PRECISION * S_PI / 180;
-      Double  ctr_pitch = -m_fisheyeInfo.fCentreElevation/SVIDEO_ROT_PRECISION  * S_PI / 180;
+    Double  ctr_sphere_x = scos(ctr_pitch)*scos(ctr_yaw);
+    Double  ctr_sphere_y = ssin(ctr_pitch);
+    Double  ctr_sphere_z = -scos(ctr_pitch)*ssin(ctr_yaw);
 
-      Double  ctr_sphere_x = scos(ctr_pitch)*scos(ctr_yaw);
-      Double  ctr_sphere_y = ssin(ctr_pitch);
-      Double  ctr_sphere_z = -scos(ctr_pitch)*ssin(ctr_yaw);
+    Double  ctr_norm = ssqrt(ctr_sphere_x*ctr_sphere_x + ctr_sphere_y*ctr_sphere_y + ctr_sphere_z*ctr_sphere_z);
 
-      Double  ctr_norm = ssqrt(ctr_sphere_x*ctr_sphere_x + ctr_sphere_y*ctr_sphere_y + ctr_sphere_z*ctr_sphere_z);
+    Int    xx = x << getComponentScaleX(ch, fmt);
+    Int    yy = y << getComponentScaleY(ch, fmt);
 
+    Int    sWidth = iWidth << getComponentScaleX(ch, fmt);
+    Int    sHeight = iHeight << getComponentScaleY(ch, fmt);
 
-      Int    xx = x << getComponentScaleX(ch, pcPicD->chromaFormat);
-      Int    yy = y << getComponentScaleY(ch, pcPicD->chromaFormat);
+    Double  yaw = ((xx + 0.5) / sWidth - 0.5) * 2 * S_PI;
+    Double  pitch = ((yy + 0.5) / sHeight - 0.5) * -S_PI;
 
-      Int    sWidth = pcPicD->get(ch).width << getComponentScaleX(ch, pcPicD->chromaFormat);
-      Int    sHeight = pcPicD->get(ch).height << getComponentScaleY(ch, pcPicD->chromaFormat);
+    Double  sphere_x = scos(pitch)*scos(yaw);
+    Double  sphere_y = ssin(pitch);
+    Double  sphere_z = -scos(pitch)*ssin(yaw);
 
-      Double  yaw = ((xx + 0.5) / sWidth - 0.5) * 2 * S_PI;
-      Double  pitch = ((yy + 0.5) / sHeight - 0.5) * -S_PI;
+    Double  norm = ssqrt(sphere_x*sphere_x + sphere_y*sphere_y + sphere_z*sphere_z);
 
-      Double  sphere_x = scos(pitch)*scos(yaw);
-      Double  sphere_y = ssin(pitch);
-      Double  sphere_z = -scos(pitch)*ssin(yaw);
+    Double  innerProduct = sphere_x*ctr_sphere_x + sphere_y*ctr_sphere_y + sphere_z*ctr_sphere_z;
+    Double  theta_rad = acos(innerProduct / (norm * ctr_norm));
 
-      Double  norm = ssqrt(sphere_x*sphere_x + sphere_y*sphere_y + sphere_z*sphere_z);
+    if (theta_rad >= max_angle_rad)
+    {
+      fWeight = 0;
+    }
+  }
+#endif  // SVIDEO_FISHEYE
 
+  return fWeight;
+}
 
-      Double  innerProduct = sphere_x*ctr_sphere_x + sphere_y*ctr_sphere_y + sphere_z*ctr_sphere_z;
-      Double  theta_rad = acos(innerProduct / (norm * ctr_norm));
-      
-      if (theta_rad < max_angle_rad)
+Void TWSPSNRMetric::xDestroyWeightPlanes()
+{
+  for (Int comp = 0; comp < MAX_NUM_COMPONENT; comp++)
+  {
+    if (m_pWeightPlane[comp])
+    {
+      free(m_pWeightPlane[comp]);
+      m_pWeightPlane[comp] = nullptr;
+    }
+    m_pRowWeight[comp] = nullptr;
+    m_iWeightPlaneWidth[comp] = 0;
+    m_iWeightPlaneHeight[comp] = 0;
+    m_dWeightSum[comp] = 0;
+  }
+}
+
+Void TWSPSNRMetric::xInitWeightPlanes(PelUnitBuf* pcPicD)
+{
+  const ChromaFormat fmt = pcPicD->chromaFormat;
+  for (Int chan = 0; chan < getNumberValidComponents(fmt); chan++)
+  {
+    const ComponentID ch = ComponentID(chan);
+    const Int iWidth  = pcPicD->get(ch).width;
+    const Int iHeight = pcPicD->get(ch).height;
+    if (m_pWeightPlane[ch] && m_iWeightPlaneWidth[ch] == iWidth && m_iWeightPlaneHeight[ch] == iHeight)
+    {
+      continue;
+    }
+    if (m_pWeightPlane[ch])
+    {
+      free(m_pWeightPlane[ch]);
+    }
+
+    //ERP weights only depend on the row, the plane then degenerates to a single column mask;
+    Bool bRowWeight = m_codingGeoType == SVIDEO_EQUIRECT;
+#if SVIDEO_FISHEYE
+    bRowWeight = bRowWeight && m_recGeoType != SVIDEO_FISHEYE_CIRCULAR;
+#endif
+    const Int iPlaneHeight = bRowWeight ? 1 : iHeight;
+    m_pWeightPlane[ch] = (Double*)malloc(iWidth*iPlaneHeight*sizeof(Double));
+    m_pRowWeight[ch] = bRowWeight ? (!chan ? m_fErpWeight_Y : m_fErpWeight_C) : nullptr;
+    m_iWeightPlaneWidth[ch] = iWidth;
+    m_iWeightPlaneHeight[ch] = iHeight;
+
+    Double fWeightSum = 0;
+    if (bRowWeight)
+    {
+      Double *pMask = m_pWeightPlane[ch];
+      for (Int x = 0; x < iWidth; x++)
       {
-        if (fWeight > 0)
-          fWeightSum += fWeight;
-        SSDwpsnr += iDiff * iDiff*fWeight;
+        pMask[x] = xGetSampleWeight(ch, x, 0, iWidth, iHeight, fmt) > 0 ? 1 : 0;
+      }
+      for (Int y = 0; y < iHeight; y++)
+      {
+        for (Int x = 0; x < iWidth; x++)
+        {
+          if (pMask[x] > 0 && m_pRowWeight[ch][y] > 0)
+            fWeightSum += m_pRowWeight[ch][y];
+        }
       }
     }
     else
     {
-#endif  // SVIDEO_FISHEYE
-      if (fWeight > 0)
-        fWeightSum += fWeight;
-      SSDwpsnr += iDiff * iDiff*fWeight;
-#if SVIDEO_FISHEYE
+      for (Int y = 0; y < iHeight; y++)
+      {
+        Double *pWeight = m_pWeightPlane[ch] + y*iWidth;
+        for (Int x = 0; x < iWidth; x++)
+        {
+          pWeight[x] = xGetSampleWeight(ch, x, y, iWidth, iHeight, fmt);
+          if (pWeight[x] > 0)
+            fWeightSum += pWeight[x];
+        }
+      }
     }
-#endif  // SVIDEO_FISHEYE
+    m_dWeightSum[ch] = fWeightSum;
+  }
+}
+
+Void TWSPSNRMetric::xCalculateWSPSNR( PelUnitBuf* pcOrgPicYuv, PelUnitBuf* pcPicD )
+{
+  Int iBitDepthForPSNRCalc[MAX_NUM_CHANNEL_TYPE];
+  Int iReferenceBitShift[MAX_NUM_CHANNEL_TYPE];
+  Int iOutputBitShift[MAX_NUM_CHANNEL_TYPE];
+  iBitDepthForPSNRCalc[CHANNEL_TYPE_LUMA] = std::max(m_outputBitDepth[CHANNEL_TYPE_LUMA], m_referenceBitDepth[CHANNEL_TYPE_LUMA]);
+  iBitDepthForPSNRCalc[CHANNEL_TYPE_CHROMA] = std::max(m_outputBitDepth[CHANNEL_TYPE_CHROMA], m_referenceBitDepth[CHANNEL_TYPE_CHROMA]);
+  iReferenceBitShift[CHANNEL_TYPE_LUMA] = iBitDepthForPSNRCalc[CHANNEL_TYPE_LUMA] - m_referenceBitDepth[CHANNEL_TYPE_LUMA];
+  iReferenceBitShift[CHANNEL_TYPE_CHROMA] = iBitDepthForPSNRCalc[CHANNEL_TYPE_CHROMA] - m_referenceBitDepth[CHANNEL_TYPE_CHROMA];
+  iOutputBitShift[CHANNEL_TYPE_LUMA] = iBitDepthForPSNRCalc[CHANNEL_TYPE_LUMA] - m_outputBitDepth[CHANNEL_TYPE_LUMA];
+  iOutputBitShift[CHANNEL_TYPE_CHROMA] = iBitDepthForPSNRCalc[CHANNEL_TYPE_CHROMA] - m_outputBitDepth[CHANNEL_TYPE_CHROMA];
+
+  memset(m_dWSPSNR, 0, sizeof(Double)*3);
+  xInitWeightPlanes(pcPicD);
+
+  for(Int chan=0; chan< getNumberValidComponents(pcPicD->chromaFormat); chan++)
+  {
+    const ComponentID ch=ComponentID(chan);
+    const Pel*  pOrg       = pcOrgPicYuv->get(ch).bufAt(0, 0);
+    const Int   iOrgStride = pcOrgPicYuv->get(ch).stride;
+    const Pel*  pRec       = pcPicD->get(ch).bufAt(0, 0);
+    const Int   iRecStride = pcPicD->get(ch).stride;
+    const Int   iWidth     = pcPicD->get(ch).width;
+    const Int   iHeight    = pcPicD->get(ch).height;
+    const Int   iOrgShift  = iReferenceBitShift[toChannelType(ch)];
+    const Int   iRecShift  = iOutputBitShift[toChannelType(ch)];
+
+    Double SSDwpsnr=0;
+    if (m_pRowWeight[ch])
+    {
+      for(Int y = 0; y < iHeight; y++ )
+      {
+        if (m_pRowWeight[ch][y] != 0)
+        {
+          SSDwpsnr += m_pRowWeight[ch][y] * g_pelBufOP.wghtSse(pOrg, iOrgStride, pRec, iRecStride, m_pWeightPlane[ch], 0, iWidth, 1, iOrgShift, iRecShift);
+        }
+        pOrg += iOrgStride;
+        pRec += iRecStride;
       }
-    
-      pOrg += iOrgStride;
-      pRec += iRecStride;
-    }      
+    }
+    else
+    {
+      SSDwpsnr = g_pelBufOP.wghtSse(pOrg, iOrgStride, pRec, iRecStride, m_pWeightPlane[ch], iWidth, iWidth, iHeight, iOrgShift, iRecShift);
+    }
 
     const Int maxval = 255<<(iBitDepthForPSNRCalc[toChannelType(ch)]-8) ;
-    //const Double fRefValue = (Double) maxval * maxval * iSize;
 
-    m_dWSPSNR[ch]         = ( SSDwpsnr ? 10.0 * log10( (maxval * maxval*fWeightSum) / (Double)SSDwpsnr ) : 999.99 );
-}
+    m_dWSPSNR[ch]         = ( SSDwpsnr ? 10.0 * log10( (maxval * maxval*m_dWeightSum[ch]) / (Double)SSDwpsnr ) : 999.99 );
+  }
 }
 
 #if SVIDEO_WSPSNR_E2E
@@ -3202,6 +3173,7 @@ Void TWSPSNRMetric::setCodingGeoInfo2(SVideoInfo& sRefVideoInfo, SVideoInfo& sRe
 Void TWSPSNRMetric::setCodingGeoInfo2(SVideoInfo& sRefVideoInfo, SVideoInfo& sRecVideoInfo, InputGeoParam *pInGeoParam, TVideoIOYuv& yuvInputFile, Int iInputWidth, Int iInputHeight, UInt tempSubsampleRatio)
 #endif
 {
+  xDestroyWeightPlanes();
   m_codingGeoType = sRefVideoInfo.geoType; 
   m_iCodingFaceWidth = sRefVideoInfo.iFaceWidth; 
   m_iCodingFaceHeight = sRefVideoInfo.iFaceHeight; 
@@ -117,6 +117,16 @@ private:
 #if SVIDEO_FISHEYE
   FisheyeInfo m_fisheyeInfo;
 #endif
+  //per-sample weight planes, derived once from the geometry weight tables;
+  Double* m_pWeightPlane[MAX_NUM_COMPONENT];      ///< per-sample weights, or a single column mask when m_pRowWeight is set
+  Double* m_pRowWeight[MAX_NUM_COMPONENT];        ///< per-row weights (ERP), not owned
+  Int     m_iWeightPlaneWidth[MAX_NUM_COMPONENT];
+  Int     m_iWeightPlaneHeight[MAX_NUM_COMPONENT];
+  Double  m_dWeightSum[MAX_NUM_COMPONENT];
+
+  Double  xGetSampleWeight(ComponentID ch, Int x, Int y, Int iWidth, Int iHeight, ChromaFormat fmt);
+  Void    xInitWeightPlanes(PelUnitBuf* pcPicD);
+  Void    xDestroyWeightPlanes();
 public:
   TWSPSNRMetric();
   virtual ~TWSPSNRMetric();
@@ -136,6 +146,7 @@ public:
 #if SVIDEO_ERP_PADDING
     m_bPERP = sVidInfo.bPERP;
 #endif
+    xDestroyWeightPlanes();
 #if SVIDEO_FISHEYE
   m_fisheyeInfo = sVidInfo.sFisheyeInfo;
 #endif
@@ -41,6 +41,11 @@
 #include <fstream>
 #include <iostream>
 #include <memory.h>
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
 
 #include "CommonLib/Rom.h"
 #include "VideoIOYuv.h"
@@ -68,46 +73,257 @@ using namespace std;
  */
 static void scalePlane( PelBuf& areaBuf, const int shiftbits, const Pel minval, const Pel maxval)
 {
-  const unsigned width  = areaBuf.width;
-  const unsigned height = areaBuf.height;
-  const unsigned stride = areaBuf.stride;
-        Pel*        img = areaBuf.bufAt(0,0);
-
   if( 0 == shiftbits )
   {
     return;
   }
 
-  if( shiftbits > 0)
+  g_pelBufOP.scaleSamples( areaBuf.bufAt( 0, 0 ), areaBuf.stride, areaBuf.width, areaBuf.height, shiftbits, minval, maxval );
+}
+
+/// number of bytes of a width x height frame (luma samples) in the file
+static size_t frameFileSize( const uint32_t width, const uint32_t height, const ChromaFormat format, const bool is16bit )
+{
+  size_t frameSize = 0;
+  for( uint32_t comp = 0; comp < getNumberValidComponents( format ); comp++ )
+  {
+    const ComponentID compID = ComponentID( comp );
+    frameSize += size_t( width >> getComponentScaleX( compID, format ) ) * ( height >> getComponentScaleY( compID, format ) );
+  }
+  return frameSize * ( is16bit ? 2 : 1 );
+}
+
+/**
+ * Stream buffer moving the file I/O of a VideoIOYuv to a background thread.
+ *
+ * It is installed in place of the file buffer of the fstream, so the plane
+ * readers and writers keep using the stream interface. The file is
+ * transferred in chunks of about one frame through a fixed ring of chunks:
+ * in read mode the thread reads ahead while the caller converts the previous
+ * frames, in write mode the chunks are written in the order they were filled
+ * and a full ring blocks the caller.
+ */
+class AsyncYuvStreamBuf : public std::streambuf
+{
+public:
+  AsyncYuvStreamBuf( std::streambuf* file, bool writeMode, size_t chunkSize, int numChunks )
+    : m_file( file ), m_writeMode( writeMode ), m_chunkSize( chunkSize ), m_chunks( numChunks )
+    , m_chunkSizes( numChunks, 0 ), m_current( -1 ), m_position( 0 ), m_stop( false ), m_eof( false ), m_error( false )
+  {
+    m_position = std::max<off_type>( off_type( file->pubseekoff( 0, std::ios_base::cur, writeMode ? std::ios_base::out : std::ios_base::in ) ), 0 );
+    for( int i = 0; i < numChunks; i++ )
+    {
+      m_chunks[i].resize( chunkSize );
+      m_free.push_back( i );
+    }
+    m_thread = std::thread( &AsyncYuvStreamBuf::xThreadLoop, this );
+  }
+
+  ~AsyncYuvStreamBuf()
+  {
+    finish();
+  }
+
+  /// writes all pending data (write mode) and stops the thread, returns false if writing failed
+  bool finish()
   {
-    for( unsigned y = 0; y < height; y++, img+=stride)
+    if( m_thread.joinable() )
     {
-      for( unsigned x = 0; x < width; x++)
+      std::unique_lock<std::mutex> lock( m_mutex );
+      if( m_writeMode )
       {
-        img[x] <<= shiftbits;
+        xReleaseChunk();
       }
+      m_stop = true;
+      m_cond.notify_all();
+      lock.unlock();
+      m_thread.join();
+    }
+    return !m_error;
+  }
+
+protected:
+  int_type underflow()
+  {
+    if( m_writeMode )
+    {
+      return traits_type::eof();
+    }
+    if( gptr() < egptr() )
+    {
+      return traits_type::to_int_type( *gptr() );
+    }
+
+    std::unique_lock<std::mutex> lock( m_mutex );
+    xReleaseChunk();
+    m_cond.wait( lock, [this] { return !m_filled.empty() || m_eof; } );
+    if( m_filled.empty() )
+    {
+      return traits_type::eof();
+    }
+    xAcquireChunk( m_filled );
+    return gptr() < egptr() ? traits_type::to_int_type( *gptr() ) : traits_type::eof();
+  }
+
+  int_type overflow( int_type c )
+  {
+    if( !m_writeMode )
+    {
+      return traits_type::eof();
+    }
+
+    std::unique_lock<std::mutex> lock( m_mutex );
+    xReleaseChunk();
+    m_cond.wait( lock, [this] { return !m_free.empty() || m_error; } );
+    if( m_error )
+    {
+      return traits_type::eof();
+    }
+    xAcquireChunk( m_free );
+    if( !traits_type::eq_int_type( c, traits_type::eof() ) )
+    {
+      *pptr() = traits_type::to_char_type( c );
+      pbump( 1 );
     }
+    return traits_type::not_eof( c );
   }
-  else if (shiftbits < 0)
+
+  int sync()
+  {
+    return !m_writeMode || !traits_type::eq_int_type( overflow( traits_type::eof() ), traits_type::eof() ) ? 0 : -1;
+  }
+
+  // only relative forward seeks (skipping frames) and position queries are supported
+  pos_type seekoff( off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which )
   {
-    const int shiftbitsr =- shiftbits;
-    const Pel rounding = 1 << (shiftbitsr-1);
+    if( dir != std::ios_base::cur || off < 0 || ( m_writeMode && off != 0 ) )
+    {
+      return pos_type( off_type( -1 ) );
+    }
+    if( m_writeMode )
+    {
+      return pos_type( m_position + off_type( pptr() - pbase() ) );
+    }
 
-    for( unsigned y = 0; y < height; y++, img+=stride)
+    while( off > 0 )
     {
-      for( unsigned x = 0; x < width; x++)
+      if( gptr() == egptr() && traits_type::eq_int_type( underflow(), traits_type::eof() ) )
       {
-        img[x] = Clip3(minval, maxval, Pel((img[x] + rounding) >> shiftbitsr));
+        return pos_type( off_type( -1 ) );
       }
+      const off_type step = std::min<off_type>( off, egptr() - gptr() );
+      gbump( int( step ) );
+      off -= step;
     }
+    return pos_type( m_position + off_type( gptr() - eback() ) );
   }
-}
+
+private:
+  // hands the chunk of the caller to the other side, called with the mutex held
+  void xReleaseChunk()
+  {
+    if( m_current < 0 )
+    {
+      return;
+    }
+    if( m_writeMode )
+    {
+      m_chunkSizes[m_current] = size_t( pptr() - pbase() );
+      m_position += off_type( m_chunkSizes[m_current] );
+      ( m_chunkSizes[m_current] > 0 ? m_filled : m_free ).push_back( m_current );
+      setp( nullptr, nullptr );
+    }
+    else
+    {
+      m_position += off_type( m_chunkSizes[m_current] );
+      m_free.push_back( m_current );
+      setg( nullptr, nullptr, nullptr );
+    }
+    m_current = -1;
+    m_cond.notify_all();
+  }
+
+  void xAcquireChunk( std::deque<int>& queue )
+  {
+    m_current = queue.front();
+    queue.pop_front();
+    char* data = m_chunks[m_current].data();
+    if( m_writeMode )
+    {
+      setp( data, data + m_chunkSize );
+    }
+    else
+    {
+      setg( data, data, data + m_chunkSizes[m_current] );
+    }
+  }
+
+  void xThreadLoop()
+  {
+    std::unique_lock<std::mutex> lock( m_mutex );
+    while( true )
+    {
+      std::deque<int>& input = m_writeMode ? m_filled : m_free;
+      m_cond.wait( lock, [&] { return !input.empty() || m_stop || ( !m_writeMode && m_eof ); } );
+      if( input.empty() || ( !m_writeMode && ( m_stop || m_eof ) ) )
+      {
+        break;
+      }
+
+      const int idx = input.front();
+      input.pop_front();
+      lock.unlock();
+      char* data = m_chunks[idx].data();
+      const std::streamsize size = m_writeMode ? m_file->sputn( data, m_chunkSizes[idx] ) : m_file->sgetn( data, m_chunkSize );
+      lock.lock();
+
+      if( m_writeMode )
+      {
+        m_error |= size != std::streamsize( m_chunkSizes[idx] );
+        m_free.push_back( idx );
+      }
+      else
+      {
+        m_chunkSizes[idx] = size_t( std::max<std::streamsize>( size, 0 ) );
+        m_eof = m_chunkSizes[idx] < m_chunkSize;
+        m_filled.push_back( idx );
+      }
+      m_cond.notify_all();
+    }
+  }
+
+  std::streambuf*                 m_file;
+  const bool                      m_writeMode;
+  const size_t                    m_chunkSize;
+  std::vector<std::vector<char> > m_chunks;
+  std::vector<size_t>             m_chunkSizes;
+  std::deque<int>                 m_free;       ///< chunks available to be filled (by the thread when reading, by the caller when writing)
+  std::deque<int>                 m_filled;     ///< filled chunks in file order
+  int                             m_current;    ///< chunk currently used by the caller, -1 if none
+  off_type                        m_position;   ///< stream position of the current chunk
+  bool                            m_stop;
+  bool                            m_eof;
+  bool                            m_error;
+  std::mutex                      m_mutex;
+  std::condition_variable         m_cond;
+  std::thread                     m_thread;
+};
 
 
 // ====================================================================================================================
 // Public member functions
 // ====================================================================================================================
 
+VideoIOYuv::VideoIOYuv()
+  : m_asyncFrames( 0 )
+{
+}
+
+VideoIOYuv::~VideoIOYuv()
+{
+  xStopAsyncIO();
+}
+
 /**
  * Open file for reading/writing Y'CbCr frames.
  *
@@ -170,9 +386,41 @@ void VideoIOYuv::open( const std::string &fileName, bool bWriteMode, const int f
 
 void VideoIOYuv::close()
 {
+  if( !xStopAsyncIO() )
+  {
+    msg( WARNING, "\nWarning: writing the YUV file failed\n" );
+  }
   m_cHandle.close();
 }
 
+/**
+ * Install the background I/O stream buffer on the file handle.
+ *
+ * \param bWriteMode  true: write-behind, false: read-ahead
+ * \param frameSize   size of one frame in the file, used as chunk size
+ */
+void VideoIOYuv::xStartAsyncIO( bool bWriteMode, size_t frameSize )
+{
+  const std::ios::iostate state = m_cHandle.rdstate();
+  m_asyncBuf.reset( new AsyncYuvStreamBuf( m_cHandle.rdbuf(), bWriteMode, std::max<size_t>( frameSize, 1 ), m_asyncFrames + 1 ) );
+  static_cast<std::ios&>( m_cHandle ).rdbuf( m_asyncBuf.get() );
+  m_cHandle.clear( state );
+}
+
+bool VideoIOYuv::xStopAsyncIO()
+{
+  if( !m_asyncBuf )
+  {
+    return true;
+  }
+  const bool success = m_asyncBuf->finish();
+  const std::ios::iostate state = m_cHandle.rdstate();
+  static_cast<std::ios&>( m_cHandle ).rdbuf( m_cHandle.rdbuf() );
+  m_cHandle.clear( state );
+  m_asyncBuf.reset();
+  return success;
+}
+
 bool VideoIOYuv::isEof()
 {
   return m_cHandle.eof();
@@ -359,7 +607,11 @@ static bool readPlane(Pel* dst,
         {
           // eg file is 422, dest is 444.
           const uint32_t sx=csx_file-csx_dest;
-          if (!is16bit)
+          if (sx == 0)
+          {
+            g_pelBufOP.unpackSamples(buf, pDstBuf, width_dest, is16bit);
+          }
+          else if (!is16bit)
           {
             for (uint32_t x = 0; x < width_dest; x++)
             {
@@ -419,22 +671,7 @@ static bool verifyPlane(Pel* dst,
   const uint32_t fullWidth  = (width444 + padX444) >> csx;
   const uint32_t fullHeight = (height444 +padY444) >> csy;
 
-  Pel  *dstBuf              = dst;
-
-  const Pel mask = ~((1 << bitDepth) - 1);
-
-  for (uint32_t y = 0; y < fullHeight; y++, dstBuf+= stride)
-  {
-    for (uint32_t x = 0; x < fullWidth; x++)
-    {
-      if ( (dstBuf[x] & mask) != 0)
-      {
-        return false;
-      }
-    }
-  }
-
-  return true;
+  return g_pelBufOP.checkSampleRange(dst, stride, fullWidth, fullHeight, bitDepth);
 }
 
 
@@ -665,7 +902,11 @@ static bool writePlane( uint32_t orgWidth, uint32_t orgHeight, ostream& fd, cons
         {
           // eg file is 422, source is 444.
           const uint32_t sx = csx_file - csx_src;
-          if (!is16bit)
+          if (sx == 0)
+          {
+            g_pelBufOP.packSamples(pSrcBuf, buf, width_file, is16bit);
+          }
+          else if (!is16bit)
           {
             for (uint32_t x = 0; x < width_file; x++)
             {
@@ -926,6 +1167,11 @@ bool VideoIOYuv::read ( PelUnitBuf& pic, PelUnitBuf& picOrg, const InputColourSp
   const uint32_t width444       = width_full444 - pad_h444;
   const uint32_t height444      = height_full444 - pad_v444;
 
+  if( m_asyncFrames > 0 && !m_asyncBuf )
+  {
+    xStartAsyncIO( false, frameFileSize( width444, height444, format, is16bit ) );
+  }
+
   for( uint32_t comp=0; comp < ::getNumberValidComponents(format); comp++)
   {
     const ComponentID compID = ComponentID(comp);
@@ -1060,6 +1306,11 @@ bool VideoIOYuv::write( uint32_t orgWidth, uint32_t orgHeight, const CPelUnitBuf
     msg( WARNING, "\nWarning: writing %d x %d luma sample output picture!", width444, height444);
   }
 
+  if( m_asyncFrames > 0 && !m_asyncBuf )
+  {
+    xStartAsyncIO( true, frameFileSize( orgWidth, orgHeight, format, is16bit ) );
+  }
+
   for(uint32_t comp=0; retval && comp < ::getNumberValidComponents(format); comp++)
   {
     const ComponentID compID      = ComponentID(comp);
@@ -1151,6 +1402,11 @@ bool VideoIOYuv::write( const CPelUnitBuf& picTop, const CPelUnitBuf& picBottom,
   CHECK( picTopO.chromaFormat != picBottomO.chromaFormat, "Incompatible formats of bottom and top fields" );
 
   const ChromaFormat dstChrFormat = picTopO.chromaFormat;
+  if( m_asyncFrames > 0 && !m_asyncBuf )
+  {
+    xStartAsyncIO( true, 2 * frameFileSize( picTopO.Y().width, picTopO.Y().height, format, is16bit ) );
+  }
+
   for (uint32_t comp = 0; retval && comp < ::getNumberValidComponents(dstChrFormat); comp++)
   {
     const ComponentID compID     = ComponentID(comp);
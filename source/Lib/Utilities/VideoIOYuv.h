@@ -41,6 +41,7 @@
 #include <stdio.h>
 #include <fstream>
 #include <iostream>
+#include <memory>
 #include "CommonLib/CommonDef.h"
 #include "CommonLib/Unit.h"
 
@@ -53,6 +54,8 @@ using namespace std;
 #include "CommonLib/Slice.h"
 #include "CommonLib/Picture.h"
 
+class AsyncYuvStreamBuf;
+
 /// YUV file I/O class
 class VideoIOYuv
 {
@@ -61,10 +64,17 @@ private:
   int       m_fileBitdepth[MAX_NUM_CHANNEL_TYPE]; ///< bitdepth of input/output video file
   int       m_MSBExtendedBitDepth[MAX_NUM_CHANNEL_TYPE];  ///< bitdepth after addition of MSBs (with value 0)
   int       m_bitdepthShift[MAX_NUM_CHANNEL_TYPE];  ///< number of bits to increase or decrease image by before/after write/read
+  int       m_asyncFrames;                                  ///< number of frames read ahead / written behind by a background thread, 0: synchronous I/O
+  std::unique_ptr<AsyncYuvStreamBuf> m_asyncBuf;            ///< stream buffer installed on m_cHandle while asynchronous I/O is active
+
+  void  xStartAsyncIO( bool bWriteMode, size_t frameSize );
+  bool  xStopAsyncIO ();
 
 public:
-  VideoIOYuv()           {}
-  virtual ~VideoIOYuv()  {}
+  VideoIOYuv();
+  virtual ~VideoIOYuv();
+
+  void  setAsyncFrames( int numFrames )     { m_asyncFrames = numFrames; } ///< set before open(), the background thread starts with the first read/write
 
   void  open  ( const std::string &fileName, bool bWriteMode, const int fileBitDepth[MAX_NUM_CHANNEL_TYPE], const int MSBExtendedBitDepth[MAX_NUM_CHANNEL_TYPE], const int internalBitDepth[MAX_NUM_CHANNEL_TYPE] ); ///< open or create file
   void  close ();                                           ///< close file